@@ -0,0 +1,603 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <zeus/zeus.hpp>
+
+// Microbenchmarks for the hot zeus operations, reported as ns/op.
+// Build in Release; numbers from Debug builds are meaningless.
+// The simd backend is fixed at compile time, so zeusbench-avx, zeusbench-avx512 and zeusbench-none rebuild zeus
+// with other backends. zeusbench, zeusbench-avx and zeusbench-avx512 dispatch batch kernels at runtime; zeusbench-none
+// hides the SSE macros, which also compiles out the ZEUS_KERNEL_* kernels, so it only runs the baseline ones.
+// `zeusbench-all` runs every variant. An optional argument only runs benchmarks whose name contains it.
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+/* Each benchmark is run until one timed batch takes at least this long, then timed again for the result */
+constexpr double MinBatchNs = 20e6;
+constexpr int Repetitions = 3;
+/* Inputs are cycled from pools of this size so results cannot be hoisted out of the loop */
+constexpr size_t PoolSize = 1024;
+
+const char* g_filter = nullptr;
+
+const char* kernelISAName(zeus::EKernelISA isa) {
+  switch (isa) {
+  case zeus::EKernelISA::Baseline:
+    return "baseline";
+  case zeus::EKernelISA::AVX2:
+    return "AVX2";
+  case zeus::EKernelISA::AVX512:
+    return "AVX-512";
+  }
+  return "unknown";
+}
+
+const char* backendName() {
+#if __AVX512F__
+  return "AVX-512";
+#elif __AVX__
+  return "AVX";
+#elif __SSE__
+  return "SSE";
+#elif __ARM_NEON
+  return "NEON";
+#else
+  return "none";
+#endif
+}
+
+template <typename T>
+void doNotOptimize(const T& value) {
+#if __GNUC__
+  asm volatile("" : : "m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+template <typename Func>
+double timeBatchNs(Func& func, size_t iterations) {
+  const auto start = Clock::now();
+  for (size_t i = 0; i < iterations; ++i)
+    func(i % PoolSize);
+  return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+/* func(i) performs one operation on pool entry i */
+template <typename Func>
+void runBenchmark(const char* name, Func&& func) {
+  if (g_filter != nullptr && std::strstr(name, g_filter) == nullptr)
+    return;
+
+  size_t iterations = 1;
+  for (double elapsed = timeBatchNs(func, iterations); elapsed < MinBatchNs;
+       elapsed = timeBatchNs(func, iterations))
+    iterations *= elapsed < MinBatchNs / 16 ? 16 : 2;
+
+  double best = timeBatchNs(func, iterations);
+  for (int r = 1; r < Repetitions; ++r)
+    best = std::min(best, timeBatchNs(func, iterations));
+  std::printf("%-48s %12.2f ns/op %10zu iterations\n", name, best / iterations, iterations);
+}
+
+struct Pools {
+  std::vector<zeus::CMatrix4f> matrices4;
+  std::vector<zeus::CMatrix3f> matrices3;
+  std::vector<zeus::CTransform> transforms;
+  std::vector<zeus::CQuaternion> quats;
+  std::vector<zeus::CVector3f> points;
+  std::vector<zeus::CAABox> boxes;
+  std::vector<zeus::COBBox> obbs;
+
+  explicit Pools(std::mt19937& rng) {
+    std::uniform_real_distribution<float> angle(-M_PIF, M_PIF);
+    std::uniform_real_distribution<float> pos(-50.f, 50.f);
+    std::uniform_real_distribution<float> size(0.5f, 4.f);
+    for (size_t i = 0; i < PoolSize; ++i) {
+      const zeus::CTransform xf =
+          zeus::CTransformFromEditorEulers({angle(rng), angle(rng), angle(rng)}, {pos(rng), pos(rng), pos(rng)});
+      transforms.push_back(xf);
+      matrices4.push_back(xf.toMatrix4f());
+      matrices3.push_back(xf.basis * zeus::CMatrix3f(zeus::CVector3f(size(rng), size(rng), size(rng))));
+      quats.push_back(zeus::CQuaternion(xf.basis));
+      points.emplace_back(pos(rng), pos(rng), pos(rng));
+      const zeus::CVector3f extents(size(rng), size(rng), size(rng));
+      boxes.emplace_back(points.back() - extents, points.back() + extents);
+      obbs.emplace_back(xf, extents);
+    }
+  }
+};
+
+void benchMath(const Pools& pools) {
+  runBenchmark("CMatrix4f::operator*(CMatrix4f)", [&](size_t i) {
+    doNotOptimize(pools.matrices4[i] * pools.matrices4[(i + 1) % PoolSize]);
+  });
+  runBenchmark("CMatrix4f::transposed", [&](size_t i) { doNotOptimize(pools.matrices4[i].transposed()); });
+  runBenchmark("CMatrix3f::inverted", [&](size_t i) { doNotOptimize(pools.matrices3[i].inverted()); });
+  runBenchmark("CQuaternion::slerp", [&](size_t i) {
+    doNotOptimize(zeus::CQuaternion::slerp(pools.quats[i], pools.quats[(i + 1) % PoolSize], double(i) / PoolSize));
+  });
+  runBenchmark("std::sin + std::cos x3", [&](size_t i) {
+    for (int c = 0; c < 3; ++c) {
+      doNotOptimize(std::sin(pools.points[i][c]));
+      doNotOptimize(std::cos(pools.points[i][c]));
+    }
+  });
+  runBenchmark("sincos(simd<float>)", [&](size_t i) {
+    zeus::simd<float> sines, cosines;
+    zeus::_simd::sincos(pools.points[i].mSimd, sines, cosines);
+    doNotOptimize(sines);
+    doNotOptimize(cosines);
+  });
+  runBenchmark("sincos<Fast>(simd<float>)", [&](size_t i) {
+    zeus::simd<float> sines, cosines;
+    zeus::_simd::sincos<zeus::EMathPrecision::Fast>(pools.points[i].mSimd, sines, cosines);
+    doNotOptimize(sines);
+    doNotOptimize(cosines);
+  });
+  runBenchmark("std::atan2 x3", [&](size_t i) {
+    for (int c = 0; c < 3; ++c)
+      doNotOptimize(std::atan2(pools.points[i][c], pools.points[(i + 1) % PoolSize][c]));
+  });
+  runBenchmark("atan2(simd<float>)", [&](size_t i) {
+    doNotOptimize(atan2(pools.points[i].mSimd, pools.points[(i + 1) % PoolSize].mSimd));
+  });
+  runBenchmark("CTransformFromEditorEuler", [&](size_t i) {
+    doNotOptimize(zeus::CTransformFromEditorEuler(pools.points[i]));
+  });
+  runBenchmark("CVector3f::normalized", [&](size_t i) { doNotOptimize(pools.points[i].normalized()); });
+  runBenchmark("CVector3f::fastNormalized", [&](size_t i) { doNotOptimize(pools.points[i].fastNormalized()); });
+  runBenchmark("CQuaternion::normalized", [&](size_t i) { doNotOptimize(pools.quats[i].normalized()); });
+  runBenchmark("CQuaternion::fastNormalized", [&](size_t i) { doNotOptimize(pools.quats[i].fastNormalized()); });
+  runBenchmark("CQuaternion::operator*(CQuaternion)", [&](size_t i) {
+    doNotOptimize(pools.quats[i] * pools.quats[(i + 1) % PoolSize]);
+  });
+  runBenchmark("CQuaternion::transform", [&](size_t i) {
+    doNotOptimize(pools.quats[i].transform(pools.points[(i + 1) % PoolSize]));
+  });
+}
+
+void benchCollision(const Pools& pools) {
+  zeus::CFrustum frustum;
+  frustum.updatePlanes(zeus::lookAt({0.f, -60.f, 0.f}, {0.f, 0.f, 0.f}),
+                       zeus::CProjection(zeus::SProjPersp(zeus::degToRad(60.f), 1.f, 1.f, 100.f)));
+  runBenchmark("CFrustum::aabbFrustumTest", [&](size_t i) { doNotOptimize(frustum.aabbFrustumTest(pools.boxes[i])); });
+
+  std::array<std::vector<float>, 6> soa;
+  for (const zeus::CAABox& box : pools.boxes) {
+    for (int c = 0; c < 3; ++c) {
+      soa[c].push_back(box.min[c]);
+      soa[c + 3].push_back(box.max[c]);
+    }
+  }
+  const zeus::CAABoxSoA soaBoxes{soa[0], soa[1], soa[2], soa[3], soa[4], soa[5]};
+  std::vector<uint32_t> visibleBits(PoolSize / 32);
+  runBenchmark("CFrustum::aabbFrustumTest(SoA) per 1024 boxes", [&](size_t) {
+    frustum.aabbFrustumTest(soaBoxes, visibleBits);
+    doNotOptimize(visibleBits[0]);
+  });
+
+  runBenchmark("COBBox::OBBIntersectsBox", [&](size_t i) {
+    doNotOptimize(pools.obbs[i].OBBIntersectsBox(pools.obbs[(i + 1) % PoolSize]));
+  });
+  runBenchmark("COBBox::AABoxIntersectsBox", [&](size_t i) {
+    doNotOptimize(pools.obbs[i].AABoxIntersectsBox(pools.boxes[(i + 1) % PoolSize]));
+  });
+  std::array<std::vector<float>, 15> obbSoa;
+  for (const zeus::COBBox& obb : pools.obbs) {
+    for (int r = 0; r < 3; ++r) {
+      obbSoa[r].push_back(obb.transform.origin[r]);
+      obbSoa[12 + r].push_back(obb.extents[r]);
+      for (int c = 0; c < 3; ++c)
+        obbSoa[3 + c * 3 + r].push_back(obb.transform.basis[c][r]);
+    }
+  }
+  const zeus::COBBoxSoA soaObbs{obbSoa[0],
+                                obbSoa[1],
+                                obbSoa[2],
+                                {obbSoa[3], obbSoa[4], obbSoa[5], obbSoa[6], obbSoa[7], obbSoa[8], obbSoa[9],
+                                 obbSoa[10], obbSoa[11]},
+                                obbSoa[12],
+                                obbSoa[13],
+                                obbSoa[14]};
+  std::vector<uint32_t> hitBits(PoolSize / 32);
+  runBenchmark("COBBox::OBBIntersectsBox x 1024", [&](size_t i) {
+    for (size_t j = 0; j < PoolSize; ++j)
+      doNotOptimize(pools.obbs[i].OBBIntersectsBox(pools.obbs[j]));
+  });
+  runBenchmark("COBBox::OBBIntersectsBoxes(SoA) per 1024 boxes", [&](size_t i) {
+    pools.obbs[i].OBBIntersectsBoxes(soaObbs, hitBits);
+    doNotOptimize(hitBits[0]);
+  });
+  runBenchmark("COBBox::OBBIntersectsBoxes per 1024 boxes", [&](size_t i) {
+    pools.obbs[i].OBBIntersectsBoxes(pools.obbs, hitBits);
+    doNotOptimize(hitBits[0]);
+  });
+
+  runBenchmark("gjkIntersects(COBBox)", [&](size_t i) {
+    doNotOptimize(zeus::gjkIntersects(pools.obbs[i], pools.obbs[(i + 1) % PoolSize]));
+  });
+  runBenchmark("gjkDistance(COBBox)", [&](size_t i) {
+    doNotOptimize(zeus::gjkDistance(pools.obbs[i], pools.obbs[(i + 1) % PoolSize]).distance);
+  });
+  /* Each pair keeps its cache across passes over the pool, as a pair tracked frame to frame would */
+  std::vector<zeus::SGJKCache> gjkCaches(PoolSize);
+  runBenchmark("gjkDistance(COBBox) warm", [&](size_t i) {
+    doNotOptimize(zeus::gjkDistance(pools.obbs[i], pools.obbs[(i + 1) % PoolSize], &gjkCaches[i]).distance);
+  });
+  runBenchmark("epaPenetration(COBBox)", [&](size_t i) {
+    zeus::COBBox overlapping = pools.obbs[(i + 1) % PoolSize];
+    overlapping.transform.origin = pools.obbs[i].transform.origin + pools.obbs[i].extents * 0.5f;
+    doNotOptimize(zeus::epaPenetration(pools.obbs[i], overlapping).depth);
+  });
+  std::vector<zeus::CVector3f> cloud(64);
+  for (size_t i = 0; i < cloud.size(); ++i)
+    cloud[i] = pools.points[i] * 0.05f;
+  const zeus::CConvexHull hull(cloud);
+  runBenchmark("CConvexHull::support of 64 points", [&](size_t i) { doNotOptimize(hull.support(pools.points[i])); });
+  runBenchmark("sweepSphereAABox", [&](size_t i) {
+    const zeus::CSphere sphere(pools.points[i], 1.f);
+    doNotOptimize(zeus::sweepSphereAABox(sphere, pools.points[(i + 1) % PoolSize], pools.boxes[i]).time);
+  });
+  runBenchmark("sweepSphereAABoxes(SoA) per 1024 boxes", [&](size_t i) {
+    uint32_t index = 0;
+    const zeus::CSphere sphere(pools.points[i], 1.f);
+    doNotOptimize(zeus::sweepSphereAABoxes(sphere, pools.points[(i + 1) % PoolSize], soaBoxes, index).time);
+  });
+  runBenchmark("sweepAABoxAABoxes(SoA) per 1024 boxes", [&](size_t i) {
+    uint32_t index = 0;
+    doNotOptimize(zeus::sweepAABoxAABoxes(pools.boxes[i], pools.points[(i + 1) % PoolSize], soaBoxes, index).time);
+  });
+  std::vector<zeus::CVector3f> soupVerts;
+  std::vector<uint32_t> soupIndices;
+  for (const zeus::CAABox& box : pools.boxes) {
+    soupVerts.insert(soupVerts.end(), {box.min, box.max, {box.min.x(), box.max.y(), box.min.z()}});
+    for (uint32_t c = 0; c < 3; ++c)
+      soupIndices.push_back(uint32_t(soupVerts.size() - 3 + c));
+  }
+  const zeus::CTriangleSoup soup(soupVerts, soupIndices);
+  const auto soupRay = [&](size_t i) {
+    const zeus::CVector3f delta = pools.points[(i + 1) % PoolSize] - pools.points[i];
+    return zeus::CMRay(pools.points[i], delta.normalized(), delta.magnitude());
+  };
+  runBenchmark("rayTriangleIntersect x 1024", [&](size_t i) {
+    const zeus::CMRay ray = soupRay(i);
+    float dist;
+    zeus::CVector3f bary;
+    for (size_t j = 0; j < PoolSize; ++j) {
+      const auto [p0, p1, p2] = soup.triangle(j);
+      doNotOptimize(zeus::rayTriangleIntersect(ray, p0, p1, p2, dist, bary));
+    }
+  });
+  runBenchmark("CTriangleSoup::rayCastClosest per 1024 triangles", [&](size_t i) {
+    zeus::STriangleHit hit;
+    doNotOptimize(soup.rayCastClosest(soupRay(i), hit));
+  });
+  runBenchmark("CTriangleSoup::intersect per 1024 triangles", [&](size_t i) {
+    soup.intersect(pools.boxes[i], hitBits);
+    doNotOptimize(hitBits[0]);
+  });
+  runBenchmark("CTriangleSoup::closestPoint per 1024 triangles", [&](size_t i) {
+    zeus::STriangleHit hit;
+    doNotOptimize(soup.closestPoint(pools.points[i], hit));
+  });
+  runBenchmark("timeOfImpact(COBBox)", [&](size_t i) {
+    const zeus::COBBox& target = pools.obbs[(i + 1) % PoolSize];
+    zeus::CTransform end = pools.obbs[i].transform;
+    end.origin = target.transform.origin * 2.f - end.origin;
+    doNotOptimize(zeus::timeOfImpact(pools.obbs[i], end, target, target.transform).time);
+  });
+  runBenchmark("CAABox::getTransformedAABox", [&](size_t i) {
+    doNotOptimize(pools.boxes[i].getTransformedAABox(pools.transforms[(i + 1) % PoolSize]));
+  });
+
+  std::vector<std::pair<uint32_t, uint32_t>> pairs;
+  runBenchmark("CAABox::intersects all pairs of 1024 boxes", [&](size_t) {
+    pairs.clear();
+    for (uint32_t a = 0; a < PoolSize; ++a)
+      for (uint32_t b = a + 1; b < PoolSize; ++b)
+        if (pools.boxes[a].intersects(pools.boxes[b]))
+          pairs.emplace_back(a, b);
+    doNotOptimize(pairs.size());
+  });
+  zeus::CSpatialHashGrid grid(8.f);
+  for (uint32_t i = 0; i < PoolSize; ++i)
+    grid.insert(i, pools.boxes[i]);
+  runBenchmark("CSpatialHashGrid::findPairs per 1024 boxes", [&](size_t) {
+    pairs.clear();
+    grid.findPairs(pairs);
+    doNotOptimize(pairs.size());
+  });
+  /* Alternate passes over the pool move each box forward and back */
+  size_t moves = 0;
+  runBenchmark("CSpatialHashGrid::move", [&](size_t i) {
+    const float offset = (moves++ / PoolSize) % 2 != 0 ? -0.5f : 0.5f;
+    grid.move(uint32_t(i), grid.bounds(uint32_t(i)).getTransformedAABox(zeus::CTransform::Translate(offset, 0.f, 0.f)));
+  });
+  runBenchmark("CSweepAndPrune::FindPairs per 1024 boxes", [&](size_t) {
+    pairs.clear();
+    zeus::CSweepAndPrune::FindPairs(pools.boxes, pairs);
+    doNotOptimize(pairs.size());
+  });
+  zeus::CSweepAndPrune sap;
+  for (uint32_t i = 0; i < PoolSize; ++i)
+    sap.insert(i, pools.boxes[i]);
+  std::vector<std::pair<uint32_t, uint32_t>> added, removed;
+  sap.collectEvents(added, removed);
+  moves = 0;
+  runBenchmark("CSweepAndPrune::move", [&](size_t i) {
+    const float offset = (moves++ / PoolSize) % 2 != 0 ? -0.5f : 0.5f;
+    sap.move(uint32_t(i), sap.bounds(uint32_t(i)).getTransformedAABox(zeus::CTransform::Translate(offset, 0.f, 0.f)));
+    if (i == PoolSize - 1) {
+      added.clear();
+      removed.clear();
+      sap.collectEvents(added, removed);
+    }
+  });
+  zeus::CDynamicAABBTree dynTree;
+  std::vector<uint32_t> dynHandles;
+  for (uint32_t i = 0; i < PoolSize; ++i)
+    dynHandles.push_back(dynTree.insert(pools.boxes[i], i));
+  moves = 0;
+  runBenchmark("CDynamicAABBTree::move", [&](size_t i) {
+    const float offset = (moves++ / PoolSize) % 2 != 0 ? -0.5f : 0.5f;
+    const uint32_t handle = dynHandles[i];
+    dynTree.move(handle, dynTree.bounds(handle).getTransformedAABox(zeus::CTransform::Translate(offset, 0.f, 0.f)),
+                 zeus::CVector3f(offset, 0.f, 0.f));
+  });
+  std::vector<uint32_t> dynHits;
+  runBenchmark("CDynamicAABBTree::queryAABB", [&](size_t i) {
+    dynHits.clear();
+    dynTree.queryAABB(pools.boxes[i], dynHits);
+    doNotOptimize(dynHits.size());
+  });
+  zeus::CAABox world;
+  for (const zeus::CAABox& box : pools.boxes)
+    world.accumulateBounds(box);
+  zeus::CLooseOctree octree(world);
+  for (uint32_t i = 0; i < PoolSize; ++i)
+    octree.insert(i, pools.boxes[i]);
+  moves = 0;
+  runBenchmark("CLooseOctree::move", [&](size_t i) {
+    const float offset = (moves++ / PoolSize) % 2 != 0 ? -0.5f : 0.5f;
+    const zeus::CTransform step = zeus::CTransform::Translate(offset, 0.f, 0.f);
+    octree.move(uint32_t(i), octree.bounds(uint32_t(i)).getTransformedAABox(step));
+  });
+  runBenchmark("CLooseOctree::queryAABB", [&](size_t i) {
+    dynHits.clear();
+    octree.queryAABB(pools.boxes[i], dynHits);
+    doNotOptimize(dynHits.size());
+  });
+
+  const zeus::CRaySlab slab(zeus::CMRay({-60.f, 1.f, 2.f}, zeus::CVector3f(1.f, 0.1f, 0.05f).normalized(), 120.f));
+  float tEnter = 0.f;
+  float tExit = 0.f;
+  runBenchmark("CRaySlab::intersect(CAABox)", [&](size_t i) {
+    doNotOptimize(slab.intersect(pools.boxes[i], tEnter, tExit));
+  });
+}
+
+void benchBatch(const Pools& pools) {
+  std::vector<float> points;
+  for (const zeus::CVector3f& point : pools.points)
+    for (int c = 0; c < 3; ++c)
+      points.push_back(point[c]);
+  std::vector<float> out(points.size());
+  runBenchmark("transformPoints(CTransform) per 1024 points", [&](size_t i) {
+    zeus::transformPoints(pools.transforms[i], points, out);
+    doNotOptimize(out[0]);
+  });
+  runBenchmark("CAABox::accumulateBounds x1024", [&](size_t) {
+    zeus::CAABox bounds;
+    for (const zeus::CVector3f& point : pools.points)
+      bounds.accumulateBounds(point);
+    doNotOptimize(bounds);
+  });
+  runBenchmark("CAABox::FromPoints per 1024 points", [&](size_t) {
+    doNotOptimize(zeus::CAABox::FromPoints(pools.points));
+  });
+  runBenchmark("CAABox::FromPoints(packed) per 1024 points", [&](size_t) {
+    doNotOptimize(zeus::CAABox::FromPoints(points));
+  });
+  runBenchmark("CAABox::FromPoints(CTransform, packed) per 1024 points", [&](size_t i) {
+    doNotOptimize(zeus::CAABox::FromPoints(pools.transforms[i], points));
+  });
+  std::vector<zeus::CVector3f> rotated(pools.points.size());
+  runBenchmark("rotateVectors(CQuaternion) per 1024 vectors", [&](size_t i) {
+    zeus::rotateVectors(pools.quats[i], pools.points, rotated);
+    doNotOptimize(rotated[0]);
+  });
+  runBenchmark("CVector3f::normalized x1024", [&](size_t) {
+    for (size_t p = 0; p < PoolSize; ++p)
+      rotated[p] = pools.points[p].normalized();
+    doNotOptimize(rotated[0]);
+  });
+  runBenchmark("normalizeVectors per 1024 vectors", [&](size_t) {
+    zeus::normalizeVectors(points, out);
+    doNotOptimize(out[0]);
+  });
+  std::array<std::vector<float>, 4> quats;
+  for (const zeus::CQuaternion& quat : pools.quats)
+    for (int c = 0; c < 4; ++c)
+      quats[c].push_back(quat.mSimd[c]);
+  std::array<std::vector<float>, 4> blended{quats};
+  /* Blends each quaternion toward the next one in the pool */
+  const auto quatView = [&](size_t first) {
+    return zeus::CQuaternionSoA{std::span(quats[0]).subspan(first, PoolSize - 1),
+                                std::span(quats[1]).subspan(first, PoolSize - 1),
+                                std::span(quats[2]).subspan(first, PoolSize - 1),
+                                std::span(quats[3]).subspan(first, PoolSize - 1)};
+  };
+  const zeus::CQuaternionSoA quatsA = quatView(0);
+  const zeus::CQuaternionSoA quatsB = quatView(1);
+  const zeus::CQuaternionSoAOut blendedView{blended[0], blended[1], blended[2], blended[3]};
+  runBenchmark("slerpQuaternions per 1023 quaternions", [&](size_t i) {
+    zeus::slerpQuaternions(quatsA, quatsB, float(i) / PoolSize, blendedView);
+    doNotOptimize(blended[0][0]);
+  });
+  runBenchmark("nlerpQuaternions per 1023 quaternions", [&](size_t i) {
+    zeus::nlerpQuaternions(quatsA, quatsB, float(i) / PoolSize, blendedView);
+    doNotOptimize(blended[0][0]);
+  });
+  runBenchmark("normalizeQuaternions per 1024 quaternions", [&](size_t) {
+    zeus::normalizeQuaternions({quats[0], quats[1], quats[2], quats[3]}, blendedView);
+    doNotOptimize(blended[0][0]);
+  });
+  runBenchmark("CQuaternion::slerpShort x1023", [&](size_t i) {
+    for (size_t q = 0; q + 1 < PoolSize; ++q)
+      doNotOptimize(zeus::CQuaternion::slerpShort(pools.quats[q], pools.quats[q + 1], double(i) / PoolSize));
+  });
+  runBenchmark("CTransform::operator*(CVector3f) x1024", [&](size_t i) {
+    for (const zeus::CVector3f& point : pools.points)
+      doNotOptimize(pools.transforms[i] * point);
+  });
+
+  const zeus::CAABox pointBounds = zeus::CAABox::FromPoints(pools.points);
+  std::vector<uint64_t> keys(PoolSize);
+  runBenchmark("mortonKeys63 per 1024 points", [&](size_t) {
+    zeus::mortonKeys63(pools.points, pointBounds, keys);
+    doNotOptimize(keys[0]);
+  });
+  runBenchmark("mortonKey63 x1024", [&](size_t) {
+    for (size_t i = 0; i < PoolSize; ++i)
+      keys[i] = zeus::mortonKey63(pools.points[i], pointBounds);
+    doNotOptimize(keys[0]);
+  });
+  runBenchmark("hilbertKeys63 per 1024 points", [&](size_t) {
+    zeus::hilbertKeys63(pools.points, pointBounds, keys);
+    doNotOptimize(keys[0]);
+  });
+  /* Sorting pays off on larger inputs, so sort 64 jittered copies of the pool */
+  std::vector<zeus::CVector3f> manyPoints;
+  for (size_t copy = 0; copy < 64; ++copy)
+    for (const zeus::CVector3f& point : pools.points)
+      manyPoints.push_back(point + zeus::CVector3f(float(copy) * 0.01f));
+  std::vector<uint64_t> manyKeys(manyPoints.size());
+  zeus::mortonKeys63(manyPoints, zeus::CAABox::FromPoints(manyPoints), manyKeys);
+  std::vector<uint64_t> sortKeys(manyKeys.size());
+  std::vector<uint32_t> order(manyKeys.size());
+  runBenchmark("radixSortByKey per 65536 63-bit keys", [&](size_t) {
+    sortKeys = manyKeys;
+    for (uint32_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+    zeus::radixSortByKey(std::span(sortKeys), std::span(order));
+    doNotOptimize(order[0]);
+  });
+  runBenchmark("std::sort by 63-bit key per 65536 keys", [&](size_t) {
+    for (uint32_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return manyKeys[a] < manyKeys[b]; });
+    doNotOptimize(order[0]);
+  });
+}
+
+std::vector<zeus::CAABox> makeBoxes(size_t count, std::mt19937& rng) {
+  std::uniform_real_distribution<float> pos(-500.f, 500.f);
+  std::uniform_real_distribution<float> size(0.5f, 4.f);
+  std::vector<zeus::CAABox> boxes;
+  boxes.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    const zeus::CVector3f center(pos(rng), pos(rng), pos(rng));
+    const zeus::CVector3f extents(size(rng), size(rng), size(rng));
+    boxes.emplace_back(center - extents, center + extents);
+  }
+  return boxes;
+}
+
+void benchBVH(size_t count) {
+  std::mt19937 rng(1234);
+  const std::vector<zeus::CAABox> boxes = makeBoxes(count, rng);
+  const std::vector<zeus::CAABox> queries = makeBoxes(PoolSize, rng);
+
+  char name[64];
+  zeus::CBVH bvh;
+  std::snprintf(name, sizeof(name), "CBVH::build %zu boxes", count);
+  runBenchmark(name, [&](size_t) { bvh.build(boxes); });
+  std::snprintf(name, sizeof(name), "CBVH::buildLBVH %zu boxes", count);
+  runBenchmark(name, [&](size_t) { bvh.buildLBVH(boxes); });
+
+  bvh.build(boxes);
+  std::vector<uint32_t> hits;
+  std::snprintf(name, sizeof(name), "CBVH::queryAABB %zu boxes", count);
+  runBenchmark(name, [&](size_t i) {
+    hits.clear();
+    bvh.queryAABB(zeus::CAABox(queries[i].min - 20.f, queries[i].max + 20.f), hits);
+    doNotOptimize(hits.size());
+  });
+  std::snprintf(name, sizeof(name), "brute force queryAABB %zu boxes", count);
+  runBenchmark(name, [&](size_t i) {
+    const zeus::CAABox grown(queries[i].min - 20.f, queries[i].max + 20.f);
+    size_t bruteHits = 0;
+    for (const zeus::CAABox& box : boxes)
+      bruteHits += box.intersects(grown);
+    doNotOptimize(bruteHits);
+  });
+}
+
+void benchKdTree(size_t count) {
+  std::mt19937 rng(1234);
+  std::vector<zeus::CVector3f> points;
+  for (const zeus::CAABox& box : makeBoxes(count, rng))
+    points.push_back(box.center());
+  std::vector<zeus::CVector3f> queries;
+  for (const zeus::CAABox& box : makeBoxes(PoolSize, rng))
+    queries.push_back(box.center());
+
+  char name[64];
+  zeus::CKdTree tree;
+  std::snprintf(name, sizeof(name), "CKdTree::build %zu points", count);
+  runBenchmark(name, [&](size_t) { tree.build(points); });
+
+  tree.build(points);
+  std::array<zeus::SNeighbor, 5> neighbors;
+  std::snprintf(name, sizeof(name), "CKdTree::queryNearest k=5 %zu points", count);
+  runBenchmark(name, [&](size_t i) { doNotOptimize(tree.queryNearest(queries[i], neighbors)); });
+  std::snprintf(name, sizeof(name), "CKdTree::queryNearest k=5 eps=0.5 %zu points", count);
+  runBenchmark(name, [&](size_t i) { doNotOptimize(tree.queryNearest(queries[i], neighbors, FLT_MAX, 0.5f)); });
+  std::snprintf(name, sizeof(name), "brute force nearest k=5 %zu points", count);
+  runBenchmark(name, [&](size_t i) {
+    std::array<float, 5> best;
+    best.fill(FLT_MAX);
+    for (const zeus::CVector3f& point : points) {
+      const float d = (point - queries[i]).magSquared();
+      if (d < best.back()) {
+        best.back() = d;
+        std::sort(best.begin(), best.end());
+      }
+    }
+    doNotOptimize(best[0]);
+  });
+  std::vector<uint32_t> hits;
+  std::snprintf(name, sizeof(name), "CKdTree::queryRadius %zu points", count);
+  runBenchmark(name, [&](size_t i) {
+    hits.clear();
+    tree.queryRadius(queries[i], 40.f, hits);
+    doNotOptimize(hits.size());
+  });
+}
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+  if (!zeus::validateCPU().first) {
+    std::printf("zeusbench was built for instructions this CPU lacks; skipping %s backend\n", backendName());
+    return 0;
+  }
+  if (argc > 1)
+    g_filter = argv[1];
+
+  std::printf("zeusbench, %s backend, %s batch kernels\n", backendName(), kernelISAName(zeus::kernelISA()));
+  std::mt19937 rng(1234);
+  const Pools pools(rng);
+  benchMath(pools);
+  benchCollision(pools);
+  benchBatch(pools);
+  for (size_t count : {1000, 10000, 100000})
+    benchBVH(count);
+  for (size_t count : {1000, 100000})
+    benchKdTree(count);
+  return 0;
+}
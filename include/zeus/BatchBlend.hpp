@@ -0,0 +1,54 @@
+#pragma once
+
+#include <span>
+
+#include "zeus/CQuaternion.hpp"
+
+namespace zeus {
+/* Read-only view of quaternions stored as four parallel component arrays of equal size */
+struct CQuaternionSoA {
+  std::span<const float> w, x, y, z;
+
+  [[nodiscard]] size_t size() const { return w.size(); }
+};
+
+/* Writable counterpart of CQuaternionSoA */
+struct CQuaternionSoAOut {
+  std::span<float> w, x, y, z;
+
+  [[nodiscard]] size_t size() const { return w.size(); }
+};
+
+/**
+ * Batch blending of unit quaternions, such as mixing two animation poses of many skeletons at once.
+ *
+ * Each function blends a[i] toward b[i] by t[i], or by one t for the whole range, along the shorter arc as
+ * CQuaternion::slerpShort does. t is clamped to [0, 1]. Inputs are assumed to be unit length.
+ * out must be at least as large as a, and may be the same memory as a or b, but must not otherwise overlap them.
+ * Ranges are split across threadCount workers once they are large enough to pay for it; 0 uses every
+ * hardware thread.
+ */
+
+/* Slerp with polynomial acos and sin instead of the libm calls; within about 1e-5 of CQuaternion::slerpShort */
+void slerpQuaternions(const CQuaternionSoA& a, const CQuaternionSoA& b, std::span<const float> t,
+                      const CQuaternionSoAOut& out, unsigned threadCount = 1);
+void slerpQuaternions(const CQuaternionSoA& a, const CQuaternionSoA& b, float t, const CQuaternionSoAOut& out,
+                      unsigned threadCount = 1);
+
+/**
+ * Normalized lerp with t first remapped by a cubic whose coefficients are fitted to the angle between a and b
+ * (Kapoulkine's approximation). Results stay within 0.001 radians of rotation of slerp, where plain nlerp drifts
+ * by up to 0.14 radians, and cost no transcendental functions.
+ */
+void nlerpQuaternions(const CQuaternionSoA& a, const CQuaternionSoA& b, std::span<const float> t,
+                      const CQuaternionSoAOut& out, unsigned threadCount = 1);
+void nlerpQuaternions(const CQuaternionSoA& a, const CQuaternionSoA& b, float t, const CQuaternionSoAOut& out,
+                      unsigned threadCount = 1);
+
+/**
+ * Scales quaternions back to unit length as CQuaternion::fastNormalized does, e.g. after summing weighted poses or
+ * integrating angular velocity. out follows the same rules as above; magnitudes end up within 5e-7 of 1.
+ */
+void normalizeQuaternions(std::span<const CQuaternion> in, std::span<CQuaternion> out, unsigned threadCount = 1);
+void normalizeQuaternions(const CQuaternionSoA& in, const CQuaternionSoAOut& out, unsigned threadCount = 1);
+} // namespace zeus
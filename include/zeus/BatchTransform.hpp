@@ -0,0 +1,79 @@
+#pragma once
+
+#include <span>
+
+#include "zeus/CMatrix4f.hpp"
+#include "zeus/CQuaternion.hpp"
+#include "zeus/CTransform.hpp"
+
+namespace zeus {
+/* Read-only view of points or vectors stored as three parallel coordinate arrays of equal size */
+struct CVector3fSoA {
+  std::span<const float> x, y, z;
+
+  [[nodiscard]] size_t size() const { return x.size(); }
+};
+
+/* Writable counterpart of CVector3fSoA */
+struct CVector3fSoAOut {
+  std::span<float> x, y, z;
+
+  [[nodiscard]] size_t size() const { return x.size(); }
+};
+
+/**
+ * Batch versions of CTransform::operator*, CTransform::rotate, CQuaternion::transform,
+ * CMatrix4f::multiplyOneOverW and CVector3f::fastNormalized.
+ *
+ * AoS overloads read and write tightly packed xyz triples, so in.size() must be a multiple of 3;
+ * SoA overloads take parallel coordinate arrays. out must be at least as large as in, and may be the same
+ * memory as in, but must not otherwise overlap it.
+ * Ranges are split across threadCount workers once they are large enough to pay for it; 0 uses every
+ * hardware thread.
+ */
+void transformPoints(const CTransform& xf, std::span<const float> in, std::span<float> out, unsigned threadCount = 1);
+void transformPoints(const CTransform& xf, const CVector3fSoA& in, const CVector3fSoAOut& out,
+                     unsigned threadCount = 1);
+
+/* Transforms by the upper 3x4 of mtx and ignores the resulting w; use projectPoints for projective matrices */
+void transformPoints(const CMatrix4f& mtx, std::span<const float> in, std::span<float> out, unsigned threadCount = 1);
+void transformPoints(const CMatrix4f& mtx, const CVector3fSoA& in, const CVector3fSoAOut& out,
+                     unsigned threadCount = 1);
+
+/**
+ * Transforms normals by the inverse transpose of the rotation/scale part, so they stay perpendicular to
+ * transformed surfaces under non-uniform scale. Results are not renormalized.
+ */
+void transformNormals(const CTransform& xf, std::span<const float> in, std::span<float> out,
+                      unsigned threadCount = 1);
+void transformNormals(const CTransform& xf, const CVector3fSoA& in, const CVector3fSoAOut& out,
+                      unsigned threadCount = 1);
+void transformNormals(const CMatrix4f& mtx, std::span<const float> in, std::span<float> out,
+                      unsigned threadCount = 1);
+void transformNormals(const CMatrix4f& mtx, const CVector3fSoA& in, const CVector3fSoAOut& out,
+                      unsigned threadCount = 1);
+
+/* Transforms by mtx and divides by the resulting w, as CMatrix4f::multiplyOneOverW does */
+void projectPoints(const CMatrix4f& mtx, std::span<const float> in, std::span<float> out, unsigned threadCount = 1);
+void projectPoints(const CMatrix4f& mtx, const CVector3fSoA& in, const CVector3fSoAOut& out,
+                   unsigned threadCount = 1);
+
+/**
+ * Rotates vectors by a unit quaternion, as CQuaternion::transform does. The rotation is converted to a 3x3 matrix
+ * once, so each vector costs three broadcasts and multiply-adds instead of the quaternion sandwich.
+ */
+void rotateVectors(const CQuaternion& rotation, std::span<const CVector3f> in, std::span<CVector3f> out,
+                   unsigned threadCount = 1);
+void rotateVectors(const CQuaternion& rotation, std::span<const float> in, std::span<float> out,
+                   unsigned threadCount = 1);
+void rotateVectors(const CQuaternion& rotation, const CVector3fSoA& in, const CVector3fSoAOut& out,
+                   unsigned threadCount = 1);
+
+/**
+ * Scales vectors to unit length as CVector3f::fastNormalized does, with an rsqrt estimate and one Newton-Raphson
+ * step instead of a square root and divide per vector. Lengths end up within 5e-7 of 1; zero vectors give NaN.
+ */
+void normalizeVectors(std::span<const CVector3f> in, std::span<CVector3f> out, unsigned threadCount = 1);
+void normalizeVectors(std::span<const float> in, std::span<float> out, unsigned threadCount = 1);
+void normalizeVectors(const CVector3fSoA& in, const CVector3fSoAOut& out, unsigned threadCount = 1);
+} // namespace zeus
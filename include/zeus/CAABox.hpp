@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cassert>
+#include <span>
 
 #include "zeus/CLineSeg.hpp"
 #include "zeus/CPlane.hpp"
@@ -36,6 +37,20 @@ public:
   constexpr CAABox(float minX, float minY, float minZ, float maxX, float maxY, float maxZ)
   : min(minX, minY, minZ), max(maxX, maxY, maxZ) {}
 
+  /**
+   * Bounds of a point cloud, the same box as accumulating every point into CAABox() (NaN coordinates included) but
+   * reduced over whole registers. The packed overloads take tightly packed xyz triples, so
+   * points.size() must be a multiple of 3; the CTransform overloads bound xf * point without storing the
+   * transformed points. Ranges are split across threadCount workers once they are large enough to pay for it;
+   * 0 uses every hardware thread.
+   */
+  [[nodiscard]] static CAABox FromPoints(std::span<const CVector3f> points, unsigned threadCount = 1);
+  [[nodiscard]] static CAABox FromPoints(std::span<const float> points, unsigned threadCount = 1);
+  [[nodiscard]] static CAABox FromPoints(const CTransform& xf, std::span<const CVector3f> points,
+                                         unsigned threadCount = 1);
+  [[nodiscard]] static CAABox FromPoints(const CTransform& xf, std::span<const float> points,
+                                         unsigned threadCount = 1);
+
   [[nodiscard]] bool intersects(const CAABox& other) const {
     const auto mmax = max >= other.min;
     const auto mmin = min <= other.max;
@@ -117,40 +132,31 @@ public:
   };
   [[nodiscard]] Tri getTri(EBoxFaceId face, int windOffset) const;
 
+  /**
+   * Arvo's method: each basis column adds its product with min or with max, whichever is lower, to the new min and
+   * the other to the new max, picked by the sign of each coefficient. The terms are summed in the same order as
+   * CTransform * CVector3f, so rounding never leaves a transformed corner outside the result and the identity
+   * returns the box unchanged. Inverted boxes stay inverted.
+   */
   [[nodiscard]] CAABox getTransformedAABox(const CTransform& xfrm) const {
-    CAABox box;
-    CVector3f point = xfrm * getPoint(0);
-    box.accumulateBounds(point);
-    point = xfrm * getPoint(1);
-    box.accumulateBounds(point);
-    point = xfrm * getPoint(2);
-    box.accumulateBounds(point);
-    point = xfrm * getPoint(3);
-    box.accumulateBounds(point);
-    point = xfrm * getPoint(4);
-    box.accumulateBounds(point);
-    point = xfrm * getPoint(5);
-    box.accumulateBounds(point);
-    point = xfrm * getPoint(6);
-    box.accumulateBounds(point);
-    point = xfrm * getPoint(7);
-    box.accumulateBounds(point);
-    return box;
+    const auto lowTerm = [&](const simd<float>& column, const simd<float>& lo, const simd<float>& hi) {
+      return _simd::select(column >= simd<float>(0.f), column * lo, column * hi);
+    };
+    const simd<float>& b0 = xfrm.basis[0].mSimd;
+    const simd<float>& b1 = xfrm.basis[1].mSimd;
+    const simd<float>& b2 = xfrm.basis[2].mSimd;
+    const simd<float> min0 = min.mSimd.shuffle<0, 0, 0, 0>(), max0 = max.mSimd.shuffle<0, 0, 0, 0>();
+    const simd<float> min1 = min.mSimd.shuffle<1, 1, 1, 1>(), max1 = max.mSimd.shuffle<1, 1, 1, 1>();
+    const simd<float> min2 = min.mSimd.shuffle<2, 2, 2, 2>(), max2 = max.mSimd.shuffle<2, 2, 2, 2>();
+    const simd<float> newMin = lowTerm(b0, min0, max0) + lowTerm(b1, min1, max1) + lowTerm(b2, min2, max2);
+    const simd<float> newMax = lowTerm(b0, max0, min0) + lowTerm(b1, max1, min1) + lowTerm(b2, max2, min2);
+    return {xfrm.origin.mSimd + newMin, xfrm.origin.mSimd + newMax};
   }
 
+  /* Branchless; a NaN coordinate leaves that bound unchanged */
   void accumulateBounds(const CVector3f& point) {
-    if (min.x() > point.x())
-      min.x() = point.x();
-    if (min.y() > point.y())
-      min.y() = point.y();
-    if (min.z() > point.z())
-      min.z() = point.z();
-    if (max.x() < point.x())
-      max.x() = point.x();
-    if (max.y() < point.y())
-      max.y() = point.y();
-    if (max.z() < point.z())
-      max.z() = point.z();
+    min.mSimd = _simd::select(point.mSimd < min.mSimd, point.mSimd, min.mSimd);
+    max.mSimd = _simd::select(point.mSimd > max.mSimd, point.mSimd, max.mSimd);
   }
 
   void accumulateBounds(const CAABox& other) {
@@ -288,6 +294,17 @@ public:
 constexpr inline CAABox skInvertedBox;
 constexpr inline CAABox skNullBox(CVector3f{}, CVector3f{});
 
+/**
+ * Structure-of-arrays view over a set of boxes, one span per bound component.
+ * All spans must have the same length.
+ */
+struct CAABoxSoA {
+  std::span<const float> minX, minY, minZ;
+  std::span<const float> maxX, maxY, maxZ;
+
+  [[nodiscard]] size_t size() const { return minX.size(); }
+};
+
 [[nodiscard]] inline bool operator==(const CAABox& left, const CAABox& right) {
   return (left.min == right.min && left.max == right.max);
 }
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "zeus/CAABox.hpp"
+
+namespace zeus {
+class CFrustum;
+struct CMRay;
+class CSphere;
+
+/**
+ * Bounding volume hierarchy over a set of CAABoxes.
+ * Built with binned SAH, or as an LBVH for scenes rebuilt every frame; nodes are stored flat with four children
+ * each, child bounds kept in SoA form so a node is tested against a query in one simd<float> pass.
+ * Every leaf holds exactly one primitive, referenced by its index in the input span.
+ */
+class CBVH {
+public:
+  static constexpr uint32_t LeafFlag = 0x80000000;
+  static constexpr uint32_t EmptyChild = 0xFFFFFFFF;
+
+  struct alignas(16) Node {
+    std::array<float, 4> minX, minY, minZ;
+    std::array<float, 4> maxX, maxY, maxZ;
+    /* Node index, (LeafFlag | primitive index) or EmptyChild */
+    std::array<uint32_t, 4> children;
+
+    [[nodiscard]] CAABox getChildBounds(size_t i) const {
+      return {minX[i], minY[i], minZ[i], maxX[i], maxY[i], maxZ[i]};
+    }
+    void setChildBounds(size_t i, const CAABox& box);
+  };
+
+  CBVH() = default;
+  explicit CBVH(std::span<const CAABox> boxes, unsigned threadCount = 1) { build(boxes, threadCount); }
+
+  /**
+   * Rebuilds the hierarchy over boxes.
+   * Large subtrees and the top-level binning passes are spread over threadCount workers;
+   * 0 uses every hardware thread. Only node order, not tree shape, depends on threadCount.
+   */
+  void build(std::span<const CAABox> boxes, unsigned threadCount = 1);
+
+  /**
+   * Rebuilds the hierarchy as a linear BVH: primitives are radix sorted by the 30-bit Morton code of their box
+   * centre, the binary radix tree over the sorted codes (Karras) is built bottom-up together with its bounds, and
+   * then collapsed into the same nodes build() makes. Linear in the primitive count and several times faster than
+   * build(), at the price of looser bounds for queries. Every pass uses up to threadCount workers once the input is
+   * large enough; 0 uses every hardware thread. Only node order, not tree shape, depends on threadCount.
+   */
+  void buildLBVH(std::span<const CAABox> boxes, unsigned threadCount = 1);
+
+  /**
+   * Recomputes every node bound bottom-up from boxes while keeping the topology.
+   * boxes must hold the same primitives, in the same order, as the last build.
+   */
+  void refit(std::span<const CAABox> boxes);
+
+  void clear();
+
+  [[nodiscard]] bool empty() const { return m_nodes.empty(); }
+  [[nodiscard]] size_t primitiveCount() const { return m_primCount; }
+  [[nodiscard]] const std::vector<Node>& nodes() const { return m_nodes; }
+  [[nodiscard]] CAABox bounds() const;
+
+  /* Queries append the indices of all matching primitives to out, in no particular order */
+  void queryAABB(const CAABox& box, std::vector<uint32_t>& out) const;
+  void querySphere(const CSphere& sphere, std::vector<uint32_t>& out) const;
+  void queryFrustum(const CFrustum& frustum, std::vector<uint32_t>& out) const;
+  void queryRay(const CMRay& ray, std::vector<uint32_t>& out) const;
+
+  /**
+   * Finds the primitive whose box the ray segment enters first.
+   * On a hit, primOut receives its index and distOut the distance from ray.start to the entry point.
+   */
+  [[nodiscard]] bool rayCastClosest(const CMRay& ray, uint32_t& primOut, float& distOut) const;
+
+private:
+  std::vector<Node> m_nodes;
+  size_t m_primCount = 0;
+};
+} // namespace zeus
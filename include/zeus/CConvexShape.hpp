@@ -0,0 +1,69 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "zeus/CMatrix3f.hpp"
+#include "zeus/CTransform.hpp"
+#include "zeus/CVector3f.hpp"
+
+namespace zeus {
+class CAABox;
+class COBBox;
+class CSphere;
+class CLineSeg;
+
+/**
+ * Convex hull of a point cloud, given by its points; interior points are allowed and only cost support time.
+ * Points are kept as three coordinate arrays so support searches several points per instruction.
+ */
+class CConvexHull {
+public:
+  explicit CConvexHull(std::span<const CVector3f> points);
+
+  [[nodiscard]] size_t size() const { return m_size; }
+  [[nodiscard]] CVector3f point(size_t i) const { return {m_x[i], m_y[i], m_z[i]}; }
+  [[nodiscard]] const CVector3f& centroid() const { return m_centroid; }
+
+  /* The point farthest along dir; the hull must not be empty */
+  [[nodiscard]] CVector3f support(const CVector3f& dir) const;
+
+private:
+  /* Padded to whole registers by repeating the first point */
+  std::vector<float> m_x, m_y, m_z;
+  size_t m_size;
+  CVector3f m_centroid;
+};
+
+/**
+ * A convex shape as seen by the GJK and EPA queries: the shape is only ever asked for its support point, the
+ * point farthest along a direction. Spheres and segments with a radius (capsules) are rounded shapes, whose
+ * support adds the radius along the direction.
+ */
+class CConvexShape {
+public:
+  CConvexShape(const CSphere& sphere);
+  CConvexShape(const CAABox& box);
+  CConvexShape(const COBBox& box);
+  /* A capsule when radius is positive */
+  explicit CConvexShape(const CLineSeg& seg, float radius = 0.f);
+  /* hull is referenced, not copied, and must outlive the shape */
+  CConvexShape(const CConvexHull& hull, const CTransform& xf = CTransform());
+
+  [[nodiscard]] CVector3f support(const CVector3f& dir) const;
+  /* A point inside the shape, used to pick the first search direction */
+  [[nodiscard]] CVector3f center() const;
+
+private:
+  enum class EKind { Sphere, AABox, OBBox, Segment, Hull };
+
+  EKind m_kind;
+  /* Sphere center, box min or segment start; box max, OBB extents or segment end */
+  CVector3f m_a, m_b;
+  float m_radius = 0.f;
+  /* OBB and hull placement, with the transposed basis that maps directions into their frame */
+  CTransform m_xf;
+  CMatrix3f m_basisT;
+  const CConvexHull* m_hull = nullptr;
+};
+} // namespace zeus
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "zeus/CAABox.hpp"
+
+namespace zeus {
+class CFrustum;
+struct CMRay;
+
+/**
+ * Incrementally updated binary AABB tree for objects that move every frame.
+ * Each leaf stores the object's box and a fat copy grown by a margin and stretched along its last displacement;
+ * internal nodes bound the fat boxes. A move that stays inside the fat box only updates the leaf, and one that leaves
+ * it removes and reinserts that single leaf, so per-frame cost depends on the movers rather than on the tree size.
+ * Leaves are inserted next to the sibling that grows the total surface area least, and every node on the way back
+ * up is rebalanced with AVL-style rotations, keeping the height logarithmic whatever the insertion order.
+ * Nodes live in a pool with a free list; an object's handle is the index of its leaf and stays valid until it is
+ * removed.
+ */
+class CDynamicAABBTree {
+public:
+  static constexpr uint32_t NullNode = 0xFFFFFFFF;
+
+  /* Fat boxes are grown by margin on every side and stretched by displacementScale times each move's displacement */
+  explicit CDynamicAABBTree(float margin = 0.1f, float displacementScale = 2.f)
+  : m_margin(margin), m_displacementScale(displacementScale) {}
+
+  [[nodiscard]] uint32_t insert(const CAABox& box, uint32_t userData = 0);
+  void remove(uint32_t handle);
+
+  /**
+   * Sets the object's box; displacement is its expected motion, used to stretch a new fat box ahead of it.
+   * Returns true when the object left its fat box and was reinserted.
+   */
+  bool move(uint32_t handle, const CAABox& box, const CVector3f& displacement = {});
+  void clear();
+
+  [[nodiscard]] size_t size() const { return m_leafCount; }
+  [[nodiscard]] bool empty() const { return m_leafCount == 0; }
+  [[nodiscard]] bool contains(uint32_t handle) const {
+    return handle < m_nodes.size() && m_nodes[handle].height == 0;
+  }
+  [[nodiscard]] const CAABox& bounds(uint32_t handle) const { return m_nodes[handle].box; }
+  [[nodiscard]] const CAABox& fatBounds(uint32_t handle) const { return m_nodes[handle].fat; }
+  [[nodiscard]] uint32_t userData(uint32_t handle) const { return m_nodes[handle].userData; }
+  /* Height of the root, 0 for a single leaf */
+  [[nodiscard]] int height() const { return m_root == NullNode ? 0 : m_nodes[m_root].height; }
+  /* Total surface area of the internal nodes over that of the root, the SAH cost of walking the tree */
+  [[nodiscard]] float areaRatio() const;
+
+  /* Queries test the fat boxes on the way down and the objects' own boxes at the leaves, appending handles to out */
+  void queryAABB(const CAABox& box, std::vector<uint32_t>& out) const;
+  void queryFrustum(const CFrustum& frustum, std::vector<uint32_t>& out) const;
+  void queryRay(const CMRay& ray, std::vector<uint32_t>& out) const;
+
+  /* Finds the object whose box the ray segment enters first, as CBVH::rayCastClosest does */
+  [[nodiscard]] bool rayCastClosest(const CMRay& ray, uint32_t& handleOut, float& distOut) const;
+
+private:
+  struct Node {
+    CAABox fat;
+    /* The object's own box; leaves only */
+    CAABox box;
+    /* Parent, or the next free node while on the free list */
+    uint32_t parent = NullNode;
+    uint32_t child1 = NullNode;
+    uint32_t child2 = NullNode;
+    /* 0 for leaves, -1 for free nodes */
+    int height = -1;
+    uint32_t userData = 0;
+
+    [[nodiscard]] bool isLeaf() const { return child1 == NullNode; }
+  };
+
+  uint32_t allocateNode();
+  void freeNode(uint32_t index);
+  void insertLeaf(uint32_t leaf);
+  void removeLeaf(uint32_t leaf);
+  /* Rotates the subtree at index if its children's heights differ by more than one; returns the new subtree root */
+  uint32_t balance(uint32_t index);
+  /* Refits bounds and heights from index up to the root, rebalancing as it goes */
+  void refitUpward(uint32_t index);
+  [[nodiscard]] CAABox fatten(const CAABox& box, const CVector3f& displacement) const;
+
+  template <typename BoxTest>
+  void traverse(BoxTest&& boxTest, std::vector<uint32_t>& out) const;
+
+  std::vector<Node> m_nodes;
+  uint32_t m_root = NullNode;
+  uint32_t m_freeList = NullNode;
+  size_t m_leafCount = 0;
+  float m_margin;
+  float m_displacementScale;
+};
+} // namespace zeus
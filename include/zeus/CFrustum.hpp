@@ -1,10 +1,13 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
+#include <span>
 #include "zeus/CPlane.hpp"
 
 namespace zeus {
 class CAABox;
+struct CAABoxSoA;
 class CMatrix4f;
 class CProjection;
 class CSphere;
@@ -13,11 +16,34 @@ class CFrustum {
   std::array<CPlane, 6> planes;
   bool valid = false;
 
+public:
+  /* Planes transposed into SoA form for the batched tests, refreshed by updatePlanes */
+  struct SoAPlanes {
+    std::array<float, 6> x, y, z, d;
+    std::array<float, 6> absX, absY, absZ;
+  };
+
+private:
+  SoAPlanes soaPlanes{};
+
 public:
   void updatePlanes(const CMatrix4f& viewMtx, const CMatrix4f& projection);
   void updatePlanes(const CTransform& viewPointMtx, const CProjection& projection);
   [[nodiscard]] bool aabbFrustumTest(const CAABox& aabb) const;
   [[nodiscard]] bool sphereFrustumTest(const CSphere& sphere) const;
   [[nodiscard]] bool pointFrustumTest(const CVector3f& point) const;
+
+  /**
+   * Tests every box in boxes against the frustum, several boxes per instruction.
+   * Bit (i % 32) of visibleBits[i / 32] is set when box i is at least partially inside;
+   * visibleBits must hold at least (boxes.size() + 31) / 32 words.
+   */
+  void aabbFrustumTest(const CAABoxSoA& boxes, std::span<uint32_t> visibleBits) const;
+
+  /**
+   * Same test as above, but writes the indices of visible boxes in ascending order.
+   * visibleIndices must hold at least boxes.size() entries; returns the number written.
+   */
+  [[nodiscard]] size_t aabbFrustumCull(const CAABoxSoA& boxes, std::span<uint32_t> visibleIndices) const;
 };
 } // namespace zeus
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cfloat>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "zeus/CAABox.hpp"
+
+namespace zeus {
+struct SNeighbor {
+  uint32_t index = 0;
+  float distanceSq = 0.f;
+};
+
+/**
+ * Static k-d tree over points for nearest-neighbour and radius queries.
+ * Nodes split at the median of their widest axis and keep the tight bounds of their points, so a query skips any
+ * node farther than its current bound. Leaves hold up to LeafSize points as coordinate arrays in tree order, padded
+ * to whole simd<float> registers with NaN points that never match, and are scanned a register at a time.
+ * Points are referenced by their index in the input span, as CBVH leaves reference their boxes.
+ */
+class CKdTree {
+public:
+  static constexpr uint32_t LeafSize = 8;
+
+  CKdTree() = default;
+  explicit CKdTree(std::span<const CVector3f> points) { build(points); }
+
+  void build(std::span<const CVector3f> points);
+  void clear();
+
+  [[nodiscard]] size_t size() const { return m_pointCount; }
+  [[nodiscard]] bool empty() const { return m_pointCount == 0; }
+  [[nodiscard]] size_t nodeCount() const { return m_nodes.size(); }
+  [[nodiscard]] CAABox bounds() const;
+
+  /**
+   * Finds the up to out.size() points nearest to point and no farther than maxDistance, writing them to out nearest
+   * first; returns how many were found. With a positive epsilon the search is approximate: it skips nodes that
+   * can't hold a point more than 1 + epsilon times closer than the current candidates, so the j-th result is at
+   * most 1 + epsilon times as far as the true j-th nearest point.
+   */
+  size_t queryNearest(const CVector3f& point, std::span<SNeighbor> out, float maxDistance = FLT_MAX,
+                      float epsilon = 0.f) const;
+
+  /* Appends the indices of all points no farther than radius from center, in no particular order */
+  void queryRadius(const CVector3f& center, float radius, std::vector<uint32_t>& out) const;
+
+  /**
+   * Batch versions of the above, split across threadCount workers once there are enough queries; 0 uses every
+   * hardware thread. queryNearest writes the neighbours of points[i] to out[i * k] onwards and their count to
+   * counts[i]. queryRadius appends the matches of every center to out in order, those of centers[i] ending up
+   * in [offsets[i], offsets[i + 1]); offsets must hold centers.size() + 1 entries.
+   */
+  void queryNearest(std::span<const CVector3f> points, uint32_t k, std::span<SNeighbor> out,
+                    std::span<uint32_t> counts, float maxDistance = FLT_MAX, float epsilon = 0.f,
+                    unsigned threadCount = 1) const;
+  void queryRadius(std::span<const CVector3f> centers, float radius, std::vector<uint32_t>& out,
+                   std::span<uint32_t> offsets, unsigned threadCount = 1) const;
+
+private:
+  struct Node {
+    std::array<float, 3> min, max;
+    /* Inner nodes: the first of two adjacent children. Leaves: the first point slot */
+    uint32_t first;
+    /* Points in a leaf, 0 for inner nodes */
+    uint32_t count;
+  };
+
+  /* Fills in node from points[begin, end), each paired with its input index */
+  void buildNode(std::vector<std::pair<CVector3f, uint32_t>>& points, uint32_t node, uint32_t begin, uint32_t end);
+
+  std::vector<Node> m_nodes;
+  /* Leaf points in tree order, each leaf starting on a register boundary */
+  std::vector<float> m_x, m_y, m_z;
+  std::vector<uint32_t> m_indices;
+  size_t m_pointCount = 0;
+};
+} // namespace zeus
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "zeus/CAABox.hpp"
+#include "zeus/CLooseTree.hpp"
+
+namespace zeus {
+class CFrustum;
+
+/**
+ * Loose octree over fixed world bounds. Each node's loose bounds are its cell grown by half a cell on every side, so
+ * an object goes straight to the deepest level whose cells are at least as large as it, in the cell holding its
+ * centre, without testing any node on the way; objects stay there while they move, as long as their centre stays in
+ * the cell and their size still matches the level.
+ * Children are allocated as blocks of eight siblings numbered in Morton order (bit 0 of the child index selects +x,
+ * bit 1 +y and bit 2 +z, as in CAABox::getPoint). Released blocks are recycled through a free list, and optimize()
+ * lays the blocks out depth-first in Morton order so traversals walk memory forwards. A block is released as soon as
+ * its parent's subtree is empty, so regions streamed out cost nothing to traverse.
+ * Objects whose centre lies outside the world bounds are kept at the root, which queries never cull.
+ * Objects are referenced by caller-chosen ids, which index an internal array and so should be dense.
+ */
+class CLooseOctree : public CLooseTree<3, CAABox> {
+public:
+  static constexpr uint32_t MaxDepth = 12;
+
+  CLooseOctree(const CAABox& bounds, uint32_t maxDepth = 6);
+
+  /* Queries append the ids of all matching objects to out, each once, visiting children in Morton order */
+  void queryPoint(const CVector3f& point, std::vector<uint32_t>& out) const;
+  void queryAABB(const CAABox& box, std::vector<uint32_t>& out) const;
+  void queryFrustum(const CFrustum& frustum, std::vector<uint32_t>& out) const;
+};
+} // namespace zeus
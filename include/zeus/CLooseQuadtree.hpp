@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "zeus/CLooseTree.hpp"
+#include "zeus/CRectangle.hpp"
+
+namespace zeus {
+/**
+ * Two-dimensional counterpart of CLooseOctree over CRectangle bounds, for maps and other planar layouts.
+ * Children come in blocks of four siblings numbered in Morton order (bit 0 of the child index selects +x, bit 1 +y);
+ * placement, pooling and pruning follow CLooseOctree.
+ */
+class CLooseQuadtree : public CLooseTree<2, CRectangle> {
+public:
+  static constexpr uint32_t MaxDepth = 16;
+
+  CLooseQuadtree(const CRectangle& bounds, uint32_t maxDepth = 8);
+
+  /* Queries append the ids of all matching objects to out, each once, visiting children in Morton order */
+  void queryPoint(const CVector2f& point, std::vector<uint32_t>& out) const;
+  void queryRect(const CRectangle& rect, std::vector<uint32_t>& out) const;
+};
+} // namespace zeus
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace zeus {
+/**
+ * Node pool, object placement and traversal shared by CLooseOctree (Dim 3 over CAABox) and CLooseQuadtree (Dim 2 over
+ * CRectangle); see CLooseOctree for the placement rules. Each node has 1 << Dim children, numbered in Morton order
+ * within their block: bit k of the child index selects the positive half along axis k. New blocks are appended or taken
+ * from a free list; optimize() renumbers the pool so blocks follow a depth-first walk in Morton order, keeping each
+ * subtree contiguous and siblings' subtrees in Morton key order. remove() runs it once released blocks make up half
+ * the pool.
+ * Member definitions live in src/CLooseTree.cpp, which instantiates the two supported dimensions.
+ */
+template <uint32_t Dim, typename Box>
+class CLooseTree {
+public:
+  static constexpr uint32_t ChildCount = 1u << Dim;
+
+  void insert(uint32_t id, const Box& box);
+  void remove(uint32_t id);
+  /* Updates id in place while it still belongs to the same node, otherwise moves it to its new node */
+  void move(uint32_t id, const Box& box);
+  void clear();
+  /* Lays the node pool out in Morton order and drops released blocks; ids and query results are unaffected */
+  void optimize();
+
+  [[nodiscard]] const Box& worldBounds() const { return m_bounds; }
+  [[nodiscard]] uint32_t maxDepth() const { return m_maxDepth; }
+  [[nodiscard]] size_t size() const { return m_objectCount; }
+  /* Nodes currently allocated, including the root */
+  [[nodiscard]] size_t nodeCount() const { return m_nodes.size() - m_freeBlocks.size() * ChildCount; }
+  [[nodiscard]] bool contains(uint32_t id) const { return id < m_objects.size() && m_objects[id].node != NullNode; }
+  [[nodiscard]] const Box& bounds(uint32_t id) const { return m_objects[id].box; }
+  /* Depth of the node holding id, 0 for the root */
+  [[nodiscard]] uint32_t depth(uint32_t id) const { return m_nodes[m_objects[id].node].depth; }
+
+protected:
+  CLooseTree(const Box& bounds, uint32_t maxDepth);
+
+  /* Visits non-empty nodes depth-first whose loose bounds boxTest accepts, emitting the entries it accepts */
+  template <typename BoxTest>
+  void traverse(BoxTest&& boxTest, std::vector<uint32_t>& out) const;
+
+private:
+  static constexpr uint32_t NullNode = 0xFFFFFFFF;
+
+  /* An object's bounds as stored in its node */
+  struct Entry {
+    Box box;
+    uint32_t id;
+  };
+  struct Node {
+    Box cell;
+    Box loose;
+    uint32_t parent = NullNode;
+    /* First of ChildCount children in Morton order, or NullNode */
+    uint32_t firstChild = NullNode;
+    uint32_t depth = 0;
+    /* Objects in this node and below; a node without any has no children */
+    uint32_t count = 0;
+    std::vector<Entry> entries;
+  };
+  struct Object {
+    Box box;
+    uint32_t node = NullNode;
+    /* Position in the node's entries */
+    uint32_t slot = 0;
+  };
+
+  [[nodiscard]] uint32_t targetDepth(const Box& box) const;
+  [[nodiscard]] bool belongsTo(uint32_t node, const Box& box) const;
+  /* Finds the node box belongs in, allocating the path to it */
+  uint32_t acquireNode(const Box& box);
+  void allocateChildren(uint32_t parent);
+  void attach(uint32_t id, uint32_t node);
+  void detach(uint32_t id);
+
+  Box m_bounds;
+  uint32_t m_maxDepth;
+  std::vector<Node> m_nodes;
+  /* First nodes of released child blocks */
+  std::vector<uint32_t> m_freeBlocks;
+  std::vector<Object> m_objects;
+  size_t m_objectCount = 0;
+};
+
+template <uint32_t Dim, typename Box>
+template <typename BoxTest>
+void CLooseTree<Dim, Box>::traverse(BoxTest&& boxTest, std::vector<uint32_t>& out) const {
+  if (m_nodes.front().count == 0)
+    return;
+
+  std::vector<uint32_t> stack;
+  stack.reserve(64);
+  stack.push_back(0);
+  while (!stack.empty()) {
+    const uint32_t index = stack.back();
+    stack.pop_back();
+    const Node& node = m_nodes[index];
+    if (index != 0 && !boxTest(node.loose))
+      continue;
+    for (const Entry& entry : node.entries)
+      if (boxTest(entry.box))
+        out.push_back(entry.id);
+    if (node.firstChild == NullNode)
+      continue;
+    for (uint32_t i = ChildCount; i-- > 0;)
+      if (m_nodes[node.firstChild + i].count != 0)
+        stack.push_back(node.firstChild + i);
+  }
+}
+} // namespace zeus
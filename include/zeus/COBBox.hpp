@@ -1,10 +1,16 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <span>
+
 #include "zeus/CAABox.hpp"
 #include "zeus/CTransform.hpp"
 #include "zeus/CVector3f.hpp"
 
 namespace zeus {
+struct COBBoxSoA;
+
 class COBBox {
 public:
   CTransform transform;
@@ -27,8 +33,30 @@ public:
 
   [[nodiscard]] bool OBBIntersectsBox(const COBBox& other) const;
 
-  [[nodiscard]] bool AABoxIntersectsBox(const CAABox& other) const {
-    return OBBIntersectsBox(FromAABox(other, CTransform()));
-  }
+  /* Same result as OBBIntersectsBox(FromAABox(other, CTransform())), reading the rotation straight from our basis */
+  [[nodiscard]] bool AABoxIntersectsBox(const CAABox& other) const;
+
+  /**
+   * Tests this box against every box in others, with all 15 separating axes evaluated for several boxes at once.
+   * Bit (i % 32) of hitBits[i / 32] is set when box i intersects;
+   * hitBits must hold at least (others.size() + 31) / 32 words.
+   */
+  void OBBIntersectsBoxes(const COBBoxSoA& others, std::span<uint32_t> hitBits) const;
+  void OBBIntersectsBoxes(std::span<const COBBox> others, std::span<uint32_t> hitBits) const;
+
+  /* Tests a[i] against b[i] for every i, setting bits as above; a and b must have the same size */
+  static void OBBIntersectsPairs(std::span<const COBBox> a, std::span<const COBBox> b, std::span<uint32_t> hitBits);
+};
+
+/**
+ * Structure-of-arrays view over a set of oriented boxes, one span per component.
+ * basis[c * 3 + r] holds transform.basis[c][r]. All spans must have the same length.
+ */
+struct COBBoxSoA {
+  std::span<const float> originX, originY, originZ;
+  std::array<std::span<const float>, 9> basis;
+  std::span<const float> extentX, extentY, extentZ;
+
+  [[nodiscard]] size_t size() const { return originX.size(); }
 };
 } // namespace zeus
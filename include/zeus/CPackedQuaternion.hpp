@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "zeus/CQuaternion.hpp"
+#include "zeus/Math.hpp"
+
+namespace zeus {
+/**
+ * Unit quaternion stored in 12 bytes as x, y and z; w is rebuilt as sqrt(1 - x^2 - y^2 - z^2).
+ * q and -q are the same rotation, so packing flips the sign to keep w non-negative.
+ * w loses precision for rotations near 180 degrees, where it approaches 0.
+ */
+struct CPackedQuaternion {
+  float x = 0.f;
+  float y = 0.f;
+  float z = 0.f;
+
+  constexpr CPackedQuaternion() = default;
+  CPackedQuaternion(const CQuaternion& quat) {
+    const float sign = quat.w() < 0.f ? -1.f : 1.f;
+    x = quat.x() * sign;
+    y = quat.y() * sign;
+    z = quat.z() * sign;
+  }
+
+  [[nodiscard]] CQuaternion toQuaternion() const {
+    return {std::sqrt(std::max(0.f, 1.f - (x * x + y * y + z * z))), x, y, z};
+  }
+};
+static_assert(sizeof(CPackedQuaternion) == 12, "CPackedQuaternion must not be padded");
+
+/** w, x, y and z as IEEE half floats in 8 bytes; unlike CPackedQuaternion, no unit length is assumed */
+struct CPackedHalfQuaternion {
+  uint16_t w = 0x3C00;
+  uint16_t x = 0;
+  uint16_t y = 0;
+  uint16_t z = 0;
+
+  constexpr CPackedHalfQuaternion() = default;
+  CPackedHalfQuaternion(const CQuaternion& quat)
+  : w(floatToHalf(quat.w())), x(floatToHalf(quat.x())), y(floatToHalf(quat.y())), z(floatToHalf(quat.z())) {}
+
+  [[nodiscard]] CQuaternion toQuaternion() const {
+    return {halfToFloat(w), halfToFloat(x), halfToFloat(y), halfToFloat(z)};
+  }
+};
+static_assert(sizeof(CPackedHalfQuaternion) == 8, "CPackedHalfQuaternion must not be padded");
+
+/* Bulk conversions between packed and simd storage; out must hold at least in.size() elements */
+void loadPacked(std::span<const CPackedQuaternion> in, std::span<CQuaternion> out);
+void storePacked(std::span<const CQuaternion> in, std::span<CPackedQuaternion> out);
+void loadPacked(std::span<const CPackedHalfQuaternion> in, std::span<CQuaternion> out);
+void storePacked(std::span<const CQuaternion> in, std::span<CPackedHalfQuaternion> out);
+} // namespace zeus
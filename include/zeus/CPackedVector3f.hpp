@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "zeus/CVector3f.hpp"
+#include "zeus/Math.hpp"
+
+namespace zeus {
+/**
+ * Unpadded xyz storage for bulk data such as vertex buffers and particle arrays,
+ * where CVector3f's 16-byte simd layout would waste a quarter of the memory.
+ * Convert to CVector3f to do arithmetic.
+ */
+struct CPackedVector3f {
+  float x = 0.f;
+  float y = 0.f;
+  float z = 0.f;
+
+  constexpr CPackedVector3f() = default;
+  constexpr CPackedVector3f(float x, float y, float z) : x(x), y(y), z(z) {}
+  CPackedVector3f(const CVector3f& vec) : x(vec.x()), y(vec.y()), z(vec.z()) {}
+
+  [[nodiscard]] CVector3f toVec3f() const { return {x, y, z}; }
+
+  [[nodiscard]] bool operator==(const CPackedVector3f& rhs) const { return x == rhs.x && y == rhs.y && z == rhs.z; }
+  [[nodiscard]] bool operator!=(const CPackedVector3f& rhs) const { return !(*this == rhs); }
+};
+static_assert(sizeof(CPackedVector3f) == 12, "CPackedVector3f must not be padded");
+
+/** xyz as IEEE half floats: about three significant digits and a range of +-65504 in 6 bytes */
+struct CPackedHalfVector3f {
+  uint16_t x = 0;
+  uint16_t y = 0;
+  uint16_t z = 0;
+
+  constexpr CPackedHalfVector3f() = default;
+  CPackedHalfVector3f(const CVector3f& vec)
+  : x(floatToHalf(vec.x())), y(floatToHalf(vec.y())), z(floatToHalf(vec.z())) {}
+
+  [[nodiscard]] CVector3f toVec3f() const { return {halfToFloat(x), halfToFloat(y), halfToFloat(z)}; }
+};
+static_assert(sizeof(CPackedHalfVector3f) == 6, "CPackedHalfVector3f must not be padded");
+
+/* Bulk conversions between packed and simd storage; out must hold at least in.size() elements */
+void loadPacked(std::span<const CPackedVector3f> in, std::span<CVector3f> out);
+void storePacked(std::span<const CVector3f> in, std::span<CPackedVector3f> out);
+void loadPacked(std::span<const CPackedHalfVector3f> in, std::span<CVector3f> out);
+void storePacked(std::span<const CVector3f> in, std::span<CPackedHalfVector3f> out);
+} // namespace zeus
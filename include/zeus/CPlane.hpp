@@ -38,6 +38,9 @@ public:
     mSimd[3] = nd * mag;
   }
 
+  /* normalize() through fastInvSqrtF's estimate, which scales the normal and d alike */
+  void fastNormalize() { mSimd *= rsqrt(simd<float>(normal().magSquared())); }
+
   [[nodiscard]] float pointToPlaneDist(const CVector3f& pos) const { return normal().dot(pos) - d(); }
 
   [[nodiscard]] bool rayPlaneIntersection(const CVector3f& from, const CVector3f& to, CVector3f& point) const;
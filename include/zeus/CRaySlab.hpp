@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "zeus/CAABox.hpp"
+#include "zeus/CMRay.hpp"
+
+namespace zeus {
+/**
+ * Slab-test form of a CMRay segment: origin broadcast across simd lanes and the reciprocal direction.
+ * Distances are measured along ray.dir from ray.start and clipped to [0, ray.length].
+ * Zero direction components use a reciprocal of +-FLT_MAX, so axis-parallel and zero-length rays need no
+ * special case; a ray with a NaN start, direction or length hits nothing, as does a box with a NaN or inverted bound.
+ * An axis-parallel ray lying exactly in the plane of a box face is not guaranteed to hit it.
+ */
+class CRaySlab {
+public:
+  explicit CRaySlab(const CMRay& ray);
+
+  [[nodiscard]] bool valid() const { return m_valid; }
+  [[nodiscard]] float length() const { return m_length; }
+
+  /* On a hit writes the distances at which the segment enters and leaves box */
+  [[nodiscard]] bool intersect(const CAABox& box, float& tEnter, float& tExit) const;
+
+  /**
+   * Tests every box in boxes, several boxes per instruction.
+   * Bit (i % 32) of hitBits[i / 32] is set when the segment overlaps box i, and tEnter[i]/tExit[i] then hold the
+   * entry and exit distances. hitBits must hold at least (boxes.size() + 31) / 32 words and the distance spans
+   * at least boxes.size() entries; distances of missed boxes are unspecified.
+   */
+  void intersect(const CAABoxSoA& boxes, std::span<uint32_t> hitBits, std::span<float> tEnter,
+                 std::span<float> tExit) const;
+
+  /**
+   * Tests simd<float>::size() boxes given as SoA lanes against the segment clipped to [0, tMax].
+   * Returns the lane mask of hits; used directly by hierarchy traversals that keep their bounds in lanes.
+   */
+  [[nodiscard]] int intersectLanes(const simd<float>& minX, const simd<float>& minY, const simd<float>& minZ,
+                                   const simd<float>& maxX, const simd<float>& maxY, const simd<float>& maxZ,
+                                   float tMax, simd<float>& tEnter, simd<float>& tExit) const {
+    const simd<float> t1x = (minX - m_ox) * m_idx;
+    const simd<float> t2x = (maxX - m_ox) * m_idx;
+    const simd<float> t1y = (minY - m_oy) * m_idy;
+    const simd<float> t2y = (maxY - m_oy) * m_idy;
+    const simd<float> t1z = (minZ - m_oz) * m_idz;
+    const simd<float> t2z = (maxZ - m_oz) * m_idz;
+
+    tEnter = max(max(min(t1x, t2x), min(t1y, t2y)), max(min(t1z, t2z), simd<float>(0.f)));
+    tExit = min(min(max(t1x, t2x), max(t1y, t2y)), min(max(t1z, t2z), simd<float>(tMax)));
+
+    /* min <= max rejects empty lanes and any bound that is NaN */
+    return bitmask(tEnter <= tExit) & bitmask(minX <= maxX) & bitmask(minY <= maxY) & bitmask(minZ <= maxZ);
+  }
+
+private:
+  friend struct CRaySlabKernels;
+
+  simd<float> m_ox, m_oy, m_oz;
+  simd<float> m_idx, m_idy, m_idz;
+  float m_length;
+  bool m_valid;
+};
+
+/**
+ * Up to MaxRays ray segments in SoA form, tested together against one box.
+ * Rays are processed simd<float>::size() at a time; distances follow the same conventions as CRaySlab.
+ */
+class CRayPacket {
+public:
+  static constexpr size_t MaxRays = 8;
+
+  explicit CRayPacket(std::span<const CMRay> rays);
+
+  [[nodiscard]] size_t size() const { return m_count; }
+
+  /**
+   * Returns a mask with bit i set when ray i overlaps box; tEnter[i]/tExit[i] then hold its entry and exit
+   * distances. Distances of rays that miss are unspecified.
+   */
+  [[nodiscard]] uint32_t intersect(const CAABox& box, std::array<float, MaxRays>& tEnter,
+                                   std::array<float, MaxRays>& tExit) const;
+
+private:
+  static constexpr size_t Lanes = simd<float>::size();
+  static constexpr size_t GroupCount = MaxRays / Lanes;
+
+  struct Group {
+    simd<float> ox, oy, oz;
+    simd<float> idx, idy, idz;
+    simd<float> length;
+    /* Lanes holding a ray that can hit anything */
+    int valid;
+  };
+
+  std::array<Group, GroupCount> m_groups;
+  size_t m_count;
+};
+} // namespace zeus
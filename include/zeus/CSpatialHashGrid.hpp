@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "zeus/CAABox.hpp"
+
+namespace zeus {
+struct CMRay;
+class CSphere;
+
+/**
+ * Uniform grid over unbounded space for broad-phase collision, with cells created on demand in an open-addressing
+ * hash table. Each object is a CAABox registered in every cell it overlaps, and a cell keeps copies of its objects'
+ * bounds next to their ids, so scanning a cell reads one contiguous array.
+ * Objects are referenced by caller-chosen ids, which index an internal array and so should be dense.
+ * Work grows with the number of cells an object or query covers; cellSize should be near the typical object size.
+ * Results need no per-query bookkeeping to stay unique: an object is only reported from the first cell it shares
+ * with the query, i.e. the lowest cell of their overlap, or the first one reached along a ray.
+ */
+class CSpatialHashGrid {
+public:
+  explicit CSpatialHashGrid(float cellSize);
+
+  void insert(uint32_t id, const CAABox& box);
+  /* Spheres are stored by their bounding boxes */
+  void insert(uint32_t id, const CSphere& sphere);
+  void remove(uint32_t id);
+  /* Same result as remove and insert, but cells id stays in are updated in place */
+  void move(uint32_t id, const CAABox& box);
+  void clear();
+
+  [[nodiscard]] float cellSize() const { return m_cellSize; }
+  [[nodiscard]] size_t size() const { return m_objectCount; }
+  [[nodiscard]] size_t cellCount() const { return m_usedSlots; }
+  [[nodiscard]] bool contains(uint32_t id) const { return id < m_objects.size() && m_objects[id].live; }
+  [[nodiscard]] const CAABox& bounds(uint32_t id) const { return m_objects[id].box; }
+
+  /* Queries append the ids of all matching objects to out, each once and in no particular order */
+  void queryAABB(const CAABox& box, std::vector<uint32_t>& out) const;
+  void querySphere(const CSphere& sphere, std::vector<uint32_t>& out) const;
+  /* Marches the ray segment cell by cell, so ids come out roughly in order of distance */
+  void queryRay(const CMRay& ray, std::vector<uint32_t>& out) const;
+
+  /**
+   * Finds the object whose box the ray segment enters first, stopping the march at the first cell that ends
+   * beyond the closest hit so far. On a hit, idOut receives its id and distOut the distance from ray.start.
+   */
+  [[nodiscard]] bool rayCastClosest(const CMRay& ray, uint32_t& idOut, float& distOut) const;
+
+  /* Appends every pair of objects with overlapping boxes once, as (lower id, higher id) */
+  void findPairs(std::vector<std::pair<uint32_t, uint32_t>>& out) const;
+
+private:
+  using CellCoord = std::array<int32_t, 3>;
+  static constexpr uint32_t EmptySlot = 0xFFFFFFFF;
+
+  struct CellRange {
+    CellCoord lo, hi;
+  };
+  /* An object's bounds as stored in each of its cells */
+  struct Entry {
+    std::array<float, 3> min, max;
+    uint32_t id;
+  };
+  struct Slot {
+    CellCoord cell;
+    /* Index into m_cells, or EmptySlot */
+    uint32_t index = EmptySlot;
+  };
+  struct Object {
+    CAABox box;
+    CellRange cells;
+    bool live = false;
+  };
+
+  [[nodiscard]] CellCoord cellOf(float x, float y, float z) const;
+  [[nodiscard]] CellRange rangeOf(const CAABox& box) const;
+  [[nodiscard]] CellRange rangeOf(const Entry& entry) const;
+  [[nodiscard]] size_t findSlot(const CellCoord& cell) const;
+  [[nodiscard]] const std::vector<Entry>* findCell(const CellCoord& cell) const;
+  std::vector<Entry>& acquireCell(const CellCoord& cell);
+  void removeEntry(const CellCoord& cell, uint32_t id);
+  void eraseSlot(size_t slot);
+  void rehash(size_t slotCount);
+  template <typename Visit>
+  void marchRay(const CMRay& ray, Visit&& visit) const;
+
+  float m_cellSize;
+  float m_invCellSize;
+  std::vector<Object> m_objects;
+  /* Power-of-two table, kept at most half full */
+  std::vector<Slot> m_slots;
+  std::vector<std::vector<Entry>> m_cells;
+  std::vector<uint32_t> m_freeCells;
+  size_t m_objectCount = 0;
+  size_t m_usedSlots = 0;
+};
+} // namespace zeus
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "zeus/CAABox.hpp"
+
+namespace zeus {
+/**
+ * Incremental sweep and prune broad phase. Every object's box contributes a min and a max endpoint to a sorted
+ * array per axis, and moving an object re-sorts only its own endpoints by insertion sort, so objects that move a
+ * little each frame cost a few swaps. Whenever a min endpoint crosses another object's max endpoint the pair may
+ * have started or stopped overlapping; the set of overlapping pairs is updated there, without ever scanning for
+ * pairs.
+ * Objects are referenced by caller-chosen ids below 2^31, which index an internal array and so should be dense.
+ * Bounds must not be NaN. Boxes that only touch count as overlapping, as with CAABox::intersects.
+ */
+class CSweepAndPrune {
+public:
+  using Pair = std::pair<uint32_t, uint32_t>;
+
+  void insert(uint32_t id, const CAABox& box);
+  void remove(uint32_t id);
+  void move(uint32_t id, const CAABox& box);
+  void clear();
+
+  [[nodiscard]] size_t size() const { return m_objectCount; }
+  [[nodiscard]] size_t pairCount() const { return m_pairs.size(); }
+  [[nodiscard]] bool contains(uint32_t id) const { return id < m_objects.size() && m_objects[id].live; }
+  [[nodiscard]] const CAABox& bounds(uint32_t id) const { return m_objects[id].box; }
+  [[nodiscard]] bool overlapping(uint32_t a, uint32_t b) const { return m_pairs.count(pairKey(a, b)) != 0; }
+
+  /* Appends every currently overlapping pair once, as (lower id, higher id), in no particular order */
+  void pairs(std::vector<Pair>& out) const;
+
+  /**
+   * Appends the pairs that started and stopped overlapping since the last call, in ascending order. This is the
+   * net change: a pair that was found and lost again in between is not reported.
+   */
+  void collectEvents(std::vector<Pair>& added, std::vector<Pair>& removed);
+
+  /**
+   * One-off sort and sweep over the x axis that appends every overlapping pair of boxes as (lower index, higher
+   * index). Candidates whose x intervals overlap are tested on y and z several at a time.
+   */
+  static void FindPairs(std::span<const CAABox> boxes, std::vector<Pair>& out);
+
+private:
+  /* Value of a box bound, and the owning id shifted left by one with the low bit set on max endpoints */
+  struct Endpoint {
+    float value;
+    uint32_t data;
+  };
+  struct Object {
+    CAABox box;
+    /* Positions of the min and max endpoints in each axis array */
+    std::array<uint32_t, 3> minIndex{}, maxIndex{};
+    bool live = false;
+  };
+
+  static uint64_t pairKey(uint32_t a, uint32_t b) {
+    return a < b ? uint64_t(a) << 32 | b : uint64_t(b) << 32 | a;
+  }
+
+  void place(uint32_t axis, uint32_t index);
+  void sortDown(uint32_t axis, uint32_t index);
+  void sortUp(uint32_t axis, uint32_t index, bool toEnd = false);
+  void beginOverlap(uint32_t a, uint32_t b);
+  void endOverlap(uint32_t a, uint32_t b);
+
+  std::vector<Object> m_objects;
+  std::array<std::vector<Endpoint>, 3> m_axes;
+  std::unordered_set<uint64_t> m_pairs;
+  /* Keys of pairs whose overlap changed since the last collectEvents, once per change */
+  std::vector<uint64_t> m_changes;
+  size_t m_objectCount = 0;
+};
+} // namespace zeus
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <cfloat>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "zeus/TriangleQuery.hpp"
+
+namespace zeus {
+/**
+ * Indexed triangle soup packed for batched queries. Alongside its own copy of the mesh it keeps each triangle's
+ * first corner and two edges as coordinate arrays, padded to a whole number of registers with triangles that can't
+ * be hit, so the kernels below test a register of triangles per step. Triangles are referenced by their position in
+ * the index list divided by three, as CBVH leaves reference their boxes.
+ */
+class CTriangleSoup {
+public:
+  CTriangleSoup() = default;
+  CTriangleSoup(std::span<const CVector3f> vertices, std::span<const uint32_t> indices) { build(vertices, indices); }
+
+  /* Replaces the soup; indices holds three vertex indices per triangle */
+  void build(std::span<const CVector3f> vertices, std::span<const uint32_t> indices);
+
+  [[nodiscard]] size_t size() const { return m_indices.size() / 3; }
+  [[nodiscard]] bool empty() const { return m_indices.empty(); }
+  [[nodiscard]] std::array<CVector3f, 3> triangle(size_t i) const {
+    return {m_vertices[m_indices[i * 3]], m_vertices[m_indices[i * 3 + 1]], m_vertices[m_indices[i * 3 + 2]]};
+  }
+  [[nodiscard]] CAABox triangleBounds(size_t i) const;
+
+  /**
+   * Finds the triangle the ray segment hits first, eight triangles per step on AVX2 machines and a register at a
+   * time elsewhere. Ties go to the lower index. The hit follows rayTriangleIntersect's conventions.
+   */
+  [[nodiscard]] bool rayCastClosest(const CMRay& ray, STriangleHit& hit) const;
+
+  /**
+   * Tests every triangle against box. Bit (i % 32) of hitBits[i / 32] is set when triangle i overlaps it;
+   * hitBits must hold at least (size() + 31) / 32 words.
+   */
+  void intersect(const CAABox& box, std::span<uint32_t> hitBits) const;
+
+  /* Nearest point of the soup no farther than maxDistance from point */
+  [[nodiscard]] bool closestPoint(const CVector3f& point, STriangleHit& hit, float maxDistance = FLT_MAX) const;
+
+private:
+  friend struct CTriangleSoupKernels;
+
+  std::vector<CVector3f> m_vertices;
+  std::vector<uint32_t> m_indices;
+  /* First corner, then the edges to the second and third corners */
+  std::vector<float> m_x0, m_y0, m_z0;
+  std::vector<float> m_e1x, m_e1y, m_e1z;
+  std::vector<float> m_e2x, m_e2y, m_e2z;
+};
+} // namespace zeus
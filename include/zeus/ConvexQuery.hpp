@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "zeus/CConvexShape.hpp"
+
+namespace zeus {
+/**
+ * Warm start state for repeated queries on the same pair of shapes. GJK records the search directions behind its
+ * final simplex here, and the next query rebuilds its first simplex from the supports along them, which for
+ * slowly moving shapes is already close to the answer. A default constructed cache starts from scratch.
+ */
+struct SGJKCache {
+  std::array<CVector3f, 4> directions;
+  uint32_t count = 0;
+};
+
+struct SConvexDistance {
+  bool intersecting = false;
+  /* Zero when intersecting */
+  float distance = 0.f;
+  /* Closest points on a and b; when intersecting, a point both shapes share */
+  CVector3f pointA, pointB;
+};
+
+struct SConvexPenetration {
+  bool intersecting = false;
+  /* Distance b has to move along normal to only touch a */
+  float depth = 0.f;
+  /* Unit direction from a toward b */
+  CVector3f normal;
+  /* Deepest points of a inside b and of b inside a, so pointA - pointB = normal * depth */
+  CVector3f pointA, pointB;
+};
+
+/* GJK separation test; stops at the first separating direction it finds */
+[[nodiscard]] bool gjkIntersects(const CConvexShape& a, const CConvexShape& b, SGJKCache* cache = nullptr);
+
+/* GJK distance between the shapes, with closest points */
+[[nodiscard]] SConvexDistance gjkDistance(const CConvexShape& a, const CConvexShape& b, SGJKCache* cache = nullptr);
+
+/**
+ * Penetration depth of intersecting shapes by the expanding polytope algorithm, seeded with GJK's final simplex.
+ * Rounded shapes are approximated by the polytope, to within a small fraction of the depth.
+ * Returns intersecting = false when GJK separates the shapes.
+ */
+[[nodiscard]] SConvexPenetration epaPenetration(const CConvexShape& a, const CConvexShape& b,
+                                                SGJKCache* cache = nullptr);
+} // namespace zeus
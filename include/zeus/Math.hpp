@@ -25,8 +25,11 @@
 #define M_SQRT1_2F 0.70710678118654752440f /* 1/sqrt(2) */
 
 #include <cmath>
+#include <cstdint>
 #include <algorithm>
 
+#include "zeus/simd/simd.hpp"
+
 namespace zeus {
 
 #if _MSC_VER
@@ -43,6 +46,20 @@ namespace zeus {
 #endif
 #endif
 
+/* Mark functions built for AVX2 or AVX-512 whatever the build's own flags; they must only be reached through kernel
+ * dispatch */
+#if (ZEUS_ARCH_X86_64 || ZEUS_ARCH_X86) && (defined(__SSE__) || defined(_MSC_VER))
+#define ZEUS_KERNEL_AVX2 1
+#define ZEUS_KERNEL_AVX512 1
+#if _MSC_VER && !defined(__clang__)
+#define ZEUS_TARGET_AVX2
+#define ZEUS_TARGET_AVX512
+#else
+#define ZEUS_TARGET_AVX2 __attribute__((target("avx2")))
+#define ZEUS_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+#endif
+
 struct CPUInfo {
   const char cpuBrand[48] = {0};
   const char cpuVendor[32] = {0};
@@ -58,6 +75,10 @@ struct CPUInfo {
   const bool AESNI = false;
   const bool AVX = false;
   const bool AVX2 = false;
+  const bool AVX512F = false;
+  const bool AVX512DQ = false;
+  const bool AVX512BW = false;
+  const bool AVX512VL = false;
 #endif
 };
 
@@ -70,6 +91,22 @@ const CPUInfo& cpuFeatures();
 
 [[nodiscard]] std::pair<bool, const CPUInfo&> validateCPU();
 
+/** Instruction sets the batch kernels (batch transforms, SoA culling, SoA ray tests) are compiled for */
+enum class EKernelISA { Baseline, AVX2, AVX512 };
+constexpr size_t KernelISACount = 3;
+
+/**
+ * Returns the instruction set the batch kernels dispatch to.
+ * On first use this is the best one compiled in that cpuFeatures() reports;
+ * Baseline is whatever the build's own compiler flags target.
+ */
+[[nodiscard]] EKernelISA kernelISA();
+
+[[nodiscard]] bool kernelISASupported(EKernelISA isa);
+
+/* Overrides the dispatch choice, e.g. to compare kernel paths; returns false and changes nothing if unsupported */
+bool setKernelISA(EKernelISA isa);
+
 void getCpuInfo(int eax, int regs[4]);
 
 void getCpuInfoEx(int eax, int ecx, int regs[4]);
@@ -133,10 +170,18 @@ template <typename T>
 
 [[nodiscard]] inline float invSqrtF(float val) { return float(1.0 / std::sqrt(val)); }
 
+/* Hardware estimate plus one Newton-Raphson step; relative error below 5e-7 for positive finite val */
+[[nodiscard]] inline float fastInvSqrtF(float val) { return rsqrt(simd<float>(val))[0]; }
+
 [[nodiscard]] int floorPowerOfTwo(int x);
 
 [[nodiscard]] int ceilingPowerOfTwo(int x);
 
+/* IEEE 754 binary16 conversions; floatToHalf rounds to nearest even and overflows to infinity */
+[[nodiscard]] uint16_t floatToHalf(float val);
+
+[[nodiscard]] float halfToFloat(uint16_t val);
+
 template <typename U>
 [[nodiscard]] typename std::enable_if<!std::is_enum<U>::value && std::is_integral<U>::value, int>::type PopCount(U x) {
 #if __GNUC__ >= 4
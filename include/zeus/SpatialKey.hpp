@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#if __BMI2__
+#include <immintrin.h>
+#endif
+
+#include "zeus/CAABox.hpp"
+#include "zeus/CVector2i.hpp"
+
+namespace zeus {
+/**
+ * Space-filling curve keys for sorting points so that nearby points end up nearby in memory.
+ * Morton codes interleave the coordinate bits, x in the lowest bit of each group, so sorting by them walks a grid in
+ * Z order; Hilbert keys follow a curve on which consecutive cells always share a face, at some extra cost per key.
+ * Coordinate bits above each code's width are ignored. Builds targeting BMI2 spread and gather bits with pdep/pext.
+ */
+constexpr uint32_t Morton30AxisBits = 10;
+constexpr uint32_t Morton63AxisBits = 21;
+
+[[nodiscard]] inline uint32_t encodeMorton30(uint32_t x, uint32_t y, uint32_t z) {
+#if __BMI2__
+  return _pdep_u32(x, 0x09249249u) | _pdep_u32(y, 0x12492492u) | _pdep_u32(z, 0x24924924u);
+#else
+  const auto spread = [](uint32_t v) {
+    v &= 0x3FFu;
+    v = (v | v << 16) & 0x030000FFu;
+    v = (v | v << 8) & 0x0300F00Fu;
+    v = (v | v << 4) & 0x030C30C3u;
+    return (v | v << 2) & 0x09249249u;
+  };
+  return spread(x) | spread(y) << 1 | spread(z) << 2;
+#endif
+}
+
+inline void decodeMorton30(uint32_t code, uint32_t& x, uint32_t& y, uint32_t& z) {
+#if __BMI2__
+  x = _pext_u32(code, 0x09249249u);
+  y = _pext_u32(code, 0x12492492u);
+  z = _pext_u32(code, 0x24924924u);
+#else
+  const auto compact = [](uint32_t v) {
+    v &= 0x09249249u;
+    v = (v | v >> 2) & 0x030C30C3u;
+    v = (v | v >> 4) & 0x0300F00Fu;
+    v = (v | v >> 8) & 0x030000FFu;
+    return (v | v >> 16) & 0x3FFu;
+  };
+  x = compact(code);
+  y = compact(code >> 1);
+  z = compact(code >> 2);
+#endif
+}
+
+[[nodiscard]] inline uint64_t encodeMorton63(uint32_t x, uint32_t y, uint32_t z) {
+#if __BMI2__ && __x86_64__
+  return _pdep_u64(x, 0x1249249249249249ull) | _pdep_u64(y, 0x2492492492492492ull) |
+         _pdep_u64(z, 0x4924924924924924ull);
+#else
+  const auto spread = [](uint64_t v) {
+    v &= 0x1FFFFFull;
+    v = (v | v << 32) & 0x001F00000000FFFFull;
+    v = (v | v << 16) & 0x001F0000FF0000FFull;
+    v = (v | v << 8) & 0x100F00F00F00F00Full;
+    v = (v | v << 4) & 0x10C30C30C30C30C3ull;
+    return (v | v << 2) & 0x1249249249249249ull;
+  };
+  return spread(x) | spread(y) << 1 | spread(z) << 2;
+#endif
+}
+
+inline void decodeMorton63(uint64_t code, uint32_t& x, uint32_t& y, uint32_t& z) {
+#if __BMI2__ && __x86_64__
+  x = uint32_t(_pext_u64(code, 0x1249249249249249ull));
+  y = uint32_t(_pext_u64(code, 0x2492492492492492ull));
+  z = uint32_t(_pext_u64(code, 0x4924924924924924ull));
+#else
+  const auto compact = [](uint64_t v) {
+    v &= 0x1249249249249249ull;
+    v = (v | v >> 2) & 0x10C30C30C30C30C3ull;
+    v = (v | v >> 4) & 0x100F00F00F00F00Full;
+    v = (v | v >> 8) & 0x001F0000FF0000FFull;
+    v = (v | v >> 16) & 0x001F00000000FFFFull;
+    return uint32_t((v | v >> 32) & 0x1FFFFFull);
+  };
+  x = compact(code);
+  y = compact(code >> 1);
+  z = compact(code >> 2);
+#endif
+}
+
+/* 2D codes take the low 16 bits of each component, e.g. tile or texel coordinates */
+[[nodiscard]] inline uint32_t encodeMorton2(const CVector2i& v) {
+#if __BMI2__
+  return _pdep_u32(uint32_t(v.x), 0x55555555u) | _pdep_u32(uint32_t(v.y), 0xAAAAAAAAu);
+#else
+  const auto spread = [](uint32_t v) {
+    v &= 0xFFFFu;
+    v = (v | v << 8) & 0x00FF00FFu;
+    v = (v | v << 4) & 0x0F0F0F0Fu;
+    v = (v | v << 2) & 0x33333333u;
+    return (v | v << 1) & 0x55555555u;
+  };
+  return spread(uint32_t(v.x)) | spread(uint32_t(v.y)) << 1;
+#endif
+}
+
+[[nodiscard]] inline CVector2i decodeMorton2(uint32_t code) {
+#if __BMI2__
+  return {int32_t(_pext_u32(code, 0x55555555u)), int32_t(_pext_u32(code, 0xAAAAAAAAu))};
+#else
+  const auto compact = [](uint32_t v) {
+    v &= 0x55555555u;
+    v = (v | v >> 1) & 0x33333333u;
+    v = (v | v >> 2) & 0x0F0F0F0Fu;
+    v = (v | v >> 4) & 0x00FF00FFu;
+    return int32_t((v | v >> 8) & 0xFFFFu);
+  };
+  return {compact(code), compact(code >> 1)};
+#endif
+}
+
+/* Skilling's transpose of the coordinates, interleaved like a Morton code */
+[[nodiscard]] uint64_t encodeHilbert63(uint32_t x, uint32_t y, uint32_t z);
+[[nodiscard]] uint32_t encodeHilbert2(const CVector2i& v);
+
+/**
+ * Keys of points quantized to the cells of a grid over bounds, 2^10 or 2^21 cells along each axis.
+ * Points outside bounds are clamped to its border cells; NaN coordinates map to cell 0.
+ */
+[[nodiscard]] uint32_t mortonKey30(const CVector3f& point, const CAABox& bounds);
+[[nodiscard]] uint64_t mortonKey63(const CVector3f& point, const CAABox& bounds);
+[[nodiscard]] uint64_t hilbertKey63(const CVector3f& point, const CAABox& bounds);
+
+/**
+ * Batch versions of the above; keys must hold at least points.size() entries, computed eight points per step on
+ * AVX2 machines. Ranges are split across threadCount workers once they are large enough to pay
+ * for it; 0 uses every hardware thread.
+ */
+void mortonKeys30(std::span<const CVector3f> points, const CAABox& bounds, std::span<uint32_t> keys,
+                  unsigned threadCount = 1);
+void mortonKeys63(std::span<const CVector3f> points, const CAABox& bounds, std::span<uint64_t> keys,
+                  unsigned threadCount = 1);
+void hilbertKeys63(std::span<const CVector3f> points, const CAABox& bounds, std::span<uint64_t> keys,
+                   unsigned threadCount = 1);
+
+/**
+ * Stable LSD radix sort of keys, applying the same permutation to values (typically primitive indices), one byte
+ * per pass. Passes in which every key has the same byte are skipped, so keys that only use their low bits cost
+ * fewer passes. Large inputs are histogrammed and scattered by up to threadCount workers; 0 uses every hardware
+ * thread.
+ */
+void radixSortByKey(std::span<uint32_t> keys, std::span<uint32_t> values, unsigned threadCount = 1);
+void radixSortByKey(std::span<uint64_t> keys, std::span<uint32_t> values, unsigned threadCount = 1);
+} // namespace zeus
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "zeus/CAABox.hpp"
+#include "zeus/COBBox.hpp"
+#include "zeus/CSphere.hpp"
+#include "zeus/CTransform.hpp"
+
+namespace zeus {
+struct SSweepHit {
+  bool hit = false;
+  /* Fraction of the motion done at first contact, in [0, 1]; 0 when the shapes start out overlapping */
+  float time = 0.f;
+  /* Unit contact normal on the static (or second) shape, pointing toward the moving (or first) one */
+  CVector3f normal;
+};
+
+/**
+ * Continuous collision queries: the first shape moves by delta over the query, the second stays put. For two
+ * moving shapes pass the first one's motion relative to the second's.
+ * Shapes that already overlap hit at time 0, with the normal of the shallowest way out.
+ */
+[[nodiscard]] SSweepHit sweepSphereAABox(const CSphere& sphere, const CVector3f& delta, const CAABox& box);
+[[nodiscard]] SSweepHit sweepAABoxAABox(const CAABox& moving, const CVector3f& delta, const CAABox& box);
+
+/**
+ * Earliest hit against a list of candidate boxes, with index set to the box hit. Candidates are screened against
+ * their boxes grown by the moving shape a register of boxes at a time; only those the screen can't settle run the
+ * exact scalar test.
+ */
+[[nodiscard]] SSweepHit sweepSphereAABoxes(const CSphere& sphere, const CVector3f& delta, const CAABoxSoA& boxes,
+                                           uint32_t& index);
+[[nodiscard]] SSweepHit sweepAABoxAABoxes(const CAABox& moving, const CVector3f& delta, const CAABoxSoA& boxes,
+                                          uint32_t& index);
+
+/**
+ * Time of impact of two oriented boxes by conservative advancement. Each box moves from its own transform to the
+ * given end transform, with the origin interpolated linearly and the rotation by slerp; bases must be
+ * orthonormal. Steps are sized by the GJK distance over a bound on how fast any point can close it, so no contact
+ * is skipped, and the search stops once the boxes come within a small fraction of their size.
+ */
+[[nodiscard]] SSweepHit timeOfImpact(const COBBox& a, const CTransform& aEnd, const COBBox& b, const CTransform& bEnd);
+
+/* Earliest time of impact of a moving box against static candidates, with index set to the box hit */
+[[nodiscard]] SSweepHit timeOfImpact(const COBBox& a, const CTransform& aEnd, std::span<const COBBox> boxes,
+                                     uint32_t& index);
+} // namespace zeus
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+#include "zeus/CAABox.hpp"
+#include "zeus/CMRay.hpp"
+#include "zeus/CVector3f.hpp"
+
+namespace zeus {
+struct STriangleHit {
+  uint32_t index = 0;
+  /* Along ray.dir from ray.start for ray casts, Euclidean for closest point queries */
+  float distance = 0.f;
+  /* Weights of the three corners, for baryToWorld */
+  CVector3f bary;
+  CVector3f point;
+};
+
+/**
+ * Möller–Trumbore ray segment against the triangle p0 p1 p2, from either side. Distances follow CRaySlab: along
+ * ray.dir from ray.start, clipped to [0, ray.length]. Rays in the plane of the triangle and degenerate triangles
+ * never hit. On a hit writes the distance and the corner weights of the hit point.
+ */
+[[nodiscard]] bool rayTriangleIntersect(const CMRay& ray, const CVector3f& p0, const CVector3f& p1,
+                                        const CVector3f& p2, float& distOut, CVector3f& baryOut);
+
+/* Separating axis test of the triangle against the box: the box faces, the triangle plane and the nine edge pairs */
+[[nodiscard]] bool triangleAABoxIntersect(const CVector3f& p0, const CVector3f& p1, const CVector3f& p2,
+                                          const CAABox& box);
+
+/* Point of the triangle closest to point, with its corner weights written to baryOut when given */
+[[nodiscard]] CVector3f closestPointOnTriangle(const CVector3f& point, const CVector3f& p0, const CVector3f& p1,
+                                               const CVector3f& p2, CVector3f* baryOut = nullptr);
+} // namespace zeus
@@ -1311,6 +1311,9 @@ public:
   // loads [simd.load]
   void copy_from(const simd_data<simd>& __buffer) { __s_.__copy_from(__buffer); }
 
+  // unaligned loads of packed value_type
+  void copy_from(const _Tp* __buffer, element_aligned_tag) { __s_.__copy_from(__buffer); }
+
 #if 0
   // stores [simd.store]
   template <class _Up, class _Flags>
@@ -1326,6 +1329,13 @@ public:
   // stores [simd.store]
   void copy_to(simd_data<simd>& __buffer) const { __s_.__copy_to(__buffer); }
 
+  // unaligned stores of packed value_type
+  void copy_to(_Tp* __buffer, element_aligned_tag) const { __s_.__copy_to(__buffer); }
+
+  // partial loads and stores of the first __count lanes, for loop tails; lanes past __count load as zero
+  void copy_from(const _Tp* __buffer, size_t __count, element_aligned_tag) { __s_.__copy_from(__buffer, __count); }
+  void copy_to(_Tp* __buffer, size_t __count, element_aligned_tag) const { __s_.__copy_to(__buffer, __count); }
+
   constexpr void set(_Tp a, _Tp b, _Tp c = {}, _Tp d = {}) { __s_.__set4(a, b, c, d); }
   constexpr void broadcast(_Tp rv) { __s_.__broadcast(rv); }
 
@@ -1455,6 +1465,8 @@ public:
   friend simd_mask operator<=(const simd_type&, const simd_type&);
   friend simd_mask operator>(const simd_type&, const simd_type&);
   friend simd_mask operator<(const simd_type&, const simd_type&);
+
+  constexpr decltype(auto) native() const { return __s_.__native(); }
 };
 
 template <class _Simd>
@@ -1477,7 +1489,7 @@ private:
   friend class simd_mask;
 
 public:
-  constexpr __simd_storage(_Tp __rv) : __storage_{__rv, __rv, __rv, __rv} {}
+  constexpr __simd_storage(_Tp __rv) { __storage_.fill(__rv); }
   constexpr __simd_storage(_Tp a, _Tp b, _Tp c, _Tp d) : __storage_{a, b, c, d} {}
 
   constexpr _Tp __get(size_t __index) const noexcept { return __storage_[__index]; };
@@ -1515,6 +1527,18 @@ public:
     std::copy(__storage_.begin(), __storage_.end(), __buffer.begin());
   }
 
+  constexpr void __copy_from(const _Tp* __buffer) noexcept {
+    std::copy(__buffer, __buffer + __num_element, __storage_.begin());
+  }
+  constexpr void __copy_to(_Tp* __buffer) const noexcept { std::copy(__storage_.begin(), __storage_.end(), __buffer); }
+  constexpr void __copy_from(const _Tp* __buffer, size_t __count) noexcept {
+    std::copy_n(__buffer, __count, __storage_.begin());
+    std::fill(__storage_.begin() + __count, __storage_.end(), _Tp{});
+  }
+  constexpr void __copy_to(_Tp* __buffer, size_t __count) const noexcept {
+    std::copy_n(__storage_.begin(), __count, __buffer);
+  }
+
   constexpr __simd_storage() = default;
   template <class _Up, int __Unum_element>
   constexpr explicit __simd_storage(
@@ -1531,6 +1555,7 @@ class __simd_mask_storage<_Tp, __simd_abi<_StorageKind::_Array, __num_element>>
 public:
   [[nodiscard]] constexpr bool __get(size_t __index) const noexcept { return __storage_.test(__index); }
   constexpr void __set(size_t __index, bool __val) noexcept { __storage_.set(__index, __val); }
+  [[nodiscard]] constexpr const std::bitset<__num_element>& __native() const noexcept { return __storage_; }
 };
 
 } // namespace zeus::_simd
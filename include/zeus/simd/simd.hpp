@@ -11,7 +11,9 @@ using namespace std;
 #if _M_IX86_FP >= 1 || _M_X64
 #define __SSE__ 1
 #endif
-#if __AVX__
+#if __AVX512F__
+#include "simd_avx512.hpp"
+#elif __AVX__
 #include "simd_avx.hpp"
 #elif __SSE__
 #include "simd_sse.hpp"
@@ -32,6 +34,8 @@ struct zeus_native<double> {
 } // namespace zeus::_simd::simd_abi
 #include "simd_none.hpp"
 #endif
+#include "simd_fixed.hpp"
+#include "simd_math.hpp"
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
 #endif
@@ -42,4 +46,16 @@ template <typename T>
 using simd_values = _simd::simd_data<simd<T>>;
 using simd_floats = simd_values<float>;
 using simd_doubles = simd_values<double>;
+/* simd<float, fixed_size<8>> is one register on AVX and simd<float, fixed_size<16>> one on AVX-512; elsewhere they
+ * fall back to arrays with the same interface */
+template <typename T, int N>
+using fixed_size_simd = _simd::fixed_size_simd<T, N>;
+
+/* One register of Simd from data, which needs no particular alignment */
+template <typename Simd = simd<float>>
+Simd loadLanes(const typename Simd::value_type* data) {
+  Simd ret;
+  ret.copy_from(data, _simd::element_aligned);
+  return ret;
+}
 } // namespace zeus
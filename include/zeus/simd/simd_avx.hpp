@@ -171,6 +171,202 @@ inline __simd_storage<float, m128_abi>::__simd_storage(const __simd_storage<doub
   __storage_ = _mm256_cvtpd_ps(other.__storage_);
 }
 
+// __m256 ABI; simd<float, fixed_size<8>> is backed by a single register on AVX
+using m256_abi = simd_abi::fixed_size<8>;
+
+// Lane masks for partial loads and stores: the first __count lanes of the 8 starting at __lanes + 8 - __count are set
+inline __m256i __m256_tail_mask(size_t __count) noexcept {
+  alignas(32) static constexpr int32_t __lanes[16] = {-1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(__lanes + 8 - __count));
+}
+
+// __m256 storage for AVX
+template <>
+class __simd_storage<float, m256_abi> {
+public:
+  using storage_type = __m256;
+  storage_type __storage_{};
+  [[nodiscard]] inline float __get(size_t __index) const noexcept {
+#if _MSC_VER && !defined(__clang__)
+    alignas(32) std::array<float, 8> avx_data;
+    _mm256_store_ps(avx_data.data(), __storage_);
+    return avx_data[__index];
+#else
+    return __storage_[__index];
+#endif
+  }
+  inline void __set(size_t __index, float __val) noexcept {
+#if _MSC_VER && !defined(__clang__)
+    alignas(32) std::array<float, 8> avx_data;
+    _mm256_store_ps(avx_data.data(), __storage_);
+    avx_data[__index] = __val;
+    __storage_ = _mm256_load_ps(avx_data.data());
+#else
+    __storage_[__index] = __val;
+#endif
+  }
+  constexpr __simd_storage(float a, float b, float c, float d) : __storage_{a, b, c, d, 0.f, 0.f, 0.f, 0.f} {}
+  constexpr void __set4(float a, float b, float c, float d) noexcept {
+    __storage_ = storage_type{a, b, c, d, 0.f, 0.f, 0.f, 0.f};
+  }
+  constexpr explicit __simd_storage(float rv) : __storage_{rv, rv, rv, rv, rv, rv, rv, rv} {}
+  inline void __broadcast(float __val) noexcept { __storage_ = _mm256_set1_ps(__val); }
+
+  inline void __copy_from(const simd_data<simd<float, m256_abi>>& __buffer) noexcept {
+    __storage_ = _mm256_loadu_ps(__buffer.data());
+  }
+
+  inline void __copy_to(simd_data<simd<float, m256_abi>>& __buffer) const noexcept {
+    _mm256_storeu_ps(__buffer.data(), __storage_);
+  }
+
+  inline void __copy_from(const float* __buffer) noexcept { __storage_ = _mm256_loadu_ps(__buffer); }
+
+  inline void __copy_to(float* __buffer) const noexcept { _mm256_storeu_ps(__buffer, __storage_); }
+
+  inline void __copy_from(const float* __buffer, size_t __count) noexcept {
+    __storage_ = _mm256_maskload_ps(__buffer, __m256_tail_mask(__count));
+  }
+
+  inline void __copy_to(float* __buffer, size_t __count) const noexcept {
+    _mm256_maskstore_ps(__buffer, __m256_tail_mask(__count), __storage_);
+  }
+
+  __simd_storage() = default;
+  constexpr explicit __simd_storage(const storage_type& s) : __storage_(s) {}
+  [[nodiscard]] constexpr const storage_type& __native() const { return __storage_; }
+};
+// __m256 mask storage for AVX
+template <>
+class __simd_mask_storage<float, m256_abi> : public __simd_storage<float, m256_abi> {
+public:
+  [[nodiscard]] inline bool __get(size_t __index) const noexcept {
+    return ((_mm256_movemask_ps(__storage_) >> __index) & 1) != 0;
+  }
+  inline void __set(size_t __index, bool __val) noexcept {
+    alignas(32) uint32_t avx_data[8];
+    _mm256_store_ps(reinterpret_cast<float*>(avx_data), __storage_);
+    avx_data[__index] = __val ? UINT32_MAX : 0;
+    __storage_ = _mm256_load_ps(reinterpret_cast<float*>(avx_data));
+  }
+};
+
+template <>
+inline simd<float, m256_abi> simd<float, m256_abi>::operator-() const {
+  return _mm256_xor_ps(__s_.__storage_, _mm256_set1_ps(-0.f));
+}
+
+inline simd<float, m256_abi> operator+(const simd<float, m256_abi>& a, const simd<float, m256_abi>& b) {
+  return _mm256_add_ps(a.__s_.__storage_, b.__s_.__storage_);
+}
+
+inline simd<float, m256_abi> operator-(const simd<float, m256_abi>& a, const simd<float, m256_abi>& b) {
+  return _mm256_sub_ps(a.__s_.__storage_, b.__s_.__storage_);
+}
+
+inline simd<float, m256_abi> operator*(const simd<float, m256_abi>& a, const simd<float, m256_abi>& b) {
+  return _mm256_mul_ps(a.__s_.__storage_, b.__s_.__storage_);
+}
+
+inline simd<float, m256_abi> operator/(const simd<float, m256_abi>& a, const simd<float, m256_abi>& b) {
+  return _mm256_div_ps(a.__s_.__storage_, b.__s_.__storage_);
+}
+
+inline simd<float, m256_abi>& operator+=(simd<float, m256_abi>& a, const simd<float, m256_abi>& b) {
+  a.__s_.__storage_ = _mm256_add_ps(a.__s_.__storage_, b.__s_.__storage_);
+  return a;
+}
+
+inline simd<float, m256_abi>& operator-=(simd<float, m256_abi>& a, const simd<float, m256_abi>& b) {
+  a.__s_.__storage_ = _mm256_sub_ps(a.__s_.__storage_, b.__s_.__storage_);
+  return a;
+}
+
+inline simd<float, m256_abi>& operator*=(simd<float, m256_abi>& a, const simd<float, m256_abi>& b) {
+  a.__s_.__storage_ = _mm256_mul_ps(a.__s_.__storage_, b.__s_.__storage_);
+  return a;
+}
+
+inline simd<float, m256_abi>& operator/=(simd<float, m256_abi>& a, const simd<float, m256_abi>& b) {
+  a.__s_.__storage_ = _mm256_div_ps(a.__s_.__storage_, b.__s_.__storage_);
+  return a;
+}
+
+inline simd<float, m256_abi>::mask_type operator==(const simd<float, m256_abi>& a, const simd<float, m256_abi>& b) {
+  simd<float, m256_abi>::mask_type ret;
+  ret.__s_.__storage_ = _mm256_cmp_ps(a.__s_.__storage_, b.__s_.__storage_, _CMP_EQ_OQ);
+  return ret;
+}
+
+inline simd<float, m256_abi>::mask_type operator!=(const simd<float, m256_abi>& a, const simd<float, m256_abi>& b) {
+  simd<float, m256_abi>::mask_type ret;
+  ret.__s_.__storage_ = _mm256_cmp_ps(a.__s_.__storage_, b.__s_.__storage_, _CMP_NEQ_UQ);
+  return ret;
+}
+
+inline simd<float, m256_abi>::mask_type operator>=(const simd<float, m256_abi>& a, const simd<float, m256_abi>& b) {
+  simd<float, m256_abi>::mask_type ret;
+  ret.__s_.__storage_ = _mm256_cmp_ps(a.__s_.__storage_, b.__s_.__storage_, _CMP_GE_OQ);
+  return ret;
+}
+
+inline simd<float, m256_abi>::mask_type operator<=(const simd<float, m256_abi>& a, const simd<float, m256_abi>& b) {
+  simd<float, m256_abi>::mask_type ret;
+  ret.__s_.__storage_ = _mm256_cmp_ps(a.__s_.__storage_, b.__s_.__storage_, _CMP_LE_OQ);
+  return ret;
+}
+
+inline simd<float, m256_abi>::mask_type operator>(const simd<float, m256_abi>& a, const simd<float, m256_abi>& b) {
+  simd<float, m256_abi>::mask_type ret;
+  ret.__s_.__storage_ = _mm256_cmp_ps(a.__s_.__storage_, b.__s_.__storage_, _CMP_GT_OQ);
+  return ret;
+}
+
+inline simd<float, m256_abi>::mask_type operator<(const simd<float, m256_abi>& a, const simd<float, m256_abi>& b) {
+  simd<float, m256_abi>::mask_type ret;
+  ret.__s_.__storage_ = _mm256_cmp_ps(a.__s_.__storage_, b.__s_.__storage_, _CMP_LT_OQ);
+  return ret;
+}
+
+inline simd<float, m256_abi> min(const simd<float, m256_abi>& a, const simd<float, m256_abi>& b) {
+  return _mm256_min_ps(a.native(), b.native());
+}
+
+inline simd<float, m256_abi> max(const simd<float, m256_abi>& a, const simd<float, m256_abi>& b) {
+  return _mm256_max_ps(a.native(), b.native());
+}
+
+// Packs the lanes of a mask into the low bits of an int (lane 0 -> bit 0)
+inline int bitmask(const simd<float, m256_abi>::mask_type& m) { return _mm256_movemask_ps(m.native()); }
+
+inline simd<float, m256_abi> sqrt(const simd<float, m256_abi>& a) { return _mm256_sqrt_ps(a.native()); }
+
+// Approximate 1 / sqrt(a), relative error at most 1.5 * 2^-12
+inline simd<float, m256_abi> rsqrt_estimate(const simd<float, m256_abi>& a) { return _mm256_rsqrt_ps(a.native()); }
+
+// Lanes of a where m is set and lanes of b elsewhere
+inline simd<float, m256_abi> select(const simd<float, m256_abi>::mask_type& m, const simd<float, m256_abi>& a,
+                                    const simd<float, m256_abi>& b) {
+  return _mm256_blendv_ps(b.native(), a.native(), m.native());
+}
+
+// The integer halves of these need AVX2, so each 128-bit half goes through the SSE versions
+inline simd<float, m256_abi> ldexp(const simd<float, m256_abi>& x, const simd<float, m256_abi>& n) {
+  const simd<float, m128_abi> lo = ldexp(simd<float, m128_abi>(_mm256_castps256_ps128(x.native())),
+                                         simd<float, m128_abi>(_mm256_castps256_ps128(n.native())));
+  const simd<float, m128_abi> hi = ldexp(simd<float, m128_abi>(_mm256_extractf128_ps(x.native(), 1)),
+                                         simd<float, m128_abi>(_mm256_extractf128_ps(n.native(), 1)));
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(lo.native()), hi.native(), 1);
+}
+
+inline simd<float, m256_abi> frexp(const simd<float, m256_abi>& x, simd<float, m256_abi>& exponent) {
+  simd<float, m128_abi> loExponent, hiExponent;
+  const simd<float, m128_abi> lo = frexp(simd<float, m128_abi>(_mm256_castps256_ps128(x.native())), loExponent);
+  const simd<float, m128_abi> hi = frexp(simd<float, m128_abi>(_mm256_extractf128_ps(x.native(), 1)), hiExponent);
+  exponent = _mm256_insertf128_ps(_mm256_castps128_ps256(loExponent.native()), hiExponent.native(), 1);
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(lo.native()), hi.native(), 1);
+}
+
 namespace simd_abi {
 template <>
 struct zeus_native<double> {
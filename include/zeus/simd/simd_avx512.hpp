@@ -0,0 +1,183 @@
+#pragma once
+#ifndef _ZEUS_SIMD_INCLUDED
+#error simd_avx512.hpp must not be included directly. Include simd.hpp instead.
+#endif
+#include "simd_avx.hpp"
+#include <immintrin.h>
+namespace zeus::_simd {
+// __m512 ABI; simd<float, fixed_size<16>> is backed by a single register on AVX-512
+using m512_abi = simd_abi::fixed_size<16>;
+
+inline __mmask16 __m512_tail_mask(size_t __count) noexcept { return __mmask16((1u << __count) - 1); }
+
+// __m512 storage for AVX-512
+template <>
+class __simd_storage<float, m512_abi> {
+public:
+  using storage_type = __m512;
+  storage_type __storage_{};
+  [[nodiscard]] inline float __get(size_t __index) const noexcept {
+#if _MSC_VER && !defined(__clang__)
+    alignas(64) std::array<float, 16> avx_data;
+    _mm512_store_ps(avx_data.data(), __storage_);
+    return avx_data[__index];
+#else
+    return __storage_[__index];
+#endif
+  }
+  inline void __set(size_t __index, float __val) noexcept {
+    __storage_ = _mm512_mask_broadcastss_ps(__storage_, __mmask16(1u << __index), _mm_set_ss(__val));
+  }
+  constexpr __simd_storage(float a, float b, float c, float d)
+  : __storage_{a, b, c, d, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f} {}
+  inline void __set4(float a, float b, float c, float d) noexcept {
+    __storage_ = _mm512_insertf32x4(_mm512_setzero_ps(), _mm_setr_ps(a, b, c, d), 0);
+  }
+  constexpr explicit __simd_storage(float rv)
+  : __storage_{rv, rv, rv, rv, rv, rv, rv, rv, rv, rv, rv, rv, rv, rv, rv, rv} {}
+  inline void __broadcast(float __val) noexcept { __storage_ = _mm512_set1_ps(__val); }
+
+  inline void __copy_from(const simd_data<simd<float, m512_abi>>& __buffer) noexcept {
+    __storage_ = _mm512_loadu_ps(__buffer.data());
+  }
+
+  inline void __copy_to(simd_data<simd<float, m512_abi>>& __buffer) const noexcept {
+    _mm512_storeu_ps(__buffer.data(), __storage_);
+  }
+
+  inline void __copy_from(const float* __buffer) noexcept { __storage_ = _mm512_loadu_ps(__buffer); }
+
+  inline void __copy_to(float* __buffer) const noexcept { _mm512_storeu_ps(__buffer, __storage_); }
+
+  inline void __copy_from(const float* __buffer, size_t __count) noexcept {
+    __storage_ = _mm512_maskz_loadu_ps(__m512_tail_mask(__count), __buffer);
+  }
+
+  inline void __copy_to(float* __buffer, size_t __count) const noexcept {
+    _mm512_mask_storeu_ps(__buffer, __m512_tail_mask(__count), __storage_);
+  }
+
+  __simd_storage() = default;
+  constexpr explicit __simd_storage(const storage_type& s) : __storage_(s) {}
+  [[nodiscard]] constexpr const storage_type& __native() const { return __storage_; }
+};
+// __mmask16 mask storage for AVX-512, one bit per lane
+template <>
+class __simd_mask_storage<float, m512_abi> {
+public:
+  __mmask16 __storage_ = 0;
+  [[nodiscard]] constexpr bool __get(size_t __index) const noexcept { return ((__storage_ >> __index) & 1) != 0; }
+  constexpr void __set(size_t __index, bool __val) noexcept {
+    __storage_ = __mmask16(__val ? __storage_ | (1u << __index) : __storage_ & ~(1u << __index));
+  }
+  [[nodiscard]] constexpr __mmask16 __native() const noexcept { return __storage_; }
+};
+
+template <>
+inline simd<float, m512_abi> simd<float, m512_abi>::operator-() const {
+  return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(__s_.__storage_), _mm512_set1_epi32(INT32_MIN)));
+}
+
+inline simd<float, m512_abi> operator+(const simd<float, m512_abi>& a, const simd<float, m512_abi>& b) {
+  return _mm512_add_ps(a.__s_.__storage_, b.__s_.__storage_);
+}
+
+inline simd<float, m512_abi> operator-(const simd<float, m512_abi>& a, const simd<float, m512_abi>& b) {
+  return _mm512_sub_ps(a.__s_.__storage_, b.__s_.__storage_);
+}
+
+inline simd<float, m512_abi> operator*(const simd<float, m512_abi>& a, const simd<float, m512_abi>& b) {
+  return _mm512_mul_ps(a.__s_.__storage_, b.__s_.__storage_);
+}
+
+inline simd<float, m512_abi> operator/(const simd<float, m512_abi>& a, const simd<float, m512_abi>& b) {
+  return _mm512_div_ps(a.__s_.__storage_, b.__s_.__storage_);
+}
+
+inline simd<float, m512_abi>& operator+=(simd<float, m512_abi>& a, const simd<float, m512_abi>& b) {
+  a.__s_.__storage_ = _mm512_add_ps(a.__s_.__storage_, b.__s_.__storage_);
+  return a;
+}
+
+inline simd<float, m512_abi>& operator-=(simd<float, m512_abi>& a, const simd<float, m512_abi>& b) {
+  a.__s_.__storage_ = _mm512_sub_ps(a.__s_.__storage_, b.__s_.__storage_);
+  return a;
+}
+
+inline simd<float, m512_abi>& operator*=(simd<float, m512_abi>& a, const simd<float, m512_abi>& b) {
+  a.__s_.__storage_ = _mm512_mul_ps(a.__s_.__storage_, b.__s_.__storage_);
+  return a;
+}
+
+inline simd<float, m512_abi>& operator/=(simd<float, m512_abi>& a, const simd<float, m512_abi>& b) {
+  a.__s_.__storage_ = _mm512_div_ps(a.__s_.__storage_, b.__s_.__storage_);
+  return a;
+}
+
+inline simd<float, m512_abi>::mask_type operator==(const simd<float, m512_abi>& a, const simd<float, m512_abi>& b) {
+  simd<float, m512_abi>::mask_type ret;
+  ret.__s_.__storage_ = _mm512_cmp_ps_mask(a.__s_.__storage_, b.__s_.__storage_, _CMP_EQ_OQ);
+  return ret;
+}
+
+inline simd<float, m512_abi>::mask_type operator!=(const simd<float, m512_abi>& a, const simd<float, m512_abi>& b) {
+  simd<float, m512_abi>::mask_type ret;
+  ret.__s_.__storage_ = _mm512_cmp_ps_mask(a.__s_.__storage_, b.__s_.__storage_, _CMP_NEQ_UQ);
+  return ret;
+}
+
+inline simd<float, m512_abi>::mask_type operator>=(const simd<float, m512_abi>& a, const simd<float, m512_abi>& b) {
+  simd<float, m512_abi>::mask_type ret;
+  ret.__s_.__storage_ = _mm512_cmp_ps_mask(a.__s_.__storage_, b.__s_.__storage_, _CMP_GE_OQ);
+  return ret;
+}
+
+inline simd<float, m512_abi>::mask_type operator<=(const simd<float, m512_abi>& a, const simd<float, m512_abi>& b) {
+  simd<float, m512_abi>::mask_type ret;
+  ret.__s_.__storage_ = _mm512_cmp_ps_mask(a.__s_.__storage_, b.__s_.__storage_, _CMP_LE_OQ);
+  return ret;
+}
+
+inline simd<float, m512_abi>::mask_type operator>(const simd<float, m512_abi>& a, const simd<float, m512_abi>& b) {
+  simd<float, m512_abi>::mask_type ret;
+  ret.__s_.__storage_ = _mm512_cmp_ps_mask(a.__s_.__storage_, b.__s_.__storage_, _CMP_GT_OQ);
+  return ret;
+}
+
+inline simd<float, m512_abi>::mask_type operator<(const simd<float, m512_abi>& a, const simd<float, m512_abi>& b) {
+  simd<float, m512_abi>::mask_type ret;
+  ret.__s_.__storage_ = _mm512_cmp_ps_mask(a.__s_.__storage_, b.__s_.__storage_, _CMP_LT_OQ);
+  return ret;
+}
+
+inline simd<float, m512_abi> min(const simd<float, m512_abi>& a, const simd<float, m512_abi>& b) {
+  return _mm512_min_ps(a.native(), b.native());
+}
+
+inline simd<float, m512_abi> max(const simd<float, m512_abi>& a, const simd<float, m512_abi>& b) {
+  return _mm512_max_ps(a.native(), b.native());
+}
+
+// Packs the lanes of a mask into the low bits of an int (lane 0 -> bit 0)
+inline int bitmask(const simd<float, m512_abi>::mask_type& m) { return int(m.native()); }
+
+inline simd<float, m512_abi> sqrt(const simd<float, m512_abi>& a) { return _mm512_sqrt_ps(a.native()); }
+
+// Approximate 1 / sqrt(a), relative error at most 2^-14
+inline simd<float, m512_abi> rsqrt_estimate(const simd<float, m512_abi>& a) { return _mm512_rsqrt14_ps(a.native()); }
+
+// Lanes of a where m is set and lanes of b elsewhere
+inline simd<float, m512_abi> select(const simd<float, m512_abi>::mask_type& m, const simd<float, m512_abi>& a,
+                                    const simd<float, m512_abi>& b) {
+  return _mm512_mask_blend_ps(m.native(), b.native(), a.native());
+}
+
+inline simd<float, m512_abi> ldexp(const simd<float, m512_abi>& x, const simd<float, m512_abi>& n) {
+  return _mm512_scalef_ps(x.native(), n.native());
+}
+
+inline simd<float, m512_abi> frexp(const simd<float, m512_abi>& x, simd<float, m512_abi>& exponent) {
+  exponent = _mm512_add_ps(_mm512_getexp_ps(x.native()), _mm512_set1_ps(1.f));
+  return _mm512_getmant_ps(x.native(), _MM_MANT_NORM_p5_1, _MM_MANT_SIGN_src);
+}
+} // namespace zeus::_simd
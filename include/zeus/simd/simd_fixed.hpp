@@ -0,0 +1,160 @@
+#pragma once
+#ifndef _ZEUS_SIMD_INCLUDED
+#error simd_fixed.hpp must not be included directly. Include simd.hpp instead.
+#endif
+#include <algorithm>
+#include <cmath>
+#include <functional>
+namespace zeus::_simd {
+// Lane-by-lane fallbacks for fixed_size float ABIs that no register of the target covers
+
+template <int _Np, class _Op>
+inline simd<float, simd_abi::fixed_size<_Np>> __fixed_apply(const simd<float, simd_abi::fixed_size<_Np>>& a,
+                                                             const simd<float, simd_abi::fixed_size<_Np>>& b,
+                                                             _Op __op) {
+  simd<float, simd_abi::fixed_size<_Np>> ret;
+  for (size_t __i = 0; __i < _Np; ++__i)
+    ret[__i] = __op(a[__i], b[__i]);
+  return ret;
+}
+
+template <int _Np, class _Op>
+inline simd_mask<float, simd_abi::fixed_size<_Np>> __fixed_compare(const simd<float, simd_abi::fixed_size<_Np>>& a,
+                                                                    const simd<float, simd_abi::fixed_size<_Np>>& b,
+                                                                    _Op __op) {
+  simd_mask<float, simd_abi::fixed_size<_Np>> ret;
+  for (size_t __i = 0; __i < _Np; ++__i)
+    ret[__i] = __op(a[__i], b[__i]);
+  return ret;
+}
+
+template <int _Np>
+inline simd<float, simd_abi::fixed_size<_Np>> min(const simd<float, simd_abi::fixed_size<_Np>>& a,
+                                                   const simd<float, simd_abi::fixed_size<_Np>>& b) {
+  return __fixed_apply(a, b, [](float x, float y) { return std::min(x, y); });
+}
+
+template <int _Np>
+inline simd<float, simd_abi::fixed_size<_Np>> max(const simd<float, simd_abi::fixed_size<_Np>>& a,
+                                                   const simd<float, simd_abi::fixed_size<_Np>>& b) {
+  return __fixed_apply(a, b, [](float x, float y) { return std::max(x, y); });
+}
+
+// Packs the lanes of a mask into the low bits of an int (lane 0 -> bit 0)
+template <int _Np>
+inline int bitmask(const simd_mask<float, simd_abi::fixed_size<_Np>>& m) {
+  return int(m.native().to_ulong());
+}
+
+template <int _Np>
+inline simd<float, simd_abi::fixed_size<_Np>> sqrt(const simd<float, simd_abi::fixed_size<_Np>>& a) {
+  return __fixed_apply(a, a, [](float x, float) { return std::sqrt(x); });
+}
+
+template <int _Np>
+inline simd<float, simd_abi::fixed_size<_Np>> rsqrt_estimate(const simd<float, simd_abi::fixed_size<_Np>>& a) {
+  return __fixed_apply(a, a, [](float x, float) { return 1.f / std::sqrt(x); });
+}
+
+// Lanes of a where m is set and lanes of b elsewhere
+template <int _Np>
+inline simd<float, simd_abi::fixed_size<_Np>> select(const simd_mask<float, simd_abi::fixed_size<_Np>>& m,
+                                                     const simd<float, simd_abi::fixed_size<_Np>>& a,
+                                                     const simd<float, simd_abi::fixed_size<_Np>>& b) {
+  simd<float, simd_abi::fixed_size<_Np>> ret;
+  for (size_t __i = 0; __i < _Np; ++__i)
+    ret[__i] = m[__i] ? a[__i] : b[__i];
+  return ret;
+}
+
+// x * 2^n for integral n in [-126, 127]
+template <int _Np>
+inline simd<float, simd_abi::fixed_size<_Np>> ldexp(const simd<float, simd_abi::fixed_size<_Np>>& x,
+                                                    const simd<float, simd_abi::fixed_size<_Np>>& n) {
+  return __fixed_apply(x, n, [](float v, float e) { return std::ldexp(v, int(e)); });
+}
+
+// Splits normal, finite x into a mantissa in [0.5, 1) carrying the sign of x and an exponent, as std::frexp does
+template <int _Np>
+inline simd<float, simd_abi::fixed_size<_Np>> frexp(const simd<float, simd_abi::fixed_size<_Np>>& x,
+                                                    simd<float, simd_abi::fixed_size<_Np>>& exponent) {
+  simd<float, simd_abi::fixed_size<_Np>> ret;
+  for (size_t __i = 0; __i < _Np; ++__i) {
+    int __e = 0;
+    ret[__i] = std::frexp(x[__i], &__e);
+    exponent[__i] = float(__e);
+  }
+  return ret;
+}
+
+// The operators are declared as non-template friends of simd, so each size needs its own definitions
+#define _ZEUS_SIMD_FIXED_FLOAT_OPERATORS(_Np)                                                                        \
+  template <>                                                                                                        \
+  inline simd<float, simd_abi::fixed_size<_Np>> simd<float, simd_abi::fixed_size<_Np>>::operator-() const {          \
+    return __fixed_apply(*this, *this, [](float x, float) { return -x; });                                          \
+  }                                                                                                                  \
+  inline simd<float, simd_abi::fixed_size<_Np>> operator+(const simd<float, simd_abi::fixed_size<_Np>>& a,          \
+                                                          const simd<float, simd_abi::fixed_size<_Np>>& b) {        \
+    return __fixed_apply(a, b, std::plus<float>());                                                                 \
+  }                                                                                                                  \
+  inline simd<float, simd_abi::fixed_size<_Np>> operator-(const simd<float, simd_abi::fixed_size<_Np>>& a,          \
+                                                          const simd<float, simd_abi::fixed_size<_Np>>& b) {        \
+    return __fixed_apply(a, b, std::minus<float>());                                                                \
+  }                                                                                                                  \
+  inline simd<float, simd_abi::fixed_size<_Np>> operator*(const simd<float, simd_abi::fixed_size<_Np>>& a,          \
+                                                          const simd<float, simd_abi::fixed_size<_Np>>& b) {        \
+    return __fixed_apply(a, b, std::multiplies<float>());                                                           \
+  }                                                                                                                  \
+  inline simd<float, simd_abi::fixed_size<_Np>> operator/(const simd<float, simd_abi::fixed_size<_Np>>& a,          \
+                                                          const simd<float, simd_abi::fixed_size<_Np>>& b) {        \
+    return __fixed_apply(a, b, std::divides<float>());                                                              \
+  }                                                                                                                  \
+  inline simd<float, simd_abi::fixed_size<_Np>>& operator+=(simd<float, simd_abi::fixed_size<_Np>>& a,              \
+                                                            const simd<float, simd_abi::fixed_size<_Np>>& b) {      \
+    return a = a + b;                                                                                                \
+  }                                                                                                                  \
+  inline simd<float, simd_abi::fixed_size<_Np>>& operator-=(simd<float, simd_abi::fixed_size<_Np>>& a,              \
+                                                            const simd<float, simd_abi::fixed_size<_Np>>& b) {      \
+    return a = a - b;                                                                                                \
+  }                                                                                                                  \
+  inline simd<float, simd_abi::fixed_size<_Np>>& operator*=(simd<float, simd_abi::fixed_size<_Np>>& a,              \
+                                                            const simd<float, simd_abi::fixed_size<_Np>>& b) {      \
+    return a = a * b;                                                                                                \
+  }                                                                                                                  \
+  inline simd<float, simd_abi::fixed_size<_Np>>& operator/=(simd<float, simd_abi::fixed_size<_Np>>& a,              \
+                                                            const simd<float, simd_abi::fixed_size<_Np>>& b) {      \
+    return a = a / b;                                                                                                \
+  }                                                                                                                  \
+  inline simd_mask<float, simd_abi::fixed_size<_Np>> operator==(const simd<float, simd_abi::fixed_size<_Np>>& a,    \
+                                                                const simd<float, simd_abi::fixed_size<_Np>>& b) {  \
+    return __fixed_compare(a, b, std::equal_to<float>());                                                           \
+  }                                                                                                                  \
+  inline simd_mask<float, simd_abi::fixed_size<_Np>> operator!=(const simd<float, simd_abi::fixed_size<_Np>>& a,    \
+                                                                const simd<float, simd_abi::fixed_size<_Np>>& b) {  \
+    return __fixed_compare(a, b, std::not_equal_to<float>());                                                       \
+  }                                                                                                                  \
+  inline simd_mask<float, simd_abi::fixed_size<_Np>> operator>=(const simd<float, simd_abi::fixed_size<_Np>>& a,    \
+                                                                const simd<float, simd_abi::fixed_size<_Np>>& b) {  \
+    return __fixed_compare(a, b, std::greater_equal<float>());                                                      \
+  }                                                                                                                  \
+  inline simd_mask<float, simd_abi::fixed_size<_Np>> operator<=(const simd<float, simd_abi::fixed_size<_Np>>& a,    \
+                                                                const simd<float, simd_abi::fixed_size<_Np>>& b) {  \
+    return __fixed_compare(a, b, std::less_equal<float>());                                                         \
+  }                                                                                                                  \
+  inline simd_mask<float, simd_abi::fixed_size<_Np>> operator>(const simd<float, simd_abi::fixed_size<_Np>>& a,     \
+                                                               const simd<float, simd_abi::fixed_size<_Np>>& b) {   \
+    return __fixed_compare(a, b, std::greater<float>());                                                            \
+  }                                                                                                                  \
+  inline simd_mask<float, simd_abi::fixed_size<_Np>> operator<(const simd<float, simd_abi::fixed_size<_Np>>& a,     \
+                                                               const simd<float, simd_abi::fixed_size<_Np>>& b) {   \
+    return __fixed_compare(a, b, std::less<float>());                                                               \
+  }
+
+#if !__AVX__
+_ZEUS_SIMD_FIXED_FLOAT_OPERATORS(8)
+#endif
+#if !__AVX512F__
+_ZEUS_SIMD_FIXED_FLOAT_OPERATORS(16)
+#endif
+#undef _ZEUS_SIMD_FIXED_FLOAT_OPERATORS
+} // namespace zeus::_simd
@@ -0,0 +1,237 @@
+#pragma once
+#ifndef _ZEUS_SIMD_INCLUDED
+#error simd_math.hpp must not be included directly. Include simd.hpp instead.
+#endif
+#include <array>
+#include <cfloat>
+#include <limits>
+namespace zeus {
+/* Fast keeps absolute errors below 1e-4 with shorter polynomials; Precise stays within a few ULP of libm */
+enum class EMathPrecision { Fast, Precise };
+} // namespace zeus
+
+namespace zeus::_simd {
+// <cmath> counterparts for float simd of every ABI, built on the arithmetic, min/max, sqrt, rsqrt_estimate, select,
+// ldexp and frexp that each backend provides. The Precise polynomials are Cephes' single precision ones.
+
+inline constexpr float __pi = 3.14159265358979323846f;
+inline constexpr float __pi_2 = 1.57079632679489661923f;
+inline constexpr float __pi_4 = 0.78539816339744830962f;
+
+// Horner evaluation with coefficients ordered from the highest power down
+template <class _Abi, size_t _Np>
+inline simd<float, _Abi> __horner(const simd<float, _Abi>& x, const std::array<float, _Np>& coefficients) {
+  simd<float, _Abi> ret(coefficients[0]);
+  for (size_t __i = 1; __i < _Np; ++__i)
+    ret = ret * x + simd<float, _Abi>(coefficients[__i]);
+  return ret;
+}
+
+// Round to nearest for |x| < 2^22: adding 1.5 * 2^23 leaves no fraction bits
+template <class _Abi>
+inline simd<float, _Abi> __round(const simd<float, _Abi>& x) {
+  const simd<float, _Abi> magic(12582912.f);
+  return (x + magic) - magic;
+}
+
+template <class _Abi>
+inline simd<float, _Abi> __abs(const simd<float, _Abi>& x) {
+  return max(x, -x);
+}
+
+// sin and cos of x together, sharing the range reduction; accurate for |x| <= 8192
+template <EMathPrecision _Precision = EMathPrecision::Precise, class _Abi>
+inline void sincos(const simd<float, _Abi>& x, simd<float, _Abi>& s, simd<float, _Abi>& c) {
+  using V = simd<float, _Abi>;
+  // x - q * pi/2 with pi/2 split into three parts whose products with q are exact
+  const V q = __round(x * V(2.f / __pi));
+  const V r = ((x - q * V(1.5703125f)) - q * V(4.837512969970703125e-4f)) - q * V(7.54978995489188216e-8f);
+  const V r2 = r * r;
+
+  V sinR, cosR;
+  if constexpr (_Precision == EMathPrecision::Fast) {
+    sinR = r + r * r2 * __horner(r2, std::array{0.0081529920f, -0.16662834f});
+    cosR = V(1.f) + r2 * __horner(r2, std::array{0.040488937f, -0.49977631f});
+  } else {
+    sinR = r + r * r2 * __horner(r2, std::array{-1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f});
+    cosR = (V(1.f) - r2 * V(0.5f)) +
+           r2 * r2 * __horner(r2, std::array{2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f});
+  }
+
+  // Quadrants 1 and 3 swap sin and cos; sin is negated in quadrants 2 and 3, cos in 1 and 2
+  const V quadrant = q - V(4.f) * __round(q * V(0.25f) - V(0.375f));
+  const V fromTwo = quadrant - V(2.f);
+  const V fromMiddle = quadrant - V(1.5f);
+  const auto swapped = fromTwo * fromTwo == V(1.f);
+  s = select(swapped, cosR, sinR);
+  c = select(swapped, sinR, cosR);
+  s = select(quadrant >= V(2.f), -s, s);
+  c = select(fromMiddle * fromMiddle < V(1.f), -c, c);
+}
+
+template <EMathPrecision _Precision = EMathPrecision::Precise, class _Abi>
+inline simd<float, _Abi> sin(const simd<float, _Abi>& x) {
+  simd<float, _Abi> s, c;
+  sincos<_Precision>(x, s, c);
+  return s;
+}
+
+template <EMathPrecision _Precision = EMathPrecision::Precise, class _Abi>
+inline simd<float, _Abi> cos(const simd<float, _Abi>& x) {
+  simd<float, _Abi> s, c;
+  sincos<_Precision>(x, s, c);
+  return c;
+}
+
+// atan of t in [0, 1]
+template <EMathPrecision _Precision, class _Abi>
+inline simd<float, _Abi> __atan_unit(const simd<float, _Abi>& t) {
+  using V = simd<float, _Abi>;
+  if constexpr (_Precision == EMathPrecision::Fast) {
+    // Abramowitz and Stegun 4.4.48, |error| <= 1e-5
+    return t * __horner(t * t, std::array{0.0208351f, -0.0851330f, 0.1801410f, -0.3302995f, 0.9998660f});
+  } else {
+    // Above tan(pi/8), atan(t) = pi/4 + atan((t - 1) / (t + 1))
+    const auto reduced = t > V(0.4142135623730950f);
+    const V u = select(reduced, (t - V(1.f)) / (t + V(1.f)), t);
+    const V u2 = u * u;
+    const V p = u + u * u2 * __horner(u2, std::array{8.05374449538e-2f, -1.38776856032e-1f, 1.99777106478e-1f,
+                                                     -3.33329491539e-1f});
+    return select(reduced, V(__pi_4) + p, p);
+  }
+}
+
+template <EMathPrecision _Precision = EMathPrecision::Precise, class _Abi>
+inline simd<float, _Abi> atan(const simd<float, _Abi>& x) {
+  using V = simd<float, _Abi>;
+  const V a = __abs(x);
+  const auto inverted = a > V(1.f);
+  V ret = __atan_unit<_Precision>(select(inverted, V(1.f) / a, a));
+  ret = select(inverted, V(__pi_2) - ret, ret);
+  return select(x < V(0.f), -ret, ret);
+}
+
+// atan2(0, 0) is 0, and atan2(0, -0) is 0 rather than pi
+template <EMathPrecision _Precision = EMathPrecision::Precise, class _Abi>
+inline simd<float, _Abi> atan2(const simd<float, _Abi>& y, const simd<float, _Abi>& x) {
+  using V = simd<float, _Abi>;
+  const V ax = __abs(x);
+  const V ay = __abs(y);
+  V ret = __atan_unit<_Precision>(min(ax, ay) / max(max(ax, ay), V(FLT_MIN)));
+  ret = select(ay > ax, V(__pi_2) - ret, ret);
+  ret = select(x < V(0.f), V(__pi) - ret, ret);
+  return select(y < V(0.f), -ret, ret);
+}
+
+// asin(s) for |s| <= 0.5, given z = s^2
+template <EMathPrecision _Precision, class _Abi>
+inline simd<float, _Abi> __asin_poly(const simd<float, _Abi>& s, const simd<float, _Abi>& z) {
+  if constexpr (_Precision == EMathPrecision::Fast)
+    return s + s * z * __horner(z, std::array{0.095892081f, 0.16470950f});
+  else
+    return s + s * z * __horner(z, std::array{4.2163199048e-2f, 2.4181311049e-2f, 4.5470025998e-2f, 7.4953002686e-2f,
+                                              1.6666752422e-1f});
+}
+
+// Arguments outside [-1, 1] give NaN
+template <EMathPrecision _Precision = EMathPrecision::Precise, class _Abi>
+inline simd<float, _Abi> asin(const simd<float, _Abi>& x) {
+  using V = simd<float, _Abi>;
+  // Above 0.5, asin(a) = pi/2 - 2 * asin(sqrt((1 - a) / 2))
+  const V a = __abs(x);
+  const auto reduced = a > V(0.5f);
+  const V z = select(reduced, V(0.5f) * (V(1.f) - a), a * a);
+  const V p = __asin_poly<_Precision>(select(reduced, sqrt(z), a), z);
+  const V ret = select(reduced, V(__pi_2) - (p + p), p);
+  return select(x < V(0.f), -ret, ret);
+}
+
+template <EMathPrecision _Precision = EMathPrecision::Precise, class _Abi>
+inline simd<float, _Abi> acos(const simd<float, _Abi>& x) {
+  using V = simd<float, _Abi>;
+  // Above 0.5, acos(a) = 2 * asin(sqrt((1 - a) / 2)), which keeps precision near 1
+  const V a = __abs(x);
+  const auto reduced = a > V(0.5f);
+  const V z = select(reduced, V(0.5f) * (V(1.f) - a), x * x);
+  const V p = __asin_poly<_Precision>(select(reduced, sqrt(z), x), z);
+  const V twice = p + p;
+  return select(reduced, select(x < V(0.f), V(__pi) - twice, twice), V(__pi_2) - p);
+}
+
+// Overflows to infinity above about 88.72 and underflows to 0 below about -87.34, where results would be denormal
+template <EMathPrecision _Precision = EMathPrecision::Precise, class _Abi>
+inline simd<float, _Abi> exp(const simd<float, _Abi>& x) {
+  using V = simd<float, _Abi>;
+  constexpr float MaxLog = 88.72283905f;
+  constexpr float MinLog = -87.33654475f;
+  const V clamped = min(max(x, V(MinLog)), V(MaxLog));
+  // x = n * ln 2 + r with ln 2 split in two so that n * 0.693359375 is exact
+  V n = __round(clamped * V(1.44269504088896340736f));
+  const V r = (clamped - n * V(0.693359375f)) - n * V(-2.12194440e-4f);
+
+  V p;
+  if constexpr (_Precision == EMathPrecision::Fast) {
+    p = __horner(r, std::array{1.f / 24.f, 1.f / 6.f, 0.5f, 1.f, 1.f});
+  } else {
+    p = __horner(r, std::array{1.9875691500e-4f, 1.3981999507e-3f, 8.3334519073e-3f, 4.1665795894e-2f,
+                               1.6666665459e-1f, 5.0000001201e-1f}) *
+            (r * r) +
+        r + V(1.f);
+  }
+
+  // 2^128 is not a float, so the top of the range is scaled as 2 * 2^127
+  const auto top = n > V(127.f);
+  p = select(top, p + p, p);
+  n = select(top, n - V(1.f), n);
+  const V ret = select(x > V(MaxLog), V(std::numeric_limits<float>::infinity()), ldexp(p, n));
+  return select(x < V(MinLog), V(0.f), ret);
+}
+
+// Natural log; 0 gives -infinity and negative arguments NaN
+template <EMathPrecision _Precision = EMathPrecision::Precise, class _Abi>
+inline simd<float, _Abi> log(const simd<float, _Abi>& x) {
+  using V = simd<float, _Abi>;
+  // Denormals are scaled by 2^23 first, since frexp only splits normal floats
+  const auto denormal = x < V(FLT_MIN);
+  V e;
+  V m = frexp(select(denormal, x * V(8388608.f), x), e);
+  e = select(denormal, e - V(23.f), e);
+  // Keep the mantissa in [sqrt(1/2), sqrt(2)) and take log(1 + m) of the remainder
+  const auto low = m < V(0.70710678118654752440f);
+  e = select(low, e - V(1.f), e);
+  m = select(low, m + m, m) - V(1.f);
+
+  V ret;
+  if constexpr (_Precision == EMathPrecision::Fast) {
+    // log(1 + m) = 2 * atanh(m / (2 + m))
+    const V s = m / (V(2.f) + m);
+    ret = V(2.f) * s * __horner(s * s, std::array{0.2f, 1.f / 3.f, 1.f}) + e * V(0.69314718055994530942f);
+  } else {
+    const V z = m * m;
+    V y = m * z *
+          __horner(m, std::array{7.0376836292e-2f, -1.1514610310e-1f, 1.1676998740e-1f, -1.2420140846e-1f,
+                                 1.4249322787e-1f, -1.6668057665e-1f, 2.0000714765e-1f, -2.4999993993e-1f,
+                                 3.3333331174e-1f});
+    y = (y + e * V(-2.12194440e-4f)) - V(0.5f) * z;
+    ret = (m + y) + e * V(0.693359375f);
+  }
+
+  const V inf(std::numeric_limits<float>::infinity());
+  ret = select(x == V(0.f), -inf, ret);
+  ret = select(x == inf, inf, ret);
+  return select(x < V(0.f), V(std::numeric_limits<float>::quiet_NaN()), ret);
+}
+
+/**
+ * 1 / sqrt(x) for positive finite x, from the backend's estimate refined by one Newton-Raphson step. The relative
+ * error stays below 5e-7, a few ULP, at a fraction of the cost of sqrt and a divide. Estimates differ between CPU
+ * vendors, so results may too in the last bits.
+ */
+template <class _Abi>
+inline simd<float, _Abi> rsqrt(const simd<float, _Abi>& x) {
+  using V = simd<float, _Abi>;
+  const V e = rsqrt_estimate(x);
+  // (x * e) * e rather than x * (e * e), which would underflow for x near FLT_MAX
+  return e * (V(1.5f) - V(0.5f) * (x * e) * e);
+}
+} // namespace zeus::_simd
@@ -44,6 +44,22 @@ public:
 
   inline void __copy_to(simd_data<simd<float, m128_abi>>& __buffer) const noexcept { vst1q_f32(__buffer.data(), __storage_); }
 
+  inline void __copy_from(const float* __buffer) noexcept { __storage_ = vld1q_f32(__buffer); }
+
+  inline void __copy_to(float* __buffer) const noexcept { vst1q_f32(__buffer, __storage_); }
+
+  inline void __copy_from(const float* __buffer, size_t __count) noexcept {
+    std::array<float, 4> neon_data{};
+    std::copy_n(__buffer, __count, neon_data.begin());
+    __storage_ = vld1q_f32(neon_data.data());
+  }
+
+  inline void __copy_to(float* __buffer, size_t __count) const noexcept {
+    std::array<float, 4> neon_data;
+    vst1q_f32(neon_data.data(), __storage_);
+    std::copy_n(neon_data.begin(), __count, __buffer);
+  }
+
   constexpr __simd_storage() = default;
   explicit __simd_storage(const __simd_storage<double, m128d_abi>& other);
 
@@ -141,6 +157,48 @@ inline simd<float, m128_abi>::mask_type operator<(const simd<float, m128_abi>& a
   return ret;
 }
 
+inline simd<float, m128_abi> min(const simd<float, m128_abi>& a, const simd<float, m128_abi>& b) {
+  return vminq_f32(a.native(), b.native());
+}
+
+inline simd<float, m128_abi> max(const simd<float, m128_abi>& a, const simd<float, m128_abi>& b) {
+  return vmaxq_f32(a.native(), b.native());
+}
+
+// Packs the lanes of a mask into the low bits of an int (lane 0 -> bit 0)
+inline int bitmask(const simd<float, m128_abi>::mask_type& m) {
+  static const uint32x4_t weights = {1, 2, 4, 8};
+  return int(vaddvq_u32(vandq_u32(vreinterpretq_u32_f32(m.native()), weights)));
+}
+
+inline simd<float, m128_abi> sqrt(const simd<float, m128_abi>& a) { return vsqrtq_f32(a.native()); }
+
+// Approximate 1 / sqrt(a); vrsqrteq_f32 alone gives 8 bits, so one vrsqrtsq_f32 step brings it to about 16
+inline simd<float, m128_abi> rsqrt_estimate(const simd<float, m128_abi>& a) {
+  const float32x4_t e = vrsqrteq_f32(a.native());
+  return vmulq_f32(e, vrsqrtsq_f32(vmulq_f32(a.native(), e), e));
+}
+
+// Lanes of a where m is set and lanes of b elsewhere
+inline simd<float, m128_abi> select(const simd<float, m128_abi>::mask_type& m, const simd<float, m128_abi>& a,
+                                    const simd<float, m128_abi>& b) {
+  return vbslq_f32(vreinterpretq_u32_f32(m.native()), a.native(), b.native());
+}
+
+// x * 2^n for integral n in [-126, 127]
+inline simd<float, m128_abi> ldexp(const simd<float, m128_abi>& x, const simd<float, m128_abi>& n) {
+  const int32x4_t bits = vshlq_n_s32(vaddq_s32(vcvtnq_s32_f32(n.native()), vdupq_n_s32(127)), 23);
+  return vmulq_f32(x.native(), vreinterpretq_f32_s32(bits));
+}
+
+// Splits normal, finite x into a mantissa in [0.5, 1) carrying the sign of x and an exponent, as std::frexp does
+inline simd<float, m128_abi> frexp(const simd<float, m128_abi>& x, simd<float, m128_abi>& exponent) {
+  const uint32x4_t bits = vreinterpretq_u32_f32(x.native());
+  const int32x4_t biased = vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(bits, 23), vdupq_n_u32(0xFF)));
+  exponent = vcvtq_f32_s32(vsubq_s32(biased, vdupq_n_s32(126)));
+  return vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x807FFFFF)), vdupq_n_u32(0x3F000000)));
+}
+
 // __m128d storage for NEON
 template <>
 class __simd_storage<double, m128d_abi> {
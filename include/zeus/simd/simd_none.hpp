@@ -2,6 +2,8 @@
 #ifndef _ZEUS_SIMD_INCLUDED
 #error simd_none.hpp must not be included directly. Include simd.hpp instead.
 #endif
+#include <algorithm>
+#include <cmath>
 namespace zeus::_simd {
 using m128_abi = __simd_abi<_StorageKind::_Array, 4>;
 using m128d_abi = __simd_abi<_StorageKind::_Array, 4>;
@@ -114,6 +116,49 @@ inline simd<float, m128_abi>::mask_type operator<(const simd<float, m128_abi>& a
   return ret;
 }
 
+inline simd<float, m128_abi> min(const simd<float, m128_abi>& a, const simd<float, m128_abi>& b) {
+  return {std::min(a[0], b[0]), std::min(a[1], b[1]), std::min(a[2], b[2]), std::min(a[3], b[3])};
+}
+
+inline simd<float, m128_abi> max(const simd<float, m128_abi>& a, const simd<float, m128_abi>& b) {
+  return {std::max(a[0], b[0]), std::max(a[1], b[1]), std::max(a[2], b[2]), std::max(a[3], b[3])};
+}
+
+// Packs the lanes of a mask into the low bits of an int (lane 0 -> bit 0)
+inline int bitmask(const simd<float, m128_abi>::mask_type& m) { return int(m.native().to_ulong()); }
+
+inline simd<float, m128_abi> sqrt(const simd<float, m128_abi>& a) {
+  return {std::sqrt(a[0]), std::sqrt(a[1]), std::sqrt(a[2]), std::sqrt(a[3])};
+}
+
+// Exact here, as there is no estimate instruction to use
+inline simd<float, m128_abi> rsqrt_estimate(const simd<float, m128_abi>& a) {
+  return {1.f / std::sqrt(a[0]), 1.f / std::sqrt(a[1]), 1.f / std::sqrt(a[2]), 1.f / std::sqrt(a[3])};
+}
+
+// Lanes of a where m is set and lanes of b elsewhere
+inline simd<float, m128_abi> select(const simd<float, m128_abi>::mask_type& m, const simd<float, m128_abi>& a,
+                                    const simd<float, m128_abi>& b) {
+  return {m[0] ? a[0] : b[0], m[1] ? a[1] : b[1], m[2] ? a[2] : b[2], m[3] ? a[3] : b[3]};
+}
+
+// x * 2^n for integral n in [-126, 127]
+inline simd<float, m128_abi> ldexp(const simd<float, m128_abi>& x, const simd<float, m128_abi>& n) {
+  return {std::ldexp(x[0], int(n[0])), std::ldexp(x[1], int(n[1])), std::ldexp(x[2], int(n[2])),
+          std::ldexp(x[3], int(n[3]))};
+}
+
+// Splits normal, finite x into a mantissa in [0.5, 1) carrying the sign of x and an exponent, as std::frexp does
+inline simd<float, m128_abi> frexp(const simd<float, m128_abi>& x, simd<float, m128_abi>& exponent) {
+  simd<float, m128_abi> ret;
+  for (size_t i = 0; i < 4; ++i) {
+    int e = 0;
+    ret[i] = std::frexp(x[i], &e);
+    exponent[i] = float(e);
+  }
+  return ret;
+}
+
 // m128d ABI
 template <>
 inline simd<double, m128d_abi> simd<double, m128d_abi>::operator-() const {
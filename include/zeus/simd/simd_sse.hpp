@@ -101,6 +101,22 @@ public:
     _mm_store_ps(__buffer.data(), __storage_);
   }
 
+  inline void __copy_from(const float* __buffer) noexcept { __storage_ = _mm_loadu_ps(__buffer); }
+
+  inline void __copy_to(float* __buffer) const noexcept { _mm_storeu_ps(__buffer, __storage_); }
+
+  inline void __copy_from(const float* __buffer, size_t __count) noexcept {
+    alignas(16) std::array<float, 4> sse_data{};
+    std::copy_n(__buffer, __count, sse_data.begin());
+    __storage_ = _mm_load_ps(sse_data.data());
+  }
+
+  inline void __copy_to(float* __buffer, size_t __count) const noexcept {
+    alignas(16) std::array<float, 4> sse_data;
+    _mm_store_ps(sse_data.data(), __storage_);
+    std::copy_n(sse_data.begin(), __count, __buffer);
+  }
+
   __simd_storage() = default;
   explicit inline __simd_storage(const __simd_storage<double, m128d_abi>& other);
 #ifdef __AVX__
@@ -204,6 +220,43 @@ inline simd<float, m128_abi>::mask_type operator<(const simd<float, m128_abi>& a
   return ret;
 }
 
+inline simd<float, m128_abi> min(const simd<float, m128_abi>& a, const simd<float, m128_abi>& b) {
+  return _mm_min_ps(a.native(), b.native());
+}
+
+inline simd<float, m128_abi> max(const simd<float, m128_abi>& a, const simd<float, m128_abi>& b) {
+  return _mm_max_ps(a.native(), b.native());
+}
+
+// Packs the lanes of a mask into the low bits of an int (lane 0 -> bit 0)
+inline int bitmask(const simd<float, m128_abi>::mask_type& m) { return _mm_movemask_ps(m.native()); }
+
+inline simd<float, m128_abi> sqrt(const simd<float, m128_abi>& a) { return _mm_sqrt_ps(a.native()); }
+
+// Approximate 1 / sqrt(a), relative error at most 1.5 * 2^-12
+inline simd<float, m128_abi> rsqrt_estimate(const simd<float, m128_abi>& a) { return _mm_rsqrt_ps(a.native()); }
+
+// Lanes of a where m is set and lanes of b elsewhere
+inline simd<float, m128_abi> select(const simd<float, m128_abi>::mask_type& m, const simd<float, m128_abi>& a,
+                                    const simd<float, m128_abi>& b) {
+  return _mm_or_ps(_mm_and_ps(m.native(), a.native()), _mm_andnot_ps(m.native(), b.native()));
+}
+
+// x * 2^n for integral n in [-126, 127]
+inline simd<float, m128_abi> ldexp(const simd<float, m128_abi>& x, const simd<float, m128_abi>& n) {
+  const __m128i bits = _mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(n.native()), _mm_set1_epi32(127)), 23);
+  return _mm_mul_ps(x.native(), _mm_castsi128_ps(bits));
+}
+
+// Splits normal, finite x into a mantissa in [0.5, 1) carrying the sign of x and an exponent, as std::frexp does
+inline simd<float, m128_abi> frexp(const simd<float, m128_abi>& x, simd<float, m128_abi>& exponent) {
+  const __m128i bits = _mm_castps_si128(x.native());
+  const __m128i biased = _mm_and_si128(_mm_srli_epi32(bits, 23), _mm_set1_epi32(0xFF));
+  exponent = _mm_cvtepi32_ps(_mm_sub_epi32(biased, _mm_set1_epi32(126)));
+  return _mm_castsi128_ps(
+      _mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(int(0x807FFFFF))), _mm_set1_epi32(0x3F000000)));
+}
+
 // __m128d storage for SSE2+
 template <>
 class __simd_storage<double, m128d_abi> {
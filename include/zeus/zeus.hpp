@@ -1,21 +1,35 @@
 #pragma once
 
+#include "zeus/BatchBlend.hpp"
+#include "zeus/BatchTransform.hpp"
 #include "zeus/CAABox.hpp"
 #include "zeus/CAxisAngle.hpp"
+#include "zeus/CBVH.hpp"
 #include "zeus/CColor.hpp"
+#include "zeus/CConvexShape.hpp"
+#include "zeus/CDynamicAABBTree.hpp"
 #include "zeus/CFrustum.hpp"
+#include "zeus/CKdTree.hpp"
 #include "zeus/CLineSeg.hpp"
+#include "zeus/CLooseOctree.hpp"
+#include "zeus/CLooseQuadtree.hpp"
 #include "zeus/CMRay.hpp"
 #include "zeus/CMatrix3f.hpp"
 #include "zeus/CMatrix4f.hpp"
 #include "zeus/COBBox.hpp"
+#include "zeus/CPackedQuaternion.hpp"
+#include "zeus/CPackedVector3f.hpp"
 #include "zeus/CPlane.hpp"
 #include "zeus/CProjection.hpp"
 #include "zeus/CQuaternion.hpp"
+#include "zeus/CRaySlab.hpp"
 #include "zeus/CRectangle.hpp"
 #include "zeus/CRelAngle.hpp"
+#include "zeus/CSpatialHashGrid.hpp"
 #include "zeus/CSphere.hpp"
+#include "zeus/CSweepAndPrune.hpp"
 #include "zeus/CTransform.hpp"
+#include "zeus/CTriangleSoup.hpp"
 #include "zeus/CUnitVector.hpp"
 #include "zeus/CVector2f.hpp"
 #include "zeus/CVector2i.hpp"
@@ -24,5 +38,9 @@
 #include "zeus/CVector3d.hpp"
 #include "zeus/CVector4f.hpp"
 #include "zeus/CVector4d.hpp"
+#include "zeus/ConvexQuery.hpp"
 #include "zeus/Global.hpp"
 #include "zeus/Math.hpp"
+#include "zeus/SpatialKey.hpp"
+#include "zeus/SweptQuery.hpp"
+#include "zeus/TriangleQuery.hpp"
@@ -0,0 +1,446 @@
+#include "zeus/BatchBlend.hpp"
+
+#include <array>
+#include <cassert>
+
+#include "ParallelSplit.hpp"
+
+#if ZEUS_KERNEL_AVX2 || ZEUS_KERNEL_AVX512
+#include <immintrin.h>
+#endif
+
+namespace zeus {
+namespace {
+using BlendSimd = simd<float>;
+constexpr size_t BlendLanes = BlendSimd::size();
+/* Each worker of a threaded split gets at least this many quaternions */
+constexpr size_t ParallelBlendCount = 1 << 13;
+/* Quaternion chunks keep to whole 16-quaternion blocks so only the last one has a tail */
+constexpr size_t BlendBlockSize = 16;
+
+/* Abramowitz and Stegun 4.4.46: acos(x) = sqrt(1 - x) * p(x) on [0, 1], |error| <= 2e-8 */
+constexpr std::array<float, 8> AcosCoefficients{-0.0012624911f, 0.0066700901f, -0.0170881256f, 0.0308918810f,
+                                                -0.0501743046f, 0.0889789874f, -0.2145988016f, 1.5707963050f};
+/* Abramowitz and Stegun 4.3.97: sin(x) = x * p(x^2) on [0, pi/2], |error| <= 2e-9 */
+constexpr std::array<float, 6> SinCoefficients{-0.0000000239f, 0.0000027526f, -0.0001984090f,
+                                               0.0083333315f,  -0.1666666664f, 1.f};
+/* Kapoulkine's fit of the t correction that makes nlerp track slerp's constant angular velocity */
+constexpr std::array<float, 4> NlerpCoefficientsA{-1.43519f, 3.55645f, -3.2452f, 1.0904f};
+constexpr std::array<float, 3> NlerpCoefficientsB{0.215638f, -1.06021f, 0.848013f};
+/* Below this angle both slerp weights are computed at this angle instead, where they are already 1 - t and t */
+constexpr float MinSlerpAngle = 1e-3f;
+
+/* Horner evaluation with coefficients ordered from the highest power down */
+template <size_t N>
+BlendSimd horner(const BlendSimd& x, const std::array<float, N>& coefficients) {
+  BlendSimd ret(coefficients[0]);
+  for (size_t i = 1; i < N; ++i)
+    ret = ret * x + BlendSimd(coefficients[i]);
+  return ret;
+}
+
+BlendSimd sinQuadrant(const BlendSimd& x) { return x * horner(x * x, SinCoefficients); }
+
+struct QuatLanes {
+  BlendSimd w, x, y, z;
+
+  QuatLanes(const BlendSimd& w, const BlendSimd& x, const BlendSimd& y, const BlendSimd& z)
+  : w(w), x(x), y(y), z(z) {}
+  /* Quaternions [i, i + BlendLanes) of q */
+  QuatLanes(const CQuaternionSoA& q, size_t i)
+  : w(loadLanes(&q.w[i])), x(loadLanes(&q.x[i])), y(loadLanes(&q.y[i])), z(loadLanes(&q.z[i])) {}
+  /* The last count < BlendLanes quaternions of q, from i */
+  QuatLanes(const CQuaternionSoA& q, size_t i, size_t count) {
+    w.copy_from(&q.w[i], count, _simd::element_aligned);
+    x.copy_from(&q.x[i], count, _simd::element_aligned);
+    y.copy_from(&q.y[i], count, _simd::element_aligned);
+    z.copy_from(&q.z[i], count, _simd::element_aligned);
+  }
+
+  void store(const CQuaternionSoAOut& q, size_t i) const {
+    w.copy_to(&q.w[i], _simd::element_aligned);
+    x.copy_to(&q.x[i], _simd::element_aligned);
+    y.copy_to(&q.y[i], _simd::element_aligned);
+    z.copy_to(&q.z[i], _simd::element_aligned);
+  }
+  void store(const CQuaternionSoAOut& q, size_t i, size_t count) const {
+    w.copy_to(&q.w[i], count, _simd::element_aligned);
+    x.copy_to(&q.x[i], count, _simd::element_aligned);
+    y.copy_to(&q.y[i], count, _simd::element_aligned);
+    z.copy_to(&q.z[i], count, _simd::element_aligned);
+  }
+};
+
+/* Flips b onto a's hemisphere and returns the cosine of the angle between them, which is then non-negative */
+BlendSimd shortestArc(const QuatLanes& a, QuatLanes& b) {
+  const BlendSimd d = a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+  const BlendSimd sign = select(d < BlendSimd(0.f), BlendSimd(-1.f), BlendSimd(1.f));
+  b.w *= sign;
+  b.x *= sign;
+  b.y *= sign;
+  b.z *= sign;
+  return d * sign;
+}
+
+/* Scales each quaternion to unit length with the refined rsqrt estimate */
+QuatLanes normalizeLanes(const QuatLanes& q) {
+  const BlendSimd invLength = rsqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+  return {q.w * invLength, q.x * invLength, q.y * invLength, q.z * invLength};
+}
+
+QuatLanes weightedSum(const QuatLanes& a, const BlendSimd& wa, const QuatLanes& b, const BlendSimd& wb) {
+  return {a.w * wa + b.w * wb, a.x * wa + b.x * wb, a.y * wa + b.y * wb, a.z * wa + b.z * wb};
+}
+
+QuatLanes slerpLanes(const QuatLanes& a, QuatLanes b, const BlendSimd& t) {
+  const BlendSimd d = min(shortestArc(a, b), BlendSimd(1.f));
+  const BlendSimd theta = max(sqrt(BlendSimd(1.f) - d) * horner(d, AcosCoefficients), BlendSimd(MinSlerpAngle));
+  const BlendSimd invSin = BlendSimd(1.f) / sinQuadrant(theta);
+  return weightedSum(a, sinQuadrant((BlendSimd(1.f) - t) * theta) * invSin, b, sinQuadrant(t * theta) * invSin);
+}
+
+QuatLanes nlerpLanes(const QuatLanes& a, QuatLanes b, const BlendSimd& t) {
+  const BlendSimd d = shortestArc(a, b);
+  const BlendSimd ka = horner(d, NlerpCoefficientsA);
+  const BlendSimd kb = horner(d, NlerpCoefficientsB);
+  const BlendSimd centered = t - BlendSimd(0.5f);
+  const BlendSimd k = ka * centered * centered + kb;
+  const BlendSimd ct = t + t * centered * (t - BlendSimd(1.f)) * k;
+
+  /* b is on a's hemisphere, so the sum is at least 1/sqrt(2) long */
+  return normalizeLanes(weightedSum(a, BlendSimd(1.f) - ct, b, ct));
+}
+
+/* Either one t per quaternion or, when perElement is null, uniform for all of them */
+struct BlendFactors {
+  const float* perElement = nullptr;
+  float uniform = 0.f;
+
+  BlendSimd load(size_t i) const {
+    const BlendSimd t = perElement == nullptr ? BlendSimd(uniform) : loadLanes(perElement + i);
+    return min(max(t, BlendSimd(0.f)), BlendSimd(1.f));
+  }
+  BlendSimd load(size_t i, size_t count) const {
+    BlendSimd t(uniform);
+    if (perElement != nullptr)
+      t.copy_from(perElement + i, count, _simd::element_aligned);
+    return min(max(t, BlendSimd(0.f)), BlendSimd(1.f));
+  }
+};
+
+using BlendLanesFn = QuatLanes (*)(const QuatLanes&, QuatLanes, const BlendSimd&);
+
+template <BlendLanesFn Blend>
+void blendKernel(const CQuaternionSoA& a, const CQuaternionSoA& b, const BlendFactors& t,
+                 const CQuaternionSoAOut& out, size_t begin, size_t end) {
+  size_t i = begin;
+  for (; i + BlendLanes <= end; i += BlendLanes)
+    Blend(QuatLanes(a, i), QuatLanes(b, i), t.load(i)).store(out, i);
+  if (i < end) {
+    const size_t rem = end - i;
+    Blend(QuatLanes(a, i, rem), QuatLanes(b, i, rem), t.load(i, rem)).store(out, i, rem);
+  }
+}
+
+void normalizeKernel(const CQuaternionSoA& in, const CQuaternionSoAOut& out, size_t begin, size_t end) {
+  size_t i = begin;
+  for (; i + BlendLanes <= end; i += BlendLanes)
+    normalizeLanes(QuatLanes(in, i)).store(out, i);
+  if (i < end)
+    normalizeLanes(QuatLanes(in, i, end - i)).store(out, i, end - i);
+}
+
+#if ZEUS_KERNEL_AVX2
+/* 8-wide versions of the lane math above, in the same operation order, which leave the tails to the kernels above */
+struct Quat8 {
+  __m256 w, x, y, z;
+};
+
+ZEUS_TARGET_AVX2 Quat8 loadQuat8(const CQuaternionSoA& q, size_t i) {
+  return {_mm256_loadu_ps(&q.w[i]), _mm256_loadu_ps(&q.x[i]), _mm256_loadu_ps(&q.y[i]), _mm256_loadu_ps(&q.z[i])};
+}
+
+ZEUS_TARGET_AVX2 void storeQuat8(const Quat8& q, const CQuaternionSoAOut& out, size_t i) {
+  _mm256_storeu_ps(&out.w[i], q.w);
+  _mm256_storeu_ps(&out.x[i], q.x);
+  _mm256_storeu_ps(&out.y[i], q.y);
+  _mm256_storeu_ps(&out.z[i], q.z);
+}
+
+template <size_t N>
+ZEUS_TARGET_AVX2 __m256 horner8(__m256 x, const std::array<float, N>& coefficients) {
+  __m256 ret = _mm256_set1_ps(coefficients[0]);
+  for (size_t i = 1; i < N; ++i)
+    ret = _mm256_add_ps(_mm256_mul_ps(ret, x), _mm256_set1_ps(coefficients[i]));
+  return ret;
+}
+
+ZEUS_TARGET_AVX2 __m256 sinQuadrant8(__m256 x) {
+  return _mm256_mul_ps(x, horner8(_mm256_mul_ps(x, x), SinCoefficients));
+}
+
+ZEUS_TARGET_AVX2 __m256 dot8(const Quat8& a, const Quat8& b) {
+  return _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a.w, b.w), _mm256_mul_ps(a.x, b.x)),
+                                     _mm256_mul_ps(a.y, b.y)),
+                       _mm256_mul_ps(a.z, b.z));
+}
+
+ZEUS_TARGET_AVX2 Quat8 scale8(const Quat8& q, __m256 s) {
+  return {_mm256_mul_ps(q.w, s), _mm256_mul_ps(q.x, s), _mm256_mul_ps(q.y, s), _mm256_mul_ps(q.z, s)};
+}
+
+ZEUS_TARGET_AVX2 __m256 shortestArc8(const Quat8& a, Quat8& b) {
+  const __m256 d = dot8(a, b);
+  const __m256 sign =
+      _mm256_blendv_ps(_mm256_set1_ps(1.f), _mm256_set1_ps(-1.f), _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_LT_OQ));
+  b = scale8(b, sign);
+  return _mm256_mul_ps(d, sign);
+}
+
+ZEUS_TARGET_AVX2 Quat8 normalize8(const Quat8& q) {
+  const __m256 lengthSq = dot8(q, q);
+  const __m256 e = _mm256_rsqrt_ps(lengthSq);
+  const __m256 half = _mm256_mul_ps(_mm256_set1_ps(0.5f), _mm256_mul_ps(lengthSq, e));
+  const __m256 refine = _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(half, e));
+  return scale8(q, _mm256_mul_ps(e, refine));
+}
+
+ZEUS_TARGET_AVX2 Quat8 weightedSum8(const Quat8& a, __m256 wa, const Quat8& b, __m256 wb) {
+  return {_mm256_add_ps(_mm256_mul_ps(a.w, wa), _mm256_mul_ps(b.w, wb)),
+          _mm256_add_ps(_mm256_mul_ps(a.x, wa), _mm256_mul_ps(b.x, wb)),
+          _mm256_add_ps(_mm256_mul_ps(a.y, wa), _mm256_mul_ps(b.y, wb)),
+          _mm256_add_ps(_mm256_mul_ps(a.z, wa), _mm256_mul_ps(b.z, wb))};
+}
+
+ZEUS_TARGET_AVX2 Quat8 slerp8(const Quat8& a, Quat8 b, __m256 t) {
+  const __m256 one = _mm256_set1_ps(1.f);
+  const __m256 d = _mm256_min_ps(shortestArc8(a, b), one);
+  const __m256 acos = _mm256_mul_ps(_mm256_sqrt_ps(_mm256_sub_ps(one, d)), horner8(d, AcosCoefficients));
+  const __m256 theta = _mm256_max_ps(acos, _mm256_set1_ps(MinSlerpAngle));
+  const __m256 invSin = _mm256_div_ps(one, sinQuadrant8(theta));
+  return weightedSum8(a, _mm256_mul_ps(sinQuadrant8(_mm256_mul_ps(_mm256_sub_ps(one, t), theta)), invSin), b,
+                      _mm256_mul_ps(sinQuadrant8(_mm256_mul_ps(t, theta)), invSin));
+}
+
+ZEUS_TARGET_AVX2 Quat8 nlerp8(const Quat8& a, Quat8 b, __m256 t) {
+  const __m256 one = _mm256_set1_ps(1.f);
+  const __m256 d = shortestArc8(a, b);
+  const __m256 ka = horner8(d, NlerpCoefficientsA);
+  const __m256 kb = horner8(d, NlerpCoefficientsB);
+  const __m256 centered = _mm256_sub_ps(t, _mm256_set1_ps(0.5f));
+  const __m256 k = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(ka, centered), centered), kb);
+  const __m256 ct =
+      _mm256_add_ps(t, _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, centered), _mm256_sub_ps(t, one)), k));
+  return normalize8(weightedSum8(a, _mm256_sub_ps(one, ct), b, ct));
+}
+
+ZEUS_TARGET_AVX2 __m256 loadFactors8(const BlendFactors& t, size_t i) {
+  const __m256 raw = t.perElement == nullptr ? _mm256_set1_ps(t.uniform) : _mm256_loadu_ps(t.perElement + i);
+  return _mm256_min_ps(_mm256_max_ps(raw, _mm256_setzero_ps()), _mm256_set1_ps(1.f));
+}
+
+template <Quat8 (*Blend)(const Quat8&, Quat8, __m256), BlendLanesFn Tail>
+ZEUS_TARGET_AVX2 void blendKernelAVX2(const CQuaternionSoA& a, const CQuaternionSoA& b, const BlendFactors& t,
+                                      const CQuaternionSoAOut& out, size_t begin, size_t end) {
+  size_t i = begin;
+  for (; i + 8 <= end; i += 8)
+    storeQuat8(Blend(loadQuat8(a, i), loadQuat8(b, i), loadFactors8(t, i)), out, i);
+  blendKernel<Tail>(a, b, t, out, i, end);
+}
+
+ZEUS_TARGET_AVX2 void normalizeKernelAVX2(const CQuaternionSoA& in, const CQuaternionSoAOut& out, size_t begin,
+                                          size_t end) {
+  size_t i = begin;
+  for (; i + 8 <= end; i += 8)
+    storeQuat8(normalize8(loadQuat8(in, i)), out, i);
+  normalizeKernel(in, out, i, end);
+}
+#endif
+
+#if ZEUS_KERNEL_AVX512
+/* 16-wide versions of the lane math, handling the tail with masked loads and stores. rsqrt14 starts from a closer
+ * estimate than the other kernels, so normalized results may differ from theirs in the last bits */
+struct Quat16 {
+  __m512 w, x, y, z;
+};
+
+ZEUS_TARGET_AVX512 __mmask16 laneMask16(size_t count) { return count >= 16 ? 0xFFFF : __mmask16((1u << count) - 1); }
+
+ZEUS_TARGET_AVX512 Quat16 loadQuat16(const CQuaternionSoA& q, size_t i, __mmask16 mask) {
+  return {_mm512_maskz_loadu_ps(mask, &q.w[i]), _mm512_maskz_loadu_ps(mask, &q.x[i]),
+          _mm512_maskz_loadu_ps(mask, &q.y[i]), _mm512_maskz_loadu_ps(mask, &q.z[i])};
+}
+
+ZEUS_TARGET_AVX512 void storeQuat16(const Quat16& q, const CQuaternionSoAOut& out, size_t i, __mmask16 mask) {
+  _mm512_mask_storeu_ps(&out.w[i], mask, q.w);
+  _mm512_mask_storeu_ps(&out.x[i], mask, q.x);
+  _mm512_mask_storeu_ps(&out.y[i], mask, q.y);
+  _mm512_mask_storeu_ps(&out.z[i], mask, q.z);
+}
+
+template <size_t N>
+ZEUS_TARGET_AVX512 __m512 horner16(__m512 x, const std::array<float, N>& coefficients) {
+  __m512 ret = _mm512_set1_ps(coefficients[0]);
+  for (size_t i = 1; i < N; ++i)
+    ret = _mm512_add_ps(_mm512_mul_ps(ret, x), _mm512_set1_ps(coefficients[i]));
+  return ret;
+}
+
+ZEUS_TARGET_AVX512 __m512 sinQuadrant16(__m512 x) {
+  return _mm512_mul_ps(x, horner16(_mm512_mul_ps(x, x), SinCoefficients));
+}
+
+ZEUS_TARGET_AVX512 __m512 dot16(const Quat16& a, const Quat16& b) {
+  return _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(a.w, b.w), _mm512_mul_ps(a.x, b.x)),
+                                     _mm512_mul_ps(a.y, b.y)),
+                       _mm512_mul_ps(a.z, b.z));
+}
+
+ZEUS_TARGET_AVX512 Quat16 scale16(const Quat16& q, __m512 s) {
+  return {_mm512_mul_ps(q.w, s), _mm512_mul_ps(q.x, s), _mm512_mul_ps(q.y, s), _mm512_mul_ps(q.z, s)};
+}
+
+ZEUS_TARGET_AVX512 __m512 shortestArc16(const Quat16& a, Quat16& b) {
+  const __m512 d = dot16(a, b);
+  const __m512 sign = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(d, _mm512_setzero_ps(), _CMP_LT_OQ),
+                                           _mm512_set1_ps(1.f), _mm512_set1_ps(-1.f));
+  b = scale16(b, sign);
+  return _mm512_mul_ps(d, sign);
+}
+
+ZEUS_TARGET_AVX512 Quat16 normalize16(const Quat16& q) {
+  const __m512 lengthSq = dot16(q, q);
+  const __m512 e = _mm512_rsqrt14_ps(lengthSq);
+  const __m512 half = _mm512_mul_ps(_mm512_set1_ps(0.5f), _mm512_mul_ps(lengthSq, e));
+  const __m512 refine = _mm512_sub_ps(_mm512_set1_ps(1.5f), _mm512_mul_ps(half, e));
+  return scale16(q, _mm512_mul_ps(e, refine));
+}
+
+ZEUS_TARGET_AVX512 Quat16 weightedSum16(const Quat16& a, __m512 wa, const Quat16& b, __m512 wb) {
+  return {_mm512_add_ps(_mm512_mul_ps(a.w, wa), _mm512_mul_ps(b.w, wb)),
+          _mm512_add_ps(_mm512_mul_ps(a.x, wa), _mm512_mul_ps(b.x, wb)),
+          _mm512_add_ps(_mm512_mul_ps(a.y, wa), _mm512_mul_ps(b.y, wb)),
+          _mm512_add_ps(_mm512_mul_ps(a.z, wa), _mm512_mul_ps(b.z, wb))};
+}
+
+ZEUS_TARGET_AVX512 Quat16 slerp16(const Quat16& a, Quat16 b, __m512 t) {
+  const __m512 one = _mm512_set1_ps(1.f);
+  const __m512 d = _mm512_min_ps(shortestArc16(a, b), one);
+  const __m512 acos = _mm512_mul_ps(_mm512_sqrt_ps(_mm512_sub_ps(one, d)), horner16(d, AcosCoefficients));
+  const __m512 theta = _mm512_max_ps(acos, _mm512_set1_ps(MinSlerpAngle));
+  const __m512 invSin = _mm512_div_ps(one, sinQuadrant16(theta));
+  return weightedSum16(a, _mm512_mul_ps(sinQuadrant16(_mm512_mul_ps(_mm512_sub_ps(one, t), theta)), invSin), b,
+                       _mm512_mul_ps(sinQuadrant16(_mm512_mul_ps(t, theta)), invSin));
+}
+
+ZEUS_TARGET_AVX512 Quat16 nlerp16(const Quat16& a, Quat16 b, __m512 t) {
+  const __m512 one = _mm512_set1_ps(1.f);
+  const __m512 d = shortestArc16(a, b);
+  const __m512 ka = horner16(d, NlerpCoefficientsA);
+  const __m512 kb = horner16(d, NlerpCoefficientsB);
+  const __m512 centered = _mm512_sub_ps(t, _mm512_set1_ps(0.5f));
+  const __m512 k = _mm512_add_ps(_mm512_mul_ps(_mm512_mul_ps(ka, centered), centered), kb);
+  const __m512 ct =
+      _mm512_add_ps(t, _mm512_mul_ps(_mm512_mul_ps(_mm512_mul_ps(t, centered), _mm512_sub_ps(t, one)), k));
+  return normalize16(weightedSum16(a, _mm512_sub_ps(one, ct), b, ct));
+}
+
+ZEUS_TARGET_AVX512 __m512 loadFactors16(const BlendFactors& t, size_t i, __mmask16 mask) {
+  const __m512 raw =
+      t.perElement == nullptr ? _mm512_set1_ps(t.uniform) : _mm512_maskz_loadu_ps(mask, t.perElement + i);
+  return _mm512_min_ps(_mm512_max_ps(raw, _mm512_setzero_ps()), _mm512_set1_ps(1.f));
+}
+
+template <Quat16 (*Blend)(const Quat16&, Quat16, __m512)>
+ZEUS_TARGET_AVX512 void blendKernelAVX512(const CQuaternionSoA& a, const CQuaternionSoA& b, const BlendFactors& t,
+                                          const CQuaternionSoAOut& out, size_t begin, size_t end) {
+  for (size_t i = begin; i < end; i += 16) {
+    const __mmask16 mask = laneMask16(end - i);
+    storeQuat16(Blend(loadQuat16(a, i, mask), loadQuat16(b, i, mask), loadFactors16(t, i, mask)), out, i, mask);
+  }
+}
+
+ZEUS_TARGET_AVX512 void normalizeKernelAVX512(const CQuaternionSoA& in, const CQuaternionSoAOut& out, size_t begin,
+                                              size_t end) {
+  for (size_t i = begin; i < end; i += 16) {
+    const __mmask16 mask = laneMask16(end - i);
+    storeQuat16(normalize16(loadQuat16(in, i, mask)), out, i, mask);
+  }
+}
+#endif
+
+struct BlendKernels {
+  void (*slerp)(const CQuaternionSoA& a, const CQuaternionSoA& b, const BlendFactors& t,
+                const CQuaternionSoAOut& out, size_t begin, size_t end);
+  void (*nlerp)(const CQuaternionSoA& a, const CQuaternionSoA& b, const BlendFactors& t,
+                const CQuaternionSoAOut& out, size_t begin, size_t end);
+  void (*normalize)(const CQuaternionSoA& in, const CQuaternionSoAOut& out, size_t begin, size_t end);
+};
+
+/* Indexed by EKernelISA */
+constexpr std::array<BlendKernels, KernelISACount> BlendKernelTable{{
+    {blendKernel<slerpLanes>, blendKernel<nlerpLanes>, normalizeKernel},
+#if ZEUS_KERNEL_AVX2
+    {blendKernelAVX2<slerp8, slerpLanes>, blendKernelAVX2<nlerp8, nlerpLanes>, normalizeKernelAVX2},
+#else
+    {blendKernel<slerpLanes>, blendKernel<nlerpLanes>, normalizeKernel},
+#endif
+#if ZEUS_KERNEL_AVX512
+    {blendKernelAVX512<slerp16>, blendKernelAVX512<nlerp16>, normalizeKernelAVX512},
+#else
+    {blendKernel<slerpLanes>, blendKernel<nlerpLanes>, normalizeKernel},
+#endif
+}};
+
+using BlendKernel = decltype(BlendKernels::slerp);
+
+void blend(BlendKernel kernel, const CQuaternionSoA& a, const CQuaternionSoA& b, const BlendFactors& t,
+           const CQuaternionSoAOut& out, unsigned threadCount) {
+  assert(a.x.size() == a.size() && a.y.size() == a.size() && a.z.size() == a.size());
+  assert(b.size() >= a.size() && b.x.size() >= a.size() && b.y.size() >= a.size() && b.z.size() >= a.size());
+  assert(out.size() >= a.size() && out.x.size() >= a.size() && out.y.size() >= a.size() &&
+         out.z.size() >= a.size());
+  parallelSplit(a.size(), threadCount, ParallelBlendCount, BlendBlockSize,
+                [&](size_t, size_t begin, size_t end) { kernel(a, b, t, out, begin, end); });
+}
+} // Anonymous namespace
+
+void slerpQuaternions(const CQuaternionSoA& a, const CQuaternionSoA& b, std::span<const float> t,
+                      const CQuaternionSoAOut& out, unsigned threadCount) {
+  assert(t.size() >= a.size());
+  blend(BlendKernelTable[size_t(kernelISA())].slerp, a, b, {t.data()}, out, threadCount);
+}
+
+void slerpQuaternions(const CQuaternionSoA& a, const CQuaternionSoA& b, float t, const CQuaternionSoAOut& out,
+                      unsigned threadCount) {
+  blend(BlendKernelTable[size_t(kernelISA())].slerp, a, b, {nullptr, t}, out, threadCount);
+}
+
+void nlerpQuaternions(const CQuaternionSoA& a, const CQuaternionSoA& b, std::span<const float> t,
+                      const CQuaternionSoAOut& out, unsigned threadCount) {
+  assert(t.size() >= a.size());
+  blend(BlendKernelTable[size_t(kernelISA())].nlerp, a, b, {t.data()}, out, threadCount);
+}
+
+void nlerpQuaternions(const CQuaternionSoA& a, const CQuaternionSoA& b, float t, const CQuaternionSoAOut& out,
+                      unsigned threadCount) {
+  blend(BlendKernelTable[size_t(kernelISA())].nlerp, a, b, {nullptr, t}, out, threadCount);
+}
+
+void normalizeQuaternions(std::span<const CQuaternion> in, std::span<CQuaternion> out, unsigned threadCount) {
+  assert(out.size() >= in.size());
+  parallelSplit(in.size(), threadCount, ParallelBlendCount, BlendBlockSize, [&](size_t, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      out[i] = in[i].fastNormalized();
+  });
+}
+
+void normalizeQuaternions(const CQuaternionSoA& in, const CQuaternionSoAOut& out, unsigned threadCount) {
+  assert(in.x.size() == in.size() && in.y.size() == in.size() && in.z.size() == in.size());
+  assert(out.size() >= in.size() && out.x.size() >= in.size() && out.y.size() >= in.size() &&
+         out.z.size() >= in.size());
+  const auto kernel = BlendKernelTable[size_t(kernelISA())].normalize;
+  parallelSplit(in.size(), threadCount, ParallelBlendCount, BlendBlockSize,
+                [&](size_t, size_t begin, size_t end) { kernel(in, out, begin, end); });
+}
+} // namespace zeus
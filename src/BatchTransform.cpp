@@ -0,0 +1,515 @@
+#include "zeus/BatchTransform.hpp"
+
+#include <algorithm>
+
+#include "ParallelSplit.hpp"
+
+#if ZEUS_KERNEL_AVX2 || ZEUS_KERNEL_AVX512
+#include <immintrin.h>
+#endif
+
+namespace zeus {
+namespace {
+using BatchSimd = simd<float>;
+constexpr size_t BatchLanes = BatchSimd::size();
+/* Each worker of a threaded split gets at least this many points */
+constexpr size_t ParallelPointCount = 1 << 14;
+/* Point chunks keep to whole 8-point blocks so only the last one has a tail */
+constexpr size_t PointBlockSize = 8;
+
+/* Row-major 4x4 matrix; the last row is only read when projecting */
+using Rows = std::array<std::array<float, 4>, 4>;
+
+Rows matrixRows(const CMatrix4f& mtx) {
+  Rows rows{};
+  for (size_t r = 0; r < 4; ++r)
+    for (size_t c = 0; c < 4; ++c)
+      rows[r][c] = mtx.m[c][r];
+  return rows;
+}
+
+Rows transformRows(const CTransform& xf) {
+  Rows rows{};
+  for (size_t r = 0; r < 3; ++r) {
+    for (size_t c = 0; c < 3; ++c)
+      rows[r][c] = xf.basis.m[c][r];
+    rows[r][3] = xf.origin[r];
+  }
+  rows[3][3] = 1.f;
+  return rows;
+}
+
+/* Inverse transpose of basis: row r of the result is column r of the inverse */
+Rows normalRows(const CMatrix3f& basis) {
+  const CMatrix3f inv = basis.inverted();
+  Rows rows{};
+  for (size_t r = 0; r < 3; ++r)
+    for (size_t c = 0; c < 3; ++c)
+      rows[r][c] = inv.m[r][c];
+  rows[3][3] = 1.f;
+  return rows;
+}
+
+template <bool Project>
+struct LaneMatrix {
+  std::array<std::array<BatchSimd, 4>, 4> m;
+
+  explicit LaneMatrix(const Rows& rows) {
+    for (size_t r = 0; r < 4; ++r)
+      for (size_t c = 0; c < 4; ++c)
+        m[r][c] = BatchSimd(rows[r][c]);
+  }
+
+  void apply(const BatchSimd& x, const BatchSimd& y, const BatchSimd& z, BatchSimd& ox, BatchSimd& oy,
+             BatchSimd& oz) const {
+    ox = m[0][0] * x + m[0][1] * y + m[0][2] * z + m[0][3];
+    oy = m[1][0] * x + m[1][1] * y + m[1][2] * z + m[1][3];
+    oz = m[2][0] * x + m[2][1] * y + m[2][2] * z + m[2][3];
+    if constexpr (Project) {
+      const BatchSimd w = m[3][0] * x + m[3][1] * y + m[3][2] * z + m[3][3];
+      ox = ox / w;
+      oy = oy / w;
+      oz = oz / w;
+    }
+  }
+};
+
+#if __SSE__
+/* Four packed xyz triples in a, b, c to one register per coordinate */
+void deinterleave(__m128 a, __m128 b, __m128 c, __m128& x, __m128& y, __m128& z) {
+  x = _mm_shuffle_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 0)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)),
+                     _MM_SHUFFLE(2, 0, 1, 0));
+  y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+  z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+void interleave(__m128 x, __m128 y, __m128 z, __m128& a, __m128& b, __m128& c) {
+  a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+  b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+  c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+}
+#endif
+
+/* Scales each vector to unit length with the refined rsqrt estimate */
+struct LaneNormalize {
+  void apply(const BatchSimd& x, const BatchSimd& y, const BatchSimd& z, BatchSimd& ox, BatchSimd& oy,
+             BatchSimd& oz) const {
+    const BatchSimd invLength = rsqrt(x * x + y * y + z * z);
+    ox = x * invLength;
+    oy = y * invLength;
+    oz = z * invLength;
+  }
+};
+
+/* Maps up to BatchLanes packed triples starting at triple first, going through lane-sized scratch arrays */
+template <class Lanes>
+void aosBlock(const Lanes& lm, const float* in, float* out, size_t first, size_t count) {
+  std::array<std::array<float, BatchLanes>, 3> lanes{};
+  for (size_t l = 0; l < count; ++l)
+    for (size_t c = 0; c < 3; ++c)
+      lanes[c][l] = in[(first + l) * 3 + c];
+
+  BatchSimd ox, oy, oz;
+  lm.apply(loadLanes(lanes[0].data()), loadLanes(lanes[1].data()), loadLanes(lanes[2].data()), ox, oy, oz);
+  ox.copy_to(lanes[0].data(), _simd::element_aligned);
+  oy.copy_to(lanes[1].data(), _simd::element_aligned);
+  oz.copy_to(lanes[2].data(), _simd::element_aligned);
+
+  for (size_t l = 0; l < count; ++l)
+    for (size_t c = 0; c < 3; ++c)
+      out[(first + l) * 3 + c] = lanes[c][l];
+}
+
+/* Runs lm.apply over packed xyz triples [begin, end) */
+template <class Lanes>
+void aosApply(const Lanes& lm, const float* in, float* out, size_t begin, size_t end) {
+  size_t i = begin;
+#if __SSE__
+  for (; i + 4 <= end; i += 4) {
+    __m128 x, y, z;
+    deinterleave(_mm_loadu_ps(in + i * 3), _mm_loadu_ps(in + i * 3 + 4), _mm_loadu_ps(in + i * 3 + 8), x, y, z);
+    BatchSimd ox, oy, oz;
+    lm.apply(x, y, z, ox, oy, oz);
+    __m128 a, b, c;
+    interleave(ox.native(), oy.native(), oz.native(), a, b, c);
+    _mm_storeu_ps(out + i * 3, a);
+    _mm_storeu_ps(out + i * 3 + 4, b);
+    _mm_storeu_ps(out + i * 3 + 8, c);
+  }
+#elif __ARM_NEON
+  for (; i + 4 <= end; i += 4) {
+    const float32x4x3_t v = vld3q_f32(in + i * 3);
+    BatchSimd ox, oy, oz;
+    lm.apply(v.val[0], v.val[1], v.val[2], ox, oy, oz);
+    vst3q_f32(out + i * 3, float32x4x3_t{{ox.native(), oy.native(), oz.native()}});
+  }
+#endif
+  for (; i < end; i += BatchLanes)
+    aosBlock(lm, in, out, i, std::min(BatchLanes, end - i));
+}
+
+template <class Lanes>
+void soaApply(const Lanes& lm, const CVector3fSoA& in, const CVector3fSoAOut& out, size_t begin, size_t end) {
+  size_t i = begin;
+  BatchSimd ox, oy, oz;
+  for (; i + BatchLanes <= end; i += BatchLanes) {
+    lm.apply(loadLanes(&in.x[i]), loadLanes(&in.y[i]), loadLanes(&in.z[i]), ox, oy, oz);
+    ox.copy_to(&out.x[i], _simd::element_aligned);
+    oy.copy_to(&out.y[i], _simd::element_aligned);
+    oz.copy_to(&out.z[i], _simd::element_aligned);
+  }
+
+  if (i < end) {
+    const size_t rem = end - i;
+    BatchSimd x, y, z;
+    x.copy_from(&in.x[i], rem, _simd::element_aligned);
+    y.copy_from(&in.y[i], rem, _simd::element_aligned);
+    z.copy_from(&in.z[i], rem, _simd::element_aligned);
+    lm.apply(x, y, z, ox, oy, oz);
+    ox.copy_to(&out.x[i], rem, _simd::element_aligned);
+    oy.copy_to(&out.y[i], rem, _simd::element_aligned);
+    oz.copy_to(&out.z[i], rem, _simd::element_aligned);
+  }
+}
+
+template <bool Project>
+void aosKernel(const Rows& rows, const float* in, float* out, size_t begin, size_t end) {
+  aosApply(LaneMatrix<Project>(rows), in, out, begin, end);
+}
+
+template <bool Project>
+void soaKernel(const Rows& rows, const CVector3fSoA& in, const CVector3fSoAOut& out, size_t begin, size_t end) {
+  soaApply(LaneMatrix<Project>(rows), in, out, begin, end);
+}
+
+#if ZEUS_KERNEL_AVX2
+template <bool Project>
+struct LaneMatrix8 {
+  __m256 m[4][4];
+
+  ZEUS_TARGET_AVX2 explicit LaneMatrix8(const Rows& rows) {
+    for (size_t r = 0; r < 4; ++r)
+      for (size_t c = 0; c < 4; ++c)
+        m[r][c] = _mm256_set1_ps(rows[r][c]);
+  }
+
+  ZEUS_TARGET_AVX2 __m256 row(size_t r, __m256 x, __m256 y, __m256 z) const {
+    /* Summed in LaneMatrix's order so both kernels round identically */
+    return _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m[r][0], x), _mm256_mul_ps(m[r][1], y)),
+                                       _mm256_mul_ps(m[r][2], z)),
+                         m[r][3]);
+  }
+
+  ZEUS_TARGET_AVX2 void apply(__m256 x, __m256 y, __m256 z, __m256& ox, __m256& oy, __m256& oz) const {
+    ox = row(0, x, y, z);
+    oy = row(1, x, y, z);
+    oz = row(2, x, y, z);
+    if constexpr (Project) {
+      const __m256 w = row(3, x, y, z);
+      ox = _mm256_div_ps(ox, w);
+      oy = _mm256_div_ps(oy, w);
+      oz = _mm256_div_ps(oz, w);
+    }
+  }
+};
+
+/* 8-wide versions of the kernels above, which finish the tails */
+template <bool Project>
+ZEUS_TARGET_AVX2 void aosKernelAVX2(const Rows& rows, const float* in, float* out, size_t begin, size_t end) {
+  const LaneMatrix8<Project> lm8(rows);
+  size_t i = begin;
+  for (; i + 8 <= end; i += 8) {
+    __m128 x0, y0, z0, x1, y1, z1;
+    deinterleave(_mm_loadu_ps(in + i * 3), _mm_loadu_ps(in + i * 3 + 4), _mm_loadu_ps(in + i * 3 + 8), x0, y0, z0);
+    deinterleave(_mm_loadu_ps(in + i * 3 + 12), _mm_loadu_ps(in + i * 3 + 16), _mm_loadu_ps(in + i * 3 + 20), x1, y1,
+                 z1);
+    __m256 ox, oy, oz;
+    lm8.apply(_mm256_set_m128(x1, x0), _mm256_set_m128(y1, y0), _mm256_set_m128(z1, z0), ox, oy, oz);
+    __m128 a, b, c;
+    interleave(_mm256_castps256_ps128(ox), _mm256_castps256_ps128(oy), _mm256_castps256_ps128(oz), a, b, c);
+    _mm_storeu_ps(out + i * 3, a);
+    _mm_storeu_ps(out + i * 3 + 4, b);
+    _mm_storeu_ps(out + i * 3 + 8, c);
+    interleave(_mm256_extractf128_ps(ox, 1), _mm256_extractf128_ps(oy, 1), _mm256_extractf128_ps(oz, 1), a, b, c);
+    _mm_storeu_ps(out + i * 3 + 12, a);
+    _mm_storeu_ps(out + i * 3 + 16, b);
+    _mm_storeu_ps(out + i * 3 + 20, c);
+  }
+  aosKernel<Project>(rows, in, out, i, end);
+}
+
+template <bool Project>
+ZEUS_TARGET_AVX2 void soaKernelAVX2(const Rows& rows, const CVector3fSoA& in, const CVector3fSoAOut& out, size_t begin,
+                                    size_t end) {
+  const LaneMatrix8<Project> lm8(rows);
+  size_t i = begin;
+  for (; i + 8 <= end; i += 8) {
+    __m256 ox, oy, oz;
+    lm8.apply(_mm256_loadu_ps(&in.x[i]), _mm256_loadu_ps(&in.y[i]), _mm256_loadu_ps(&in.z[i]), ox, oy, oz);
+    _mm256_storeu_ps(&out.x[i], ox);
+    _mm256_storeu_ps(&out.y[i], oy);
+    _mm256_storeu_ps(&out.z[i], oz);
+  }
+  soaKernel<Project>(rows, in, out, i, end);
+}
+#endif
+
+#if ZEUS_KERNEL_AVX512
+/* Mask of the first count lanes of a 16-lane register */
+ZEUS_TARGET_AVX512 __mmask16 laneMask16(size_t count) { return count >= 16 ? 0xFFFF : __mmask16((1u << count) - 1); }
+
+/* Uses fused multiply-adds, so results may differ from the other kernels in the last bit */
+template <bool Project>
+struct LaneMatrix16 {
+  __m512 m[4][4];
+
+  ZEUS_TARGET_AVX512 explicit LaneMatrix16(const Rows& rows) {
+    for (size_t r = 0; r < 4; ++r)
+      for (size_t c = 0; c < 4; ++c)
+        m[r][c] = _mm512_set1_ps(rows[r][c]);
+  }
+
+  ZEUS_TARGET_AVX512 __m512 row(size_t r, __m512 x, __m512 y, __m512 z) const {
+    return _mm512_fmadd_ps(m[r][0], x, _mm512_fmadd_ps(m[r][1], y, _mm512_fmadd_ps(m[r][2], z, m[r][3])));
+  }
+
+  ZEUS_TARGET_AVX512 void apply(__m512 x, __m512 y, __m512 z, __m512& ox, __m512& oy, __m512& oz) const {
+    ox = row(0, x, y, z);
+    oy = row(1, x, y, z);
+    oz = row(2, x, y, z);
+    if constexpr (Project) {
+      const __m512 w = row(3, x, y, z);
+      ox = _mm512_div_ps(ox, w);
+      oy = _mm512_div_ps(oy, w);
+      oz = _mm512_div_ps(oz, w);
+    }
+  }
+};
+
+/**
+ * permutex2var indices that turn 16 packed xyz triples, loaded as three registers a, b and c, into one register per
+ * coordinate and back. Coordinate k of point i is element 3i+k of a:b:c; it is picked from a:b first, then
+ * lanes whose element lies in c are filled in. Storing reverses this, merging x with y and then adding z.
+ */
+struct AoSPermutes {
+  std::array<std::array<int32_t, 16>, 3> gatherAB{};
+  std::array<std::array<int32_t, 16>, 3> gatherC{};
+  std::array<std::array<int32_t, 16>, 3> scatterXY{};
+  std::array<std::array<int32_t, 16>, 3> scatterZ{};
+};
+
+constexpr AoSPermutes makeAoSPermutes() {
+  AoSPermutes p;
+  for (int32_t k = 0; k < 3; ++k) {
+    for (int32_t i = 0; i < 16; ++i) {
+      const int32_t e = i * 3 + k;
+      p.gatherAB[k][i] = e < 32 ? e : 0;
+      p.gatherC[k][i] = e < 32 ? i : 16 + e - 32;
+    }
+  }
+  for (int32_t r = 0; r < 3; ++r) {
+    for (int32_t j = 0; j < 16; ++j) {
+      const int32_t e = r * 16 + j;
+      const int32_t point = e / 3;
+      const int32_t k = e % 3;
+      p.scatterXY[r][j] = k == 0 ? point : k == 1 ? 16 + point : 0;
+      p.scatterZ[r][j] = k == 2 ? 16 + point : j;
+    }
+  }
+  return p;
+}
+
+constexpr AoSPermutes AoSPermuteTable = makeAoSPermutes();
+
+/* 16-wide versions of the kernels, handling the tail with masked loads and stores */
+template <bool Project>
+ZEUS_TARGET_AVX512 void aosKernelAVX512(const Rows& rows, const float* in, float* out, size_t begin, size_t end) {
+  const LaneMatrix16<Project> lm(rows);
+  __m512i gatherAB[3], gatherC[3], scatterXY[3], scatterZ[3];
+  for (size_t k = 0; k < 3; ++k) {
+    gatherAB[k] = _mm512_loadu_si512(AoSPermuteTable.gatherAB[k].data());
+    gatherC[k] = _mm512_loadu_si512(AoSPermuteTable.gatherC[k].data());
+    scatterXY[k] = _mm512_loadu_si512(AoSPermuteTable.scatterXY[k].data());
+    scatterZ[k] = _mm512_loadu_si512(AoSPermuteTable.scatterZ[k].data());
+  }
+
+  for (size_t i = begin; i < end; i += 16) {
+    const size_t floats = std::min(size_t(16), end - i) * 3;
+    const std::array<__mmask16, 3> masks{laneMask16(floats), laneMask16(floats > 16 ? floats - 16 : 0),
+                                         laneMask16(floats > 32 ? floats - 32 : 0)};
+    const float* src = in + i * 3;
+    const __m512 a = _mm512_maskz_loadu_ps(masks[0], src);
+    const __m512 b = _mm512_maskz_loadu_ps(masks[1], src + 16);
+    const __m512 c = _mm512_maskz_loadu_ps(masks[2], src + 32);
+    __m512 v[3];
+    for (size_t k = 0; k < 3; ++k)
+      v[k] = _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, gatherAB[k], b), gatherC[k], c);
+
+    __m512 o[3];
+    lm.apply(v[0], v[1], v[2], o[0], o[1], o[2]);
+    float* dst = out + i * 3;
+    for (size_t r = 0; r < 3; ++r)
+      _mm512_mask_storeu_ps(dst + r * 16, masks[r],
+                            _mm512_permutex2var_ps(_mm512_permutex2var_ps(o[0], scatterXY[r], o[1]), scatterZ[r],
+                                                   o[2]));
+  }
+}
+
+template <bool Project>
+ZEUS_TARGET_AVX512 void soaKernelAVX512(const Rows& rows, const CVector3fSoA& in, const CVector3fSoAOut& out,
+                                        size_t begin, size_t end) {
+  const LaneMatrix16<Project> lm(rows);
+  for (size_t i = begin; i < end; i += 16) {
+    const __mmask16 mask = laneMask16(end - i);
+    __m512 ox, oy, oz;
+    lm.apply(_mm512_maskz_loadu_ps(mask, &in.x[i]), _mm512_maskz_loadu_ps(mask, &in.y[i]),
+             _mm512_maskz_loadu_ps(mask, &in.z[i]), ox, oy, oz);
+    _mm512_mask_storeu_ps(&out.x[i], mask, ox);
+    _mm512_mask_storeu_ps(&out.y[i], mask, oy);
+    _mm512_mask_storeu_ps(&out.z[i], mask, oz);
+  }
+}
+#endif
+
+struct TransformKernels {
+  void (*aos)(const Rows& rows, const float* in, float* out, size_t begin, size_t end);
+  void (*soa)(const Rows& rows, const CVector3fSoA& in, const CVector3fSoAOut& out, size_t begin, size_t end);
+};
+
+/* Indexed by EKernelISA */
+template <bool Project>
+constexpr std::array<TransformKernels, KernelISACount> TransformKernelTable{{
+    {aosKernel<Project>, soaKernel<Project>},
+#if ZEUS_KERNEL_AVX2
+    {aosKernelAVX2<Project>, soaKernelAVX2<Project>},
+#else
+    {aosKernel<Project>, soaKernel<Project>},
+#endif
+#if ZEUS_KERNEL_AVX512
+    {aosKernelAVX512<Project>, soaKernelAVX512<Project>},
+#else
+    {aosKernel<Project>, soaKernel<Project>},
+#endif
+}};
+
+template <bool Project>
+void transformAoS(const Rows& rows, std::span<const float> in, std::span<float> out, unsigned threadCount) {
+  assert(in.size() % 3 == 0);
+  assert(out.size() >= in.size());
+  const TransformKernels& kernels = TransformKernelTable<Project>[size_t(kernelISA())];
+  parallelSplit(in.size() / 3, threadCount, ParallelPointCount, PointBlockSize, [&](size_t, size_t begin, size_t end) {
+    kernels.aos(rows, in.data(), out.data(), begin, end);
+  });
+}
+
+template <bool Project>
+void transformSoA(const Rows& rows, const CVector3fSoA& in, const CVector3fSoAOut& out, unsigned threadCount) {
+  assert(in.y.size() == in.size() && in.z.size() == in.size());
+  assert(out.size() >= in.size() && out.y.size() >= in.size() && out.z.size() >= in.size());
+  const TransformKernels& kernels = TransformKernelTable<Project>[size_t(kernelISA())];
+  parallelSplit(in.size(), threadCount, ParallelPointCount, PointBlockSize, [&](size_t, size_t begin, size_t end) {
+    kernels.soa(rows, in, out, begin, end);
+  });
+}
+
+CMatrix3f upperBasis(const CMatrix4f& mtx) {
+  return CMatrix3f(mtx.m[0].toVec3f(), mtx.m[1].toVec3f(), mtx.m[2].toVec3f());
+}
+} // Anonymous namespace
+
+void transformPoints(const CTransform& xf, std::span<const float> in, std::span<float> out, unsigned threadCount) {
+  transformAoS<false>(transformRows(xf), in, out, threadCount);
+}
+
+void transformPoints(const CTransform& xf, const CVector3fSoA& in, const CVector3fSoAOut& out,
+                     unsigned threadCount) {
+  transformSoA<false>(transformRows(xf), in, out, threadCount);
+}
+
+void transformPoints(const CMatrix4f& mtx, std::span<const float> in, std::span<float> out, unsigned threadCount) {
+  transformAoS<false>(matrixRows(mtx), in, out, threadCount);
+}
+
+void transformPoints(const CMatrix4f& mtx, const CVector3fSoA& in, const CVector3fSoAOut& out,
+                     unsigned threadCount) {
+  transformSoA<false>(matrixRows(mtx), in, out, threadCount);
+}
+
+void transformNormals(const CTransform& xf, std::span<const float> in, std::span<float> out,
+                      unsigned threadCount) {
+  transformAoS<false>(normalRows(xf.basis), in, out, threadCount);
+}
+
+void transformNormals(const CTransform& xf, const CVector3fSoA& in, const CVector3fSoAOut& out,
+                      unsigned threadCount) {
+  transformSoA<false>(normalRows(xf.basis), in, out, threadCount);
+}
+
+void transformNormals(const CMatrix4f& mtx, std::span<const float> in, std::span<float> out,
+                      unsigned threadCount) {
+  transformAoS<false>(normalRows(upperBasis(mtx)), in, out, threadCount);
+}
+
+void transformNormals(const CMatrix4f& mtx, const CVector3fSoA& in, const CVector3fSoAOut& out,
+                      unsigned threadCount) {
+  transformSoA<false>(normalRows(upperBasis(mtx)), in, out, threadCount);
+}
+
+void projectPoints(const CMatrix4f& mtx, std::span<const float> in, std::span<float> out, unsigned threadCount) {
+  transformAoS<true>(matrixRows(mtx), in, out, threadCount);
+}
+
+void projectPoints(const CMatrix4f& mtx, const CVector3fSoA& in, const CVector3fSoAOut& out,
+                   unsigned threadCount) {
+  transformSoA<true>(matrixRows(mtx), in, out, threadCount);
+}
+
+void rotateVectors(const CQuaternion& rotation, std::span<const CVector3f> in, std::span<CVector3f> out,
+                   unsigned threadCount) {
+  assert(out.size() >= in.size());
+  const CMatrix3f mtx(rotation);
+  parallelSplit(in.size(), threadCount, ParallelPointCount, PointBlockSize, [&](size_t, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      out[i] = mtx * in[i];
+  });
+}
+
+void rotateVectors(const CQuaternion& rotation, std::span<const float> in, std::span<float> out,
+                   unsigned threadCount) {
+  transformAoS<false>(transformRows(rotation.toTransform()), in, out, threadCount);
+}
+
+void rotateVectors(const CQuaternion& rotation, const CVector3fSoA& in, const CVector3fSoAOut& out,
+                   unsigned threadCount) {
+  transformSoA<false>(transformRows(rotation.toTransform()), in, out, threadCount);
+}
+
+void normalizeVectors(std::span<const CVector3f> in, std::span<CVector3f> out, unsigned threadCount) {
+  assert(out.size() >= in.size());
+  parallelSplit(in.size(), threadCount, ParallelPointCount, PointBlockSize, [&](size_t, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      out[i] = in[i].fastNormalized();
+  });
+}
+
+void normalizeVectors(std::span<const float> in, std::span<float> out, unsigned threadCount) {
+  assert(in.size() % 3 == 0);
+  assert(out.size() >= in.size());
+  parallelSplit(in.size() / 3, threadCount, ParallelPointCount, PointBlockSize, [&](size_t, size_t begin, size_t end) {
+    aosApply(LaneNormalize{}, in.data(), out.data(), begin, end);
+  });
+}
+
+void normalizeVectors(const CVector3fSoA& in, const CVector3fSoAOut& out, unsigned threadCount) {
+  assert(in.y.size() == in.size() && in.z.size() == in.size());
+  assert(out.size() >= in.size() && out.y.size() >= in.size() && out.z.size() >= in.size());
+  parallelSplit(in.size(), threadCount, ParallelPointCount, PointBlockSize, [&](size_t, size_t begin, size_t end) {
+    soaApply(LaneNormalize{}, in, out, begin, end);
+  });
+}
+} // namespace zeus
@@ -1,7 +1,155 @@
 #include "zeus/CAABox.hpp"
 #include "zeus/CVector3f.hpp"
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "ParallelSplit.hpp"
+
 namespace zeus {
+namespace {
+using BoundsSimd = simd<float>;
+/* Each worker of a threaded split gets at least this many points */
+constexpr size_t ParallelBoundsCount = 1 << 15;
+/* Point chunks keep to whole 4-point blocks so only the last one has a tail */
+constexpr size_t BoundsBlockSize = 4;
+
+/* The select form of CAABox::accumulateBounds, so a NaN coordinate leaves the bound unchanged on every ABI */
+BoundsSimd lowerOf(const BoundsSimd& p, const BoundsSimd& lo) { return _simd::select(p < lo, p, lo); }
+BoundsSimd higherOf(const BoundsSimd& p, const BoundsSimd& hi) { return _simd::select(p > hi, p, hi); }
+
+/**
+ * Bounds of points[begin, end) as point(points[i]) gives them. Two accumulator pairs keep each min and max from
+ * waiting on the previous one.
+ */
+template <typename Point>
+CAABox vectorBounds(const CVector3f* points, size_t begin, size_t end, Point&& point) {
+  const CAABox init;
+  BoundsSimd lo0 = init.min.mSimd, lo1 = lo0;
+  BoundsSimd hi0 = init.max.mSimd, hi1 = hi0;
+  size_t i = begin;
+  for (; i + 2 <= end; i += 2) {
+    const BoundsSimd p0 = point(points[i]);
+    const BoundsSimd p1 = point(points[i + 1]);
+    lo0 = lowerOf(p0, lo0);
+    hi0 = higherOf(p0, hi0);
+    lo1 = lowerOf(p1, lo1);
+    hi1 = higherOf(p1, hi1);
+  }
+  if (i < end) {
+    const BoundsSimd p0 = point(points[i]);
+    lo0 = lowerOf(p0, lo0);
+    hi0 = higherOf(p0, hi0);
+  }
+  return {lowerOf(lo1, lo0), higherOf(hi1, hi0)};
+}
+
+/**
+ * Bounds of packed xyz triples [begin, end). Four triples fill three registers in which element j of the twelve
+ * always holds coordinate j % 3, so whole registers are reduced and only the final twelve lanes are sorted out by
+ * coordinate.
+ */
+CAABox packedBounds(const float* points, size_t begin, size_t end) {
+  static_assert(BoundsSimd::size() == 4);
+  const CAABox init;
+  BoundsSimd lo0(init.min.x()), lo1 = lo0, lo2 = lo0;
+  BoundsSimd hi0(init.max.x()), hi1 = hi0, hi2 = hi0;
+  size_t i = begin;
+  for (; i + 4 <= end; i += 4) {
+    const BoundsSimd a = loadLanes(points + i * 3);
+    const BoundsSimd b = loadLanes(points + i * 3 + 4);
+    const BoundsSimd c = loadLanes(points + i * 3 + 8);
+    lo0 = lowerOf(a, lo0);
+    hi0 = higherOf(a, hi0);
+    lo1 = lowerOf(b, lo1);
+    hi1 = higherOf(b, hi1);
+    lo2 = lowerOf(c, lo2);
+    hi2 = higherOf(c, hi2);
+  }
+
+  std::array<float, 12> loLanes, hiLanes;
+  lo0.copy_to(loLanes.data(), _simd::element_aligned);
+  lo1.copy_to(loLanes.data() + 4, _simd::element_aligned);
+  lo2.copy_to(loLanes.data() + 8, _simd::element_aligned);
+  hi0.copy_to(hiLanes.data(), _simd::element_aligned);
+  hi1.copy_to(hiLanes.data() + 4, _simd::element_aligned);
+  hi2.copy_to(hiLanes.data() + 8, _simd::element_aligned);
+  std::array<float, 3> mins{init.min.x(), init.min.y(), init.min.z()};
+  std::array<float, 3> maxes{init.max.x(), init.max.y(), init.max.z()};
+  for (size_t j = 0; j < 12; ++j) {
+    mins[j % 3] = std::min(mins[j % 3], loLanes[j]);
+    maxes[j % 3] = std::max(maxes[j % 3], hiLanes[j]);
+  }
+  CAABox ret({mins[0], mins[1], mins[2]}, {maxes[0], maxes[1], maxes[2]});
+  for (; i < end; ++i)
+    ret.accumulateBounds(CVector3f(points[i * 3], points[i * 3 + 1], points[i * 3 + 2]));
+  return ret;
+}
+
+float laneMin(const BoundsSimd& v) {
+  std::array<float, BoundsSimd::size()> lanes;
+  v.copy_to(lanes.data(), _simd::element_aligned);
+  return *std::min_element(lanes.begin(), lanes.end());
+}
+
+float laneMax(const BoundsSimd& v) {
+  std::array<float, BoundsSimd::size()> lanes;
+  v.copy_to(lanes.data(), _simd::element_aligned);
+  return *std::max_element(lanes.begin(), lanes.end());
+}
+
+/**
+ * Bounds of xf * point for packed xyz triples [begin, end). Each group of four points is gathered into one register
+ * per coordinate, and the transform is summed in CTransform::operator*'s order.
+ */
+CAABox transformedPackedBounds(const CTransform& xf, const float* points, size_t begin, size_t end) {
+  const BoundsSimd m00(xf.basis[0][0]), m01(xf.basis[1][0]), m02(xf.basis[2][0]), tx(xf.origin[0]);
+  const BoundsSimd m10(xf.basis[0][1]), m11(xf.basis[1][1]), m12(xf.basis[2][1]), ty(xf.origin[1]);
+  const BoundsSimd m20(xf.basis[0][2]), m21(xf.basis[1][2]), m22(xf.basis[2][2]), tz(xf.origin[2]);
+  const CAABox init;
+  BoundsSimd loX(init.min.x()), loY = loX, loZ = loX;
+  BoundsSimd hiX(init.max.x()), hiY = hiX, hiZ = hiX;
+  size_t i = begin;
+  for (; i + 4 <= end; i += 4) {
+    const float* block = points + i * 3;
+    const BoundsSimd x(block[0], block[3], block[6], block[9]);
+    const BoundsSimd y(block[1], block[4], block[7], block[10]);
+    const BoundsSimd z(block[2], block[5], block[8], block[11]);
+    const BoundsSimd ox = tx + (m00 * x + m01 * y + m02 * z);
+    const BoundsSimd oy = ty + (m10 * x + m11 * y + m12 * z);
+    const BoundsSimd oz = tz + (m20 * x + m21 * y + m22 * z);
+    loX = lowerOf(ox, loX);
+    hiX = higherOf(ox, hiX);
+    loY = lowerOf(oy, loY);
+    hiY = higherOf(oy, hiY);
+    loZ = lowerOf(oz, loZ);
+    hiZ = higherOf(oz, hiZ);
+  }
+
+  CAABox ret({laneMin(loX), laneMin(loY), laneMin(loZ)}, {laneMax(hiX), laneMax(hiY), laneMax(hiZ)});
+  for (; i < end; ++i)
+    ret.accumulateBounds(xf * CVector3f(points[i * 3], points[i * 3 + 1], points[i * 3 + 2]));
+  return ret;
+}
+
+/* Merges boundsOf(begin, end) over [0, count), split into chunks for up to threadCount workers */
+template <typename Bounds>
+CAABox parallelBounds(size_t count, unsigned threadCount, Bounds&& boundsOf) {
+  const size_t workers = parallelWorkers(count, threadCount, ParallelBoundsCount);
+  if (workers <= 1)
+    return boundsOf(size_t(0), count);
+
+  std::vector<CAABox> chunks(workers);
+  const size_t ran = parallelSplit(count, threadCount, ParallelBoundsCount, BoundsBlockSize,
+                                   [&](size_t w, size_t begin, size_t end) { chunks[w] = boundsOf(begin, end); });
+  CAABox ret = chunks.front();
+  for (size_t w = 1; w < ran; ++w)
+    ret.accumulateBounds(chunks[w]);
+  return ret;
+}
+} // Anonymous namespace
+
 static const int ProjWindings[6][4] = {
   {2, 0, 4, 6}, // -X
   {0, 1, 5, 4}, // -Y
@@ -159,4 +307,28 @@ CAABox::Tri CAABox::getTri(EBoxFaceId face, int windOffset) const {
           {verts[windOffset % 2], verts[(windOffset + 1) % 2], verts[(windOffset + 2) % 2]}};
 }
 
+CAABox CAABox::FromPoints(std::span<const CVector3f> points, unsigned threadCount) {
+  return parallelBounds(points.size(), threadCount, [&](size_t begin, size_t end) {
+    return vectorBounds(points.data(), begin, end, [](const CVector3f& point) { return point.mSimd; });
+  });
+}
+
+CAABox CAABox::FromPoints(std::span<const float> points, unsigned threadCount) {
+  assert(points.size() % 3 == 0);
+  return parallelBounds(points.size() / 3, threadCount,
+                        [&](size_t begin, size_t end) { return packedBounds(points.data(), begin, end); });
+}
+
+CAABox CAABox::FromPoints(const CTransform& xf, std::span<const CVector3f> points, unsigned threadCount) {
+  return parallelBounds(points.size(), threadCount, [&](size_t begin, size_t end) {
+    return vectorBounds(points.data(), begin, end, [&xf](const CVector3f& point) { return (xf * point).mSimd; });
+  });
+}
+
+CAABox CAABox::FromPoints(const CTransform& xf, std::span<const float> points, unsigned threadCount) {
+  assert(points.size() % 3 == 0);
+  return parallelBounds(points.size() / 3, threadCount, [&](size_t begin, size_t end) {
+    return transformedPackedBounds(xf, points.data(), begin, end);
+  });
+}
 } // namespace zeus
@@ -0,0 +1,652 @@
+#include "zeus/CBVH.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cfloat>
+#include <future>
+#include <numeric>
+#include <thread>
+
+#include "zeus/CFrustum.hpp"
+#include "zeus/CMRay.hpp"
+#include "zeus/CRaySlab.hpp"
+#include "zeus/CSphere.hpp"
+#include "zeus/SpatialKey.hpp"
+
+#include "ParallelSplit.hpp"
+
+namespace zeus {
+namespace {
+using BVHSimd = simd<float>;
+static_assert(BVHSimd::size() == 4, "CBVH nodes are laid out for 4-wide simd<float>");
+
+constexpr uint32_t BinCount = 16;
+/* Ranges at or below this size are split at the centroid median instead of being binned */
+constexpr uint32_t MedianSplitCount = 12;
+/* Parallel builds bin ranges at least this large across threads, and hand subtrees this large to new tasks */
+constexpr uint32_t ParallelBinCount = 1 << 16;
+constexpr uint32_t ParallelSubtreeCount = 1 << 12;
+/* LBVH builds give each worker of their flat passes at least this many primitives */
+constexpr size_t ParallelLBVHCount = 1 << 13;
+/* Builds keep every leaf within this many levels of the root: LBVH radix trees are at most 64 key bits deep, and
+ * SAH builds switch to even splits below MaxSAHDepth, which finish any 32-bit primitive count in 17 more levels */
+constexpr uint32_t MaxTreeDepth = 64;
+constexpr uint32_t MaxSAHDepth = 40;
+/* Depth-first traversal leaves at most three siblings pending per level, so the stack never outgrows this */
+constexpr size_t StackSize = 3 * MaxTreeDepth + 1;
+
+float surfaceArea(const CAABox& box) {
+  const CVector3f d = box.max - box.min;
+  return d.x() * d.y() + d.y() * d.z() + d.z() * d.x();
+}
+
+void growBounds(CAABox& bounds, const CAABox& other) {
+  bounds.min.mSimd = min(bounds.min.mSimd, other.min.mSimd);
+  bounds.max.mSimd = max(bounds.max.mSimd, other.max.mSimd);
+}
+
+void growBounds(CAABox& bounds, const CVector3f& point) {
+  bounds.min.mSimd = min(bounds.min.mSimd, point.mSimd);
+  bounds.max.mSimd = max(bounds.max.mSimd, point.mSimd);
+}
+
+struct BuildPrim {
+  CAABox bounds;
+  CVector3f centroid;
+  uint32_t index;
+};
+
+struct BuildContext {
+  std::vector<BuildPrim> prims;
+  /* Pre-sized to the worst case; slots are claimed through nodeCount so subtrees can build concurrently */
+  std::vector<CBVH::Node>& nodes;
+  std::atomic<uint32_t> nodeCount{0};
+};
+
+struct BuildRange {
+  uint32_t begin;
+  uint32_t end;
+
+  [[nodiscard]] uint32_t count() const { return end - begin; }
+};
+
+struct SAHBins {
+  std::array<std::array<CAABox, BinCount>, 3> bounds{};
+  std::array<std::array<uint32_t, BinCount>, 3> counts{};
+
+  void merge(const SAHBins& other) {
+    for (int axis = 0; axis < 3; ++axis) {
+      for (uint32_t b = 0; b < BinCount; ++b) {
+        growBounds(bounds[axis][b], other.bounds[axis][b]);
+        counts[axis][b] += other.counts[axis][b];
+      }
+    }
+  }
+};
+
+CAABox rangeBounds(const BuildContext& ctx, const BuildRange& range) {
+  CAABox ret;
+  for (uint32_t i = range.begin; i < range.end; ++i)
+    growBounds(ret, ctx.prims[i].bounds);
+  return ret;
+}
+
+void binRange(const BuildContext& ctx, const BuildRange& range, const CVector3f& lo, const CVector3f& scale,
+              SAHBins& bins) {
+  for (uint32_t i = range.begin; i < range.end; ++i) {
+    const BuildPrim& prim = ctx.prims[i];
+    const simd_floats binf(((prim.centroid - lo) * scale).mSimd);
+    for (int axis = 0; axis < 3; ++axis) {
+      const uint32_t bin = std::min(uint32_t(binf[axis]), BinCount - 1);
+      growBounds(bins.bounds[axis][bin], prim.bounds);
+      ++bins.counts[axis][bin];
+    }
+  }
+}
+
+/* Partitions range by the cheapest binned SAH plane across all three axes and returns the split point */
+uint32_t splitRange(BuildContext& ctx, const BuildRange& range, unsigned threads) {
+  CAABox centroidBounds;
+  for (uint32_t i = range.begin; i < range.end; ++i)
+    growBounds(centroidBounds, ctx.prims[i].centroid);
+
+  const auto first = ctx.prims.begin() + range.begin;
+  const auto last = ctx.prims.begin() + range.end;
+  const CVector3f extent = centroidBounds.max - centroidBounds.min;
+  if (range.count() <= MedianSplitCount) {
+    const int axis = extent.x() > extent.y() ? (extent.x() > extent.z() ? 0 : 2) : (extent.y() > extent.z() ? 1 : 2);
+    const auto mid = first + range.count() / 2;
+    std::nth_element(first, mid, last, [axis](const BuildPrim& a, const BuildPrim& b) {
+      return a.centroid[axis] < b.centroid[axis];
+    });
+    return uint32_t(mid - ctx.prims.begin());
+  }
+
+  /* Bin all three axes in a single pass; degenerate axes get a zero scale and are skipped below */
+  CVector3f scale;
+  for (int axis = 0; axis < 3; ++axis)
+    scale[axis] = extent[axis] > 0.f ? float(BinCount) / extent[axis] : 0.f;
+
+  SAHBins bins;
+  if (threads > 1 && range.count() >= ParallelBinCount) {
+    std::vector<SAHBins> chunkBins(threads);
+    std::vector<std::future<void>> tasks;
+    const uint32_t chunk = (range.count() + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; ++t) {
+      const BuildRange sub{std::min(range.begin + t * chunk, range.end),
+                           std::min(range.begin + (t + 1) * chunk, range.end)};
+      tasks.push_back(std::async(std::launch::async, [&, sub, t] {
+        binRange(ctx, sub, centroidBounds.min, scale, chunkBins[t]);
+      }));
+    }
+    for (unsigned t = 0; t < threads; ++t) {
+      tasks[t].get();
+      bins.merge(chunkBins[t]);
+    }
+  } else {
+    binRange(ctx, range, centroidBounds.min, scale, bins);
+  }
+
+  float bestCost = FLT_MAX;
+  int bestAxis = -1;
+  uint32_t bestBin = 0;
+  for (int axis = 0; axis < 3; ++axis) {
+    if (scale[axis] == 0.f)
+      continue;
+
+    /* Sweep from the right to collect suffix areas, then from the left to evaluate each plane */
+    std::array<float, BinCount> rightArea{};
+    CAABox accum;
+    for (uint32_t b = BinCount - 1; b > 0; --b) {
+      if (bins.counts[axis][b] != 0)
+        growBounds(accum, bins.bounds[axis][b]);
+      rightArea[b] = accum.invalid() ? 0.f : surfaceArea(accum);
+    }
+
+    accum = CAABox();
+    uint32_t leftCount = 0;
+    for (uint32_t b = 0; b < BinCount - 1; ++b) {
+      if (bins.counts[axis][b] != 0)
+        growBounds(accum, bins.bounds[axis][b]);
+      leftCount += bins.counts[axis][b];
+      const uint32_t rightCount = range.count() - leftCount;
+      if (leftCount == 0 || rightCount == 0)
+        continue;
+      const float cost = surfaceArea(accum) * float(leftCount) + rightArea[b + 1] * float(rightCount);
+      if (cost < bestCost) {
+        bestCost = cost;
+        bestAxis = axis;
+        bestBin = b;
+      }
+    }
+  }
+
+  if (bestAxis >= 0) {
+    const float lo = centroidBounds.min[bestAxis];
+    const float axisScale = scale[bestAxis];
+    const auto mid = std::partition(first, last, [&](const BuildPrim& prim) {
+      return std::min(uint32_t((prim.centroid[bestAxis] - lo) * axisScale), BinCount - 1) <= bestBin;
+    });
+    if (mid != first && mid != last)
+      return uint32_t(mid - ctx.prims.begin());
+  }
+
+  /* Coincident centroids; fall back to an even split by index */
+  return range.begin + range.count() / 2;
+}
+
+/* Builds the subtree for range at depth using up to threads workers; returns its node index */
+uint32_t buildNode(BuildContext& ctx, const BuildRange& range, unsigned threads, uint32_t depth) {
+  /* Claim the slot first so every child ends up at a higher index than its parent */
+  const uint32_t nodeIdx = ctx.nodeCount.fetch_add(1, std::memory_order_relaxed);
+
+  /* Open up to four children by repeatedly splitting the most populated one */
+  std::array<BuildRange, 4> lanes{range};
+  size_t laneCount = 1;
+  while (laneCount < 4) {
+    size_t widest = 0;
+    for (size_t i = 1; i < laneCount; ++i)
+      if (lanes[i].count() > lanes[widest].count())
+        widest = i;
+    if (lanes[widest].count() < 2)
+      break;
+    const uint32_t mid = depth < MaxSAHDepth ? splitRange(ctx, lanes[widest], threads)
+                                             : lanes[widest].begin + lanes[widest].count() / 2;
+    lanes[laneCount++] = {mid, lanes[widest].end};
+    lanes[widest].end = mid;
+  }
+
+  CBVH::Node& node = ctx.nodes[nodeIdx];
+  std::array<std::future<uint32_t>, 4> subtrees;
+  const unsigned laneThreads = std::max(1u, threads / unsigned(laneCount));
+  for (size_t i = 0; i < 4; ++i) {
+    if (i >= laneCount) {
+      node.setChildBounds(i, CAABox(FLT_MAX, -FLT_MAX));
+      node.children[i] = CBVH::EmptyChild;
+      continue;
+    }
+    node.setChildBounds(i, rangeBounds(ctx, lanes[i]));
+    if (lanes[i].count() == 1)
+      node.children[i] = CBVH::LeafFlag | ctx.prims[lanes[i].begin].index;
+    else if (threads > 1 && lanes[i].count() >= ParallelSubtreeCount)
+      subtrees[i] = std::async(std::launch::async, [&ctx, lane = lanes[i], laneThreads, depth] {
+        return buildNode(ctx, lane, laneThreads, depth + 1);
+      });
+    else
+      node.children[i] = buildNode(ctx, lanes[i], 1, depth + 1);
+  }
+  for (size_t i = 0; i < laneCount; ++i)
+    if (subtrees[i].valid())
+      node.children[i] = subtrees[i].get();
+  return nodeIdx;
+}
+
+int occupiedLanes(const CBVH::Node& node) {
+  int ret = 0;
+  for (size_t i = 0; i < 4; ++i)
+    if (node.children[i] != CBVH::EmptyChild)
+      ret |= 1 << i;
+  return ret;
+}
+
+/* Visits nodes depth-first, descending into (or emitting) each child lane selected by laneTest */
+template <typename LaneTest>
+void traverse(const std::vector<CBVH::Node>& nodes, LaneTest&& laneTest, std::vector<uint32_t>& out) {
+  if (nodes.empty())
+    return;
+
+  std::array<uint32_t, StackSize> stack;
+  size_t top = 0;
+  stack[top++] = 0;
+  while (top != 0) {
+    const CBVH::Node& node = nodes[stack[--top]];
+    const int mask = laneTest(node);
+    for (size_t i = 0; i < 4; ++i) {
+      if ((mask & (1 << i)) == 0)
+        continue;
+      const uint32_t child = node.children[i];
+      if (child & CBVH::LeafFlag) {
+        out.push_back(child & ~CBVH::LeafFlag);
+      } else {
+        assert(top < StackSize);
+        stack[top++] = child;
+      }
+    }
+  }
+}
+
+/* Empty lanes hold inverted bounds, so they never win these reductions */
+float laneMin(const std::array<float, 4>& lanes) {
+  const BVHSimd v = loadLanes(lanes.data());
+  const BVHSimd pairs = min(v, v.shuffle<2, 3, 0, 1>());
+  return min(pairs, pairs.shuffle<1, 0, 3, 2>())[0];
+}
+
+float laneMax(const std::array<float, 4>& lanes) {
+  const BVHSimd v = loadLanes(lanes.data());
+  const BVHSimd pairs = max(v, v.shuffle<2, 3, 0, 1>());
+  return max(pairs, pairs.shuffle<1, 0, 3, 2>())[0];
+}
+
+/* Returns a lane mask of the child boxes the segment overlaps before tMax, writing each entry distance */
+int raySlabLanes(const CBVH::Node& node, const CRaySlab& slab, float tMax, BVHSimd& tEnterOut) {
+  BVHSimd tExit;
+  return slab.intersectLanes(loadLanes(node.minX.data()), loadLanes(node.minY.data()), loadLanes(node.minZ.data()),
+                             loadLanes(node.maxX.data()), loadLanes(node.maxY.data()), loadLanes(node.maxZ.data()),
+                             tMax, tEnterOut, tExit);
+}
+
+/* Distance between the sorted keys at i and i + 1, whose highest set bit is where their common prefix ends;
+ * duplicate keys fall back to the index bits so that every pair stays distinct */
+uint64_t keyDistance(std::span<const uint32_t> keys, uint32_t i) {
+  const uint32_t diff = keys[i] ^ keys[i + 1];
+  return diff != 0 ? uint64_t(diff) << 32 : uint64_t(i ^ (i + 1));
+}
+
+/* Internal node i of the binary radix tree over the sorted keys splits its leaves between i and i + 1 */
+struct RadixNode {
+  /* Radix node index or (LeafFlag | sorted leaf index) */
+  std::array<uint32_t, 2> children;
+  uint32_t count;
+  /* The far end of the first child to arrive, handed to the second */
+  std::atomic<uint32_t> pendingEnd{CBVH::EmptyChild};
+  CAABox bounds;
+};
+
+struct LBVHContext {
+  /* Primitive indices and boxes in Morton order, so leaves are read sequentially */
+  std::vector<uint32_t> order;
+  std::vector<CAABox> boxes;
+  std::vector<uint32_t> keys;
+  std::vector<RadixNode> radix;
+  /* Pre-sized to the worst case like BuildContext::nodes */
+  std::vector<CBVH::Node>& nodes;
+  std::atomic<uint32_t> nodeCount{0};
+  uint32_t root = 0;
+
+  [[nodiscard]] uint32_t count(uint32_t child) const {
+    return (child & CBVH::LeafFlag) != 0 ? 1 : radix[child].count;
+  }
+  [[nodiscard]] const CAABox& bounds(uint32_t child) const {
+    return (child & CBVH::LeafFlag) != 0 ? boxes[child & ~CBVH::LeafFlag] : radix[child].bounds;
+  }
+};
+
+/* Apetrei, "Fast and simple agglomerative LBVH construction": each leaf climbs the Karras radix tree, a subtree
+ * covering [first, last] being a child of whichever of internal nodes first - 1 and last splits at the lower level.
+ * The first child to reach a node stops there; the second merges the two and carries on, so every node is built
+ * exactly once, bounds included, without searching the keys. A lone worker can skip the atomic handover. */
+template <bool Concurrent>
+void climbLeaves(LBVHContext& ctx, uint32_t begin, uint32_t end) {
+  const uint32_t lastLeaf = uint32_t(ctx.keys.size() - 1);
+  for (uint32_t leaf = begin; leaf < end; ++leaf) {
+    uint32_t first = leaf;
+    uint32_t last = leaf;
+    uint32_t node = CBVH::LeafFlag | leaf;
+    while (first != 0 || last != lastLeaf) {
+      const bool isLeft = first == 0 || (last != lastLeaf && keyDistance(ctx.keys, last) <
+                                                                   keyDistance(ctx.keys, first - 1));
+      const uint32_t parentIdx = isLeft ? last : first - 1;
+      RadixNode& parent = ctx.radix[parentIdx];
+      parent.children[isLeft ? 0 : 1] = node;
+      uint32_t siblingEnd;
+      if constexpr (Concurrent) {
+        siblingEnd = parent.pendingEnd.exchange(isLeft ? first : last, std::memory_order_acq_rel);
+      } else {
+        siblingEnd = parent.pendingEnd.load(std::memory_order_relaxed);
+        parent.pendingEnd.store(isLeft ? first : last, std::memory_order_relaxed);
+      }
+      if (siblingEnd == CBVH::EmptyChild)
+        break;
+
+      (isLeft ? last : first) = siblingEnd;
+      parent.count = last - first + 1;
+      parent.bounds = ctx.bounds(parent.children[0]);
+      growBounds(parent.bounds, ctx.bounds(parent.children[1]));
+      node = parentIdx;
+    }
+    if (first == 0 && last == lastLeaf)
+      ctx.root = node;
+  }
+}
+
+/* Collapses the radix subtree at radixIdx into four-wide nodes; returns its node index */
+uint32_t collapseNode(LBVHContext& ctx, uint32_t radixIdx, unsigned threads) {
+  const uint32_t nodeIdx = ctx.nodeCount.fetch_add(1, std::memory_order_relaxed);
+
+  /* Open up to four children by repeatedly expanding the most populated one, as buildNode splits */
+  std::array<uint32_t, 4> lanes{ctx.radix[radixIdx].children[0], ctx.radix[radixIdx].children[1]};
+  size_t laneCount = 2;
+  while (laneCount < 4) {
+    size_t widest = 0;
+    for (size_t i = 1; i < laneCount; ++i)
+      if (ctx.count(lanes[i]) > ctx.count(lanes[widest]))
+        widest = i;
+    if (ctx.count(lanes[widest]) < 2)
+      break;
+    const RadixNode& open = ctx.radix[lanes[widest]];
+    lanes[laneCount++] = open.children[1];
+    lanes[widest] = open.children[0];
+  }
+
+  CBVH::Node& node = ctx.nodes[nodeIdx];
+  std::array<std::future<uint32_t>, 4> subtrees;
+  const unsigned laneThreads = std::max(1u, threads / unsigned(laneCount));
+  for (size_t i = 0; i < 4; ++i) {
+    if (i >= laneCount) {
+      node.setChildBounds(i, CAABox(FLT_MAX, -FLT_MAX));
+      node.children[i] = CBVH::EmptyChild;
+      continue;
+    }
+    const uint32_t lane = lanes[i];
+    node.setChildBounds(i, ctx.bounds(lane));
+    if ((lane & CBVH::LeafFlag) != 0)
+      node.children[i] = CBVH::LeafFlag | ctx.order[lane & ~CBVH::LeafFlag];
+    else if (threads > 1 && ctx.count(lane) >= ParallelSubtreeCount)
+      subtrees[i] = std::async(std::launch::async,
+                               [&ctx, lane, laneThreads] { return collapseNode(ctx, lane, laneThreads); });
+    else
+      node.children[i] = collapseNode(ctx, lane, 1);
+  }
+  for (size_t i = 0; i < laneCount; ++i)
+    if (subtrees[i].valid())
+      node.children[i] = subtrees[i].get();
+  return nodeIdx;
+}
+} // Anonymous namespace
+
+void CBVH::Node::setChildBounds(size_t i, const CAABox& box) {
+  minX[i] = box.min.x();
+  minY[i] = box.min.y();
+  minZ[i] = box.min.z();
+  maxX[i] = box.max.x();
+  maxY[i] = box.max.y();
+  maxZ[i] = box.max.z();
+}
+
+void CBVH::build(std::span<const CAABox> boxes, unsigned threadCount) {
+  clear();
+  m_primCount = boxes.size();
+  if (boxes.empty())
+    return;
+  if (threadCount == 0)
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+  /* One primitive per leaf and at least two children per node bounds the node count by n - 1 */
+  m_nodes.resize(std::max<size_t>(boxes.size() - 1, 1));
+  BuildContext ctx{{}, m_nodes};
+  ctx.prims.resize(boxes.size());
+  for (size_t i = 0; i < boxes.size(); ++i)
+    ctx.prims[i] = {boxes[i], boxes[i].center(), uint32_t(i)};
+  buildNode(ctx, {0, uint32_t(boxes.size())}, threadCount, 0);
+  m_nodes.resize(ctx.nodeCount.load());
+}
+
+void CBVH::buildLBVH(std::span<const CAABox> boxes, unsigned threadCount) {
+  clear();
+  m_primCount = boxes.size();
+  if (boxes.empty())
+    return;
+  if (threadCount == 0)
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  const size_t count = boxes.size();
+  const size_t workers = parallelWorkers(count, threadCount, ParallelLBVHCount);
+
+  if (count == 1) {
+    Node& root = m_nodes.emplace_back();
+    for (size_t i = 1; i < 4; ++i) {
+      root.setChildBounds(i, CAABox(FLT_MAX, -FLT_MAX));
+      root.children[i] = EmptyChild;
+    }
+    root.setChildBounds(0, boxes[0]);
+    root.children[0] = LeafFlag;
+    return;
+  }
+
+  std::vector<CVector3f> centroids(count);
+  std::vector<CAABox> chunkBounds(workers);
+  const size_t chunks =
+      parallelSplit(count, threadCount, ParallelLBVHCount, 1, [&](size_t w, size_t begin, size_t end) {
+        CAABox bounds;
+        for (size_t i = begin; i < end; ++i) {
+          centroids[i] = boxes[i].center();
+          growBounds(bounds, centroids[i]);
+        }
+        chunkBounds[w] = bounds;
+      });
+  CAABox centroidBounds;
+  for (size_t w = 0; w < chunks; ++w)
+    growBounds(centroidBounds, chunkBounds[w]);
+
+  m_nodes.resize(count - 1);
+  LBVHContext ctx{std::vector<uint32_t>(count), std::vector<CAABox>(count), std::vector<uint32_t>(count),
+                  std::vector<RadixNode>(count - 1), m_nodes};
+  mortonKeys30(centroids, centroidBounds, ctx.keys, threadCount);
+  std::iota(ctx.order.begin(), ctx.order.end(), 0u);
+  radixSortByKey(ctx.keys, ctx.order, threadCount);
+
+  /* The gather is the one scattered read of the build; everything after it walks memory in Morton order */
+  parallelSplit(count, threadCount, ParallelLBVHCount, 1, [&](size_t, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      ctx.boxes[i] = boxes[ctx.order[i]];
+  });
+  if (workers > 1)
+    parallelSplit(count, threadCount, ParallelLBVHCount, 1,
+                  [&](size_t, size_t begin, size_t end) { climbLeaves<true>(ctx, begin, end); });
+  else
+    climbLeaves<false>(ctx, 0, uint32_t(count));
+  collapseNode(ctx, ctx.root, threadCount);
+  m_nodes.resize(ctx.nodeCount.load());
+}
+
+void CBVH::refit(std::span<const CAABox> boxes) {
+  assert(boxes.size() == m_primCount);
+
+  /* Children always sit at higher indices than their parent, so one reverse sweep is bottom-up */
+  for (size_t n = m_nodes.size(); n-- > 0;) {
+    Node& node = m_nodes[n];
+    for (size_t i = 0; i < 4; ++i) {
+      const uint32_t child = node.children[i];
+      if (child == EmptyChild)
+        continue;
+      if (child & LeafFlag) {
+        node.setChildBounds(i, boxes[child & ~LeafFlag]);
+        continue;
+      }
+      const Node& sub = m_nodes[child];
+      node.minX[i] = laneMin(sub.minX);
+      node.minY[i] = laneMin(sub.minY);
+      node.minZ[i] = laneMin(sub.minZ);
+      node.maxX[i] = laneMax(sub.maxX);
+      node.maxY[i] = laneMax(sub.maxY);
+      node.maxZ[i] = laneMax(sub.maxZ);
+    }
+  }
+}
+
+void CBVH::clear() {
+  m_nodes.clear();
+  m_primCount = 0;
+}
+
+CAABox CBVH::bounds() const {
+  CAABox ret;
+  if (m_nodes.empty())
+    return ret;
+  for (size_t i = 0; i < 4; ++i)
+    if (m_nodes[0].children[i] != EmptyChild)
+      ret.accumulateBounds(m_nodes[0].getChildBounds(i));
+  return ret;
+}
+
+void CBVH::queryAABB(const CAABox& box, std::vector<uint32_t>& out) const {
+  const BVHSimd qMinX(box.min.x()), qMinY(box.min.y()), qMinZ(box.min.z());
+  const BVHSimd qMaxX(box.max.x()), qMaxY(box.max.y()), qMaxZ(box.max.z());
+  traverse(
+      m_nodes,
+      [&](const Node& node) {
+        return bitmask(loadLanes(node.maxX.data()) >= qMinX) & bitmask(loadLanes(node.minX.data()) <= qMaxX) &
+               bitmask(loadLanes(node.maxY.data()) >= qMinY) & bitmask(loadLanes(node.minY.data()) <= qMaxY) &
+               bitmask(loadLanes(node.maxZ.data()) >= qMinZ) & bitmask(loadLanes(node.minZ.data()) <= qMaxZ) &
+               occupiedLanes(node);
+      },
+      out);
+}
+
+void CBVH::querySphere(const CSphere& sphere, std::vector<uint32_t>& out) const {
+  const BVHSimd cx(sphere.position.x()), cy(sphere.position.y()), cz(sphere.position.z());
+  const BVHSimd radiusSq(sphere.radius * sphere.radius);
+  const BVHSimd zero(0.f);
+  traverse(
+      m_nodes,
+      [&](const Node& node) {
+        const BVHSimd dx = max(max(loadLanes(node.minX.data()) - cx, cx - loadLanes(node.maxX.data())), zero);
+        const BVHSimd dy = max(max(loadLanes(node.minY.data()) - cy, cy - loadLanes(node.maxY.data())), zero);
+        const BVHSimd dz = max(max(loadLanes(node.minZ.data()) - cz, cz - loadLanes(node.maxZ.data())), zero);
+        return bitmask(dx * dx + dy * dy + dz * dz <= radiusSq) & occupiedLanes(node);
+      },
+      out);
+}
+
+void CBVH::queryFrustum(const CFrustum& frustum, std::vector<uint32_t>& out) const {
+  traverse(
+      m_nodes,
+      [&](const Node& node) {
+        uint32_t visible = 0;
+        frustum.aabbFrustumTest(CAABoxSoA{node.minX, node.minY, node.minZ, node.maxX, node.maxY, node.maxZ},
+                                {&visible, 1});
+        return int(visible) & occupiedLanes(node);
+      },
+      out);
+}
+
+void CBVH::queryRay(const CMRay& ray, std::vector<uint32_t>& out) const {
+  const CRaySlab slab(ray);
+  if (!slab.valid())
+    return;
+  traverse(
+      m_nodes,
+      [&](const Node& node) {
+        BVHSimd tEnter;
+        return raySlabLanes(node, slab, slab.length(), tEnter);
+      },
+      out);
+}
+
+bool CBVH::rayCastClosest(const CMRay& ray, uint32_t& primOut, float& distOut) const {
+  const CRaySlab slab(ray);
+  if (m_nodes.empty() || !slab.valid())
+    return false;
+
+  struct Entry {
+    uint32_t node;
+    float tEnter;
+  };
+  std::array<Entry, StackSize> stack;
+  size_t top = 0;
+  stack[top++] = {0, 0.f};
+
+  bool hit = false;
+  float tClosest = slab.length();
+  while (top != 0) {
+    const Entry entry = stack[--top];
+    if (entry.tEnter > tClosest)
+      continue;
+
+    const Node& node = m_nodes[entry.node];
+    BVHSimd tEnterLanes;
+    const int mask = raySlabLanes(node, slab, tClosest, tEnterLanes);
+    const simd_floats tEnter(tEnterLanes);
+
+    /* Push the farther children first so the nearest is popped next */
+    std::array<size_t, 4> order{};
+    size_t orderCount = 0;
+    for (size_t i = 0; i < 4; ++i) {
+      if ((mask & (1 << i)) == 0)
+        continue;
+      const uint32_t child = node.children[i];
+      if (child & LeafFlag) {
+        if (tEnter[i] <= tClosest) {
+          tClosest = tEnter[i];
+          primOut = child & ~LeafFlag;
+          hit = true;
+        }
+        continue;
+      }
+      size_t j = orderCount++;
+      for (; j > 0 && tEnter[order[j - 1]] < tEnter[i]; --j)
+        order[j] = order[j - 1];
+      order[j] = i;
+    }
+    assert(top + orderCount <= StackSize);
+    for (size_t j = 0; j < orderCount; ++j)
+      stack[top++] = {node.children[order[j]], tEnter[order[j]]};
+  }
+
+  if (hit)
+    distOut = tClosest;
+  return hit;
+}
+
+} // namespace zeus
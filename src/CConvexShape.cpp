@@ -0,0 +1,122 @@
+#include "zeus/CConvexShape.hpp"
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "zeus/CAABox.hpp"
+#include "zeus/CLineSeg.hpp"
+#include "zeus/COBBox.hpp"
+#include "zeus/CSphere.hpp"
+
+namespace zeus {
+namespace {
+using HullSimd = simd<float>;
+constexpr size_t HullLanes = HullSimd::size();
+
+/* p pushed out by radius along dir, for the rounded shapes */
+CVector3f roundOut(const CVector3f& p, const CVector3f& dir, float radius) {
+  const float magSq = dir.magSquared();
+  if (radius == 0.f || !(magSq > 0.f))
+    return p;
+  return p + dir * (radius / std::sqrt(magSq));
+}
+
+/* Per component, hi where dir is not negative and lo elsewhere */
+CVector3f selectCorner(const CVector3f& dir, const CVector3f& lo, const CVector3f& hi) {
+  return CVector3f(_simd::select(dir.mSimd >= HullSimd(0.f), hi.mSimd, lo.mSimd));
+}
+} // Anonymous namespace
+
+CConvexHull::CConvexHull(std::span<const CVector3f> points) : m_size(points.size()) {
+  assert(!points.empty() && points.size() < (1u << 24));
+  const size_t padded = (points.size() + HullLanes - 1) / HullLanes * HullLanes;
+  m_x.reserve(padded);
+  m_y.reserve(padded);
+  m_z.reserve(padded);
+  CVector3f sum;
+  for (size_t i = 0; i < padded; ++i) {
+    const CVector3f& p = points[i < points.size() ? i : 0];
+    m_x.push_back(p.x());
+    m_y.push_back(p.y());
+    m_z.push_back(p.z());
+    if (i < points.size())
+      sum += p;
+  }
+  m_centroid = sum / float(points.size());
+}
+
+CVector3f CConvexHull::support(const CVector3f& dir) const {
+  std::array<float, HullLanes> lanes;
+  for (size_t l = 0; l < HullLanes; ++l)
+    lanes[l] = float(l);
+  HullSimd index = loadLanes(lanes.data());
+  const HullSimd step(static_cast<float>(HullLanes));
+  const HullSimd dx(dir.x()), dy(dir.y()), dz(dir.z());
+  HullSimd best(-std::numeric_limits<float>::infinity());
+  HullSimd bestIndex(0.f);
+  for (size_t i = 0; i < m_x.size(); i += HullLanes) {
+    const HullSimd d = loadLanes(&m_x[i]) * dx + loadLanes(&m_y[i]) * dy + loadLanes(&m_z[i]) * dz;
+    const auto better = d > best;
+    best = _simd::select(better, d, best);
+    bestIndex = _simd::select(better, index, bestIndex);
+    index = index + step;
+  }
+
+  std::array<float, HullLanes> bestLanes, indexLanes;
+  best.copy_to(bestLanes.data(), _simd::element_aligned);
+  bestIndex.copy_to(indexLanes.data(), _simd::element_aligned);
+  size_t lane = 0;
+  for (size_t l = 1; l < HullLanes; ++l)
+    if (bestLanes[l] > bestLanes[lane])
+      lane = l;
+  return point(size_t(indexLanes[lane]));
+}
+
+CConvexShape::CConvexShape(const CSphere& sphere)
+: m_kind(EKind::Sphere), m_a(sphere.position), m_radius(sphere.radius) {}
+
+CConvexShape::CConvexShape(const CAABox& box) : m_kind(EKind::AABox), m_a(box.min), m_b(box.max) {}
+
+CConvexShape::CConvexShape(const COBBox& box)
+: m_kind(EKind::OBBox), m_b(box.extents), m_xf(box.transform), m_basisT(box.transform.basis.transposed()) {}
+
+CConvexShape::CConvexShape(const CLineSeg& seg, float radius)
+: m_kind(EKind::Segment), m_a(seg.x0_start), m_b(seg.x18_end), m_radius(radius) {}
+
+CConvexShape::CConvexShape(const CConvexHull& hull, const CTransform& xf)
+: m_kind(EKind::Hull), m_xf(xf), m_basisT(xf.basis.transposed()), m_hull(&hull) {}
+
+CVector3f CConvexShape::support(const CVector3f& dir) const {
+  switch (m_kind) {
+  case EKind::Sphere:
+    return roundOut(m_a, dir, m_radius);
+  case EKind::AABox:
+    return selectCorner(dir, m_a, m_b);
+  case EKind::OBBox:
+    return m_xf * selectCorner(m_basisT * dir, -m_b, m_b);
+  case EKind::Segment:
+    return roundOut((m_b - m_a).dot(dir) > 0.f ? m_b : m_a, dir, m_radius);
+  case EKind::Hull:
+    /* The support of a linearly mapped set is the map of the support along the transposed direction */
+    return m_xf * m_hull->support(m_basisT * dir);
+  }
+  return m_a;
+}
+
+CVector3f CConvexShape::center() const {
+  switch (m_kind) {
+  case EKind::Sphere:
+    return m_a;
+  case EKind::AABox:
+  case EKind::Segment:
+    return (m_a + m_b) * 0.5f;
+  case EKind::OBBox:
+    return m_xf.origin;
+  case EKind::Hull:
+    return m_xf * m_hull->centroid();
+  }
+  return m_a;
+}
+} // namespace zeus
@@ -0,0 +1,358 @@
+#include "zeus/CDynamicAABBTree.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "zeus/CFrustum.hpp"
+#include "zeus/CMRay.hpp"
+#include "zeus/CRaySlab.hpp"
+
+namespace zeus {
+namespace {
+/* Fat boxes this many margins larger than needed on every side are shrunk again by the next move */
+constexpr float ShrinkMargins = 4.f;
+
+float surfaceArea(const CAABox& box) {
+  const CVector3f d = box.max - box.min;
+  return 2.f * (d.x() * d.y() + d.y() * d.z() + d.z() * d.x());
+}
+
+CAABox merged(const CAABox& a, const CAABox& b) {
+  CAABox ret = a;
+  ret.accumulateBounds(b);
+  return ret;
+}
+} // Anonymous namespace
+
+uint32_t CDynamicAABBTree::insert(const CAABox& box, uint32_t userData) {
+  const uint32_t leaf = allocateNode();
+  Node& node = m_nodes[leaf];
+  node.fat = fatten(box, {});
+  node.box = box;
+  node.height = 0;
+  node.userData = userData;
+  insertLeaf(leaf);
+  ++m_leafCount;
+  return leaf;
+}
+
+void CDynamicAABBTree::remove(uint32_t handle) {
+  assert(contains(handle));
+  removeLeaf(handle);
+  freeNode(handle);
+  --m_leafCount;
+}
+
+bool CDynamicAABBTree::move(uint32_t handle, const CAABox& box, const CVector3f& displacement) {
+  assert(contains(handle));
+  Node& node = m_nodes[handle];
+  node.box = box;
+  const CAABox fat = fatten(box, displacement);
+  if (box.inside(node.fat)) {
+    /* Still covered; keep the old fat box unless it has grown far larger than the motion calls for */
+    const CVector3f slack(ShrinkMargins * m_margin);
+    if (node.fat.inside(CAABox(fat.min - slack, fat.max + slack)))
+      return false;
+  }
+
+  removeLeaf(handle);
+  m_nodes[handle].fat = fat;
+  insertLeaf(handle);
+  return true;
+}
+
+void CDynamicAABBTree::clear() {
+  m_nodes.clear();
+  m_root = NullNode;
+  m_freeList = NullNode;
+  m_leafCount = 0;
+}
+
+float CDynamicAABBTree::areaRatio() const {
+  if (m_root == NullNode)
+    return 0.f;
+  const float rootArea = surfaceArea(m_nodes[m_root].fat);
+  if (rootArea <= 0.f)
+    return 0.f;
+
+  float totalArea = 0.f;
+  for (const Node& node : m_nodes) {
+    if (node.height > 0)
+      totalArea += surfaceArea(node.fat);
+  }
+  return totalArea / rootArea;
+}
+
+uint32_t CDynamicAABBTree::allocateNode() {
+  if (m_freeList == NullNode) {
+    m_nodes.emplace_back();
+    return uint32_t(m_nodes.size() - 1);
+  }
+  const uint32_t index = m_freeList;
+  m_freeList = m_nodes[index].parent;
+  m_nodes[index] = Node{};
+  return index;
+}
+
+void CDynamicAABBTree::freeNode(uint32_t index) {
+  Node& node = m_nodes[index];
+  node.parent = m_freeList;
+  node.child1 = NullNode;
+  node.child2 = NullNode;
+  node.height = -1;
+  m_freeList = index;
+}
+
+void CDynamicAABBTree::insertLeaf(uint32_t leaf) {
+  if (m_root == NullNode) {
+    m_root = leaf;
+    m_nodes[leaf].parent = NullNode;
+    return;
+  }
+
+  /* Descend towards the sibling with the lowest SAH cost, charging each level the growth it inherits */
+  const CAABox leafBox = m_nodes[leaf].fat;
+  uint32_t index = m_root;
+  while (!m_nodes[index].isLeaf()) {
+    const Node& node = m_nodes[index];
+    const float area = surfaceArea(node.fat);
+    const float combinedArea = surfaceArea(merged(node.fat, leafBox));
+    const float cost = 2.f * combinedArea;
+    const float inheritance = 2.f * (combinedArea - area);
+
+    const auto descendCost = [&](uint32_t child) {
+      const Node& c = m_nodes[child];
+      const float grown = surfaceArea(merged(c.fat, leafBox));
+      return (c.isLeaf() ? grown : grown - surfaceArea(c.fat)) + inheritance;
+    };
+    const float cost1 = descendCost(node.child1);
+    const float cost2 = descendCost(node.child2);
+    if (cost < cost1 && cost < cost2)
+      break;
+    index = cost1 < cost2 ? node.child1 : node.child2;
+  }
+
+  const uint32_t sibling = index;
+  const uint32_t oldParent = m_nodes[sibling].parent;
+  const uint32_t newParent = allocateNode();
+  Node& parent = m_nodes[newParent];
+  parent.parent = oldParent;
+  parent.fat = merged(leafBox, m_nodes[sibling].fat);
+  parent.height = m_nodes[sibling].height + 1;
+  parent.child1 = sibling;
+  parent.child2 = leaf;
+  m_nodes[sibling].parent = newParent;
+  m_nodes[leaf].parent = newParent;
+
+  if (oldParent == NullNode) {
+    m_root = newParent;
+    return;
+  }
+  Node& old = m_nodes[oldParent];
+  if (old.child1 == sibling)
+    old.child1 = newParent;
+  else
+    old.child2 = newParent;
+  refitUpward(oldParent);
+}
+
+void CDynamicAABBTree::removeLeaf(uint32_t leaf) {
+  if (leaf == m_root) {
+    m_root = NullNode;
+    return;
+  }
+
+  const uint32_t parent = m_nodes[leaf].parent;
+  const uint32_t grandParent = m_nodes[parent].parent;
+  const uint32_t sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+  m_nodes[sibling].parent = grandParent;
+  freeNode(parent);
+
+  if (grandParent == NullNode) {
+    m_root = sibling;
+    return;
+  }
+  Node& grand = m_nodes[grandParent];
+  if (grand.child1 == parent)
+    grand.child1 = sibling;
+  else
+    grand.child2 = sibling;
+  refitUpward(grandParent);
+}
+
+uint32_t CDynamicAABBTree::balance(uint32_t iA) {
+  Node& a = m_nodes[iA];
+  if (a.isLeaf() || a.height < 2)
+    return iA;
+
+  const uint32_t iB = a.child1;
+  const uint32_t iC = a.child2;
+  Node& b = m_nodes[iB];
+  Node& c = m_nodes[iC];
+  const int skew = c.height - b.height;
+  if (skew >= -1 && skew <= 1)
+    return iA;
+
+  /* Promote the taller child: it takes a's place, a takes its shorter grandchild, and it keeps the taller one */
+  const bool promoteC = skew > 1;
+  const uint32_t iUp = promoteC ? iC : iB;
+  Node& up = m_nodes[iUp];
+  const uint32_t iF = up.child1;
+  const uint32_t iG = up.child2;
+  Node& f = m_nodes[iF];
+  Node& g = m_nodes[iG];
+
+  up.child1 = iA;
+  up.parent = a.parent;
+  a.parent = iUp;
+  if (up.parent == NullNode) {
+    m_root = iUp;
+  } else {
+    Node& p = m_nodes[up.parent];
+    if (p.child1 == iA)
+      p.child1 = iUp;
+    else
+      p.child2 = iUp;
+  }
+
+  const uint32_t iKeep = f.height > g.height ? iF : iG;
+  const uint32_t iGive = f.height > g.height ? iG : iF;
+  Node& keep = m_nodes[iKeep];
+  Node& give = m_nodes[iGive];
+  up.child2 = iKeep;
+  if (promoteC)
+    a.child2 = iGive;
+  else
+    a.child1 = iGive;
+  give.parent = iA;
+
+  const Node& other = promoteC ? b : c;
+  a.fat = merged(other.fat, give.fat);
+  a.height = 1 + std::max(other.height, give.height);
+  up.fat = merged(a.fat, keep.fat);
+  up.height = 1 + std::max(a.height, keep.height);
+  return iUp;
+}
+
+void CDynamicAABBTree::refitUpward(uint32_t index) {
+  while (index != NullNode) {
+    index = balance(index);
+    Node& node = m_nodes[index];
+    const Node& child1 = m_nodes[node.child1];
+    const Node& child2 = m_nodes[node.child2];
+    node.fat = merged(child1.fat, child2.fat);
+    node.height = 1 + std::max(child1.height, child2.height);
+    index = node.parent;
+  }
+}
+
+CAABox CDynamicAABBTree::fatten(const CAABox& box, const CVector3f& displacement) const {
+  CAABox ret(box.min - CVector3f(m_margin), box.max + CVector3f(m_margin));
+  const CVector3f d = displacement * m_displacementScale;
+  for (int i = 0; i < 3; ++i) {
+    if (d[i] < 0.f)
+      ret.min[i] += d[i];
+    else
+      ret.max[i] += d[i];
+  }
+  return ret;
+}
+
+/* Visits nodes depth-first, descending into fat boxes and emitting leaves whose own box boxTest accepts */
+template <typename BoxTest>
+void CDynamicAABBTree::traverse(BoxTest&& boxTest, std::vector<uint32_t>& out) const {
+  if (m_root == NullNode)
+    return;
+
+  std::vector<uint32_t> stack;
+  stack.reserve(64);
+  stack.push_back(m_root);
+  while (!stack.empty()) {
+    const uint32_t index = stack.back();
+    stack.pop_back();
+    const Node& node = m_nodes[index];
+    if (!boxTest(node.fat))
+      continue;
+    if (node.isLeaf()) {
+      if (boxTest(node.box))
+        out.push_back(index);
+      continue;
+    }
+    stack.push_back(node.child2);
+    stack.push_back(node.child1);
+  }
+}
+
+void CDynamicAABBTree::queryAABB(const CAABox& box, std::vector<uint32_t>& out) const {
+  traverse([&](const CAABox& bounds) { return box.intersects(bounds); }, out);
+}
+
+void CDynamicAABBTree::queryFrustum(const CFrustum& frustum, std::vector<uint32_t>& out) const {
+  traverse([&](const CAABox& bounds) { return frustum.aabbFrustumTest(bounds); }, out);
+}
+
+void CDynamicAABBTree::queryRay(const CMRay& ray, std::vector<uint32_t>& out) const {
+  const CRaySlab slab(ray);
+  if (!slab.valid())
+    return;
+  traverse(
+      [&](const CAABox& bounds) {
+        float tEnter, tExit;
+        return slab.intersect(bounds, tEnter, tExit);
+      },
+      out);
+}
+
+bool CDynamicAABBTree::rayCastClosest(const CMRay& ray, uint32_t& handleOut, float& distOut) const {
+  const CRaySlab slab(ray);
+  if (m_root == NullNode || !slab.valid())
+    return false;
+
+  struct Entry {
+    uint32_t node;
+    float tEnter;
+  };
+  std::vector<Entry> stack;
+  stack.reserve(64);
+  float tEnter, tExit;
+  if (slab.intersect(m_nodes[m_root].fat, tEnter, tExit))
+    stack.push_back({m_root, tEnter});
+
+  bool hit = false;
+  float tClosest = slab.length();
+  while (!stack.empty()) {
+    const Entry entry = stack.back();
+    stack.pop_back();
+    if (entry.tEnter > tClosest)
+      continue;
+
+    const Node& node = m_nodes[entry.node];
+    if (node.isLeaf()) {
+      if (slab.intersect(node.box, tEnter, tExit) && tEnter <= tClosest) {
+        tClosest = tEnter;
+        handleOut = entry.node;
+        hit = true;
+      }
+      continue;
+    }
+
+    /* Push the farther child first so the nearer is popped next */
+    float t1, t2;
+    const bool hit1 = slab.intersect(m_nodes[node.child1].fat, t1, tExit) && t1 <= tClosest;
+    const bool hit2 = slab.intersect(m_nodes[node.child2].fat, t2, tExit) && t2 <= tClosest;
+    if (hit1 && hit2) {
+      const bool firstNearer = t1 <= t2;
+      stack.push_back(firstNearer ? Entry{node.child2, t2} : Entry{node.child1, t1});
+      stack.push_back(firstNearer ? Entry{node.child1, t1} : Entry{node.child2, t2});
+    } else if (hit1) {
+      stack.push_back({node.child1, t1});
+    } else if (hit2) {
+      stack.push_back({node.child2, t2});
+    }
+  }
+
+  if (hit)
+    distOut = tClosest;
+  return hit;
+}
+} // namespace zeus
@@ -7,7 +7,174 @@
 #include "zeus/CProjection.hpp"
 #include "zeus/CTransform.hpp"
 
+#if ZEUS_KERNEL_AVX2 || ZEUS_KERNEL_AVX512
+#include <immintrin.h>
+#endif
+
 namespace zeus {
+namespace {
+using FrustumSimd = simd<float>;
+constexpr size_t FrustumLanes = FrustumSimd::size();
+
+/* Returns a lane mask of the boxes that are not entirely behind any plane */
+int aabbFrustumLanes(const CFrustum::SoAPlanes& planes, const std::array<const float*, 6>& bounds) {
+  const FrustumSimd minX = loadLanes(bounds[0]);
+  const FrustumSimd minY = loadLanes(bounds[1]);
+  const FrustumSimd minZ = loadLanes(bounds[2]);
+  const FrustumSimd maxX = loadLanes(bounds[3]);
+  const FrustumSimd maxY = loadLanes(bounds[4]);
+  const FrustumSimd maxZ = loadLanes(bounds[5]);
+
+  const FrustumSimd half(0.5f);
+  const FrustumSimd cx = (minX + maxX) * half;
+  const FrustumSimd cy = (minY + maxY) * half;
+  const FrustumSimd cz = (minZ + maxZ) * half;
+  const FrustumSimd ex = (maxX - minX) * half;
+  const FrustumSimd ey = (maxY - minY) * half;
+  const FrustumSimd ez = (maxZ - minZ) * half;
+
+  constexpr int allLanes = (1 << FrustumLanes) - 1;
+  const FrustumSimd zero(0.f);
+  int outside = 0;
+  for (size_t i = 0; i < 6 && outside != allLanes; ++i) {
+    const FrustumSimd m = cx * FrustumSimd(planes.x[i]) + cy * FrustumSimd(planes.y[i]) +
+                          cz * FrustumSimd(planes.z[i]) + FrustumSimd(planes.d[i]);
+    const FrustumSimd n =
+        ex * FrustumSimd(planes.absX[i]) + ey * FrustumSimd(planes.absY[i]) + ez * FrustumSimd(planes.absZ[i]);
+    outside |= bitmask(m + n < zero);
+  }
+  return ~outside & allLanes;
+}
+
+/* Sets the visibility bit of every box from begin on, FrustumLanes boxes at a time, padding the final run */
+void aabbFrustumBits(const CFrustum::SoAPlanes& planes, const CAABoxSoA& boxes, size_t begin,
+                     std::span<uint32_t> visibleBits) {
+  const size_t count = boxes.size();
+  const std::array<std::span<const float>, 6> spans{boxes.minX, boxes.minY, boxes.minZ,
+                                                   boxes.maxX, boxes.maxY, boxes.maxZ};
+  size_t i = begin;
+  for (; i + FrustumLanes <= count; i += FrustumLanes) {
+    const int mask = aabbFrustumLanes(
+        planes, {&spans[0][i], &spans[1][i], &spans[2][i], &spans[3][i], &spans[4][i], &spans[5][i]});
+    visibleBits[i / 32] |= uint32_t(mask) << (i % 32);
+  }
+
+  if (i < count) {
+    const size_t rem = count - i;
+    std::array<std::array<float, FrustumLanes>, 6> tail{};
+    for (size_t c = 0; c < 6; ++c)
+      std::copy_n(&spans[c][i], rem, tail[c].begin());
+    const int mask = aabbFrustumLanes(planes, {tail[0].data(), tail[1].data(), tail[2].data(), tail[3].data(),
+                                               tail[4].data(), tail[5].data()}) &
+                     ((1 << rem) - 1);
+    visibleBits[i / 32] |= uint32_t(mask) << (i % 32);
+  }
+}
+
+void aabbFrustumKernel(const CFrustum::SoAPlanes& planes, const CAABoxSoA& boxes, std::span<uint32_t> visibleBits) {
+  aabbFrustumBits(planes, boxes, 0, visibleBits);
+}
+
+#if ZEUS_KERNEL_AVX2
+/* Same test eight boxes at a time, evaluated in the same order so results match the baseline kernel exactly */
+ZEUS_TARGET_AVX2 void aabbFrustumKernelAVX2(const CFrustum::SoAPlanes& planes, const CAABoxSoA& boxes,
+                                            std::span<uint32_t> visibleBits) {
+  const size_t count = boxes.size();
+  const __m256 half = _mm256_set1_ps(0.5f);
+  const __m256 zero = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 minX = _mm256_loadu_ps(&boxes.minX[i]);
+    const __m256 minY = _mm256_loadu_ps(&boxes.minY[i]);
+    const __m256 minZ = _mm256_loadu_ps(&boxes.minZ[i]);
+    const __m256 maxX = _mm256_loadu_ps(&boxes.maxX[i]);
+    const __m256 maxY = _mm256_loadu_ps(&boxes.maxY[i]);
+    const __m256 maxZ = _mm256_loadu_ps(&boxes.maxZ[i]);
+
+    const __m256 cx = _mm256_mul_ps(_mm256_add_ps(minX, maxX), half);
+    const __m256 cy = _mm256_mul_ps(_mm256_add_ps(minY, maxY), half);
+    const __m256 cz = _mm256_mul_ps(_mm256_add_ps(minZ, maxZ), half);
+    const __m256 ex = _mm256_mul_ps(_mm256_sub_ps(maxX, minX), half);
+    const __m256 ey = _mm256_mul_ps(_mm256_sub_ps(maxY, minY), half);
+    const __m256 ez = _mm256_mul_ps(_mm256_sub_ps(maxZ, minZ), half);
+
+    int outside = 0;
+    for (size_t p = 0; p < 6 && outside != 0xFF; ++p) {
+      const __m256 m = _mm256_add_ps(
+          _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cx, _mm256_set1_ps(planes.x[p])),
+                                      _mm256_mul_ps(cy, _mm256_set1_ps(planes.y[p]))),
+                        _mm256_mul_ps(cz, _mm256_set1_ps(planes.z[p]))),
+          _mm256_set1_ps(planes.d[p]));
+      const __m256 n = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ex, _mm256_set1_ps(planes.absX[p])),
+                                                   _mm256_mul_ps(ey, _mm256_set1_ps(planes.absY[p]))),
+                                     _mm256_mul_ps(ez, _mm256_set1_ps(planes.absZ[p])));
+      outside |= _mm256_movemask_ps(_mm256_cmp_ps(_mm256_add_ps(m, n), zero, _CMP_LT_OQ));
+    }
+    visibleBits[i / 32] |= uint32_t(~outside & 0xFF) << (i % 32);
+  }
+  aabbFrustumBits(planes, boxes, i, visibleBits);
+}
+#endif
+
+#if ZEUS_KERNEL_AVX512
+/* Sixteen boxes at a time, with a masked final run; fused multiply-adds can flip boxes lying exactly on a plane */
+ZEUS_TARGET_AVX512 void aabbFrustumKernelAVX512(const CFrustum::SoAPlanes& planes, const CAABoxSoA& boxes,
+                                                std::span<uint32_t> visibleBits) {
+  const size_t count = boxes.size();
+  const __m512 half = _mm512_set1_ps(0.5f);
+  const __m512 zero = _mm512_setzero_ps();
+  for (size_t i = 0; i < count; i += 16) {
+    const __mmask16 lanes = count - i >= 16 ? 0xFFFF : __mmask16((1u << (count - i)) - 1);
+    const __m512 minX = _mm512_maskz_loadu_ps(lanes, &boxes.minX[i]);
+    const __m512 minY = _mm512_maskz_loadu_ps(lanes, &boxes.minY[i]);
+    const __m512 minZ = _mm512_maskz_loadu_ps(lanes, &boxes.minZ[i]);
+    const __m512 maxX = _mm512_maskz_loadu_ps(lanes, &boxes.maxX[i]);
+    const __m512 maxY = _mm512_maskz_loadu_ps(lanes, &boxes.maxY[i]);
+    const __m512 maxZ = _mm512_maskz_loadu_ps(lanes, &boxes.maxZ[i]);
+
+    const __m512 cx = _mm512_mul_ps(_mm512_add_ps(minX, maxX), half);
+    const __m512 cy = _mm512_mul_ps(_mm512_add_ps(minY, maxY), half);
+    const __m512 cz = _mm512_mul_ps(_mm512_add_ps(minZ, maxZ), half);
+    const __m512 ex = _mm512_mul_ps(_mm512_sub_ps(maxX, minX), half);
+    const __m512 ey = _mm512_mul_ps(_mm512_sub_ps(maxY, minY), half);
+    const __m512 ez = _mm512_mul_ps(_mm512_sub_ps(maxZ, minZ), half);
+
+    __mmask16 inside = lanes;
+    for (size_t p = 0; p < 6 && inside != 0; ++p) {
+      const __m512 m = _mm512_fmadd_ps(
+          cx, _mm512_set1_ps(planes.x[p]),
+          _mm512_fmadd_ps(cy, _mm512_set1_ps(planes.y[p]),
+                          _mm512_fmadd_ps(cz, _mm512_set1_ps(planes.z[p]), _mm512_set1_ps(planes.d[p]))));
+      const __m512 n = _mm512_fmadd_ps(ex, _mm512_set1_ps(planes.absX[p]),
+                                       _mm512_fmadd_ps(ey, _mm512_set1_ps(planes.absY[p]),
+                                                       _mm512_mul_ps(ez, _mm512_set1_ps(planes.absZ[p]))));
+      inside = _mm512_mask_cmp_ps_mask(inside, _mm512_add_ps(m, n), zero, _CMP_NLT_UQ);
+    }
+    visibleBits[i / 32] |= uint32_t(inside) << (i % 32);
+  }
+}
+#endif
+
+/* Indexed by EKernelISA; visibleBits must be zeroed beforehand */
+using FrustumKernel = void (*)(const CFrustum::SoAPlanes& planes, const CAABoxSoA& boxes,
+                               std::span<uint32_t> visibleBits);
+constexpr std::array<FrustumKernel, KernelISACount> FrustumKernelTable{
+    aabbFrustumKernel,
+#if ZEUS_KERNEL_AVX2
+    aabbFrustumKernelAVX2,
+#else
+    aabbFrustumKernel,
+#endif
+#if ZEUS_KERNEL_AVX512
+    aabbFrustumKernelAVX512,
+#else
+    aabbFrustumKernel,
+#endif
+};
+
+/* Boxes are culled in chunks of this many, a whole number of visibility words */
+constexpr size_t CullChunkSize = 256;
+} // Anonymous namespace
 
 void CFrustum::updatePlanes(const CMatrix4f& viewMtx, const CMatrix4f& projection) {
   const CMatrix4f mvp = projection * viewMtx;
@@ -38,6 +205,16 @@ void CFrustum::updatePlanes(const CMatrix4f& viewMtx, const CMatrix4f& projectio
   planes[4].normalize();
   planes[5].normalize();
 
+  for (size_t i = 0; i < planes.size(); ++i) {
+    soaPlanes.x[i] = planes[i].x();
+    soaPlanes.y[i] = planes[i].y();
+    soaPlanes.z[i] = planes[i].z();
+    soaPlanes.d[i] = planes[i].d();
+    soaPlanes.absX[i] = std::fabs(soaPlanes.x[i]);
+    soaPlanes.absY[i] = std::fabs(soaPlanes.y[i]);
+    soaPlanes.absZ[i] = std::fabs(soaPlanes.z[i]);
+  }
+
   valid = true;
 }
 
@@ -64,6 +241,50 @@ bool CFrustum::aabbFrustumTest(const CAABox& aabb) const {
   });
 }
 
+void CFrustum::aabbFrustumTest(const CAABoxSoA& boxes, std::span<uint32_t> visibleBits) const {
+  const size_t count = boxes.size();
+  assert(visibleBits.size() >= (count + 31) / 32);
+  std::fill_n(visibleBits.begin(), (count + 31) / 32, 0u);
+
+  if (!valid) {
+    for (size_t i = 0; i < count; ++i)
+      visibleBits[i / 32] |= 1u << (i % 32);
+    return;
+  }
+
+  FrustumKernelTable[size_t(kernelISA())](soaPlanes, boxes, visibleBits);
+}
+
+size_t CFrustum::aabbFrustumCull(const CAABoxSoA& boxes, std::span<uint32_t> visibleIndices) const {
+  const size_t count = boxes.size();
+  assert(visibleIndices.size() >= count);
+
+  if (!valid) {
+    for (size_t i = 0; i < count; ++i)
+      visibleIndices[i] = uint32_t(i);
+    return count;
+  }
+
+  const FrustumKernel kernel = FrustumKernelTable[size_t(kernelISA())];
+  size_t written = 0;
+  for (size_t first = 0; first < count; first += CullChunkSize) {
+    const size_t chunk = std::min(CullChunkSize, count - first);
+    const CAABoxSoA chunkBoxes{boxes.minX.subspan(first, chunk), boxes.minY.subspan(first, chunk),
+                               boxes.minZ.subspan(first, chunk), boxes.maxX.subspan(first, chunk),
+                               boxes.maxY.subspan(first, chunk), boxes.maxZ.subspan(first, chunk)};
+    std::array<uint32_t, CullChunkSize / 32> visibleBits{};
+    kernel(soaPlanes, chunkBoxes, visibleBits);
+    for (size_t w = 0; w < visibleBits.size(); ++w) {
+      uint32_t bits = visibleBits[w];
+      for (size_t bit = 0; bits != 0; ++bit, bits >>= 1) {
+        if (bits & 1)
+          visibleIndices[written++] = uint32_t(first + w * 32 + bit);
+      }
+    }
+  }
+  return written;
+}
+
 bool CFrustum::sphereFrustumTest(const CSphere& sphere) const {
   if (!valid) {
     return true;
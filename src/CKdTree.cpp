@@ -0,0 +1,242 @@
+#include "zeus/CKdTree.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+#include "ParallelSplit.hpp"
+
+namespace zeus {
+namespace {
+using KdSimd = simd<float>;
+constexpr uint32_t KdLanes = KdSimd::size();
+static_assert(CKdTree::LeafSize % KdLanes == 0, "CKdTree leaves are scanned a whole register at a time");
+/* Median splits keep the depth below 32 for any uint32_t point count, and a depth-first search never holds more
+ * than one pending sibling per level */
+constexpr size_t StackSize = 64;
+/* Each worker of a batch query gets at least this many queries */
+constexpr size_t ParallelQueryCount = 1 << 8;
+
+float boxDistanceSq(const std::array<float, 3>& min, const std::array<float, 3>& max, const CVector3f& point) {
+  float ret = 0.f;
+  for (int axis = 0; axis < 3; ++axis) {
+    const float d = std::max(std::max(min[axis] - point[axis], point[axis] - max[axis]), 0.f);
+    ret += d * d;
+  }
+  return ret;
+}
+} // Anonymous namespace
+
+void CKdTree::build(std::span<const CVector3f> points) {
+  clear();
+  m_pointCount = points.size();
+  if (points.empty())
+    return;
+
+  std::vector<std::pair<CVector3f, uint32_t>> work(points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+    work[i] = {points[i], uint32_t(i)};
+  m_nodes.reserve(points.size() / (LeafSize / 2) + 1);
+  m_nodes.emplace_back();
+  buildNode(work, 0, 0, uint32_t(points.size()));
+}
+
+void CKdTree::buildNode(std::vector<std::pair<CVector3f, uint32_t>>& points, uint32_t node, uint32_t begin,
+                        uint32_t end) {
+  CAABox bounds;
+  for (uint32_t i = begin; i < end; ++i)
+    bounds.accumulateBounds(points[i].first);
+  for (int axis = 0; axis < 3; ++axis) {
+    m_nodes[node].min[axis] = bounds.min[axis];
+    m_nodes[node].max[axis] = bounds.max[axis];
+  }
+
+  const uint32_t count = end - begin;
+  if (count <= LeafSize) {
+    m_nodes[node].first = uint32_t(m_x.size());
+    m_nodes[node].count = count;
+    for (uint32_t i = begin; i < end; ++i) {
+      m_x.push_back(points[i].first.x());
+      m_y.push_back(points[i].first.y());
+      m_z.push_back(points[i].first.z());
+      m_indices.push_back(points[i].second);
+    }
+    while (m_x.size() % KdLanes != 0) {
+      m_x.push_back(NAN);
+      m_y.push_back(NAN);
+      m_z.push_back(NAN);
+      m_indices.push_back(UINT32_MAX);
+    }
+    return;
+  }
+
+  /* Split at the median of the widest axis, rounded so the left half fills whole registers */
+  const CVector3f extent = bounds.max - bounds.min;
+  const int axis = extent.x() > extent.y() ? (extent.x() > extent.z() ? 0 : 2) : (extent.y() > extent.z() ? 1 : 2);
+  const uint32_t mid = begin + ((count / 2 + KdLanes - 1) & ~(KdLanes - 1));
+  std::nth_element(points.begin() + begin, points.begin() + mid, points.begin() + end,
+                   [axis](const auto& a, const auto& b) { return a.first[axis] < b.first[axis]; });
+
+  const uint32_t child = uint32_t(m_nodes.size());
+  m_nodes.resize(m_nodes.size() + 2);
+  m_nodes[node].first = child;
+  m_nodes[node].count = 0;
+  buildNode(points, child, begin, mid);
+  buildNode(points, child + 1, mid, end);
+}
+
+void CKdTree::clear() {
+  m_nodes.clear();
+  m_x.clear();
+  m_y.clear();
+  m_z.clear();
+  m_indices.clear();
+  m_pointCount = 0;
+}
+
+CAABox CKdTree::bounds() const {
+  if (m_nodes.empty())
+    return {};
+  const Node& root = m_nodes.front();
+  return {root.min[0], root.min[1], root.min[2], root.max[0], root.max[1], root.max[2]};
+}
+
+size_t CKdTree::queryNearest(const CVector3f& point, std::span<SNeighbor> out, float maxDistance,
+                             float epsilon) const {
+  assert(epsilon >= 0.f);
+  if (m_nodes.empty() || out.empty())
+    return 0;
+
+  /* Candidates form a max-heap on distance in out[0, found) until the search ends. Until out is full they only need
+   * to lie within maxDistance; after that they must beat the farthest candidate, which is also when approximate
+   * searches start scaling node distances */
+  const auto closer = [](const SNeighbor& a, const SNeighbor& b) { return a.distanceSq < b.distanceSq; };
+  const float nodeScale = (1.f + epsilon) * (1.f + epsilon);
+  size_t found = 0;
+  float bound = maxDistance * maxDistance;
+  const auto within = [&](float distanceSq) {
+    return found == out.size() ? distanceSq < bound : distanceSq <= bound;
+  };
+
+  struct Pending {
+    uint32_t node;
+    float distanceSq;
+  };
+  std::array<Pending, StackSize> stack;
+  size_t top = 0;
+  stack[top++] = {0, boxDistanceSq(m_nodes[0].min, m_nodes[0].max, point)};
+  const KdSimd px(point.x()), py(point.y()), pz(point.z());
+  while (top > 0) {
+    const Pending pending = stack[--top];
+    if (!within(found == out.size() ? pending.distanceSq * nodeScale : pending.distanceSq))
+      continue;
+
+    const Node& node = m_nodes[pending.node];
+    if (node.count == 0) {
+      /* Push the farther child first so the nearer one is searched first */
+      const float left = boxDistanceSq(m_nodes[node.first].min, m_nodes[node.first].max, point);
+      const float right = boxDistanceSq(m_nodes[node.first + 1].min, m_nodes[node.first + 1].max, point);
+      if (left <= right) {
+        stack[top++] = {node.first + 1, right};
+        stack[top++] = {node.first, left};
+      } else {
+        stack[top++] = {node.first, left};
+        stack[top++] = {node.first + 1, right};
+      }
+      continue;
+    }
+
+    for (uint32_t i = node.first; i < node.first + node.count; i += KdLanes) {
+      const KdSimd dx = loadLanes(&m_x[i]) - px;
+      const KdSimd dy = loadLanes(&m_y[i]) - py;
+      const KdSimd dz = loadLanes(&m_z[i]) - pz;
+      const KdSimd distSq = dx * dx + dy * dy + dz * dz;
+      for (int mask = bitmask(distSq <= KdSimd(bound)); mask != 0; mask &= mask - 1) {
+        const int lane = std::countr_zero(unsigned(mask));
+        const float d = distSq[lane];
+        if (!within(d))
+          continue;
+        if (found == out.size())
+          std::pop_heap(out.begin(), out.end(), closer);
+        else
+          ++found;
+        out[found - 1] = {m_indices[i + lane], d};
+        std::push_heap(out.begin(), out.begin() + found, closer);
+        if (found == out.size())
+          bound = out.front().distanceSq;
+      }
+    }
+  }
+  std::sort_heap(out.begin(), out.begin() + found, closer);
+  return found;
+}
+
+void CKdTree::queryRadius(const CVector3f& center, float radius, std::vector<uint32_t>& out) const {
+  if (m_nodes.empty())
+    return;
+
+  const float radiusSq = radius * radius;
+  const KdSimd px(center.x()), py(center.y()), pz(center.z()), limit(radiusSq);
+  std::array<uint32_t, StackSize> stack;
+  size_t top = 0;
+  stack[top++] = 0;
+  while (top > 0) {
+    const Node& node = m_nodes[stack[--top]];
+    if (!(boxDistanceSq(node.min, node.max, center) <= radiusSq))
+      continue;
+    if (node.count == 0) {
+      stack[top++] = node.first + 1;
+      stack[top++] = node.first;
+      continue;
+    }
+
+    for (uint32_t i = node.first; i < node.first + node.count; i += KdLanes) {
+      const KdSimd dx = loadLanes(&m_x[i]) - px;
+      const KdSimd dy = loadLanes(&m_y[i]) - py;
+      const KdSimd dz = loadLanes(&m_z[i]) - pz;
+      for (int mask = bitmask(dx * dx + dy * dy + dz * dz <= limit); mask != 0; mask &= mask - 1)
+        out.push_back(m_indices[i + std::countr_zero(unsigned(mask))]);
+    }
+  }
+}
+
+void CKdTree::queryNearest(std::span<const CVector3f> points, uint32_t k, std::span<SNeighbor> out,
+                           std::span<uint32_t> counts, float maxDistance, float epsilon, unsigned threadCount) const {
+  assert(out.size() >= points.size() * k && counts.size() >= points.size());
+  parallelSplit(points.size(), threadCount, ParallelQueryCount, 1, [&](size_t, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      counts[i] = uint32_t(queryNearest(points[i], out.subspan(i * k, k), maxDistance, epsilon));
+  });
+}
+
+void CKdTree::queryRadius(std::span<const CVector3f> centers, float radius, std::vector<uint32_t>& out,
+                          std::span<uint32_t> offsets, unsigned threadCount) const {
+  assert(offsets.size() > centers.size());
+
+  /* Workers collect their chunk's matches with chunk-relative offsets, then the chunks are appended in order */
+  struct Chunk {
+    size_t begin = 0;
+    std::vector<uint32_t> matches;
+  };
+  std::vector<Chunk> chunks(parallelWorkers(centers.size(), threadCount, ParallelQueryCount));
+  const size_t chunkCount =
+      parallelSplit(centers.size(), threadCount, ParallelQueryCount, 1, [&](size_t w, size_t begin, size_t end) {
+        Chunk& chunk = chunks[w];
+        chunk.begin = begin;
+        for (size_t i = begin; i < end; ++i) {
+          offsets[i] = uint32_t(chunk.matches.size());
+          queryRadius(centers[i], radius, chunk.matches);
+        }
+      });
+
+  for (size_t c = 0; c < chunkCount; ++c) {
+    const size_t end = c + 1 < chunkCount ? chunks[c + 1].begin : centers.size();
+    const uint32_t base = uint32_t(out.size());
+    for (size_t i = chunks[c].begin; i < end; ++i)
+      offsets[i] += base;
+    out.insert(out.end(), chunks[c].matches.begin(), chunks[c].matches.end());
+  }
+  offsets[centers.size()] = uint32_t(out.size());
+}
+} // namespace zeus
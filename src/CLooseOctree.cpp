@@ -0,0 +1,23 @@
+#include "zeus/CLooseOctree.hpp"
+
+#include <cassert>
+
+#include "zeus/CFrustum.hpp"
+
+namespace zeus {
+CLooseOctree::CLooseOctree(const CAABox& bounds, uint32_t maxDepth) : CLooseTree(bounds, maxDepth) {
+  assert(maxDepth <= MaxDepth && !bounds.invalid());
+}
+
+void CLooseOctree::queryPoint(const CVector3f& point, std::vector<uint32_t>& out) const {
+  traverse([&](const CAABox& bounds) { return bounds.pointInside(point); }, out);
+}
+
+void CLooseOctree::queryAABB(const CAABox& box, std::vector<uint32_t>& out) const {
+  traverse([&](const CAABox& bounds) { return box.intersects(bounds); }, out);
+}
+
+void CLooseOctree::queryFrustum(const CFrustum& frustum, std::vector<uint32_t>& out) const {
+  traverse([&](const CAABox& bounds) { return frustum.aabbFrustumTest(bounds); }, out);
+}
+} // namespace zeus
@@ -0,0 +1,17 @@
+#include "zeus/CLooseQuadtree.hpp"
+
+#include <cassert>
+
+namespace zeus {
+CLooseQuadtree::CLooseQuadtree(const CRectangle& bounds, uint32_t maxDepth) : CLooseTree(bounds, maxDepth) {
+  assert(maxDepth <= MaxDepth && bounds.size.x() >= 0.f && bounds.size.y() >= 0.f);
+}
+
+void CLooseQuadtree::queryPoint(const CVector2f& point, std::vector<uint32_t>& out) const {
+  traverse([&](const CRectangle& bounds) { return bounds.contains(point); }, out);
+}
+
+void CLooseQuadtree::queryRect(const CRectangle& rect, std::vector<uint32_t>& out) const {
+  traverse([&](const CRectangle& bounds) { return rect.intersects(bounds); }, out);
+}
+} // namespace zeus
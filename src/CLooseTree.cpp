@@ -0,0 +1,236 @@
+#include "zeus/CLooseTree.hpp"
+
+#include <cassert>
+#include <utility>
+
+#include "zeus/CAABox.hpp"
+#include "zeus/CRectangle.hpp"
+
+namespace zeus {
+namespace {
+CVector3f center(const CAABox& box) { return box.center(); }
+CVector2f center(const CRectangle& rect) { return rect.position + rect.size * 0.5f; }
+
+CVector3f extent(const CAABox& box) { return box.max - box.min; }
+CVector2f extent(const CRectangle& rect) { return rect.size; }
+
+bool holds(const CAABox& cell, const CVector3f& point) { return cell.pointInside(point); }
+bool holds(const CRectangle& cell, const CVector2f& point) { return cell.contains(point); }
+
+/* Octant child of cell: bit 0 selects the +x half, bit 1 +y and bit 2 +z */
+CAABox childCell(const CAABox& cell, uint32_t child) {
+  CAABox neg, pos;
+  cell.splitX(neg, pos);
+  const CAABox x = (child & 1) != 0 ? pos : neg;
+  x.splitY(neg, pos);
+  const CAABox xy = (child & 2) != 0 ? pos : neg;
+  xy.splitZ(neg, pos);
+  return (child & 4) != 0 ? pos : neg;
+}
+
+/* Quadrant child of cell: bit 0 selects the +x half and bit 1 the +y half */
+CRectangle childCell(const CRectangle& cell, uint32_t child) {
+  const CVector2f half = cell.size * 0.5f;
+  return {cell.position.x() + ((child & 1) != 0 ? half.x() : 0.f),
+          cell.position.y() + ((child & 2) != 0 ? half.y() : 0.f), half.x(), half.y()};
+}
+
+/* Cell grown by half a cell on every side */
+CAABox looseCell(const CAABox& cell) {
+  const CVector3f half = cell.extents();
+  return CAABox(cell.min - half, cell.max + half);
+}
+
+CRectangle looseCell(const CRectangle& cell) {
+  CRectangle loose;
+  loose.position = cell.position - cell.size * 0.5f;
+  loose.size = cell.size * 2.f;
+  return loose;
+}
+} // Anonymous namespace
+
+template <uint32_t Dim, typename Box>
+CLooseTree<Dim, Box>::CLooseTree(const Box& bounds, uint32_t maxDepth) : m_bounds(bounds), m_maxDepth(maxDepth) {
+  Node& root = m_nodes.emplace_back();
+  root.cell = bounds;
+  root.loose = bounds;
+}
+
+template <uint32_t Dim, typename Box>
+void CLooseTree<Dim, Box>::insert(uint32_t id, const Box& box) {
+  if (id >= m_objects.size())
+    m_objects.resize(id + 1);
+  assert(!contains(id));
+  m_objects[id].box = box;
+  attach(id, acquireNode(box));
+  ++m_objectCount;
+}
+
+template <uint32_t Dim, typename Box>
+void CLooseTree<Dim, Box>::remove(uint32_t id) {
+  assert(contains(id));
+  detach(id);
+  --m_objectCount;
+  /* Compact once released blocks make up half the pool, which also restores the Morton layout */
+  if (m_freeBlocks.size() * ChildCount * 2 > m_nodes.size())
+    optimize();
+}
+
+template <uint32_t Dim, typename Box>
+void CLooseTree<Dim, Box>::move(uint32_t id, const Box& box) {
+  assert(contains(id));
+  Object& object = m_objects[id];
+  object.box = box;
+  if (belongsTo(object.node, box)) {
+    m_nodes[object.node].entries[object.slot].box = box;
+    return;
+  }
+  detach(id);
+  attach(id, acquireNode(box));
+}
+
+template <uint32_t Dim, typename Box>
+void CLooseTree<Dim, Box>::clear() {
+  m_nodes.resize(1);
+  Node& root = m_nodes.front();
+  root.firstChild = NullNode;
+  root.count = 0;
+  root.entries.clear();
+  m_freeBlocks.clear();
+  m_objects.clear();
+  m_objectCount = 0;
+}
+
+template <uint32_t Dim, typename Box>
+void CLooseTree<Dim, Box>::optimize() {
+  std::vector<Node> nodes;
+  nodes.reserve(nodeCount());
+  nodes.push_back(std::move(m_nodes.front()));
+
+  /* Places child blocks in depth-first order, visiting children in Morton order. Until a node is popped, its
+   * firstChild still indexes the old pool */
+  std::vector<uint32_t> stack{0};
+  while (!stack.empty()) {
+    const uint32_t parent = stack.back();
+    stack.pop_back();
+    const uint32_t oldFirst = nodes[parent].firstChild;
+    if (oldFirst == NullNode)
+      continue;
+    const uint32_t first = uint32_t(nodes.size());
+    nodes[parent].firstChild = first;
+    for (uint32_t i = 0; i < ChildCount; ++i) {
+      Node& child = nodes.emplace_back(std::move(m_nodes[oldFirst + i]));
+      child.parent = parent;
+      for (const Entry& entry : child.entries)
+        m_objects[entry.id].node = first + i;
+    }
+    for (uint32_t i = ChildCount; i-- > 0;)
+      stack.push_back(first + i);
+  }
+  m_nodes = std::move(nodes);
+  m_freeBlocks.clear();
+}
+
+template <uint32_t Dim, typename Box>
+uint32_t CLooseTree<Dim, Box>::targetDepth(const Box& box) const {
+  if (!holds(m_bounds, center(box)))
+    return 0;
+
+  /* Loose cells hold any object no larger than the cell whose centre lies inside it */
+  const auto size = extent(box);
+  auto cellSize = extent(m_bounds);
+  uint32_t depth = 0;
+  for (; depth < m_maxDepth; ++depth) {
+    cellSize = cellSize * 0.5f;
+    bool fits = true;
+    for (uint32_t axis = 0; axis < Dim; ++axis)
+      fits = fits && size[axis] <= cellSize[axis];
+    if (!fits)
+      break;
+  }
+  return depth;
+}
+
+template <uint32_t Dim, typename Box>
+bool CLooseTree<Dim, Box>::belongsTo(uint32_t node, const Box& box) const {
+  const Node& n = m_nodes[node];
+  return n.depth == targetDepth(box) && (n.depth == 0 || holds(n.cell, center(box)));
+}
+
+template <uint32_t Dim, typename Box>
+uint32_t CLooseTree<Dim, Box>::acquireNode(const Box& box) {
+  const uint32_t depth = targetDepth(box);
+  const auto c = center(box);
+  uint32_t index = 0;
+  while (m_nodes[index].depth < depth) {
+    if (m_nodes[index].firstChild == NullNode)
+      allocateChildren(index);
+    const Node& node = m_nodes[index];
+    const auto mid = center(node.cell);
+    uint32_t child = 0;
+    for (uint32_t axis = 0; axis < Dim; ++axis)
+      child |= uint32_t(c[axis] >= mid[axis]) << axis;
+    index = node.firstChild + child;
+  }
+  return index;
+}
+
+template <uint32_t Dim, typename Box>
+void CLooseTree<Dim, Box>::allocateChildren(uint32_t parent) {
+  uint32_t first;
+  if (m_freeBlocks.empty()) {
+    first = uint32_t(m_nodes.size());
+    m_nodes.resize(m_nodes.size() + ChildCount);
+  } else {
+    first = m_freeBlocks.back();
+    m_freeBlocks.pop_back();
+  }
+
+  const Box cell = m_nodes[parent].cell;
+  const uint32_t depth = m_nodes[parent].depth + 1;
+  for (uint32_t i = 0; i < ChildCount; ++i) {
+    Node& child = m_nodes[first + i];
+    child.cell = childCell(cell, i);
+    child.loose = looseCell(child.cell);
+    child.parent = parent;
+    child.firstChild = NullNode;
+    child.depth = depth;
+    child.count = 0;
+    child.entries.clear();
+  }
+  m_nodes[parent].firstChild = first;
+}
+
+template <uint32_t Dim, typename Box>
+void CLooseTree<Dim, Box>::attach(uint32_t id, uint32_t node) {
+  Object& object = m_objects[id];
+  std::vector<Entry>& entries = m_nodes[node].entries;
+  object.node = node;
+  object.slot = uint32_t(entries.size());
+  entries.push_back({object.box, id});
+  for (uint32_t n = node; n != NullNode; n = m_nodes[n].parent)
+    ++m_nodes[n].count;
+}
+
+template <uint32_t Dim, typename Box>
+void CLooseTree<Dim, Box>::detach(uint32_t id) {
+  Object& object = m_objects[id];
+  std::vector<Entry>& entries = m_nodes[object.node].entries;
+  m_objects[entries.back().id].slot = object.slot;
+  entries[object.slot] = entries.back();
+  entries.pop_back();
+
+  /* Release the children of every node left empty, keeping empty subtrees out of the traversal */
+  for (uint32_t n = object.node; n != NullNode; n = m_nodes[n].parent) {
+    Node& node = m_nodes[n];
+    if (--node.count == 0 && node.firstChild != NullNode) {
+      m_freeBlocks.push_back(node.firstChild);
+      node.firstChild = NullNode;
+    }
+  }
+  object.node = NullNode;
+}
+
+template class CLooseTree<3, CAABox>;
+template class CLooseTree<2, CRectangle>;
+} // namespace zeus
@@ -1,132 +1,402 @@
 #include "zeus/COBBox.hpp"
 
+#include <algorithm>
+#include <cassert>
 #include <cfloat>
 #include <cmath>
 
+#include "zeus/Math.hpp"
+
+#if ZEUS_KERNEL_AVX2 || ZEUS_KERNEL_AVX512
+#include <immintrin.h>
+#endif
+
 namespace zeus {
+namespace {
+using OBBSimd = simd<float>;
+constexpr size_t OBBLanes = OBBSimd::size();
+constexpr int AllLanes = (1 << OBBLanes) - 1;
+/* Lanes of the widest kernel */
+constexpr size_t MaxLanes = 16;
 
-CAABox COBBox::calculateAABox(const CTransform& worldXf) const {
-  CAABox ret;
-
-  CTransform trans = worldXf * transform;
-  static const CVector3f basis[8] = {{1.f, 1.f, 1.f},    {1.f, 1.f, -1.f},  {1.f, -1.f, 1.f},  {1.f, -1.f, -1.f},
-                                     {-1.f, -1.f, -1.f}, {-1.f, -1.f, 1.f}, {-1.f, 1.f, -1.f}, {-1.f, 1.f, 1.f}};
-  CVector3f p = extents * basis[0];
-  ret.accumulateBounds(trans * p);
-  p = extents * basis[1];
-  ret.accumulateBounds(trans * p);
-  p = extents * basis[2];
-  ret.accumulateBounds(trans * p);
-  p = extents * basis[3];
-  ret.accumulateBounds(trans * p);
-  p = extents * basis[4];
-  ret.accumulateBounds(trans * p);
-  p = extents * basis[5];
-  ret.accumulateBounds(trans * p);
-  p = extents * basis[6];
-  ret.accumulateBounds(trans * p);
-  p = extents * basis[7];
-  ret.accumulateBounds(trans * p);
+template <typename V>
+using Vec3 = std::array<V, 3>;
+template <typename V>
+using Mat3 = std::array<Vec3<V>, 3>;
+
+float absValue(float v) { return std::fabs(v); }
+OBBSimd absValue(const OBBSimd& v) { return max(v, -v); }
+
+/**
+ * Separating axis test of box B against box A, given B's center T and rotation R = A^T B in A's frame and both
+ * half extents. separates(t, r) receives each axis' projected center distance and radius sum and returns true
+ * once no further axis can change the outcome; so does this function.
+ */
+template <typename V, typename Separates>
+bool separatingAxes(const Vec3<V>& T, const Mat3<V>& R, const Vec3<V>& ea, const Vec3<V>& eb,
+                    Separates&& separates) {
+  /* Spelled out rather than looped so every index is a constant and the matrices stay in registers */
+  const Mat3<V> AR{{{absValue(R[0][0]), absValue(R[0][1]), absValue(R[0][2])},
+                    {absValue(R[1][0]), absValue(R[1][1]), absValue(R[1][2])},
+                    {absValue(R[2][0]), absValue(R[2][1]), absValue(R[2][2])}}};
+  const V epsilon(FLT_EPSILON);
+
+  /* A's axes */
+  const auto faceA = [&](int i) {
+    const V rb = (eb[0] * AR[i][0]) + (eb[1] * AR[i][1]) + (eb[2] * AR[i][2]);
+    return separates(absValue(T[i]), ea[i] + rb + epsilon);
+  };
+  /* B's axes */
+  const auto faceB = [&](int k) {
+    const V ra = (ea[0] * AR[0][k]) + (ea[1] * AR[1][k]) + (ea[2] * AR[2][k]);
+    return separates(absValue(T[0] * R[0][k] + T[1] * R[1][k] + T[2] * R[2][k]), ra + eb[k] + epsilon);
+  };
+  /* Ai x Bk */
+  const auto edge = [&](int i, int k) {
+    const int i1 = (i + 1) % 3;
+    const int i2 = (i + 2) % 3;
+    const int k1 = (k + 1) % 3;
+    const int k2 = (k + 2) % 3;
+    const V ra = (ea[i1] * AR[i2][k]) + (ea[i2] * AR[i1][k]);
+    const V rb = (eb[k1] * AR[i][k2]) + (eb[k2] * AR[i][k1]);
+    return separates(absValue((T[i2] * R[i1][k]) - (T[i1] * R[i2][k])), ra + rb + epsilon);
+  };
+  return faceA(0) || faceA(1) || faceA(2) || faceB(0) || faceB(1) || faceB(2) || edge(0, 0) || edge(0, 1) ||
+         edge(0, 2) || edge(1, 0) || edge(1, 1) || edge(1, 2) || edge(2, 0) || edge(2, 1) || edge(2, 2);
+}
+
+bool separatedAt(float t, float r) { return t > r; }
+
+/**
+ * The 15 component rows of a run of boxes, each holding at least one register of the widest kernel: origin, then
+ * basis column by column as in COBBoxSoA, then extents
+ */
+using LaneRows = std::array<const float*, 15>;
+using LaneStaging = std::array<std::array<float, MaxLanes>, 15>;
 
+/* Every lane holds box */
+LaneRows broadcastRows(const COBBox& box, LaneStaging& staging) {
+  for (int r = 0; r < 3; ++r) {
+    staging[r].fill(box.transform.origin[r]);
+    staging[12 + r].fill(box.extents[r]);
+    for (int c = 0; c < 3; ++c)
+      staging[3 + c * 3 + r].fill(box.transform.basis[c][r]);
+  }
+  LaneRows ret;
+  for (size_t r = 0; r < ret.size(); ++r)
+    ret[r] = staging[r].data();
   return ret;
 }
 
-bool COBBox::OBBIntersectsBox(const COBBox& other) const {
-  CVector3f v = other.transform.origin - transform.origin;
-  CVector3f T = CVector3f(v.dot(transform.basis[0]), v.dot(transform.basis[1]), v.dot(transform.basis[2]));
+/* Rows of a whole SoA view */
+LaneRows soaRows(const COBBoxSoA& boxes) {
+  return {boxes.originX.data(),  boxes.originY.data(),  boxes.originZ.data(),  boxes.basis[0].data(),
+          boxes.basis[1].data(), boxes.basis[2].data(), boxes.basis[3].data(), boxes.basis[4].data(),
+          boxes.basis[5].data(), boxes.basis[6].data(), boxes.basis[7].data(), boxes.basis[8].data(),
+          boxes.extentX.data(),  boxes.extentY.data(),  boxes.extentZ.data()};
+}
+
+/* Boxes [i, i + count) of the size boxes SoA view at rows, read in place unless the view ends within a register of
+ * the widest kernel */
+LaneRows soaRows(const LaneRows& rows, size_t size, size_t i, size_t count, LaneStaging& staging) {
+  LaneRows ret;
+  for (size_t r = 0; r < ret.size(); ++r) {
+    if (size - i >= MaxLanes) {
+      ret[r] = rows[r] + i;
+    } else {
+      std::copy_n(rows[r] + i, count, staging[r].begin());
+      ret[r] = staging[r].data();
+    }
+  }
+  return ret;
+}
+
+/* Transposes boxes [i, i + count) into staging; unused lanes keep earlier boxes, so staging starts zeroed */
+LaneRows gatherRows(std::span<const COBBox> boxes, size_t i, size_t count, LaneStaging& staging) {
+  for (size_t l = 0; l < count; ++l) {
+    const COBBox& box = boxes[i + l];
+    for (int r = 0; r < 3; ++r) {
+      staging[r][l] = box.transform.origin[r];
+      staging[12 + r][l] = box.extents[r];
+      for (int c = 0; c < 3; ++c)
+        staging[3 + c * 3 + r][l] = box.transform.basis[c][r];
+    }
+  }
+  LaneRows ret;
+  for (size_t r = 0; r < ret.size(); ++r)
+    ret[r] = staging[r].data();
+  return ret;
+}
+
+/* Oriented boxes, one per lane */
+struct BoxLanes {
+  Vec3<OBBSimd> origin;
+  Mat3<OBBSimd> basis;
+  Vec3<OBBSimd> extents;
+};
+
+BoxLanes loadBoxLanes(const LaneRows& rows) {
+  BoxLanes ret;
+  ret.origin = {loadLanes<OBBSimd>(rows[0]), loadLanes<OBBSimd>(rows[1]), loadLanes<OBBSimd>(rows[2])};
+  ret.extents = {loadLanes<OBBSimd>(rows[12]), loadLanes<OBBSimd>(rows[13]), loadLanes<OBBSimd>(rows[14])};
+  for (int c = 0; c < 3; ++c)
+    for (int r = 0; r < 3; ++r)
+      ret.basis[c][r] = loadLanes<OBBSimd>(rows[3 + c * 3 + r]);
+  return ret;
+}
+
+/* Lane mask of the pairs (a, b) that no axis separates. R and T are laid out one entry per register, like the boxes */
+int intersectLanes(const LaneRows& aRows, const LaneRows& bRows) {
+  const BoxLanes a = loadBoxLanes(aRows);
+  const BoxLanes b = loadBoxLanes(bRows);
+  const auto dot = [](const Vec3<OBBSimd>& u, const Vec3<OBBSimd>& v) {
+    return u[0] * v[0] + u[1] * v[1] + u[2] * v[2];
+  };
+  const Vec3<OBBSimd> v{b.origin[0] - a.origin[0], b.origin[1] - a.origin[1], b.origin[2] - a.origin[2]};
+  const Vec3<OBBSimd> T{dot(v, a.basis[0]), dot(v, a.basis[1]), dot(v, a.basis[2])};
+  const Mat3<OBBSimd> R{{{dot(a.basis[0], b.basis[0]), dot(a.basis[0], b.basis[1]), dot(a.basis[0], b.basis[2])},
+                         {dot(a.basis[1], b.basis[0]), dot(a.basis[1], b.basis[1]), dot(a.basis[1], b.basis[2])},
+                         {dot(a.basis[2], b.basis[0]), dot(a.basis[2], b.basis[1]), dot(a.basis[2], b.basis[2])}}};
+
+  int separated = 0;
+  separatingAxes(T, R, a.extents, b.extents, [&](const OBBSimd& t, const OBBSimd& r) {
+    separated |= bitmask(t > r);
+    return separated == AllLanes;
+  });
+  return ~separated & AllLanes;
+}
+
+#if ZEUS_KERNEL_AVX2
+/* T, R, |R| and both half extents of separatingAxes, eight box pairs wide */
+struct Axes8 {
+  __m256 T[3], R[3][3], AR[3][3], ea[3], eb[3];
+};
+
+ZEUS_TARGET_AVX2 __m256 abs8(__m256 v) { return _mm256_max_ps(v, _mm256_sub_ps(_mm256_setzero_ps(), v)); }
+
+ZEUS_TARGET_AVX2 __m256 dot8(__m256 ux, __m256 uy, __m256 uz, __m256 vx, __m256 vy, __m256 vz) {
+  return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ux, vx), _mm256_mul_ps(uy, vy)), _mm256_mul_ps(uz, vz));
+}
+
+ZEUS_TARGET_AVX2 int separates8(__m256 t, __m256 r) {
+  return _mm256_movemask_ps(_mm256_cmp_ps(abs8(t), _mm256_add_ps(r, _mm256_set1_ps(FLT_EPSILON)), _CMP_GT_OQ));
+}
+
+/* Axis `axis` in separatingAxes order: A's three, B's three, then Ai x Bk */
+ZEUS_TARGET_AVX2 int axisAVX2(const Axes8& s, int axis) {
+  if (axis < 3) {
+    const __m256 rb = dot8(s.eb[0], s.eb[1], s.eb[2], s.AR[axis][0], s.AR[axis][1], s.AR[axis][2]);
+    return separates8(s.T[axis], _mm256_add_ps(s.ea[axis], rb));
+  }
+  if (axis < 6) {
+    const int k = axis - 3;
+    const __m256 ra = dot8(s.ea[0], s.ea[1], s.ea[2], s.AR[0][k], s.AR[1][k], s.AR[2][k]);
+    return separates8(dot8(s.T[0], s.T[1], s.T[2], s.R[0][k], s.R[1][k], s.R[2][k]), _mm256_add_ps(ra, s.eb[k]));
+  }
+  const int i = (axis - 6) / 3, i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+  const int k = (axis - 6) % 3, k1 = (k + 1) % 3, k2 = (k + 2) % 3;
+  const __m256 ra = _mm256_add_ps(_mm256_mul_ps(s.ea[i1], s.AR[i2][k]), _mm256_mul_ps(s.ea[i2], s.AR[i1][k]));
+  const __m256 rb = _mm256_add_ps(_mm256_mul_ps(s.eb[k1], s.AR[i][k2]), _mm256_mul_ps(s.eb[k2], s.AR[i][k1]));
+  const __m256 t = _mm256_sub_ps(_mm256_mul_ps(s.T[i2], s.R[i1][k]), _mm256_mul_ps(s.T[i1], s.R[i2][k]));
+  return separates8(t, _mm256_add_ps(ra, rb));
+}
+
+/* intersectLanes eight pairs at a time, evaluated in the same order so results match the baseline kernel exactly */
+ZEUS_TARGET_AVX2 int intersectAVX2(const LaneRows& a, const LaneRows& b) {
+  Axes8 s;
+  const __m256 vx = _mm256_sub_ps(_mm256_loadu_ps(b[0]), _mm256_loadu_ps(a[0]));
+  const __m256 vy = _mm256_sub_ps(_mm256_loadu_ps(b[1]), _mm256_loadu_ps(a[1]));
+  const __m256 vz = _mm256_sub_ps(_mm256_loadu_ps(b[2]), _mm256_loadu_ps(a[2]));
+  __m256 aBasis[9], bBasis[9];
+  for (int e = 0; e < 9; ++e) {
+    aBasis[e] = _mm256_loadu_ps(a[3 + e]);
+    bBasis[e] = _mm256_loadu_ps(b[3 + e]);
+  }
+  for (int i = 0; i < 3; ++i) {
+    s.T[i] = dot8(vx, vy, vz, aBasis[i * 3], aBasis[i * 3 + 1], aBasis[i * 3 + 2]);
+    s.ea[i] = _mm256_loadu_ps(a[12 + i]);
+    s.eb[i] = _mm256_loadu_ps(b[12 + i]);
+    for (int k = 0; k < 3; ++k) {
+      s.R[i][k] = dot8(aBasis[i * 3], aBasis[i * 3 + 1], aBasis[i * 3 + 2], bBasis[k * 3], bBasis[k * 3 + 1],
+                       bBasis[k * 3 + 2]);
+      s.AR[i][k] = abs8(s.R[i][k]);
+    }
+  }
+
+  int separated = 0;
+  for (int axis = 0; axis < 15 && separated != 0xFF; ++axis)
+    separated |= axisAVX2(s, axis);
+  return ~separated & 0xFF;
+}
+#endif
+
+#if ZEUS_KERNEL_AVX512
+/* T, R, |R| and both half extents of separatingAxes, sixteen box pairs wide */
+struct Axes16 {
+  __m512 T[3], R[3][3], AR[3][3], ea[3], eb[3];
+};
+
+ZEUS_TARGET_AVX512 __m512 abs16(__m512 v) { return _mm512_max_ps(v, _mm512_sub_ps(_mm512_setzero_ps(), v)); }
 
-  CMatrix3f R;
+ZEUS_TARGET_AVX512 __m512 dot16(__m512 ux, __m512 uy, __m512 uz, __m512 vx, __m512 vy, __m512 vz) {
+  return _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(ux, vx), _mm512_mul_ps(uy, vy)), _mm512_mul_ps(uz, vz));
+}
 
-  float ra, rb, t;
+ZEUS_TARGET_AVX512 int separates16(__m512 t, __m512 r) {
+  return _mm512_cmp_ps_mask(abs16(t), _mm512_add_ps(r, _mm512_set1_ps(FLT_EPSILON)), _CMP_GT_OQ);
+}
 
-  for (int i = 0; i < 3; ++i)
-    for (int k = 0; k < 3; ++k)
-      R[i][k] = transform.basis[i].dot(other.transform.basis[k]);
+ZEUS_TARGET_AVX512 int axisAVX512(const Axes16& s, int axis) {
+  if (axis < 3) {
+    const __m512 rb = dot16(s.eb[0], s.eb[1], s.eb[2], s.AR[axis][0], s.AR[axis][1], s.AR[axis][2]);
+    return separates16(s.T[axis], _mm512_add_ps(s.ea[axis], rb));
+  }
+  if (axis < 6) {
+    const int k = axis - 3;
+    const __m512 ra = dot16(s.ea[0], s.ea[1], s.ea[2], s.AR[0][k], s.AR[1][k], s.AR[2][k]);
+    return separates16(dot16(s.T[0], s.T[1], s.T[2], s.R[0][k], s.R[1][k], s.R[2][k]), _mm512_add_ps(ra, s.eb[k]));
+  }
+  const int i = (axis - 6) / 3, i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+  const int k = (axis - 6) % 3, k1 = (k + 1) % 3, k2 = (k + 2) % 3;
+  const __m512 ra = _mm512_add_ps(_mm512_mul_ps(s.ea[i1], s.AR[i2][k]), _mm512_mul_ps(s.ea[i2], s.AR[i1][k]));
+  const __m512 rb = _mm512_add_ps(_mm512_mul_ps(s.eb[k1], s.AR[i][k2]), _mm512_mul_ps(s.eb[k2], s.AR[i][k1]));
+  const __m512 t = _mm512_sub_ps(_mm512_mul_ps(s.T[i2], s.R[i1][k]), _mm512_mul_ps(s.T[i1], s.R[i2][k]));
+  return separates16(t, _mm512_add_ps(ra, rb));
+}
 
+/* Sixteen pairs at a time, like intersectAVX2 */
+ZEUS_TARGET_AVX512 int intersectAVX512(const LaneRows& a, const LaneRows& b) {
+  Axes16 s;
+  const __m512 vx = _mm512_sub_ps(_mm512_loadu_ps(b[0]), _mm512_loadu_ps(a[0]));
+  const __m512 vy = _mm512_sub_ps(_mm512_loadu_ps(b[1]), _mm512_loadu_ps(a[1]));
+  const __m512 vz = _mm512_sub_ps(_mm512_loadu_ps(b[2]), _mm512_loadu_ps(a[2]));
+  __m512 aBasis[9], bBasis[9];
+  for (int e = 0; e < 9; ++e) {
+    aBasis[e] = _mm512_loadu_ps(a[3 + e]);
+    bBasis[e] = _mm512_loadu_ps(b[3 + e]);
+  }
   for (int i = 0; i < 3; ++i) {
-    ra = extents[i];
-    rb = (other.extents[0] * std::fabs(R[i][0])) + (other.extents[1] * std::fabs(R[i][1])) +
-         (other.extents[2] * std::fabs(R[i][2]));
-    t = std::fabs(T[i]);
+    s.T[i] = dot16(vx, vy, vz, aBasis[i * 3], aBasis[i * 3 + 1], aBasis[i * 3 + 2]);
+    s.ea[i] = _mm512_loadu_ps(a[12 + i]);
+    s.eb[i] = _mm512_loadu_ps(b[12 + i]);
+    for (int k = 0; k < 3; ++k) {
+      s.R[i][k] = dot16(aBasis[i * 3], aBasis[i * 3 + 1], aBasis[i * 3 + 2], bBasis[k * 3], bBasis[k * 3 + 1],
+                        bBasis[k * 3 + 2]);
+      s.AR[i][k] = abs16(s.R[i][k]);
+    }
+  }
+
+  int separated = 0;
+  for (int axis = 0; axis < 15 && separated != 0xFFFF; ++axis)
+    separated |= axisAVX512(s, axis);
+  return ~separated & 0xFFFF;
+}
+#endif
 
-    if (t > (ra + rb + FLT_EPSILON))
-      return false;
+/* Sets the bit of every pair that intersects, Lanes pairs per call of Intersect; aRows(i, count) and bRows(i, count)
+ * return the rows of pairs [i, i + count) */
+template <size_t Lanes, int (*Intersect)(const LaneRows&, const LaneRows&), typename ARows, typename BRows>
+void intersectBits(size_t count, std::span<uint32_t> hitBits, ARows&& aRows, BRows&& bRows) {
+  assert(hitBits.size() >= (count + 31) / 32);
+  std::fill_n(hitBits.begin(), (count + 31) / 32, 0u);
+  for (size_t i = 0; i < count; i += Lanes) {
+    const size_t rem = std::min(Lanes, count - i);
+    const int mask = Intersect(aRows(i, rem), bRows(i, rem)) & ((1 << rem) - 1);
+    hitBits[i / 32] |= uint32_t(mask) << (i % 32);
   }
+}
 
-  for (int k = 0; k < 3; ++k) {
-    ra = (extents[0] * std::fabs(R[0][k])) + (extents[1] * std::fabs(R[1][k])) + (extents[2] * std::fabs(R[2][k]));
-    rb = other.extents[k];
+/* The batch entry points for one kernel */
+template <size_t Lanes, int (*Intersect)(const LaneRows&, const LaneRows&)>
+struct OBBBatch {
+  static void boxesSoA(const COBBox& box, const COBBoxSoA& others, std::span<uint32_t> hitBits) {
+    LaneStaging selfStaging, staging{};
+    const LaneRows self = broadcastRows(box, selfStaging);
+    const LaneRows rows = soaRows(others);
+    intersectBits<Lanes, Intersect>(others.size(), hitBits, [&](size_t, size_t) { return self; },
+                                    [&](size_t i, size_t count) {
+                                      return soaRows(rows, others.size(), i, count, staging);
+                                    });
+  }
 
-    t = std::fabs(T[0] * R[0][k] + T[1] * R[1][k] + T[2] * R[2][k]);
+  static void boxes(const COBBox& box, std::span<const COBBox> others, std::span<uint32_t> hitBits) {
+    LaneStaging selfStaging, staging{};
+    const LaneRows self = broadcastRows(box, selfStaging);
+    intersectBits<Lanes, Intersect>(others.size(), hitBits, [&](size_t, size_t) { return self; },
+                                    [&](size_t i, size_t count) { return gatherRows(others, i, count, staging); });
+  }
 
-    if (t > (ra + rb + FLT_EPSILON))
-      return false;
+  static void pairs(std::span<const COBBox> a, std::span<const COBBox> b, std::span<uint32_t> hitBits) {
+    LaneStaging aStaging{}, bStaging{};
+    intersectBits<Lanes, Intersect>(
+        a.size(), hitBits, [&](size_t i, size_t count) { return gatherRows(a, i, count, aStaging); },
+        [&](size_t i, size_t count) { return gatherRows(b, i, count, bStaging); });
   }
+};
+
+struct OBBKernels {
+  void (*boxesSoA)(const COBBox& box, const COBBoxSoA& others, std::span<uint32_t> hitBits);
+  void (*boxes)(const COBBox& box, std::span<const COBBox> others, std::span<uint32_t> hitBits);
+  void (*pairs)(std::span<const COBBox> a, std::span<const COBBox> b, std::span<uint32_t> hitBits);
+};
+
+template <size_t Lanes, int (*Intersect)(const LaneRows&, const LaneRows&)>
+constexpr OBBKernels batchKernels() {
+  using Batch = OBBBatch<Lanes, Intersect>;
+  return {Batch::boxesSoA, Batch::boxes, Batch::pairs};
+}
+
+/* Indexed by EKernelISA */
+constexpr std::array<OBBKernels, KernelISACount> OBBKernelTable{
+    batchKernels<OBBLanes, intersectLanes>(),
+#if ZEUS_KERNEL_AVX2
+    batchKernels<8, intersectAVX2>(),
+#else
+    batchKernels<OBBLanes, intersectLanes>(),
+#endif
+#if ZEUS_KERNEL_AVX512
+    batchKernels<16, intersectAVX512>(),
+#else
+    batchKernels<OBBLanes, intersectLanes>(),
+#endif
+};
+} // Anonymous namespace
+
+CAABox COBBox::calculateAABox(const CTransform& worldXf) const {
+  return CAABox(-extents, extents).getTransformedAABox(worldXf * transform);
+}
 
-  /* A0 x B0 */
-  ra = (extents[1] * std::fabs(R[2][0])) + (extents[2] * std::fabs(R[1][0]));
-  rb = (other.extents[1] * std::fabs(R[0][2])) + (other.extents[2] * std::fabs(R[0][1]));
-  t = std::fabs((T[2] * R[1][0]) - (T[1] * R[2][0]));
-  if (t > (ra + rb + FLT_EPSILON))
-    return false;
-
-  /* A0 x B1 */
-  ra = (extents[1] * std::fabs(R[2][1])) + (extents[2] * std::fabs(R[1][1]));
-  rb = (other.extents[0] * std::fabs(R[0][2])) + (other.extents[2] * std::fabs(R[0][0]));
-  t = std::fabs((T[2] * R[1][1]) - (T[1] * R[2][1]));
-  if (t > (ra + rb + FLT_EPSILON))
-    return false;
-
-  /* A0 x B2 */
-  ra = (extents[1] * std::fabs(R[2][2])) + (extents[2] * std::fabs(R[1][2]));
-  rb = (other.extents[0] * std::fabs(R[0][1])) + (other.extents[1] * std::fabs(R[0][0]));
-  t = std::fabs((T[2] * R[1][2]) - (T[1] * R[2][2]));
-  if (t > (ra + rb + FLT_EPSILON))
-    return false;
-
-  /* A1 x B0 */
-  ra = (extents[0] * std::fabs(R[2][0])) + (extents[2] * std::fabs(R[0][0]));
-  rb = (other.extents[1] * std::fabs(R[1][2])) + (other.extents[2] * std::fabs(R[1][1]));
-  t = std::fabs((T[0] * R[2][0]) - (T[2] * R[0][0]));
-  if (t > (ra + rb + FLT_EPSILON))
-    return false;
-
-  /* A1 x B1 */
-  ra = (extents[0] * std::fabs(R[2][1])) + (extents[2] * std::fabs(R[0][1]));
-  rb = (other.extents[0] * std::fabs(R[1][2])) + (other.extents[2] * std::fabs(R[1][0]));
-  t = std::fabs((T[0] * R[2][1]) - (T[2] * R[0][1]));
-  if (t > (ra + rb + FLT_EPSILON))
-    return false;
-
-  /* A1 x B2 */
-  ra = (extents[0] * std::fabs(R[2][2])) + (extents[2] * std::fabs(R[0][2]));
-  rb = (other.extents[0] * std::fabs(R[1][1])) + (other.extents[1] * std::fabs(R[1][0]));
-  t = std::fabs((T[0] * R[2][2]) - (T[2] * R[0][2]));
-  if (t > (ra + rb + FLT_EPSILON))
-    return false;
-
-  /* A2 x B0 */
-  ra = (extents[0] * std::fabs(R[1][0])) + (extents[1] * std::fabs(R[0][0]));
-  rb = (other.extents[1] * std::fabs(R[2][2])) + (other.extents[2] * std::fabs(R[2][1]));
-  t = std::fabs((T[1] * R[0][0]) - (T[0] * R[1][0]));
-  if (t > (ra + rb + FLT_EPSILON))
-    return false;
-
-  /* A2 x B1 */
-  ra = (extents[0] * std::fabs(R[1][1])) + (extents[1] * std::fabs(R[0][1]));
-  rb = (other.extents[0] * std::fabs(R[2][2])) + (other.extents[2] * std::fabs(R[2][0]));
-  t = std::fabs((T[1] * R[0][1]) - (T[0] * R[1][1]));
-  if (t > (ra + rb + FLT_EPSILON))
-    return false;
-
-  /* A2 x B2 */
-  ra = (extents[0] * std::fabs(R[1][2])) + (extents[1] * std::fabs(R[0][2]));
-  rb = (other.extents[0] * std::fabs(R[2][1])) + (other.extents[1] * std::fabs(R[2][0]));
-  t = std::fabs((T[1] * R[0][2]) - (T[0] * R[1][2]));
-  if (t > (ra + rb + FLT_EPSILON))
-    return false;
-
-  return true;
+bool COBBox::OBBIntersectsBox(const COBBox& other) const {
+  /* Both products run down whole columns at once; R[i][k] = basis[i].dot(other.basis[k]) lands in RT[k][i] */
+  const CMatrix3f basisT = transform.basis.transposed();
+  const CVector3f TV = basisT * (other.transform.origin - transform.origin);
+  const CMatrix3f RT = basisT * other.transform.basis;
+  const Mat3<float> R{{{RT[0][0], RT[1][0], RT[2][0]}, {RT[0][1], RT[1][1], RT[2][1]}, {RT[0][2], RT[1][2], RT[2][2]}}};
+  return !separatingAxes({TV[0], TV[1], TV[2]}, R, {extents[0], extents[1], extents[2]},
+                         {other.extents[0], other.extents[1], other.extents[2]}, separatedAt);
 }
 
+bool COBBox::AABoxIntersectsBox(const CAABox& other) const {
+  /* The box's axes are the world axes, so R is our basis transposed and needs no products */
+  const CVector3f center = other.center();
+  const CVector3f otherExtents = other.max - center;
+  const CVector3f TV = transform.basis.transposed() * (center - transform.origin);
+  const CMatrix3f& B = transform.basis;
+  const Mat3<float> R{{{B[0][0], B[0][1], B[0][2]}, {B[1][0], B[1][1], B[1][2]}, {B[2][0], B[2][1], B[2][2]}}};
+  return !separatingAxes({TV[0], TV[1], TV[2]}, R, {extents[0], extents[1], extents[2]},
+                         {otherExtents[0], otherExtents[1], otherExtents[2]}, separatedAt);
+}
+
+void COBBox::OBBIntersectsBoxes(const COBBoxSoA& others, std::span<uint32_t> hitBits) const {
+  OBBKernelTable[size_t(kernelISA())].boxesSoA(*this, others, hitBits);
+}
+
+void COBBox::OBBIntersectsBoxes(std::span<const COBBox> others, std::span<uint32_t> hitBits) const {
+  OBBKernelTable[size_t(kernelISA())].boxes(*this, others, hitBits);
+}
+
+void COBBox::OBBIntersectsPairs(std::span<const COBBox> a, std::span<const COBBox> b, std::span<uint32_t> hitBits) {
+  assert(a.size() == b.size());
+  OBBKernelTable[size_t(kernelISA())].pairs(a, b, hitBits);
+}
 } // namespace zeus
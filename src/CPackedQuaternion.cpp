@@ -0,0 +1,59 @@
+#include "zeus/CPackedQuaternion.hpp"
+
+#include <cassert>
+
+#if __F16C__
+#include <immintrin.h>
+#endif
+
+namespace zeus {
+void loadPacked(std::span<const CPackedQuaternion> in, std::span<CQuaternion> out) {
+  assert(out.size() >= in.size());
+  const auto* src = reinterpret_cast<const float*>(in.data());
+  size_t i = 0;
+  /* The 4-float load also reads the next element's x; the CQuaternion(w, vec) shuffle drops it */
+  for (; i + 1 < in.size(); ++i) {
+    CVector3f vec;
+    vec.mSimd.copy_from(src + i * 3, _simd::element_aligned);
+    out[i] = CQuaternion(std::sqrt(std::max(0.f, 1.f - vec.magSquared())), vec);
+  }
+  for (; i < in.size(); ++i)
+    out[i] = in[i].toQuaternion();
+}
+
+void storePacked(std::span<const CQuaternion> in, std::span<CPackedQuaternion> out) {
+  assert(out.size() >= in.size());
+  auto* dst = reinterpret_cast<float*>(out.data());
+  size_t i = 0;
+  /* The 4-float store spills into the next element's x, which the next iteration overwrites */
+  for (; i + 1 < in.size(); ++i) {
+    const simd<float> xyz = in[i].mSimd.shuffle<1, 2, 3, 3>();
+    (in[i].w() < 0.f ? -xyz : xyz).copy_to(dst + i * 3, _simd::element_aligned);
+  }
+  for (; i < in.size(); ++i)
+    out[i] = in[i];
+}
+
+void loadPacked(std::span<const CPackedHalfQuaternion> in, std::span<CQuaternion> out) {
+  assert(out.size() >= in.size());
+  size_t i = 0;
+#if __F16C__
+  for (; i < in.size(); ++i)
+    out[i].mSimd = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&in[i])));
+#endif
+  for (; i < in.size(); ++i)
+    out[i] = in[i].toQuaternion();
+}
+
+void storePacked(std::span<const CQuaternion> in, std::span<CPackedHalfQuaternion> out) {
+  assert(out.size() >= in.size());
+  size_t i = 0;
+#if __F16C__
+  for (; i < in.size(); ++i)
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(&out[i]),
+                     _mm_cvtps_ph(in[i].mSimd.native(), _MM_FROUND_TO_NEAREST_INT));
+#endif
+  for (; i < in.size(); ++i)
+    out[i] = in[i];
+}
+} // namespace zeus
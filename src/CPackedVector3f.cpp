@@ -0,0 +1,64 @@
+#include "zeus/CPackedVector3f.hpp"
+
+#include <cassert>
+
+#if __F16C__
+#include <immintrin.h>
+#endif
+
+namespace zeus {
+/*
+ * The simd paths move four components per element: loads also read the next element's first component and
+ * stores spill into it before the next iteration overwrites it. The last element is always converted alone so
+ * nothing past the end of either span is touched.
+ */
+
+void loadPacked(std::span<const CPackedVector3f> in, std::span<CVector3f> out) {
+  assert(out.size() >= in.size());
+  const auto* src = reinterpret_cast<const float*>(in.data());
+  size_t i = 0;
+  for (; i + 1 < in.size(); ++i) {
+    out[i].mSimd.copy_from(src + i * 3, _simd::element_aligned);
+    out[i].mSimd[3] = 0.f;
+  }
+  for (; i < in.size(); ++i)
+    out[i] = in[i].toVec3f();
+}
+
+void storePacked(std::span<const CVector3f> in, std::span<CPackedVector3f> out) {
+  assert(out.size() >= in.size());
+  auto* dst = reinterpret_cast<float*>(out.data());
+  size_t i = 0;
+  for (; i + 1 < in.size(); ++i)
+    in[i].mSimd.copy_to(dst + i * 3, _simd::element_aligned);
+  for (; i < in.size(); ++i)
+    out[i] = in[i];
+}
+
+void loadPacked(std::span<const CPackedHalfVector3f> in, std::span<CVector3f> out) {
+  assert(out.size() >= in.size());
+  size_t i = 0;
+#if __F16C__
+  const auto* src = reinterpret_cast<const uint16_t*>(in.data());
+  for (; i + 1 < in.size(); ++i) {
+    out[i].mSimd = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i * 3)));
+    out[i].mSimd[3] = 0.f;
+  }
+#endif
+  for (; i < in.size(); ++i)
+    out[i] = in[i].toVec3f();
+}
+
+void storePacked(std::span<const CVector3f> in, std::span<CPackedHalfVector3f> out) {
+  assert(out.size() >= in.size());
+  size_t i = 0;
+#if __F16C__
+  auto* dst = reinterpret_cast<uint16_t*>(out.data());
+  for (; i + 1 < in.size(); ++i)
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i * 3),
+                     _mm_cvtps_ph(in[i].mSimd.native(), _MM_FROUND_TO_NEAREST_INT));
+#endif
+  for (; i < in.size(); ++i)
+    out[i] = in[i];
+}
+} // namespace zeus
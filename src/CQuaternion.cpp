@@ -79,18 +79,6 @@ void CQuaternion::fromVector3f(const CVector3f& vec) {
   mSimd.copy_from(f);
 }
 
-
-const CQuaternion& CQuaternion::operator*=(const CQuaternion& q) {
-  CQuaternion orig = *this;
-
-  w() = orig.w() * q.w() - CVector3f(orig.x(), orig.y(), orig.z()).dot({q.x(), q.y(), q.z()});
-  x() = orig.y() * q.z() - orig.z() * q.y() + orig.w() * q.x() + orig.x() * q.w();
-  y() = orig.z() * q.x() - orig.x() * q.z() + orig.w() * q.y() + orig.y() * q.w();
-  z() = orig.x() * q.y() - orig.y() * q.x() + orig.w() * q.z() + orig.z() * q.w();
-
-  return *this;
-}
-
 CQuaternion CQuaternion::log() const {
   float a = std::acos(w());
   float sina = std::sin(a);
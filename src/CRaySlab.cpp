@@ -0,0 +1,283 @@
+#include "zeus/CRaySlab.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "SafeReciprocal.hpp"
+
+#if ZEUS_KERNEL_AVX2 || ZEUS_KERNEL_AVX512
+#include <immintrin.h>
+#endif
+
+namespace zeus {
+namespace {
+using SlabSimd = simd<float>;
+constexpr size_t SlabLanes = SlabSimd::size();
+} // Anonymous namespace
+
+CRaySlab::CRaySlab(const CMRay& ray)
+: m_ox(ray.start.x())
+, m_oy(ray.start.y())
+, m_oz(ray.start.z())
+, m_idx(safeReciprocal(ray.dir.x()))
+, m_idy(safeReciprocal(ray.dir.y()))
+, m_idz(safeReciprocal(ray.dir.z()))
+, m_length(ray.length)
+, m_valid(!ray.start.isNaN() && !ray.dir.isNaN() && !std::isnan(ray.length)) {}
+
+bool CRaySlab::intersect(const CAABox& box, float& tEnter, float& tExit) const {
+  if (!m_valid)
+    return false;
+
+  SlabSimd enter;
+  SlabSimd exit;
+  if ((intersectLanes(SlabSimd(box.min.x()), SlabSimd(box.min.y()), SlabSimd(box.min.z()), SlabSimd(box.max.x()),
+                      SlabSimd(box.max.y()), SlabSimd(box.max.z()), m_length, enter, exit) &
+       1) == 0)
+    return false;
+
+  tEnter = enter[0];
+  tExit = exit[0];
+  return true;
+}
+
+/* SoA kernels for CRaySlab, selected through RaySlabKernelTable; hitBits must be zeroed beforehand */
+struct CRaySlabKernels {
+  /* Tests boxes from begin on, SlabLanes at a time, padding the final run */
+  static void intersectFrom(const CRaySlab& slab, const CAABoxSoA& boxes, size_t begin, std::span<uint32_t> hitBits,
+                            std::span<float> tEnter, std::span<float> tExit) {
+    const size_t count = boxes.size();
+    const std::array<std::span<const float>, 6> spans{boxes.minX, boxes.minY, boxes.minZ,
+                                                     boxes.maxX, boxes.maxY, boxes.maxZ};
+    SlabSimd enter;
+    SlabSimd exit;
+    size_t i = begin;
+    for (; i + SlabLanes <= count; i += SlabLanes) {
+      const int mask =
+          slab.intersectLanes(loadLanes(&spans[0][i]), loadLanes(&spans[1][i]), loadLanes(&spans[2][i]),
+                              loadLanes(&spans[3][i]), loadLanes(&spans[4][i]), loadLanes(&spans[5][i]),
+                              slab.m_length, enter, exit);
+      enter.copy_to(&tEnter[i], _simd::element_aligned);
+      exit.copy_to(&tExit[i], _simd::element_aligned);
+      hitBits[i / 32] |= uint32_t(mask) << (i % 32);
+    }
+
+    if (i < count) {
+      /* Padding lanes are left empty (min > max) so they never report a hit */
+      const size_t rem = count - i;
+      std::array<std::array<float, SlabLanes>, 6> tail{};
+      for (size_t c = 0; c < 3; ++c) {
+        tail[c].fill(1.f);
+        std::copy_n(&spans[c][i], rem, tail[c].begin());
+        std::copy_n(&spans[c + 3][i], rem, tail[c + 3].begin());
+      }
+      const int mask =
+          slab.intersectLanes(loadLanes(tail[0].data()), loadLanes(tail[1].data()), loadLanes(tail[2].data()),
+                              loadLanes(tail[3].data()), loadLanes(tail[4].data()), loadLanes(tail[5].data()),
+                              slab.m_length, enter, exit);
+      const simd_floats enterLanes(enter);
+      const simd_floats exitLanes(exit);
+      std::copy_n(enterLanes.array().begin(), rem, &tEnter[i]);
+      std::copy_n(exitLanes.array().begin(), rem, &tExit[i]);
+      hitBits[i / 32] |= uint32_t(mask) << (i % 32);
+    }
+  }
+
+  static void intersect(const CRaySlab& slab, const CAABoxSoA& boxes, std::span<uint32_t> hitBits,
+                        std::span<float> tEnter, std::span<float> tExit) {
+    intersectFrom(slab, boxes, 0, hitBits, tEnter, tExit);
+  }
+
+#if ZEUS_KERNEL_AVX2
+  /* Eight boxes at a time with the same operation order as intersectLanes, so results match exactly */
+  ZEUS_TARGET_AVX2 static void intersectAVX2(const CRaySlab& slab, const CAABoxSoA& boxes,
+                                             std::span<uint32_t> hitBits, std::span<float> tEnter,
+                                             std::span<float> tExit) {
+    const size_t count = boxes.size();
+    const __m256 ox = _mm256_set1_ps(slab.m_ox[0]);
+    const __m256 oy = _mm256_set1_ps(slab.m_oy[0]);
+    const __m256 oz = _mm256_set1_ps(slab.m_oz[0]);
+    const __m256 idx = _mm256_set1_ps(slab.m_idx[0]);
+    const __m256 idy = _mm256_set1_ps(slab.m_idy[0]);
+    const __m256 idz = _mm256_set1_ps(slab.m_idz[0]);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 tMax = _mm256_set1_ps(slab.m_length);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+      const __m256 minX = _mm256_loadu_ps(&boxes.minX[i]);
+      const __m256 minY = _mm256_loadu_ps(&boxes.minY[i]);
+      const __m256 minZ = _mm256_loadu_ps(&boxes.minZ[i]);
+      const __m256 maxX = _mm256_loadu_ps(&boxes.maxX[i]);
+      const __m256 maxY = _mm256_loadu_ps(&boxes.maxY[i]);
+      const __m256 maxZ = _mm256_loadu_ps(&boxes.maxZ[i]);
+
+      const __m256 t1x = _mm256_mul_ps(_mm256_sub_ps(minX, ox), idx);
+      const __m256 t2x = _mm256_mul_ps(_mm256_sub_ps(maxX, ox), idx);
+      const __m256 t1y = _mm256_mul_ps(_mm256_sub_ps(minY, oy), idy);
+      const __m256 t2y = _mm256_mul_ps(_mm256_sub_ps(maxY, oy), idy);
+      const __m256 t1z = _mm256_mul_ps(_mm256_sub_ps(minZ, oz), idz);
+      const __m256 t2z = _mm256_mul_ps(_mm256_sub_ps(maxZ, oz), idz);
+
+      const __m256 enter = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(t1x, t2x), _mm256_min_ps(t1y, t2y)),
+                                         _mm256_max_ps(_mm256_min_ps(t1z, t2z), zero));
+      const __m256 exit = _mm256_min_ps(_mm256_min_ps(_mm256_max_ps(t1x, t2x), _mm256_max_ps(t1y, t2y)),
+                                        _mm256_min_ps(_mm256_max_ps(t1z, t2z), tMax));
+      _mm256_storeu_ps(&tEnter[i], enter);
+      _mm256_storeu_ps(&tExit[i], exit);
+
+      const int mask = _mm256_movemask_ps(_mm256_cmp_ps(enter, exit, _CMP_LE_OQ)) &
+                       _mm256_movemask_ps(_mm256_cmp_ps(minX, maxX, _CMP_LE_OQ)) &
+                       _mm256_movemask_ps(_mm256_cmp_ps(minY, maxY, _CMP_LE_OQ)) &
+                       _mm256_movemask_ps(_mm256_cmp_ps(minZ, maxZ, _CMP_LE_OQ));
+      hitBits[i / 32] |= uint32_t(mask) << (i % 32);
+    }
+    intersectFrom(slab, boxes, i, hitBits, tEnter, tExit);
+  }
+#endif
+
+#if ZEUS_KERNEL_AVX512
+  /* Sixteen boxes at a time with a masked final run; the operations match intersectLanes, so results do too */
+  ZEUS_TARGET_AVX512 static void intersectAVX512(const CRaySlab& slab, const CAABoxSoA& boxes,
+                                                 std::span<uint32_t> hitBits, std::span<float> tEnter,
+                                                 std::span<float> tExit) {
+    const size_t count = boxes.size();
+    const __m512 ox = _mm512_set1_ps(slab.m_ox[0]);
+    const __m512 oy = _mm512_set1_ps(slab.m_oy[0]);
+    const __m512 oz = _mm512_set1_ps(slab.m_oz[0]);
+    const __m512 idx = _mm512_set1_ps(slab.m_idx[0]);
+    const __m512 idy = _mm512_set1_ps(slab.m_idy[0]);
+    const __m512 idz = _mm512_set1_ps(slab.m_idz[0]);
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 tMax = _mm512_set1_ps(slab.m_length);
+    for (size_t i = 0; i < count; i += 16) {
+      const __mmask16 lanes = count - i >= 16 ? 0xFFFF : __mmask16((1u << (count - i)) - 1);
+      const __m512 minX = _mm512_maskz_loadu_ps(lanes, &boxes.minX[i]);
+      const __m512 minY = _mm512_maskz_loadu_ps(lanes, &boxes.minY[i]);
+      const __m512 minZ = _mm512_maskz_loadu_ps(lanes, &boxes.minZ[i]);
+      const __m512 maxX = _mm512_maskz_loadu_ps(lanes, &boxes.maxX[i]);
+      const __m512 maxY = _mm512_maskz_loadu_ps(lanes, &boxes.maxY[i]);
+      const __m512 maxZ = _mm512_maskz_loadu_ps(lanes, &boxes.maxZ[i]);
+
+      const __m512 t1x = _mm512_mul_ps(_mm512_sub_ps(minX, ox), idx);
+      const __m512 t2x = _mm512_mul_ps(_mm512_sub_ps(maxX, ox), idx);
+      const __m512 t1y = _mm512_mul_ps(_mm512_sub_ps(minY, oy), idy);
+      const __m512 t2y = _mm512_mul_ps(_mm512_sub_ps(maxY, oy), idy);
+      const __m512 t1z = _mm512_mul_ps(_mm512_sub_ps(minZ, oz), idz);
+      const __m512 t2z = _mm512_mul_ps(_mm512_sub_ps(maxZ, oz), idz);
+
+      const __m512 enter = _mm512_max_ps(_mm512_max_ps(_mm512_min_ps(t1x, t2x), _mm512_min_ps(t1y, t2y)),
+                                         _mm512_max_ps(_mm512_min_ps(t1z, t2z), zero));
+      const __m512 exit = _mm512_min_ps(_mm512_min_ps(_mm512_max_ps(t1x, t2x), _mm512_max_ps(t1y, t2y)),
+                                        _mm512_min_ps(_mm512_max_ps(t1z, t2z), tMax));
+      _mm512_mask_storeu_ps(&tEnter[i], lanes, enter);
+      _mm512_mask_storeu_ps(&tExit[i], lanes, exit);
+
+      __mmask16 hits = _mm512_mask_cmp_ps_mask(lanes, enter, exit, _CMP_LE_OQ);
+      hits = _mm512_mask_cmp_ps_mask(hits, minX, maxX, _CMP_LE_OQ);
+      hits = _mm512_mask_cmp_ps_mask(hits, minY, maxY, _CMP_LE_OQ);
+      hits = _mm512_mask_cmp_ps_mask(hits, minZ, maxZ, _CMP_LE_OQ);
+      hitBits[i / 32] |= uint32_t(hits) << (i % 32);
+    }
+  }
+#endif
+};
+
+namespace {
+/* Indexed by EKernelISA */
+using RaySlabKernel = void (*)(const CRaySlab& slab, const CAABoxSoA& boxes, std::span<uint32_t> hitBits,
+                               std::span<float> tEnter, std::span<float> tExit);
+constexpr std::array<RaySlabKernel, KernelISACount> RaySlabKernelTable{
+    CRaySlabKernels::intersect,
+#if ZEUS_KERNEL_AVX2
+    CRaySlabKernels::intersectAVX2,
+#else
+    CRaySlabKernels::intersect,
+#endif
+#if ZEUS_KERNEL_AVX512
+    CRaySlabKernels::intersectAVX512,
+#else
+    CRaySlabKernels::intersect,
+#endif
+};
+} // Anonymous namespace
+
+void CRaySlab::intersect(const CAABoxSoA& boxes, std::span<uint32_t> hitBits, std::span<float> tEnter,
+                         std::span<float> tExit) const {
+  const size_t count = boxes.size();
+  assert(hitBits.size() >= (count + 31) / 32);
+  assert(tEnter.size() >= count && tExit.size() >= count);
+  std::fill_n(hitBits.begin(), (count + 31) / 32, 0u);
+  if (!m_valid)
+    return;
+
+  RaySlabKernelTable[size_t(kernelISA())](*this, boxes, hitBits, tEnter, tExit);
+}
+
+CRayPacket::CRayPacket(std::span<const CMRay> rays) : m_groups{}, m_count(rays.size()) {
+  assert(rays.size() <= MaxRays);
+  for (size_t g = 0; g < GroupCount; ++g) {
+    std::array<float, SlabLanes> ox{}, oy{}, oz{};
+    std::array<float, SlabLanes> idx{}, idy{}, idz{};
+    std::array<float, SlabLanes> length{};
+    int valid = 0;
+    for (size_t l = 0; l < SlabLanes; ++l) {
+      const size_t r = g * SlabLanes + l;
+      if (r >= m_count)
+        break;
+      const CMRay& ray = rays[r];
+      ox[l] = ray.start.x();
+      oy[l] = ray.start.y();
+      oz[l] = ray.start.z();
+      idx[l] = safeReciprocal(ray.dir.x());
+      idy[l] = safeReciprocal(ray.dir.y());
+      idz[l] = safeReciprocal(ray.dir.z());
+      length[l] = ray.length;
+      if (!ray.start.isNaN() && !ray.dir.isNaN() && !std::isnan(ray.length))
+        valid |= 1 << l;
+    }
+
+    Group& group = m_groups[g];
+    group.ox = loadLanes(ox.data());
+    group.oy = loadLanes(oy.data());
+    group.oz = loadLanes(oz.data());
+    group.idx = loadLanes(idx.data());
+    group.idy = loadLanes(idy.data());
+    group.idz = loadLanes(idz.data());
+    group.length = loadLanes(length.data());
+    group.valid = valid;
+  }
+}
+
+uint32_t CRayPacket::intersect(const CAABox& box, std::array<float, MaxRays>& tEnter,
+                               std::array<float, MaxRays>& tExit) const {
+  /* The box is the same for every lane; reject it once instead of per ray */
+  if (!(box.min.x() <= box.max.x() && box.min.y() <= box.max.y() && box.min.z() <= box.max.z()))
+    return 0;
+
+  const SlabSimd minX(box.min.x());
+  const SlabSimd minY(box.min.y());
+  const SlabSimd minZ(box.min.z());
+  const SlabSimd maxX(box.max.x());
+  const SlabSimd maxY(box.max.y());
+  const SlabSimd maxZ(box.max.z());
+
+  uint32_t hits = 0;
+  for (size_t g = 0; g * SlabLanes < m_count; ++g) {
+    const Group& group = m_groups[g];
+    const SlabSimd t1x = (minX - group.ox) * group.idx;
+    const SlabSimd t2x = (maxX - group.ox) * group.idx;
+    const SlabSimd t1y = (minY - group.oy) * group.idy;
+    const SlabSimd t2y = (maxY - group.oy) * group.idy;
+    const SlabSimd t1z = (minZ - group.oz) * group.idz;
+    const SlabSimd t2z = (maxZ - group.oz) * group.idz;
+
+    const SlabSimd enter = max(max(min(t1x, t2x), min(t1y, t2y)), max(min(t1z, t2z), SlabSimd(0.f)));
+    const SlabSimd exit = min(min(max(t1x, t2x), max(t1y, t2y)), min(max(t1z, t2z), group.length));
+    enter.copy_to(&tEnter[g * SlabLanes], _simd::element_aligned);
+    exit.copy_to(&tExit[g * SlabLanes], _simd::element_aligned);
+    hits |= uint32_t(bitmask(enter <= exit) & group.valid) << (g * SlabLanes);
+  }
+  return hits;
+}
+} // namespace zeus
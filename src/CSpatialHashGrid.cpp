@@ -0,0 +1,326 @@
+#include "zeus/CSpatialHashGrid.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "zeus/CMRay.hpp"
+#include "zeus/CRaySlab.hpp"
+#include "zeus/CSphere.hpp"
+
+namespace zeus {
+namespace {
+constexpr size_t InitialSlotCount = 64;
+/* Cell coordinates are clamped to this range, which also keeps NaN and infinite bounds well defined */
+constexpr float MaxCellCoord = 1 << 30;
+
+size_t hashCell(const std::array<int32_t, 3>& cell) {
+  /* Teschner et al.'s primes for spatial hashing */
+  return size_t(uint32_t(cell[0]) * 73856093u ^ uint32_t(cell[1]) * 19349663u ^ uint32_t(cell[2]) * 83492791u);
+}
+
+bool inside(const std::array<int32_t, 3>& cell, const std::array<int32_t, 3>& lo, const std::array<int32_t, 3>& hi) {
+  return cell[0] >= lo[0] && cell[0] <= hi[0] && cell[1] >= lo[1] && cell[1] <= hi[1] && cell[2] >= lo[2] &&
+         cell[2] <= hi[2];
+}
+
+/* The lowest cell two ranges share; an overlapping pair is reported only from there */
+std::array<int32_t, 3> firstShared(const std::array<int32_t, 3>& a, const std::array<int32_t, 3>& b) {
+  return {std::max(a[0], b[0]), std::max(a[1], b[1]), std::max(a[2], b[2])};
+}
+
+template <typename Entry>
+bool overlaps(const Entry& a, const Entry& b) {
+  return a.min[0] <= b.max[0] && b.min[0] <= a.max[0] && a.min[1] <= b.max[1] && b.min[1] <= a.max[1] &&
+         a.min[2] <= b.max[2] && b.min[2] <= a.max[2];
+}
+
+template <typename Entry>
+CAABox entryBox(const Entry& entry) {
+  return {entry.min[0], entry.min[1], entry.min[2], entry.max[0], entry.max[1], entry.max[2]};
+}
+
+/* Calls visit(cell) for every cell of an inclusive range */
+template <typename Range, typename Visit>
+void forEachCell(const Range& range, Visit&& visit) {
+  for (int32_t z = range.lo[2]; z <= range.hi[2]; ++z)
+    for (int32_t y = range.lo[1]; y <= range.hi[1]; ++y)
+      for (int32_t x = range.lo[0]; x <= range.hi[0]; ++x)
+        visit(std::array<int32_t, 3>{x, y, z});
+}
+} // Anonymous namespace
+
+CSpatialHashGrid::CSpatialHashGrid(float cellSize)
+: m_cellSize(cellSize), m_invCellSize(1.f / cellSize), m_slots(InitialSlotCount) {
+  assert(cellSize > 0.f);
+}
+
+CSpatialHashGrid::CellCoord CSpatialHashGrid::cellOf(float x, float y, float z) const {
+  const auto coord = [&](float v) {
+    /* std::min and std::max return their first argument for NaN, so NaN ends up at MaxCellCoord */
+    return int32_t(std::max(-MaxCellCoord, std::min(MaxCellCoord, std::floor(v * m_invCellSize))));
+  };
+  return {coord(x), coord(y), coord(z)};
+}
+
+CSpatialHashGrid::CellRange CSpatialHashGrid::rangeOf(const CAABox& box) const {
+  return {cellOf(box.min.x(), box.min.y(), box.min.z()), cellOf(box.max.x(), box.max.y(), box.max.z())};
+}
+
+CSpatialHashGrid::CellRange CSpatialHashGrid::rangeOf(const Entry& entry) const {
+  return {cellOf(entry.min[0], entry.min[1], entry.min[2]), cellOf(entry.max[0], entry.max[1], entry.max[2])};
+}
+
+size_t CSpatialHashGrid::findSlot(const CellCoord& cell) const {
+  const size_t mask = m_slots.size() - 1;
+  size_t slot = hashCell(cell) & mask;
+  while (m_slots[slot].index != EmptySlot && m_slots[slot].cell != cell)
+    slot = (slot + 1) & mask;
+  return slot;
+}
+
+const std::vector<CSpatialHashGrid::Entry>* CSpatialHashGrid::findCell(const CellCoord& cell) const {
+  const Slot& slot = m_slots[findSlot(cell)];
+  return slot.index == EmptySlot ? nullptr : &m_cells[slot.index];
+}
+
+std::vector<CSpatialHashGrid::Entry>& CSpatialHashGrid::acquireCell(const CellCoord& cell) {
+  if ((m_usedSlots + 1) * 2 > m_slots.size())
+    rehash(m_slots.size() * 2);
+  Slot& slot = m_slots[findSlot(cell)];
+  if (slot.index == EmptySlot) {
+    slot.cell = cell;
+    if (m_freeCells.empty()) {
+      slot.index = uint32_t(m_cells.size());
+      m_cells.emplace_back();
+    } else {
+      slot.index = m_freeCells.back();
+      m_freeCells.pop_back();
+    }
+    ++m_usedSlots;
+  }
+  return m_cells[slot.index];
+}
+
+void CSpatialHashGrid::removeEntry(const CellCoord& cell, uint32_t id) {
+  const size_t slot = findSlot(cell);
+  assert(m_slots[slot].index != EmptySlot);
+  std::vector<Entry>& entries = m_cells[m_slots[slot].index];
+  const auto it = std::find_if(entries.begin(), entries.end(), [id](const Entry& e) { return e.id == id; });
+  assert(it != entries.end());
+  *it = entries.back();
+  entries.pop_back();
+  if (entries.empty())
+    eraseSlot(slot);
+}
+
+void CSpatialHashGrid::eraseSlot(size_t slot) {
+  /* Backward-shift deletion: later slots of the same probe run move up, so lookups never need tombstones */
+  m_freeCells.push_back(m_slots[slot].index);
+  const size_t mask = m_slots.size() - 1;
+  size_t hole = slot;
+  for (size_t next = (slot + 1) & mask; m_slots[next].index != EmptySlot; next = (next + 1) & mask) {
+    const size_t home = hashCell(m_slots[next].cell) & mask;
+    if (((next - home) & mask) >= ((next - hole) & mask)) {
+      m_slots[hole] = m_slots[next];
+      hole = next;
+    }
+  }
+  m_slots[hole].index = EmptySlot;
+  --m_usedSlots;
+}
+
+void CSpatialHashGrid::rehash(size_t slotCount) {
+  std::vector<Slot> old(slotCount);
+  old.swap(m_slots);
+  for (const Slot& slot : old)
+    if (slot.index != EmptySlot)
+      m_slots[findSlot(slot.cell)] = slot;
+}
+
+void CSpatialHashGrid::insert(uint32_t id, const CAABox& box) {
+  if (id >= m_objects.size())
+    m_objects.resize(size_t(id) + 1);
+  Object& obj = m_objects[id];
+  assert(!obj.live);
+  obj = {box, rangeOf(box), true};
+  ++m_objectCount;
+  const Entry entry{{box.min.x(), box.min.y(), box.min.z()}, {box.max.x(), box.max.y(), box.max.z()}, id};
+  forEachCell(obj.cells, [&](const CellCoord& cell) { acquireCell(cell).push_back(entry); });
+}
+
+void CSpatialHashGrid::insert(uint32_t id, const CSphere& sphere) {
+  insert(id, CAABox(sphere.position - CVector3f(sphere.radius), sphere.position + CVector3f(sphere.radius)));
+}
+
+void CSpatialHashGrid::remove(uint32_t id) {
+  assert(contains(id));
+  Object& obj = m_objects[id];
+  forEachCell(obj.cells, [&](const CellCoord& cell) { removeEntry(cell, id); });
+  obj.live = false;
+  --m_objectCount;
+}
+
+void CSpatialHashGrid::move(uint32_t id, const CAABox& box) {
+  assert(contains(id));
+  Object& obj = m_objects[id];
+  const CellRange oldCells = obj.cells;
+  const CellRange newCells = rangeOf(box);
+  const Entry entry{{box.min.x(), box.min.y(), box.min.z()}, {box.max.x(), box.max.y(), box.max.z()}, id};
+  forEachCell(oldCells, [&](const CellCoord& cell) {
+    if (!inside(cell, newCells.lo, newCells.hi)) {
+      removeEntry(cell, id);
+      return;
+    }
+    std::vector<Entry>& entries = m_cells[m_slots[findSlot(cell)].index];
+    *std::find_if(entries.begin(), entries.end(), [id](const Entry& e) { return e.id == id; }) = entry;
+  });
+  forEachCell(newCells, [&](const CellCoord& cell) {
+    if (!inside(cell, oldCells.lo, oldCells.hi))
+      acquireCell(cell).push_back(entry);
+  });
+  obj.box = box;
+  obj.cells = newCells;
+}
+
+void CSpatialHashGrid::clear() {
+  m_objects.clear();
+  m_slots.assign(InitialSlotCount, Slot{});
+  m_cells.clear();
+  m_freeCells.clear();
+  m_objectCount = 0;
+  m_usedSlots = 0;
+}
+
+void CSpatialHashGrid::queryAABB(const CAABox& box, std::vector<uint32_t>& out) const {
+  const CellRange range = rangeOf(box);
+  const Entry query{{box.min.x(), box.min.y(), box.min.z()}, {box.max.x(), box.max.y(), box.max.z()}, 0};
+  forEachCell(range, [&](const CellCoord& cell) {
+    if (const std::vector<Entry>* entries = findCell(cell))
+      for (const Entry& entry : *entries)
+        if (overlaps(entry, query) && firstShared(rangeOf(entry).lo, range.lo) == cell)
+          out.push_back(entry.id);
+  });
+}
+
+void CSpatialHashGrid::querySphere(const CSphere& sphere, std::vector<uint32_t>& out) const {
+  const CellRange range =
+      rangeOf(CAABox(sphere.position - CVector3f(sphere.radius), sphere.position + CVector3f(sphere.radius)));
+  const float radiusSq = sphere.radius * sphere.radius;
+  forEachCell(range, [&](const CellCoord& cell) {
+    const std::vector<Entry>* entries = findCell(cell);
+    if (entries == nullptr)
+      return;
+    for (const Entry& entry : *entries) {
+      float distSq = 0.f;
+      for (size_t i = 0; i < 3; ++i) {
+        const float d = std::max(std::max(entry.min[i] - sphere.position[i], sphere.position[i] - entry.max[i]), 0.f);
+        distSq += d * d;
+      }
+      if (distSq <= radiusSq && firstShared(rangeOf(entry).lo, range.lo) == cell)
+        out.push_back(entry.id);
+    }
+  });
+}
+
+/**
+ * 3D DDA after Amanatides and Woo: visits each cell the segment passes through in order, calling
+ * visit(entries, previousCell, tExit) for occupied cells, where previousCell is null for the first cell and tExit is
+ * the distance at which the segment leaves the cell. Stops early when visit returns false.
+ */
+template <typename Visit>
+void CSpatialHashGrid::marchRay(const CMRay& ray, Visit&& visit) const {
+  CellCoord cell = cellOf(ray.start.x(), ray.start.y(), ray.start.z());
+  std::array<int32_t, 3> step{};
+  std::array<float, 3> tMax{};
+  std::array<float, 3> tDelta{};
+  for (size_t i = 0; i < 3; ++i) {
+    const float d = ray.dir[i];
+    step[i] = d > 0.f ? 1 : d < 0.f ? -1 : 0;
+    if (step[i] == 0) {
+      tMax[i] = tDelta[i] = INFINITY;
+      continue;
+    }
+    const float boundary = float(cell[i] + (step[i] > 0 ? 1 : 0)) * m_cellSize;
+    tMax[i] = (boundary - ray.start[i]) / d;
+    tDelta[i] = m_cellSize / std::abs(d);
+  }
+
+  CellCoord previous{};
+  bool first = true;
+  for (;;) {
+    const size_t axis = tMax[0] < tMax[1] ? (tMax[0] < tMax[2] ? 0 : 2) : (tMax[1] < tMax[2] ? 1 : 2);
+    const float tExit = tMax[axis];
+    if (const std::vector<Entry>* entries = findCell(cell))
+      if (!visit(*entries, first ? nullptr : &previous, tExit))
+        return;
+    if (!(tExit <= ray.length) || std::abs(cell[axis]) >= int32_t(MaxCellCoord))
+      return;
+    previous = cell;
+    first = false;
+    cell[axis] += step[axis];
+    tMax[axis] += tDelta[axis];
+  }
+}
+
+void CSpatialHashGrid::queryRay(const CMRay& ray, std::vector<uint32_t>& out) const {
+  const CRaySlab slab(ray);
+  if (!slab.valid())
+    return;
+  marchRay(ray, [&](const std::vector<Entry>& entries, const CellCoord* previous, float) {
+    for (const Entry& entry : entries) {
+      /* The march is monotonic on each axis, so it reaches an object's cells in one contiguous run */
+      if (previous != nullptr) {
+        const CellRange range = rangeOf(entry);
+        if (inside(*previous, range.lo, range.hi))
+          continue;
+      }
+      float tEnter, tExit;
+      if (slab.intersect(entryBox(entry), tEnter, tExit))
+        out.push_back(entry.id);
+    }
+    return true;
+  });
+}
+
+bool CSpatialHashGrid::rayCastClosest(const CMRay& ray, uint32_t& idOut, float& distOut) const {
+  const CRaySlab slab(ray);
+  if (!slab.valid())
+    return false;
+  bool hit = false;
+  float tClosest = slab.length();
+  marchRay(ray, [&](const std::vector<Entry>& entries, const CellCoord*, float tCellExit) {
+    for (const Entry& entry : entries) {
+      float tEnter, tExit;
+      if (slab.intersect(entryBox(entry), tEnter, tExit) && (!hit || tEnter < tClosest)) {
+        tClosest = tEnter;
+        idOut = entry.id;
+        hit = true;
+      }
+    }
+    /* Objects not seen yet are entered in later cells, at or beyond tCellExit */
+    return !hit || tClosest > tCellExit;
+  });
+  if (hit)
+    distOut = tClosest;
+  return hit;
+}
+
+void CSpatialHashGrid::findPairs(std::vector<std::pair<uint32_t, uint32_t>>& out) const {
+  std::vector<CellCoord> entryLo;
+  for (const Slot& slot : m_slots) {
+    if (slot.index == EmptySlot)
+      continue;
+    const std::vector<Entry>& entries = m_cells[slot.index];
+    entryLo.clear();
+    for (const Entry& entry : entries)
+      entryLo.push_back(rangeOf(entry).lo);
+    for (size_t a = 0; a < entries.size(); ++a) {
+      for (size_t b = a + 1; b < entries.size(); ++b) {
+        if (overlaps(entries[a], entries[b]) && firstShared(entryLo[a], entryLo[b]) == slot.cell)
+          out.emplace_back(std::min(entries[a].id, entries[b].id), std::max(entries[a].id, entries[b].id));
+      }
+    }
+  }
+}
+} // namespace zeus
@@ -0,0 +1,207 @@
+#include "zeus/CSweepAndPrune.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace zeus {
+namespace {
+using SweepSimd = simd<float>;
+constexpr size_t SweepLanes = SweepSimd::size();
+
+bool isMax(uint32_t data) { return (data & 1) != 0; }
+
+/* Endpoint order; a min sorts before a max of equal value, so touching boxes overlap */
+template <typename Endpoint>
+bool endpointLess(const Endpoint& a, const Endpoint& b) {
+  return a.value < b.value || (a.value == b.value && !isMax(a.data) && isMax(b.data));
+}
+} // Anonymous namespace
+
+void CSweepAndPrune::place(uint32_t axis, uint32_t index) {
+  const uint32_t data = m_axes[axis][index].data;
+  Object& obj = m_objects[data >> 1];
+  (isMax(data) ? obj.maxIndex : obj.minIndex)[axis] = index;
+}
+
+void CSweepAndPrune::sortDown(uint32_t axis, uint32_t index) {
+  std::vector<Endpoint>& endpoints = m_axes[axis];
+  const Endpoint cur = endpoints[index];
+  while (index > 0 && endpointLess(cur, endpoints[index - 1])) {
+    const Endpoint& prev = endpoints[index - 1];
+    if (prev.data >> 1 != cur.data >> 1) {
+      if (!isMax(cur.data) && isMax(prev.data))
+        beginOverlap(cur.data >> 1, prev.data >> 1);
+      else if (isMax(cur.data) && !isMax(prev.data))
+        endOverlap(cur.data >> 1, prev.data >> 1);
+    }
+    endpoints[index] = prev;
+    place(axis, index);
+    --index;
+  }
+  endpoints[index] = cur;
+  place(axis, index);
+}
+
+void CSweepAndPrune::sortUp(uint32_t axis, uint32_t index, bool toEnd) {
+  std::vector<Endpoint>& endpoints = m_axes[axis];
+  const Endpoint cur = endpoints[index];
+  while (index + 1 < endpoints.size() && (toEnd || endpointLess(endpoints[index + 1], cur))) {
+    const Endpoint& next = endpoints[index + 1];
+    if (next.data >> 1 != cur.data >> 1) {
+      if (isMax(cur.data) && !isMax(next.data))
+        beginOverlap(cur.data >> 1, next.data >> 1);
+      else if (!isMax(cur.data) && isMax(next.data))
+        endOverlap(cur.data >> 1, next.data >> 1);
+    }
+    endpoints[index] = next;
+    place(axis, index);
+    ++index;
+  }
+  endpoints[index] = cur;
+  place(axis, index);
+}
+
+/*
+ * The endpoints crossed on one axis only, so the whole boxes decide. They already hold their final bounds, which
+ * makes the last crossing between two objects leave the right answer however the other axes are sorted so far.
+ */
+void CSweepAndPrune::beginOverlap(uint32_t a, uint32_t b) {
+  if (!m_objects[a].live || !m_objects[b].live || !m_objects[a].box.intersects(m_objects[b].box))
+    return;
+  const uint64_t key = pairKey(a, b);
+  if (m_pairs.insert(key).second)
+    m_changes.push_back(key);
+}
+
+void CSweepAndPrune::endOverlap(uint32_t a, uint32_t b) {
+  const uint64_t key = pairKey(a, b);
+  if (m_pairs.erase(key) != 0)
+    m_changes.push_back(key);
+}
+
+void CSweepAndPrune::insert(uint32_t id, const CAABox& box) {
+  assert(id < 0x80000000u && !contains(id));
+  if (id >= m_objects.size())
+    m_objects.resize(id + 1);
+  Object& obj = m_objects[id];
+  obj.box = box;
+  obj.live = true;
+  ++m_objectCount;
+  /* New endpoints enter past the end of each axis, where they overlap nothing yet, and sort down */
+  for (uint32_t axis = 0; axis < 3; ++axis) {
+    std::vector<Endpoint>& endpoints = m_axes[axis];
+    endpoints.push_back({box.min[axis], id << 1});
+    endpoints.push_back({box.max[axis], id << 1 | 1});
+    place(axis, uint32_t(endpoints.size() - 1));
+    sortDown(axis, uint32_t(endpoints.size() - 2));
+    sortDown(axis, m_objects[id].maxIndex[axis]);
+  }
+}
+
+void CSweepAndPrune::remove(uint32_t id) {
+  assert(contains(id));
+  m_objects[id].live = false;
+  --m_objectCount;
+  /* Carrying the min endpoint past every max above it ends all of the object's pairs */
+  for (uint32_t axis = 0; axis < 3; ++axis) {
+    sortUp(axis, m_objects[id].minIndex[axis], true);
+    sortUp(axis, m_objects[id].maxIndex[axis], true);
+    m_axes[axis].resize(m_axes[axis].size() - 2);
+  }
+}
+
+void CSweepAndPrune::move(uint32_t id, const CAABox& box) {
+  assert(contains(id));
+  const CAABox old = m_objects[id].box;
+  m_objects[id].box = box;
+  /* Growing sides are sorted before shrinking ones, so a min never has to get past its own max */
+  for (uint32_t axis = 0; axis < 3; ++axis) {
+    std::vector<Endpoint>& endpoints = m_axes[axis];
+    const float newMin = box.min[axis];
+    const float newMax = box.max[axis];
+    endpoints[m_objects[id].minIndex[axis]].value = newMin;
+    endpoints[m_objects[id].maxIndex[axis]].value = newMax;
+    if (newMin < old.min[axis])
+      sortDown(axis, m_objects[id].minIndex[axis]);
+    if (newMax > old.max[axis])
+      sortUp(axis, m_objects[id].maxIndex[axis]);
+    if (newMin > old.min[axis])
+      sortUp(axis, m_objects[id].minIndex[axis]);
+    if (newMax < old.max[axis])
+      sortDown(axis, m_objects[id].maxIndex[axis]);
+  }
+}
+
+void CSweepAndPrune::clear() {
+  m_objects.clear();
+  for (std::vector<Endpoint>& endpoints : m_axes)
+    endpoints.clear();
+  m_pairs.clear();
+  m_changes.clear();
+  m_objectCount = 0;
+}
+
+void CSweepAndPrune::pairs(std::vector<Pair>& out) const {
+  out.reserve(out.size() + m_pairs.size());
+  for (const uint64_t key : m_pairs)
+    out.emplace_back(uint32_t(key >> 32), uint32_t(key));
+}
+
+void CSweepAndPrune::collectEvents(std::vector<Pair>& added, std::vector<Pair>& removed) {
+  /* A pair's changes alternate between found and lost, so an odd count is a net change and m_pairs tells which */
+  std::sort(m_changes.begin(), m_changes.end());
+  for (size_t i = 0; i < m_changes.size();) {
+    size_t j = i + 1;
+    while (j < m_changes.size() && m_changes[j] == m_changes[i])
+      ++j;
+    if ((j - i) % 2 != 0) {
+      const Pair pair(uint32_t(m_changes[i] >> 32), uint32_t(m_changes[i]));
+      (m_pairs.count(m_changes[i]) != 0 ? added : removed).push_back(pair);
+    }
+    i = j;
+  }
+  m_changes.clear();
+}
+
+void CSweepAndPrune::FindPairs(std::span<const CAABox> boxes, std::vector<Pair>& out) {
+  const size_t count = boxes.size();
+  std::vector<uint32_t> order(count);
+  for (uint32_t i = 0; i < count; ++i)
+    order[i] = i;
+  std::sort(order.begin(), order.end(),
+            [&](uint32_t a, uint32_t b) { return boxes[a].min.x() < boxes[b].min.x(); });
+
+  /* Bounds in sweep order, one array per coordinate, padded to whole runs of lanes */
+  std::array<std::vector<float>, 6> sorted;
+  for (std::vector<float>& coords : sorted)
+    coords.resize(count + SweepLanes, std::numeric_limits<float>::infinity());
+  for (size_t i = 0; i < count; ++i) {
+    const CAABox& box = boxes[order[i]];
+    for (size_t c = 0; c < 3; ++c) {
+      sorted[c][i] = box.min[c];
+      sorted[c + 3][i] = box.max[c];
+    }
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    const SweepSimd minX(sorted[0][i]), minY(sorted[1][i]), minZ(sorted[2][i]);
+    const SweepSimd maxX(sorted[3][i]), maxY(sorted[4][i]), maxZ(sorted[5][i]);
+    /* Everything from the first box starting past maxX on is out, the rest of its run is masked off below */
+    for (size_t j = i + 1; j < count && sorted[0][j] <= sorted[3][i]; j += SweepLanes) {
+      int mask = bitmask(loadLanes(&sorted[0][j]) <= maxX) & bitmask(loadLanes(&sorted[3][j]) >= minX);
+      mask &= bitmask(loadLanes(&sorted[1][j]) <= maxY) & bitmask(loadLanes(&sorted[4][j]) >= minY);
+      mask &= bitmask(loadLanes(&sorted[2][j]) <= maxZ) & bitmask(loadLanes(&sorted[5][j]) >= minZ);
+      if (count - j < SweepLanes)
+        mask &= (1 << (count - j)) - 1;
+      for (size_t lane = 0; mask != 0; ++lane, mask >>= 1) {
+        if ((mask & 1) != 0) {
+          const uint32_t a = order[i];
+          const uint32_t b = order[j + lane];
+          out.emplace_back(std::min(a, b), std::max(a, b));
+        }
+      }
+    }
+  }
+}
+} // namespace zeus
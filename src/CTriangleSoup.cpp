@@ -0,0 +1,523 @@
+#include "zeus/CTriangleSoup.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "zeus/Math.hpp"
+
+#if ZEUS_KERNEL_AVX2 || ZEUS_KERNEL_AVX512
+#include <immintrin.h>
+#endif
+
+namespace zeus {
+namespace {
+using SoupSimd = simd<float>;
+constexpr size_t SoupLanes = SoupSimd::size();
+/* Packed arrays are padded to a whole register of the widest kernel */
+constexpr size_t SoupPadding = 8;
+constexpr float Miss = std::numeric_limits<float>::infinity();
+
+/* Triangle indices of the first register, kept as floats like the other lane values */
+SoupSimd firstLaneIndices() {
+  std::array<float, SoupLanes> lanes;
+  for (size_t l = 0; l < SoupLanes; ++l)
+    lanes[l] = float(l);
+  return loadLanes(lanes.data());
+}
+} // Anonymous namespace
+
+/* SoA kernels for CTriangleSoup, selected through SoupKernelTable */
+struct CTriangleSoupKernels {
+  /* Winner of a pass: ray distance or squared distance, then the weights of the second and third corners */
+  struct Best {
+    float key = Miss;
+    float u = 0.f, v = 0.f;
+    uint32_t index = UINT32_MAX;
+  };
+
+  /* Reduces per-lane winners, ties going to the lower index; lanes that never won hold a negative index */
+  static Best reduce(const float* key, const float* u, const float* v, const float* index, size_t lanes) {
+    Best ret;
+    for (size_t l = 0; l < lanes; ++l) {
+      if (index[l] < 0.f)
+        continue;
+      const uint32_t i = uint32_t(index[l]);
+      if (key[l] < ret.key || (key[l] == ret.key && i < ret.index))
+        ret = {key[l], u[l], v[l], i};
+    }
+    return ret;
+  }
+
+  static Best reduceLanes(const SoupSimd& key, const SoupSimd& u, const SoupSimd& v, const SoupSimd& index) {
+    std::array<float, SoupLanes> keyLanes, uLanes, vLanes, indexLanes;
+    key.copy_to(keyLanes.data(), _simd::element_aligned);
+    u.copy_to(uLanes.data(), _simd::element_aligned);
+    v.copy_to(vLanes.data(), _simd::element_aligned);
+    index.copy_to(indexLanes.data(), _simd::element_aligned);
+    return reduce(keyLanes.data(), uLanes.data(), vLanes.data(), indexLanes.data(), SoupLanes);
+  }
+
+  /* Möller–Trumbore with the same operation order as rayTriangleIntersect */
+  static Best rayCast(const CTriangleSoup& soup, const CMRay& ray) {
+    const SoupSimd ox(ray.start.x()), oy(ray.start.y()), oz(ray.start.z());
+    const SoupSimd dx(ray.dir.x()), dy(ray.dir.y()), dz(ray.dir.z());
+    const SoupSimd zero(0.f), one(1.f), tMax(ray.length), miss(Miss);
+    const SoupSimd step(static_cast<float>(SoupLanes));
+    SoupSimd index = firstLaneIndices();
+    SoupSimd bestT(miss), bestU(zero), bestV(zero), bestIndex(-1.f);
+    for (size_t i = 0; i < soup.m_x0.size(); i += SoupLanes) {
+      const SoupSimd e1x = loadLanes(&soup.m_e1x[i]), e1y = loadLanes(&soup.m_e1y[i]), e1z = loadLanes(&soup.m_e1z[i]);
+      const SoupSimd e2x = loadLanes(&soup.m_e2x[i]), e2y = loadLanes(&soup.m_e2y[i]), e2z = loadLanes(&soup.m_e2z[i]);
+      const SoupSimd px = dy * e2z - dz * e2y;
+      const SoupSimd py = dz * e2x - dx * e2z;
+      const SoupSimd pz = dx * e2y - dy * e2x;
+      const SoupSimd invDet = one / (e1x * px + e1y * py + e1z * pz);
+
+      const SoupSimd tx = ox - loadLanes(&soup.m_x0[i]);
+      const SoupSimd ty = oy - loadLanes(&soup.m_y0[i]);
+      const SoupSimd tz = oz - loadLanes(&soup.m_z0[i]);
+      const SoupSimd u = (tx * px + ty * py + tz * pz) * invDet;
+      const SoupSimd qx = ty * e1z - tz * e1y;
+      const SoupSimd qy = tz * e1x - tx * e1z;
+      const SoupSimd qz = tx * e1y - ty * e1x;
+      const SoupSimd v = (dx * qx + dy * qy + dz * qz) * invDet;
+      const SoupSimd t = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+
+      /* Each failed test pushes the lane out of reach; flat and padding triangles give infinities or NaNs that
+       * fail at least one of them */
+      SoupSimd dist = _simd::select(u >= zero, t, miss);
+      dist = _simd::select(v >= zero, dist, miss);
+      dist = _simd::select(u + v <= one, dist, miss);
+      dist = _simd::select(t >= zero, dist, miss);
+      dist = _simd::select(t <= tMax, dist, miss);
+      const auto better = dist < bestT;
+      bestT = _simd::select(better, dist, bestT);
+      bestU = _simd::select(better, u, bestU);
+      bestV = _simd::select(better, v, bestV);
+      bestIndex = _simd::select(better, index, bestIndex);
+      index = index + step;
+    }
+    return reduceLanes(bestT, bestU, bestV, bestIndex);
+  }
+
+  /* Akenine-Möller's separating axes, as in triangleAABoxIntersect; hitBits must be zeroed beforehand */
+  static void intersect(const CTriangleSoup& soup, const CAABox& box, std::span<uint32_t> hitBits) {
+    const CVector3f center = box.center();
+    const CVector3f halfSize = box.extents();
+    const SoupSimd cx(center.x()), cy(center.y()), cz(center.z());
+    const SoupSimd hx(halfSize.x()), hy(halfSize.y()), hz(halfSize.z());
+    const SoupSimd zero(0.f);
+    const auto separates = [](const SoupSimd& p0, const SoupSimd& p1, const SoupSimd& p2, const SoupSimd& r) {
+      return bitmask(max(max(p0, p1), p2) < -r) | bitmask(min(min(p0, p1), p2) > r);
+    };
+
+    const size_t count = soup.size();
+    for (size_t i = 0; i < count; i += SoupLanes) {
+      const SoupSimd e1x = loadLanes(&soup.m_e1x[i]), e1y = loadLanes(&soup.m_e1y[i]), e1z = loadLanes(&soup.m_e1z[i]);
+      const SoupSimd e2x = loadLanes(&soup.m_e2x[i]), e2y = loadLanes(&soup.m_e2y[i]), e2z = loadLanes(&soup.m_e2z[i]);
+      const SoupSimd v0x = loadLanes(&soup.m_x0[i]) - cx;
+      const SoupSimd v0y = loadLanes(&soup.m_y0[i]) - cy;
+      const SoupSimd v0z = loadLanes(&soup.m_z0[i]) - cz;
+      const SoupSimd v1x = v0x + e1x, v1y = v0y + e1y, v1z = v0z + e1z;
+      const SoupSimd v2x = v0x + e2x, v2y = v0y + e2y, v2z = v0z + e2z;
+
+      int separated = separates(v0x, v1x, v2x, hx) | separates(v0y, v1y, v2y, hy) | separates(v0z, v1z, v2z, hz);
+
+      const SoupSimd nx = e1y * e2z - e1z * e2y;
+      const SoupSimd ny = e1z * e2x - e1x * e2z;
+      const SoupSimd nz = e1x * e2y - e1y * e2x;
+      const SoupSimd d = nx * v0x + ny * v0y + nz * v0z;
+      separated |= bitmask(max(d, -d) > hx * max(nx, -nx) + hy * max(ny, -ny) + hz * max(nz, -nz));
+
+      /* Box axis cross each edge; the projections skip the zero component of the axis */
+      const auto edgeAxes = [&](const SoupSimd& fx, const SoupSimd& fy, const SoupSimd& fz) {
+        const SoupSimd ax = max(fx, -fx), ay = max(fy, -fy), az = max(fz, -fz);
+        return separates(v0z * fy - v0y * fz, v1z * fy - v1y * fz, v2z * fy - v2y * fz, hy * az + hz * ay) |
+               separates(v0x * fz - v0z * fx, v1x * fz - v1z * fx, v2x * fz - v2z * fx, hx * az + hz * ax) |
+               separates(v0y * fx - v0x * fy, v1y * fx - v1x * fy, v2y * fx - v2x * fy, hx * ay + hy * ax);
+      };
+      separated |= edgeAxes(e1x, e1y, e1z) | edgeAxes(e2x - e1x, e2y - e1y, e2z - e1z) |
+                   edgeAxes(zero - e2x, zero - e2y, zero - e2z);
+
+      const size_t lanes = std::min(SoupLanes, count - i);
+      hitBits[i / 32] |= uint32_t(~separated & ((1 << lanes) - 1)) << (i % 32);
+    }
+  }
+
+  /* Ericson's region tests as in closestPointOnTriangle, every region evaluated and the first that applies kept */
+  static Best closestPoint(const CTriangleSoup& soup, const CVector3f& point, float maxDistSq) {
+    const SoupSimd px(point.x()), py(point.y()), pz(point.z());
+    const SoupSimd zero(0.f), one(1.f);
+    const SoupSimd step(static_cast<float>(SoupLanes));
+    SoupSimd index = firstLaneIndices();
+    SoupSimd bestD(maxDistSq), bestV(zero), bestW(zero), bestIndex(-1.f);
+    for (size_t i = 0; i < soup.m_x0.size(); i += SoupLanes) {
+      const SoupSimd e1x = loadLanes(&soup.m_e1x[i]), e1y = loadLanes(&soup.m_e1y[i]), e1z = loadLanes(&soup.m_e1z[i]);
+      const SoupSimd e2x = loadLanes(&soup.m_e2x[i]), e2y = loadLanes(&soup.m_e2y[i]), e2z = loadLanes(&soup.m_e2z[i]);
+      const SoupSimd apx = px - loadLanes(&soup.m_x0[i]);
+      const SoupSimd apy = py - loadLanes(&soup.m_y0[i]);
+      const SoupSimd apz = pz - loadLanes(&soup.m_z0[i]);
+      const SoupSimd bpx = apx - e1x, bpy = apy - e1y, bpz = apz - e1z;
+      const SoupSimd cpx = apx - e2x, cpy = apy - e2y, cpz = apz - e2z;
+      const SoupSimd d1 = e1x * apx + e1y * apy + e1z * apz;
+      const SoupSimd d2 = e2x * apx + e2y * apy + e2z * apz;
+      const SoupSimd d3 = e1x * bpx + e1y * bpy + e1z * bpz;
+      const SoupSimd d4 = e2x * bpx + e2y * bpy + e2z * bpz;
+      const SoupSimd d5 = e1x * cpx + e1y * cpy + e1z * cpz;
+      const SoupSimd d6 = e2x * cpx + e2y * cpy + e2z * cpz;
+      const SoupSimd vc = d1 * d4 - d3 * d2;
+      const SoupSimd vb = d5 * d2 - d1 * d6;
+      const SoupSimd va = d3 * d6 - d5 * d4;
+
+      /* Interior, then each region of lower priority overridden by those before it */
+      const SoupSimd denom = one / (va + vb + vc);
+      SoupSimd v = vb * denom;
+      SoupSimd w = vc * denom;
+      const auto inBC = min(min(-va, d4 - d3), d5 - d6) >= zero;
+      const SoupSimd bcW = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+      v = _simd::select(inBC, one - bcW, v);
+      w = _simd::select(inBC, bcW, w);
+      const auto inAC = min(min(-vb, d2), -d6) >= zero;
+      v = _simd::select(inAC, zero, v);
+      w = _simd::select(inAC, d2 / (d2 - d6), w);
+      const auto atC = min(d6, d6 - d5) >= zero;
+      v = _simd::select(atC, zero, v);
+      w = _simd::select(atC, one, w);
+      const auto inAB = min(min(-vc, d1), -d3) >= zero;
+      v = _simd::select(inAB, d1 / (d1 - d3), v);
+      w = _simd::select(inAB, zero, w);
+      const auto atB = min(d3, d3 - d4) >= zero;
+      v = _simd::select(atB, one, v);
+      w = _simd::select(atB, zero, w);
+      const auto atA = min(-d1, -d2) >= zero;
+      v = _simd::select(atA, zero, v);
+      w = _simd::select(atA, zero, w);
+
+      const SoupSimd rx = apx - e1x * v - e2x * w;
+      const SoupSimd ry = apy - e1y * v - e2y * w;
+      const SoupSimd rz = apz - e1z * v - e2z * w;
+      const SoupSimd distSq = rx * rx + ry * ry + rz * rz;
+      const auto better = distSq < bestD;
+      bestD = _simd::select(better, distSq, bestD);
+      bestV = _simd::select(better, v, bestV);
+      bestW = _simd::select(better, w, bestW);
+      bestIndex = _simd::select(better, index, bestIndex);
+      index = index + step;
+    }
+    return reduceLanes(bestD, bestV, bestW, bestIndex);
+  }
+
+#if ZEUS_KERNEL_AVX2
+  ZEUS_TARGET_AVX2 static __m256 abs8(__m256 v) { return _mm256_max_ps(v, _mm256_sub_ps(_mm256_setzero_ps(), v)); }
+
+  ZEUS_TARGET_AVX2 static __m256 dot8(__m256 ax, __m256 ay, __m256 az, __m256 bx, __m256 by, __m256 bz) {
+    return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, bx), _mm256_mul_ps(ay, by)), _mm256_mul_ps(az, bz));
+  }
+
+  /* a * b - c * d */
+  ZEUS_TARGET_AVX2 static __m256 mulSub8(__m256 a, __m256 b, __m256 c, __m256 d) {
+    return _mm256_sub_ps(_mm256_mul_ps(a, b), _mm256_mul_ps(c, d));
+  }
+
+  ZEUS_TARGET_AVX2 static Best reduce8(__m256 key, __m256 u, __m256 v, __m256 index) {
+    alignas(32) std::array<float, 8> keyLanes, uLanes, vLanes, indexLanes;
+    _mm256_store_ps(keyLanes.data(), key);
+    _mm256_store_ps(uLanes.data(), u);
+    _mm256_store_ps(vLanes.data(), v);
+    _mm256_store_ps(indexLanes.data(), index);
+    return reduce(keyLanes.data(), uLanes.data(), vLanes.data(), indexLanes.data(), 8);
+  }
+
+  /* Eight triangles at a time with the same operation order as rayCast */
+  ZEUS_TARGET_AVX2 static Best rayCastAVX2(const CTriangleSoup& soup, const CMRay& ray) {
+    const __m256 ox = _mm256_set1_ps(ray.start.x()), oy = _mm256_set1_ps(ray.start.y());
+    const __m256 oz = _mm256_set1_ps(ray.start.z());
+    const __m256 dx = _mm256_set1_ps(ray.dir.x()), dy = _mm256_set1_ps(ray.dir.y());
+    const __m256 dz = _mm256_set1_ps(ray.dir.z());
+    const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.f);
+    const __m256 tMax = _mm256_set1_ps(ray.length), miss = _mm256_set1_ps(Miss);
+    const __m256 step = _mm256_set1_ps(8.f);
+    __m256 index = _mm256_setr_ps(0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f);
+    __m256 bestT = miss, bestU = zero, bestV = zero, bestIndex = _mm256_set1_ps(-1.f);
+    for (size_t i = 0; i < soup.m_x0.size(); i += 8) {
+      const __m256 e1x = _mm256_loadu_ps(&soup.m_e1x[i]), e1y = _mm256_loadu_ps(&soup.m_e1y[i]);
+      const __m256 e1z = _mm256_loadu_ps(&soup.m_e1z[i]);
+      const __m256 e2x = _mm256_loadu_ps(&soup.m_e2x[i]), e2y = _mm256_loadu_ps(&soup.m_e2y[i]);
+      const __m256 e2z = _mm256_loadu_ps(&soup.m_e2z[i]);
+      const __m256 px = mulSub8(dy, e2z, dz, e2y);
+      const __m256 py = mulSub8(dz, e2x, dx, e2z);
+      const __m256 pz = mulSub8(dx, e2y, dy, e2x);
+      const __m256 invDet = _mm256_div_ps(one, dot8(e1x, e1y, e1z, px, py, pz));
+
+      const __m256 tx = _mm256_sub_ps(ox, _mm256_loadu_ps(&soup.m_x0[i]));
+      const __m256 ty = _mm256_sub_ps(oy, _mm256_loadu_ps(&soup.m_y0[i]));
+      const __m256 tz = _mm256_sub_ps(oz, _mm256_loadu_ps(&soup.m_z0[i]));
+      const __m256 u = _mm256_mul_ps(dot8(tx, ty, tz, px, py, pz), invDet);
+      const __m256 qx = mulSub8(ty, e1z, tz, e1y);
+      const __m256 qy = mulSub8(tz, e1x, tx, e1z);
+      const __m256 qz = mulSub8(tx, e1y, ty, e1x);
+      const __m256 v = _mm256_mul_ps(dot8(dx, dy, dz, qx, qy, qz), invDet);
+      const __m256 t = _mm256_mul_ps(dot8(e2x, e2y, e2z, qx, qy, qz), invDet);
+
+      __m256 hit = _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+      hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ));
+      hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, zero, _CMP_GE_OQ));
+      hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, tMax, _CMP_LE_OQ));
+      const __m256 dist = _mm256_blendv_ps(miss, t, hit);
+      const __m256 better = _mm256_cmp_ps(dist, bestT, _CMP_LT_OQ);
+      bestT = _mm256_blendv_ps(bestT, dist, better);
+      bestU = _mm256_blendv_ps(bestU, u, better);
+      bestV = _mm256_blendv_ps(bestV, v, better);
+      bestIndex = _mm256_blendv_ps(bestIndex, index, better);
+      index = _mm256_add_ps(index, step);
+    }
+    return reduce8(bestT, bestU, bestV, bestIndex);
+  }
+
+  ZEUS_TARGET_AVX2 static int separates8(__m256 p0, __m256 p1, __m256 p2, __m256 r) {
+    const __m256 hi = _mm256_max_ps(_mm256_max_ps(p0, p1), p2);
+    const __m256 lo = _mm256_min_ps(_mm256_min_ps(p0, p1), p2);
+    return _mm256_movemask_ps(_mm256_cmp_ps(hi, _mm256_sub_ps(_mm256_setzero_ps(), r), _CMP_LT_OQ)) |
+           _mm256_movemask_ps(_mm256_cmp_ps(lo, r, _CMP_GT_OQ));
+  }
+
+  /* Triangle corners relative to the box centre */
+  struct Corners8 {
+    __m256 x[3], y[3], z[3];
+  };
+
+  /* Box axis cross the edge f; the projections skip the zero component of the axis */
+  ZEUS_TARGET_AVX2 static int edgeAxes8(const Corners8& v, __m256 fx, __m256 fy, __m256 fz, __m256 hx, __m256 hy,
+                                        __m256 hz) {
+    const __m256 ax = abs8(fx), ay = abs8(fy), az = abs8(fz);
+    return separates8(mulSub8(v.z[0], fy, v.y[0], fz), mulSub8(v.z[1], fy, v.y[1], fz),
+                      mulSub8(v.z[2], fy, v.y[2], fz), _mm256_add_ps(_mm256_mul_ps(hy, az), _mm256_mul_ps(hz, ay))) |
+           separates8(mulSub8(v.x[0], fz, v.z[0], fx), mulSub8(v.x[1], fz, v.z[1], fx),
+                      mulSub8(v.x[2], fz, v.z[2], fx), _mm256_add_ps(_mm256_mul_ps(hx, az), _mm256_mul_ps(hz, ax))) |
+           separates8(mulSub8(v.y[0], fx, v.x[0], fy), mulSub8(v.y[1], fx, v.x[1], fy),
+                      mulSub8(v.y[2], fx, v.x[2], fy), _mm256_add_ps(_mm256_mul_ps(hx, ay), _mm256_mul_ps(hy, ax)));
+  }
+
+  /* Eight triangles at a time with the same operation order as intersect */
+  ZEUS_TARGET_AVX2 static void intersectAVX2(const CTriangleSoup& soup, const CAABox& box,
+                                             std::span<uint32_t> hitBits) {
+    const CVector3f center = box.center();
+    const CVector3f halfSize = box.extents();
+    const __m256 cx = _mm256_set1_ps(center.x()), cy = _mm256_set1_ps(center.y()), cz = _mm256_set1_ps(center.z());
+    const __m256 hx = _mm256_set1_ps(halfSize.x()), hy = _mm256_set1_ps(halfSize.y());
+    const __m256 hz = _mm256_set1_ps(halfSize.z());
+    const __m256 zero = _mm256_setzero_ps();
+
+    const size_t count = soup.size();
+    for (size_t i = 0; i < count; i += 8) {
+      const __m256 e1x = _mm256_loadu_ps(&soup.m_e1x[i]), e1y = _mm256_loadu_ps(&soup.m_e1y[i]);
+      const __m256 e1z = _mm256_loadu_ps(&soup.m_e1z[i]);
+      const __m256 e2x = _mm256_loadu_ps(&soup.m_e2x[i]), e2y = _mm256_loadu_ps(&soup.m_e2y[i]);
+      const __m256 e2z = _mm256_loadu_ps(&soup.m_e2z[i]);
+      const __m256 v0x = _mm256_sub_ps(_mm256_loadu_ps(&soup.m_x0[i]), cx);
+      const __m256 v0y = _mm256_sub_ps(_mm256_loadu_ps(&soup.m_y0[i]), cy);
+      const __m256 v0z = _mm256_sub_ps(_mm256_loadu_ps(&soup.m_z0[i]), cz);
+      const Corners8 v{{v0x, _mm256_add_ps(v0x, e1x), _mm256_add_ps(v0x, e2x)},
+                       {v0y, _mm256_add_ps(v0y, e1y), _mm256_add_ps(v0y, e2y)},
+                       {v0z, _mm256_add_ps(v0z, e1z), _mm256_add_ps(v0z, e2z)}};
+
+      int separated = separates8(v.x[0], v.x[1], v.x[2], hx) | separates8(v.y[0], v.y[1], v.y[2], hy) |
+                      separates8(v.z[0], v.z[1], v.z[2], hz);
+
+      const __m256 nx = mulSub8(e1y, e2z, e1z, e2y);
+      const __m256 ny = mulSub8(e1z, e2x, e1x, e2z);
+      const __m256 nz = mulSub8(e1x, e2y, e1y, e2x);
+      const __m256 d = dot8(nx, ny, nz, v0x, v0y, v0z);
+      const __m256 r = dot8(hx, hy, hz, abs8(nx), abs8(ny), abs8(nz));
+      separated |= _mm256_movemask_ps(_mm256_cmp_ps(abs8(d), r, _CMP_GT_OQ));
+
+      separated |= edgeAxes8(v, e1x, e1y, e1z, hx, hy, hz) |
+                   edgeAxes8(v, _mm256_sub_ps(e2x, e1x), _mm256_sub_ps(e2y, e1y), _mm256_sub_ps(e2z, e1z), hx, hy,
+                             hz) |
+                   edgeAxes8(v, _mm256_sub_ps(zero, e2x), _mm256_sub_ps(zero, e2y), _mm256_sub_ps(zero, e2z), hx,
+                             hy, hz);
+
+      const size_t lanes = std::min(size_t(8), count - i);
+      hitBits[i / 32] |= uint32_t(~separated & ((1 << lanes) - 1)) << (i % 32);
+    }
+  }
+
+  /* Lanes where every argument is at least zero, tested on their minimum as closestPoint does */
+  ZEUS_TARGET_AVX2 static __m256 atLeastZero8(__m256 a, __m256 b) {
+    return _mm256_cmp_ps(_mm256_min_ps(a, b), _mm256_setzero_ps(), _CMP_GE_OQ);
+  }
+
+  ZEUS_TARGET_AVX2 static __m256 atLeastZero8(__m256 a, __m256 b, __m256 c) {
+    return atLeastZero8(_mm256_min_ps(a, b), c);
+  }
+
+  /* Eight triangles at a time with the same operation order as closestPoint */
+  ZEUS_TARGET_AVX2 static Best closestPointAVX2(const CTriangleSoup& soup, const CVector3f& point, float maxDistSq) {
+    const __m256 px = _mm256_set1_ps(point.x()), py = _mm256_set1_ps(point.y()), pz = _mm256_set1_ps(point.z());
+    const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.f);
+    const __m256 step = _mm256_set1_ps(8.f);
+    __m256 index = _mm256_setr_ps(0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f);
+    __m256 bestD = _mm256_set1_ps(maxDistSq), bestV = zero, bestW = zero, bestIndex = _mm256_set1_ps(-1.f);
+    for (size_t i = 0; i < soup.m_x0.size(); i += 8) {
+      const __m256 e1x = _mm256_loadu_ps(&soup.m_e1x[i]), e1y = _mm256_loadu_ps(&soup.m_e1y[i]);
+      const __m256 e1z = _mm256_loadu_ps(&soup.m_e1z[i]);
+      const __m256 e2x = _mm256_loadu_ps(&soup.m_e2x[i]), e2y = _mm256_loadu_ps(&soup.m_e2y[i]);
+      const __m256 e2z = _mm256_loadu_ps(&soup.m_e2z[i]);
+      const __m256 apx = _mm256_sub_ps(px, _mm256_loadu_ps(&soup.m_x0[i]));
+      const __m256 apy = _mm256_sub_ps(py, _mm256_loadu_ps(&soup.m_y0[i]));
+      const __m256 apz = _mm256_sub_ps(pz, _mm256_loadu_ps(&soup.m_z0[i]));
+      const __m256 bpx = _mm256_sub_ps(apx, e1x), bpy = _mm256_sub_ps(apy, e1y), bpz = _mm256_sub_ps(apz, e1z);
+      const __m256 cpx = _mm256_sub_ps(apx, e2x), cpy = _mm256_sub_ps(apy, e2y), cpz = _mm256_sub_ps(apz, e2z);
+      const __m256 d1 = dot8(e1x, e1y, e1z, apx, apy, apz);
+      const __m256 d2 = dot8(e2x, e2y, e2z, apx, apy, apz);
+      const __m256 d3 = dot8(e1x, e1y, e1z, bpx, bpy, bpz);
+      const __m256 d4 = dot8(e2x, e2y, e2z, bpx, bpy, bpz);
+      const __m256 d5 = dot8(e1x, e1y, e1z, cpx, cpy, cpz);
+      const __m256 d6 = dot8(e2x, e2y, e2z, cpx, cpy, cpz);
+      const __m256 vc = mulSub8(d1, d4, d3, d2);
+      const __m256 vb = mulSub8(d5, d2, d1, d6);
+      const __m256 va = mulSub8(d3, d6, d5, d4);
+      const __m256 d43 = _mm256_sub_ps(d4, d3);
+      const __m256 d56 = _mm256_sub_ps(d5, d6);
+
+      const __m256 denom = _mm256_div_ps(one, _mm256_add_ps(_mm256_add_ps(va, vb), vc));
+      __m256 v = _mm256_mul_ps(vb, denom);
+      __m256 w = _mm256_mul_ps(vc, denom);
+      const __m256 inBC = atLeastZero8(_mm256_sub_ps(zero, va), d43, d56);
+      const __m256 bcW = _mm256_div_ps(d43, _mm256_add_ps(d43, d56));
+      v = _mm256_blendv_ps(v, _mm256_sub_ps(one, bcW), inBC);
+      w = _mm256_blendv_ps(w, bcW, inBC);
+      const __m256 inAC = atLeastZero8(_mm256_sub_ps(zero, vb), d2, _mm256_sub_ps(zero, d6));
+      v = _mm256_blendv_ps(v, zero, inAC);
+      w = _mm256_blendv_ps(w, _mm256_div_ps(d2, _mm256_sub_ps(d2, d6)), inAC);
+      const __m256 atC = atLeastZero8(d6, _mm256_sub_ps(d6, d5));
+      v = _mm256_blendv_ps(v, zero, atC);
+      w = _mm256_blendv_ps(w, one, atC);
+      const __m256 inAB = atLeastZero8(_mm256_sub_ps(zero, vc), d1, _mm256_sub_ps(zero, d3));
+      v = _mm256_blendv_ps(v, _mm256_div_ps(d1, _mm256_sub_ps(d1, d3)), inAB);
+      w = _mm256_blendv_ps(w, zero, inAB);
+      const __m256 atB = atLeastZero8(d3, _mm256_sub_ps(d3, d4));
+      v = _mm256_blendv_ps(v, one, atB);
+      w = _mm256_blendv_ps(w, zero, atB);
+      const __m256 atA = atLeastZero8(_mm256_sub_ps(zero, d1), _mm256_sub_ps(zero, d2));
+      v = _mm256_blendv_ps(v, zero, atA);
+      w = _mm256_blendv_ps(w, zero, atA);
+
+      const __m256 rx = _mm256_sub_ps(_mm256_sub_ps(apx, _mm256_mul_ps(e1x, v)), _mm256_mul_ps(e2x, w));
+      const __m256 ry = _mm256_sub_ps(_mm256_sub_ps(apy, _mm256_mul_ps(e1y, v)), _mm256_mul_ps(e2y, w));
+      const __m256 rz = _mm256_sub_ps(_mm256_sub_ps(apz, _mm256_mul_ps(e1z, v)), _mm256_mul_ps(e2z, w));
+      const __m256 distSq = dot8(rx, ry, rz, rx, ry, rz);
+      const __m256 better = _mm256_cmp_ps(distSq, bestD, _CMP_LT_OQ);
+      bestD = _mm256_blendv_ps(bestD, distSq, better);
+      bestV = _mm256_blendv_ps(bestV, v, better);
+      bestW = _mm256_blendv_ps(bestW, w, better);
+      bestIndex = _mm256_blendv_ps(bestIndex, index, better);
+      index = _mm256_add_ps(index, step);
+    }
+    return reduce8(bestD, bestV, bestW, bestIndex);
+  }
+#endif
+};
+
+namespace {
+struct SoupKernels {
+  CTriangleSoupKernels::Best (*rayCast)(const CTriangleSoup& soup, const CMRay& ray);
+  void (*intersect)(const CTriangleSoup& soup, const CAABox& box, std::span<uint32_t> hitBits);
+  CTriangleSoupKernels::Best (*closestPoint)(const CTriangleSoup& soup, const CVector3f& point, float maxDistSq);
+};
+
+/* Indexed by EKernelISA; AVX-512 machines run the eight wide kernels */
+constexpr std::array<SoupKernels, KernelISACount> SoupKernelTable{{
+    {CTriangleSoupKernels::rayCast, CTriangleSoupKernels::intersect, CTriangleSoupKernels::closestPoint},
+#if ZEUS_KERNEL_AVX2
+    {CTriangleSoupKernels::rayCastAVX2, CTriangleSoupKernels::intersectAVX2, CTriangleSoupKernels::closestPointAVX2},
+    {CTriangleSoupKernels::rayCastAVX2, CTriangleSoupKernels::intersectAVX2, CTriangleSoupKernels::closestPointAVX2},
+#else
+    {CTriangleSoupKernels::rayCast, CTriangleSoupKernels::intersect, CTriangleSoupKernels::closestPoint},
+    {CTriangleSoupKernels::rayCast, CTriangleSoupKernels::intersect, CTriangleSoupKernels::closestPoint},
+#endif
+}};
+} // Anonymous namespace
+
+void CTriangleSoup::build(std::span<const CVector3f> vertices, std::span<const uint32_t> indices) {
+  assert(indices.size() % 3 == 0 && indices.size() / 3 < (1u << 24));
+  m_vertices.assign(vertices.begin(), vertices.end());
+  m_indices.assign(indices.begin(), indices.end());
+
+  const std::array<std::vector<float>*, 9> lanes{&m_x0, &m_y0, &m_z0, &m_e1x, &m_e1y, &m_e1z, &m_e2x, &m_e2y, &m_e2z};
+  const size_t count = size();
+  const size_t padded = (count + SoupPadding - 1) / SoupPadding * SoupPadding;
+  for (std::vector<float>* lane : lanes) {
+    lane->clear();
+    lane->reserve(padded);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    assert(m_indices[i * 3] < vertices.size() && m_indices[i * 3 + 1] < vertices.size() &&
+           m_indices[i * 3 + 2] < vertices.size());
+    const auto [p0, p1, p2] = triangle(i);
+    const CVector3f e1 = p1 - p0;
+    const CVector3f e2 = p2 - p0;
+    for (size_t c = 0; c < 3; ++c) {
+      lanes[c]->push_back(p0[c]);
+      lanes[3 + c]->push_back(e1[c]);
+      lanes[6 + c]->push_back(e2[c]);
+    }
+  }
+
+  /* Padding triangles are points far out of reach of any query */
+  for (size_t i = count; i < padded; ++i) {
+    for (size_t c = 0; c < 3; ++c) {
+      lanes[c]->push_back(FLT_MAX);
+      lanes[3 + c]->push_back(0.f);
+      lanes[6 + c]->push_back(0.f);
+    }
+  }
+}
+
+CAABox CTriangleSoup::triangleBounds(size_t i) const {
+  CAABox ret;
+  for (const CVector3f& p : triangle(i))
+    ret.accumulateBounds(p);
+  return ret;
+}
+
+bool CTriangleSoup::rayCastClosest(const CMRay& ray, STriangleHit& hit) const {
+  if (empty())
+    return false;
+  const CTriangleSoupKernels::Best best = SoupKernelTable[size_t(kernelISA())].rayCast(*this, ray);
+  if (best.index == UINT32_MAX)
+    return false;
+
+  const auto [p0, p1, p2] = triangle(best.index);
+  hit.index = best.index;
+  hit.distance = best.key;
+  hit.bary = CVector3f(1.f - best.u - best.v, best.u, best.v);
+  hit.point = baryToWorld(p0, p1, p2, hit.bary);
+  return true;
+}
+
+void CTriangleSoup::intersect(const CAABox& box, std::span<uint32_t> hitBits) const {
+  const size_t count = size();
+  assert(hitBits.size() >= (count + 31) / 32);
+  std::fill_n(hitBits.begin(), (count + 31) / 32, 0u);
+  SoupKernelTable[size_t(kernelISA())].intersect(*this, box, hitBits);
+}
+
+bool CTriangleSoup::closestPoint(const CVector3f& point, STriangleHit& hit, float maxDistance) const {
+  if (empty())
+    return false;
+  const float maxDistSq = maxDistance < std::sqrt(FLT_MAX) ? maxDistance * maxDistance : Miss;
+  const CTriangleSoupKernels::Best best = SoupKernelTable[size_t(kernelISA())].closestPoint(*this, point, maxDistSq);
+  if (best.index == UINT32_MAX)
+    return false;
+
+  const auto [p0, p1, p2] = triangle(best.index);
+  hit.index = best.index;
+  hit.bary = CVector3f(1.f - best.u - best.v, best.u, best.v);
+  hit.point = baryToWorld(p0, p1, p2, hit.bary);
+  hit.distance = (hit.point - point).magnitude();
+  return true;
+}
+} // namespace zeus
@@ -0,0 +1,463 @@
+#include "zeus/ConvexQuery.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace zeus {
+namespace {
+constexpr int MaxGJKIterations = 64;
+constexpr int MaxEPAIterations = 64;
+/* GJK has converged once a new support point brings the squared distance bound closer by less than this fraction */
+constexpr float GJKRelativeTolerance = 1e-6f;
+/* The origin is taken to touch the simplex within this fraction of the squared size of its vertices */
+constexpr float GJKContactTolerance = 1e-10f;
+/* Squared sine of the smallest angle between edges and faces of a simplex that still counts as not flat */
+constexpr float DegenerateTolerance = 1e-10f;
+/* EPA stops once a new support point lies within this fraction of the depth beyond the closest face */
+constexpr float EPARelativeTolerance = 1e-4f;
+constexpr float EPAAbsoluteTolerance = 1e-6f;
+
+/* A point of the Minkowski difference a - b, with the support points it came from */
+struct Vertex {
+  CVector3f w, a, b;
+  CVector3f dir;
+};
+
+Vertex supportVertex(const CConvexShape& a, const CConvexShape& b, const CVector3f& dir) {
+  const CVector3f pa = a.support(dir);
+  const CVector3f pb = b.support(-dir);
+  return {pa - pb, pa, pb, dir};
+}
+
+/* Point of a simplex closest to the origin, as weights of the simplex vertices */
+struct Closest {
+  CVector3f point;
+  std::array<float, 4> weight{};
+};
+
+const Closest& closer(const Closest& a, const Closest& b) {
+  return b.point.magSquared() < a.point.magSquared() ? b : a;
+}
+
+Closest closestOnSegment(const std::array<CVector3f, 4>& w, int i, int j) {
+  Closest ret;
+  const CVector3f ab = w[j] - w[i];
+  const float denom = ab.magSquared();
+  const float t = denom > 0.f ? -w[i].dot(ab) / denom : 0.f;
+  if (!(t > 0.f)) {
+    ret.point = w[i];
+    ret.weight[i] = 1.f;
+  } else if (t >= 1.f) {
+    ret.point = w[j];
+    ret.weight[j] = 1.f;
+  } else {
+    ret.point = w[i] + ab * t;
+    ret.weight[i] = 1.f - t;
+    ret.weight[j] = t;
+  }
+  return ret;
+}
+
+/* Ericson's region tests, with flat triangles handled as their closest edge */
+Closest closestOnTriangle(const std::array<CVector3f, 4>& w, int i, int j, int k) {
+  const CVector3f& a = w[i];
+  const CVector3f& b = w[j];
+  const CVector3f& c = w[k];
+  const CVector3f ab = b - a;
+  const CVector3f ac = c - a;
+  if (!(ab.cross(ac).magSquared() > DegenerateTolerance * ab.magSquared() * ac.magSquared()))
+    return closer(closer(closestOnSegment(w, i, j), closestOnSegment(w, i, k)), closestOnSegment(w, j, k));
+
+  Closest ret;
+  const float d1 = -ab.dot(a);
+  const float d2 = -ac.dot(a);
+  if (d1 <= 0.f && d2 <= 0.f) {
+    ret.point = a;
+    ret.weight[i] = 1.f;
+    return ret;
+  }
+  const float d3 = -ab.dot(b);
+  const float d4 = -ac.dot(b);
+  if (d3 >= 0.f && d4 <= d3) {
+    ret.point = b;
+    ret.weight[j] = 1.f;
+    return ret;
+  }
+  const float vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f) {
+    const float t = d1 / (d1 - d3);
+    ret.point = a + ab * t;
+    ret.weight[i] = 1.f - t;
+    ret.weight[j] = t;
+    return ret;
+  }
+  const float d5 = -ab.dot(c);
+  const float d6 = -ac.dot(c);
+  if (d6 >= 0.f && d5 <= d6) {
+    ret.point = c;
+    ret.weight[k] = 1.f;
+    return ret;
+  }
+  const float vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f) {
+    const float t = d2 / (d2 - d6);
+    ret.point = a + ac * t;
+    ret.weight[i] = 1.f - t;
+    ret.weight[k] = t;
+    return ret;
+  }
+  const float va = d3 * d6 - d5 * d4;
+  if (va <= 0.f && d4 - d3 >= 0.f && d5 - d6 >= 0.f) {
+    const float t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+    ret.point = b + (c - b) * t;
+    ret.weight[j] = 1.f - t;
+    ret.weight[k] = t;
+    return ret;
+  }
+  const float denom = 1.f / (va + vb + vc);
+  const float v = vb * denom;
+  const float u = vc * denom;
+  ret.point = a + ab * v + ac * u;
+  ret.weight[i] = 1.f - v - u;
+  ret.weight[j] = v;
+  ret.weight[k] = u;
+  return ret;
+}
+
+/* Closest point over the faces the origin lies outside of; contains is set when there are none */
+Closest closestOnTetrahedron(const std::array<CVector3f, 4>& w, bool& contains) {
+  /* Each face with its opposite vertex, wound alike */
+  constexpr std::array<std::array<int, 4>, 4> Faces{{{0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0}}};
+  Closest inside;
+  Closest best;
+  best.point = CVector3f(std::numeric_limits<float>::infinity());
+  bool outside = false;
+  bool flat = false;
+  for (const auto& f : Faces) {
+    const CVector3f& a = w[f[0]];
+    const CVector3f n = (w[f[1]] - a).cross(w[f[2]] - a);
+    const CVector3f ad = w[f[3]] - a;
+    const float sp = -n.dot(a);
+    const float sd = n.dot(ad);
+    if (!(sd * sd > DegenerateTolerance * n.magSquared() * ad.magSquared()))
+      flat = true;
+    /* The origin's barycentric weight of the opposite vertex is the ratio of the heights over this face */
+    inside.weight[f[3]] = sp / sd;
+    if (sp * sd < 0.f) {
+      outside = true;
+      best = closer(best, closestOnTriangle(w, f[0], f[1], f[2]));
+    }
+  }
+
+  if (flat) {
+    contains = false;
+    for (const auto& f : Faces)
+      best = closer(best, closestOnTriangle(w, f[0], f[1], f[2]));
+    return best;
+  }
+  contains = !outside;
+  return outside ? best : inside;
+}
+
+/* Up to four vertices of the Minkowski difference, reduced to the ones whose hull holds its closest point */
+struct Simplex {
+  std::array<Vertex, 4> v;
+  std::array<float, 4> weight{};
+  uint32_t count = 0;
+
+  void add(const Vertex& vertex) { v[count++] = vertex; }
+
+  /* Returns the point closest to the origin; sets contains and keeps all four when the origin is inside */
+  CVector3f solve(bool& contains) {
+    std::array<CVector3f, 4> w;
+    for (uint32_t i = 0; i < count; ++i)
+      w[i] = v[i].w;
+    contains = false;
+    Closest closest;
+    switch (count) {
+    case 1:
+      closest.point = w[0];
+      closest.weight[0] = 1.f;
+      break;
+    case 2:
+      closest = closestOnSegment(w, 0, 1);
+      break;
+    case 3:
+      closest = closestOnTriangle(w, 0, 1, 2);
+      break;
+    default:
+      closest = closestOnTetrahedron(w, contains);
+      break;
+    }
+
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+      if (contains || closest.weight[i] > 0.f) {
+        v[kept] = v[i];
+        weight[kept++] = closest.weight[i];
+      }
+    }
+    count = kept;
+    return closest.point;
+  }
+
+  [[nodiscard]] float maxVertexSq() const {
+    float ret = 0.f;
+    for (uint32_t i = 0; i < count; ++i)
+      ret = std::max(ret, v[i].w.magSquared());
+    return ret;
+  }
+
+  /* Weighted sums of the support points on a and on b */
+  void witnesses(CVector3f& pointA, CVector3f& pointB) const {
+    pointA = CVector3f();
+    pointB = CVector3f();
+    for (uint32_t i = 0; i < count; ++i) {
+      pointA += v[i].a * weight[i];
+      pointB += v[i].b * weight[i];
+    }
+  }
+};
+
+struct GJKResult {
+  Simplex simplex;
+  CVector3f closest;
+  bool intersecting = false;
+};
+
+/* With stopAtSeparation, gives up on the distance as soon as a support point proves the shapes apart */
+GJKResult runGJK(const CConvexShape& a, const CConvexShape& b, SGJKCache* cache, bool stopAtSeparation) {
+  GJKResult ret;
+  Simplex& simplex = ret.simplex;
+  if (cache != nullptr) {
+    for (uint32_t i = 0; i < cache->count; ++i) {
+      const Vertex vertex = supportVertex(a, b, cache->directions[i]);
+      bool duplicate = false;
+      for (uint32_t j = 0; j < simplex.count; ++j)
+        duplicate = duplicate || simplex.v[j].w == vertex.w;
+      if (!duplicate)
+        simplex.add(vertex);
+    }
+  }
+  if (simplex.count == 0) {
+    CVector3f dir = b.center() - a.center();
+    if (!(dir.magSquared() > 0.f))
+      dir = CVector3f(1.f, 0.f, 0.f);
+    simplex.add(supportVertex(a, b, dir));
+  }
+
+  float prevSq = std::numeric_limits<float>::infinity();
+  for (int iter = 0; iter < MaxGJKIterations; ++iter) {
+    bool contains = false;
+    const CVector3f v = simplex.solve(contains);
+    const float vv = v.magSquared();
+    ret.closest = v;
+    if (contains || vv <= GJKContactTolerance * simplex.maxVertexSq()) {
+      ret.intersecting = true;
+      break;
+    }
+    /* Rounding can stall the descent before the tolerance below is met */
+    if (!(vv < prevSq))
+      break;
+    prevSq = vv;
+
+    const Vertex w = supportVertex(a, b, -v);
+    const float vw = v.dot(w.w);
+    if ((stopAtSeparation && vw > 0.f) || vv - vw <= GJKRelativeTolerance * vv)
+      break;
+    simplex.add(w);
+  }
+
+  if (cache != nullptr) {
+    cache->count = simplex.count;
+    for (uint32_t i = 0; i < simplex.count; ++i)
+      cache->directions[i] = simplex.v[i].dir;
+  }
+  return ret;
+}
+
+/**
+ * Grows GJK's final simplex, which holds the origin but may be a point, segment, triangle or flat tetrahedron when
+ * the shapes only touch, into a tetrahedron of support points. Fails when the Minkowski difference is flat.
+ */
+bool completeTetrahedron(const CConvexShape& a, const CConvexShape& b, std::vector<Vertex>& verts) {
+  if (verts.size() == 4) {
+    const CVector3f ab = verts[1].w - verts[0].w;
+    const CVector3f ac = verts[2].w - verts[0].w;
+    const CVector3f ad = verts[3].w - verts[0].w;
+    const CVector3f n = ab.cross(ac);
+    const float sd = n.dot(ad);
+    if (sd * sd > DegenerateTolerance * n.magSquared() * ad.magSquared())
+      return true;
+    verts.pop_back();
+  }
+
+  const std::array<CVector3f, 3> axes{CVector3f(1.f, 0.f, 0.f), CVector3f(0.f, 1.f, 0.f), CVector3f(0.f, 0.f, 1.f)};
+  if (verts.size() == 1) {
+    for (const CVector3f& axis : axes) {
+      for (const CVector3f& dir : {axis, -axis}) {
+        const Vertex vertex = supportVertex(a, b, dir);
+        if (verts.size() == 1 && (vertex.w - verts[0].w).magSquared() > 0.f)
+          verts.push_back(vertex);
+      }
+    }
+  }
+  if (verts.size() == 2) {
+    const CVector3f seg = verts[1].w - verts[0].w;
+    /* Perpendiculars through the axis least aligned with the segment */
+    const CVector3f absSeg(std::fabs(seg.x()), std::fabs(seg.y()), std::fabs(seg.z()));
+    const size_t axis = absSeg.x() <= absSeg.y() && absSeg.x() <= absSeg.z() ? 0 : absSeg.y() <= absSeg.z() ? 1 : 2;
+    const CVector3f d1 = seg.cross(axes[axis]);
+    const CVector3f d2 = seg.cross(d1);
+    for (const CVector3f& dir : {d1, -d1, d2, -d2}) {
+      const Vertex vertex = supportVertex(a, b, dir);
+      const CVector3f aw = vertex.w - verts[0].w;
+      if (verts.size() == 2 &&
+          aw.cross(seg).magSquared() > DegenerateTolerance * aw.magSquared() * seg.magSquared())
+        verts.push_back(vertex);
+    }
+  }
+  if (verts.size() == 3) {
+    const CVector3f n = (verts[1].w - verts[0].w).cross(verts[2].w - verts[0].w);
+    for (const CVector3f& dir : {n, -n}) {
+      const Vertex vertex = supportVertex(a, b, dir);
+      const CVector3f aw = vertex.w - verts[0].w;
+      const float sd = n.dot(aw);
+      if (verts.size() == 3 && sd * sd > DegenerateTolerance * n.magSquared() * aw.magSquared())
+        verts.push_back(vertex);
+    }
+  }
+  return verts.size() == 4;
+}
+
+struct EPAFace {
+  std::array<uint32_t, 3> idx;
+  /* Outward unit normal, and the distance of the face plane from the origin */
+  CVector3f normal;
+  float dist;
+};
+
+EPAFace makeFace(const std::vector<Vertex>& verts, uint32_t i, uint32_t j, uint32_t k) {
+  EPAFace face{{i, j, k}, (verts[j].w - verts[i].w).cross(verts[k].w - verts[i].w), 0.f};
+  const float mag = face.normal.magnitude();
+  if (mag > 0.f) {
+    face.normal = face.normal / mag;
+    face.dist = face.normal.dot(verts[i].w);
+  } else {
+    /* A sliver never becomes the closest face, and is never seen from a new point */
+    face.normal = CVector3f();
+    face.dist = std::numeric_limits<float>::infinity();
+  }
+  return face;
+}
+} // Anonymous namespace
+
+bool gjkIntersects(const CConvexShape& a, const CConvexShape& b, SGJKCache* cache) {
+  return runGJK(a, b, cache, true).intersecting;
+}
+
+SConvexDistance gjkDistance(const CConvexShape& a, const CConvexShape& b, SGJKCache* cache) {
+  const GJKResult gjk = runGJK(a, b, cache, false);
+  SConvexDistance ret;
+  ret.intersecting = gjk.intersecting;
+  ret.distance = gjk.intersecting ? 0.f : gjk.closest.magnitude();
+  gjk.simplex.witnesses(ret.pointA, ret.pointB);
+  return ret;
+}
+
+SConvexPenetration epaPenetration(const CConvexShape& a, const CConvexShape& b, SGJKCache* cache) {
+  const GJKResult gjk = runGJK(a, b, cache, false);
+  SConvexPenetration ret;
+  if (!gjk.intersecting)
+    return ret;
+  ret.intersecting = true;
+
+  std::vector<Vertex> verts(gjk.simplex.v.begin(), gjk.simplex.v.begin() + gjk.simplex.count);
+  if (!completeTetrahedron(a, b, verts)) {
+    /* Shapes that meet without volume, such as coplanar flat hulls, only touch */
+    ret.normal = b.center() - a.center();
+    ret.normal = ret.normal.magSquared() > 0.f ? ret.normal.normalized() : CVector3f(0.f, 0.f, 1.f);
+    gjk.simplex.witnesses(ret.pointA, ret.pointB);
+    return ret;
+  }
+
+  std::vector<EPAFace> faces;
+  constexpr std::array<std::array<uint32_t, 4>, 4> Faces{{{0, 1, 2, 3}, {0, 3, 1, 2}, {0, 2, 3, 1}, {1, 3, 2, 0}}};
+  for (const auto& f : Faces) {
+    /* Wind every face so its normal points away from the opposite vertex */
+    const CVector3f n = (verts[f[1]].w - verts[f[0]].w).cross(verts[f[2]].w - verts[f[0]].w);
+    faces.push_back(n.dot(verts[f[3]].w - verts[f[0]].w) > 0.f ? makeFace(verts, f[0], f[2], f[1])
+                                                                : makeFace(verts, f[0], f[1], f[2]));
+  }
+  float scaleSq = 0.f;
+  for (const Vertex& vertex : verts)
+    scaleSq = std::max(scaleSq, vertex.w.magSquared());
+  const float absoluteTolerance = EPAAbsoluteTolerance * std::sqrt(scaleSq);
+
+  size_t closest = 0;
+  std::vector<std::pair<uint32_t, uint32_t>> horizon;
+  for (int iter = 0; iter < MaxEPAIterations; ++iter) {
+    closest = 0;
+    for (size_t i = 1; i < faces.size(); ++i)
+      if (faces[i].dist < faces[closest].dist)
+        closest = i;
+    const EPAFace face = faces[closest];
+    const Vertex w = supportVertex(a, b, face.normal);
+    if (face.normal.dot(w.w) - face.dist <= EPARelativeTolerance * std::max(face.dist, 0.f) + absoluteTolerance)
+      break;
+
+    /* Faces the new point sees are replaced by a fan from it over the edges bounding them */
+    const uint32_t newIndex = uint32_t(verts.size());
+    verts.push_back(w);
+    horizon.clear();
+    const auto visible = [&](const EPAFace& f) { return f.normal.dot(w.w - verts[f.idx[0]].w) > 0.f; };
+    for (const EPAFace& f : faces) {
+      if (!visible(f))
+        continue;
+      for (int e = 0; e < 3; ++e) {
+        const std::pair<uint32_t, uint32_t> edge(f.idx[e], f.idx[(e + 1) % 3]);
+        const auto shared = std::find(horizon.begin(), horizon.end(), std::make_pair(edge.second, edge.first));
+        if (shared != horizon.end())
+          horizon.erase(shared);
+        else
+          horizon.push_back(edge);
+      }
+    }
+    if (horizon.empty())
+      break;
+    std::erase_if(faces, visible);
+    for (const auto& edge : horizon)
+      faces.push_back(makeFace(verts, edge.first, edge.second, newIndex));
+  }
+
+  closest = 0;
+  for (size_t i = 1; i < faces.size(); ++i)
+    if (faces[i].dist < faces[closest].dist)
+      closest = i;
+  const EPAFace& face = faces[closest];
+  ret.depth = std::max(face.dist, 0.f);
+  ret.normal = face.normal;
+
+  /* Barycentric weights of the origin's projection onto the face carry over to the support points */
+  const Vertex& va = verts[face.idx[0]];
+  const Vertex& vb = verts[face.idx[1]];
+  const Vertex& vc = verts[face.idx[2]];
+  const CVector3f e0 = vb.w - va.w;
+  const CVector3f e1 = vc.w - va.w;
+  const CVector3f ep = face.normal * face.dist - va.w;
+  const float d00 = e0.dot(e0);
+  const float d01 = e0.dot(e1);
+  const float d11 = e1.dot(e1);
+  const float d20 = ep.dot(e0);
+  const float d21 = ep.dot(e1);
+  const float denom = d00 * d11 - d01 * d01;
+  const float v = denom > 0.f ? (d11 * d20 - d01 * d21) / denom : 0.f;
+  const float u = denom > 0.f ? (d00 * d21 - d01 * d20) / denom : 0.f;
+  ret.pointA = va.a * (1.f - v - u) + vb.a * v + vc.a * u;
+  ret.pointB = va.b * (1.f - v - u) + vb.b * v + vc.b * u;
+  return ret;
+}
+} // namespace zeus
@@ -1,5 +1,7 @@
 #include "zeus/Math.hpp"
 
+#include <atomic>
+#include <bit>
 #include <cfloat>
 #include <cmath>
 #include <cstring>
@@ -40,6 +42,23 @@ void getCpuInfoEx(int eax, int ecx, int regs[4]) {
 #endif
 }
 
+/* Reads XCR0, the register state the OS saves on context switches, or 0 if XGETBV is unavailable */
+static uint64_t osSavedState(int leaf1Ecx) {
+#if defined(__x86_64__) || defined(_M_X64)
+  if ((leaf1Ecx & 0x08000000) == 0)
+    return 0;
+#if _WIN32
+  return _xgetbv(0);
+#else
+  uint32_t eax, edx;
+  __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (uint64_t(edx) << 32) | eax;
+#endif
+#else
+  return 0;
+#endif
+}
+
 void detectCPU() {
 #if defined(__x86_64__) || defined(_M_X64)
   if (isCPUInit)
@@ -66,6 +85,8 @@ void detectCPU() {
     }
   }
 
+  bool osYmmState = false;
+  bool osZmmState = false;
   if (highestFeature >= 1) {
     getCpuInfo(1, regs);
     memset((bool*)&g_cpuFeatures.AESNI, ((regs[2] & 0x02000000) != 0), 1);
@@ -75,12 +96,20 @@ void detectCPU() {
     memset((bool*)&g_cpuFeatures.SSSE3, ((regs[2] & 0x00000200) != 0), 1);
     memset((bool*)&g_cpuFeatures.SSE41, ((regs[2] & 0x00080000) != 0), 1);
     memset((bool*)&g_cpuFeatures.SSE42, ((regs[2] & 0x00100000) != 0), 1);
-    memset((bool*)&g_cpuFeatures.AVX, ((regs[2] & 0x10000000) != 0), 1);
+    /* AVX registers are only usable if the OS saves the YMM state; AVX-512 also needs the opmask and ZMM state */
+    const uint64_t savedState = osSavedState(regs[2]);
+    osYmmState = (savedState & 0x06) == 0x06;
+    osZmmState = (savedState & 0xE6) == 0xE6;
+    memset((bool*)&g_cpuFeatures.AVX, ((regs[2] & 0x10000000) != 0) && osYmmState, 1);
   }
 
   if (highestFeature >= 7) {
     getCpuInfoEx(7, 0, regs);
-    memset((bool*)&g_cpuFeatures.AVX2, ((regs[1] & 0x00000020) != 0), 1);
+    memset((bool*)&g_cpuFeatures.AVX2, ((regs[1] & 0x00000020) != 0) && g_cpuFeatures.AVX, 1);
+    memset((bool*)&g_cpuFeatures.AVX512F, ((regs[1] & 0x00010000) != 0) && osZmmState, 1);
+    memset((bool*)&g_cpuFeatures.AVX512DQ, ((regs[1] & 0x00020000) != 0) && g_cpuFeatures.AVX512F, 1);
+    memset((bool*)&g_cpuFeatures.AVX512BW, ((regs[1] & 0x40000000) != 0) && g_cpuFeatures.AVX512F, 1);
+    memset((bool*)&g_cpuFeatures.AVX512VL, ((regs[1] & 0x80000000) != 0) && g_cpuFeatures.AVX512F, 1);
   }
 
   if (maxExtended >= 0x80000001) {
@@ -97,10 +126,79 @@ const CPUInfo& cpuFeatures() {
   return g_cpuFeatures;
 }
 
+static std::atomic<EKernelISA> g_kernelISA{EKernelISA::Baseline};
+
+bool kernelISASupported(EKernelISA isa) {
+  switch (isa) {
+  case EKernelISA::Baseline:
+    return true;
+  case EKernelISA::AVX2:
+#if ZEUS_KERNEL_AVX2
+    return cpuFeatures().AVX2;
+#else
+    return false;
+#endif
+  case EKernelISA::AVX512:
+#if ZEUS_KERNEL_AVX512
+    return cpuFeatures().AVX512F;
+#else
+    return false;
+#endif
+  }
+  return false;
+}
+
+EKernelISA kernelISA() {
+  static const bool detected = [] {
+    for (size_t i = KernelISACount; i-- > 0;) {
+      if (kernelISASupported(EKernelISA(i))) {
+        g_kernelISA.store(EKernelISA(i), std::memory_order_relaxed);
+        break;
+      }
+    }
+    return true;
+  }();
+  (void)detected;
+  return g_kernelISA.load(std::memory_order_relaxed);
+}
+
+bool setKernelISA(EKernelISA isa) {
+  /* Run detection first so it cannot later replace the override */
+  (void)kernelISA();
+  if (!kernelISASupported(isa))
+    return false;
+  g_kernelISA.store(isa, std::memory_order_relaxed);
+  return true;
+}
+
 std::pair<bool, const CPUInfo&> validateCPU() {
   detectCPU();
   bool ret = true;
 
+#if __AVX512VL__
+  if (!g_cpuFeatures.AVX512VL) {
+    *(bool*)&g_missingFeatures.AVX512VL = true;
+    ret = false;
+  }
+#endif
+#if __AVX512BW__
+  if (!g_cpuFeatures.AVX512BW) {
+    *(bool*)&g_missingFeatures.AVX512BW = true;
+    ret = false;
+  }
+#endif
+#if __AVX512DQ__
+  if (!g_cpuFeatures.AVX512DQ) {
+    *(bool*)&g_missingFeatures.AVX512DQ = true;
+    ret = false;
+  }
+#endif
+#if __AVX512F__
+  if (!g_cpuFeatures.AVX512F) {
+    *(bool*)&g_missingFeatures.AVX512F = true;
+    ret = false;
+  }
+#endif
 #if __AVX2__
   if (!g_cpuFeatures.AVX2) {
     *(bool*)&g_missingFeatures.AVX2 = true;
@@ -213,6 +311,49 @@ int ceilingPowerOfTwo(int x) {
   return x;
 }
 
+uint16_t floatToHalf(float val) {
+  constexpr uint32_t f32Infinity = 255 << 23;
+  constexpr uint32_t f16Max = (127 + 16) << 23;
+  constexpr uint32_t denormMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+
+  uint32_t bits = std::bit_cast<uint32_t>(val);
+  const uint32_t sign = bits & 0x80000000;
+  bits ^= sign;
+
+  uint32_t half;
+  if (bits >= f16Max) {
+    /* Inf stays Inf, NaN becomes a quiet NaN */
+    half = bits > f32Infinity ? 0x7E00 : 0x7C00;
+  } else if (bits < (113 << 23)) {
+    /* Subnormal or zero; the float add aligns the mantissa and rounds to nearest even */
+    half = std::bit_cast<uint32_t>(std::bit_cast<float>(bits) + std::bit_cast<float>(denormMagic)) - denormMagic;
+  } else {
+    const uint32_t mantOdd = (bits >> 13) & 1;
+    bits += (uint32_t(15 - 127) << 23) + 0xFFF;
+    bits += mantOdd;
+    half = bits >> 13;
+  }
+  return uint16_t(half | (sign >> 16));
+}
+
+float halfToFloat(uint16_t val) {
+  constexpr uint32_t shiftedExp = 0x7C00 << 13;
+  constexpr float magic = std::bit_cast<float>(uint32_t(113 << 23));
+
+  uint32_t bits = uint32_t(val & 0x7FFF) << 13;
+  const uint32_t exp = bits & shiftedExp;
+  bits += (127 - 15) << 23;
+  if (exp == shiftedExp) {
+    /* Inf or NaN */
+    bits += (128 - 16) << 23;
+  } else if (exp == 0) {
+    /* Zero or subnormal, renormalized through a float subtract */
+    bits += 1 << 23;
+    bits = std::bit_cast<uint32_t>(std::bit_cast<float>(bits) - magic);
+  }
+  return std::bit_cast<float>(bits | (uint32_t(val & 0x8000) << 16));
+}
+
 float getCatmullRomSplinePoint(float a, float b, float c, float d, float t) {
   if (t <= 0.0f)
     return b;
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace zeus {
+/* Workers for count items, each given at least grain of them and at most threadCount in all; 0 uses every hardware
+ * thread */
+inline size_t parallelWorkers(size_t count, unsigned threadCount, size_t grain) {
+  if (threadCount == 0)
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  return std::min(size_t(threadCount), std::max(size_t(1), count / grain));
+}
+
+/**
+ * Calls kernel(worker, begin, end) over [0, count), one chunk for each of parallelWorkers(count, threadCount, grain)
+ * workers, the first on the calling thread. Chunks start on multiples of align so only the last has a partial block.
+ * Returns how many chunks ran; they are workers [0, n), as trailing workers get no chunk once rounding covers count.
+ */
+template <typename Kernel>
+size_t parallelSplit(size_t count, unsigned threadCount, size_t grain, size_t align, Kernel&& kernel) {
+  const size_t workers = parallelWorkers(count, threadCount, grain);
+  if (workers <= 1) {
+    kernel(size_t(0), size_t(0), count);
+    return 1;
+  }
+
+  const size_t chunk = ((count + workers - 1) / workers + align - 1) / align * align;
+  std::vector<std::future<void>> tasks;
+  tasks.reserve(workers - 1);
+  size_t w = 1;
+  for (; w < workers && w * chunk < count; ++w)
+    tasks.push_back(std::async(std::launch::async, [&kernel, w, chunk, count] {
+      kernel(w, w * chunk, std::min((w + 1) * chunk, count));
+    }));
+  kernel(size_t(0), size_t(0), std::min(chunk, count));
+  for (auto& task : tasks)
+    task.get();
+  return w;
+}
+} // namespace zeus
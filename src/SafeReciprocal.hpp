@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cfloat>
+#include <cmath>
+
+namespace zeus {
+/* Finite stand-in for 1/0 so that (bound - origin) * reciprocal never produces 0 * inf */
+inline float safeReciprocal(float v) { return std::fabs(v) > FLT_MIN ? 1.f / v : std::copysign(FLT_MAX, v); }
+} // namespace zeus
@@ -0,0 +1,380 @@
+#include "zeus/SpatialKey.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#if ZEUS_KERNEL_AVX2 || ZEUS_KERNEL_AVX512
+#include <immintrin.h>
+#endif
+
+#include "zeus/Math.hpp"
+
+#include "ParallelSplit.hpp"
+
+namespace zeus {
+namespace {
+/* Each worker of a threaded split gets at least this many points or keys */
+constexpr size_t ParallelKeyCount = 1 << 14;
+constexpr size_t ParallelSortCount = 1 << 16;
+/* Key chunks keep to whole 8-point blocks so only the last one has a tail */
+constexpr size_t KeyBlockSize = 8;
+constexpr uint32_t RadixBits = 8;
+constexpr size_t RadixSize = size_t(1) << RadixBits;
+
+/* Maps coordinates to cells of a 2^bits grid over some bounds */
+struct Grid {
+  std::array<float, 3> min;
+  std::array<float, 3> scale;
+  float maxCell;
+};
+
+Grid gridOver(const CAABox& bounds, uint32_t bits) {
+  Grid grid;
+  const float cells = float(1u << bits);
+  for (int i = 0; i < 3; ++i) {
+    const float extent = bounds.max[i] - bounds.min[i];
+    grid.min[i] = bounds.min[i];
+    grid.scale[i] = extent > 0.f ? cells / extent : 0.f;
+  }
+  grid.maxCell = cells - 1.f;
+  return grid;
+}
+
+/* Written so that NaN lands in cell 0, as the SIMD max/min order does */
+uint32_t quantize(const Grid& grid, const CVector3f& point, int axis) {
+  const float cell = (point[axis] - grid.min[axis]) * grid.scale[axis];
+  return uint32_t(cell > 0.f ? std::min(cell, grid.maxCell) : 0.f);
+}
+
+/* Skilling, "Programming the Hilbert curve": turns coordinates into the transposed Hilbert index in place */
+template <size_t N>
+void hilbertTranspose(std::array<uint32_t, N>& axes, uint32_t bits) {
+  for (uint32_t bit = bits - 1; bit > 0; --bit) {
+    const uint32_t low = (1u << bit) - 1;
+    for (size_t i = 0; i < N; ++i) {
+      /* Invert the low bits of the first axis where axis i has this bit set, otherwise exchange them */
+      const uint32_t set = 0u - ((axes[i] >> bit) & 1u);
+      const uint32_t t = (axes[0] ^ axes[i]) & low;
+      axes[0] ^= (low & set) | (t & ~set);
+      axes[i] ^= t & ~set;
+    }
+  }
+  for (size_t i = 1; i < N; ++i)
+    axes[i] ^= axes[i - 1];
+  uint32_t t = 0;
+  for (uint32_t bit = bits - 1; bit > 0; --bit)
+    t ^= ((1u << bit) - 1) & (0u - ((axes[N - 1] >> bit) & 1u));
+  for (uint32_t& axis : axes)
+    axis ^= t;
+}
+
+void mortonKernel30(const Grid& grid, const CVector3f* points, uint32_t* keys, size_t begin, size_t end) {
+  for (size_t i = begin; i < end; ++i)
+    keys[i] = encodeMorton30(quantize(grid, points[i], 0), quantize(grid, points[i], 1), quantize(grid, points[i], 2));
+}
+
+void mortonKernel63(const Grid& grid, const CVector3f* points, uint64_t* keys, size_t begin, size_t end) {
+  for (size_t i = begin; i < end; ++i)
+    keys[i] = encodeMorton63(quantize(grid, points[i], 0), quantize(grid, points[i], 1), quantize(grid, points[i], 2));
+}
+
+void hilbertKernel63(const Grid& grid, const CVector3f* points, uint64_t* keys, size_t begin, size_t end) {
+  for (size_t i = begin; i < end; ++i)
+    keys[i] = encodeHilbert63(quantize(grid, points[i], 0), quantize(grid, points[i], 1), quantize(grid, points[i], 2));
+}
+
+#if ZEUS_KERNEL_AVX2
+/* Transposes eight points into coordinate registers */
+ZEUS_TARGET_AVX2 void loadPointsAVX2(const CVector3f* points, __m256& x, __m256& y, __m256& z) {
+  /* Points i and i + 4 share a register, so each 128-bit half transposes four consecutive points */
+  __m256 rows[4];
+  for (size_t i = 0; i < 4; ++i)
+    rows[i] = _mm256_insertf128_ps(_mm256_castps128_ps256(points[i].mSimd.native()), points[i + 4].mSimd.native(), 1);
+  const auto& [a, b, c, d] = rows;
+  const __m256 abLo = _mm256_unpacklo_ps(a, b);
+  const __m256 cdLo = _mm256_unpacklo_ps(c, d);
+  const __m256 abHi = _mm256_unpackhi_ps(a, b);
+  const __m256 cdHi = _mm256_unpackhi_ps(c, d);
+  x = _mm256_shuffle_ps(abLo, cdLo, _MM_SHUFFLE(1, 0, 1, 0));
+  y = _mm256_shuffle_ps(abLo, cdLo, _MM_SHUFFLE(3, 2, 3, 2));
+  z = _mm256_shuffle_ps(abHi, cdHi, _MM_SHUFFLE(1, 0, 1, 0));
+}
+
+ZEUS_TARGET_AVX2 __m256i quantizeAVX2(__m256 v, float min, float scale, __m256 maxCell) {
+  const __m256 cell = _mm256_mul_ps(_mm256_sub_ps(v, _mm256_set1_ps(min)), _mm256_set1_ps(scale));
+  return _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(cell, _mm256_setzero_ps()), maxCell));
+}
+
+ZEUS_TARGET_AVX2 __m256i spread30AVX2(__m256i v) {
+  v = _mm256_and_si256(_mm256_or_si256(v, _mm256_slli_epi32(v, 16)), _mm256_set1_epi32(0x030000FF));
+  v = _mm256_and_si256(_mm256_or_si256(v, _mm256_slli_epi32(v, 8)), _mm256_set1_epi32(0x0300F00F));
+  v = _mm256_and_si256(_mm256_or_si256(v, _mm256_slli_epi32(v, 4)), _mm256_set1_epi32(0x030C30C3));
+  return _mm256_and_si256(_mm256_or_si256(v, _mm256_slli_epi32(v, 2)), _mm256_set1_epi32(0x09249249));
+}
+
+ZEUS_TARGET_AVX2 __m256i spread63AVX2(__m128i cells) {
+  __m256i v = _mm256_cvtepu32_epi64(cells);
+  v = _mm256_and_si256(_mm256_or_si256(v, _mm256_slli_epi64(v, 32)), _mm256_set1_epi64x(0x001F00000000FFFFll));
+  v = _mm256_and_si256(_mm256_or_si256(v, _mm256_slli_epi64(v, 16)), _mm256_set1_epi64x(0x001F0000FF0000FFll));
+  v = _mm256_and_si256(_mm256_or_si256(v, _mm256_slli_epi64(v, 8)), _mm256_set1_epi64x(0x100F00F00F00F00Fll));
+  v = _mm256_and_si256(_mm256_or_si256(v, _mm256_slli_epi64(v, 4)), _mm256_set1_epi64x(0x10C30C30C30C30C3ll));
+  return _mm256_and_si256(_mm256_or_si256(v, _mm256_slli_epi64(v, 2)), _mm256_set1_epi64x(0x1249249249249249ll));
+}
+
+ZEUS_TARGET_AVX2 __m256i interleave63AVX2(__m128i x, __m128i y, __m128i z) {
+  return _mm256_or_si256(_mm256_or_si256(spread63AVX2(x), _mm256_slli_epi64(spread63AVX2(y), 1)),
+                         _mm256_slli_epi64(spread63AVX2(z), 2));
+}
+
+ZEUS_TARGET_AVX2 void quantizePointsAVX2(const Grid& grid, const CVector3f* points, __m256i& x, __m256i& y,
+                                         __m256i& z) {
+  __m256 px, py, pz;
+  loadPointsAVX2(points, px, py, pz);
+  const __m256 maxCell = _mm256_set1_ps(grid.maxCell);
+  x = quantizeAVX2(px, grid.min[0], grid.scale[0], maxCell);
+  y = quantizeAVX2(py, grid.min[1], grid.scale[1], maxCell);
+  z = quantizeAVX2(pz, grid.min[2], grid.scale[2], maxCell);
+}
+
+ZEUS_TARGET_AVX2 void mortonKernel30AVX2(const Grid& grid, const CVector3f* points, uint32_t* keys, size_t begin,
+                                         size_t end) {
+  size_t i = begin;
+  for (; i + 8 <= end; i += 8) {
+    __m256i x, y, z;
+    quantizePointsAVX2(grid, points + i, x, y, z);
+    const __m256i key = _mm256_or_si256(_mm256_or_si256(spread30AVX2(x), _mm256_slli_epi32(spread30AVX2(y), 1)),
+                                        _mm256_slli_epi32(spread30AVX2(z), 2));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys + i), key);
+  }
+  mortonKernel30(grid, points, keys, i, end);
+}
+
+ZEUS_TARGET_AVX2 void mortonKernel63AVX2(const Grid& grid, const CVector3f* points, uint64_t* keys, size_t begin,
+                                         size_t end) {
+  size_t i = begin;
+  for (; i + 8 <= end; i += 8) {
+    __m256i x, y, z;
+    quantizePointsAVX2(grid, points + i, x, y, z);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys + i),
+                        interleave63AVX2(_mm256_castsi256_si128(x), _mm256_castsi256_si128(y),
+                                         _mm256_castsi256_si128(z)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys + i + 4),
+                        interleave63AVX2(_mm256_extracti128_si256(x, 1), _mm256_extracti128_si256(y, 1),
+                                         _mm256_extracti128_si256(z, 1)));
+  }
+  mortonKernel63(grid, points, keys, i, end);
+}
+
+/* hilbertTranspose on eight points at once; the bit tests become lane masks */
+ZEUS_TARGET_AVX2 void hilbertTransposeAVX2(__m256i& x, __m256i& y, __m256i& z) {
+  __m256i* const axes[3] = {&x, &y, &z};
+  for (uint32_t bit = Morton63AxisBits - 1; bit > 0; --bit) {
+    const __m256i q = _mm256_set1_epi32(int(1u << bit));
+    const __m256i low = _mm256_set1_epi32(int((1u << bit) - 1));
+    for (__m256i* axis : axes) {
+      const __m256i set = _mm256_cmpeq_epi32(_mm256_and_si256(*axis, q), q);
+      const __m256i t = _mm256_and_si256(_mm256_xor_si256(x, *axis), low);
+      x = _mm256_xor_si256(x, _mm256_blendv_epi8(t, low, set));
+      *axis = _mm256_xor_si256(*axis, _mm256_andnot_si256(set, t));
+    }
+  }
+  y = _mm256_xor_si256(y, x);
+  z = _mm256_xor_si256(z, y);
+  __m256i t = _mm256_setzero_si256();
+  for (uint32_t bit = Morton63AxisBits - 1; bit > 0; --bit) {
+    const __m256i q = _mm256_set1_epi32(int(1u << bit));
+    const __m256i set = _mm256_cmpeq_epi32(_mm256_and_si256(z, q), q);
+    t = _mm256_xor_si256(t, _mm256_and_si256(set, _mm256_set1_epi32(int((1u << bit) - 1))));
+  }
+  x = _mm256_xor_si256(x, t);
+  y = _mm256_xor_si256(y, t);
+  z = _mm256_xor_si256(z, t);
+}
+
+ZEUS_TARGET_AVX2 void hilbertKernel63AVX2(const Grid& grid, const CVector3f* points, uint64_t* keys, size_t begin,
+                                          size_t end) {
+  size_t i = begin;
+  for (; i + 8 <= end; i += 8) {
+    __m256i x, y, z;
+    quantizePointsAVX2(grid, points + i, x, y, z);
+    hilbertTransposeAVX2(x, y, z);
+    /* As in encodeHilbert63, the first transposed axis takes the top bit of each group */
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys + i),
+                        interleave63AVX2(_mm256_castsi256_si128(z), _mm256_castsi256_si128(y),
+                                         _mm256_castsi256_si128(x)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys + i + 4),
+                        interleave63AVX2(_mm256_extracti128_si256(z, 1), _mm256_extracti128_si256(y, 1),
+                                         _mm256_extracti128_si256(x, 1)));
+  }
+  hilbertKernel63(grid, points, keys, i, end);
+}
+#endif
+
+struct KeyKernels {
+  void (*morton30)(const Grid& grid, const CVector3f* points, uint32_t* keys, size_t begin, size_t end);
+  void (*morton63)(const Grid& grid, const CVector3f* points, uint64_t* keys, size_t begin, size_t end);
+  void (*hilbert63)(const Grid& grid, const CVector3f* points, uint64_t* keys, size_t begin, size_t end);
+};
+
+/* Indexed by EKernelISA; AVX-512 machines use the AVX2 kernels */
+constexpr std::array<KeyKernels, KernelISACount> KeyKernelTable{{
+    {mortonKernel30, mortonKernel63, hilbertKernel63},
+#if ZEUS_KERNEL_AVX2
+    {mortonKernel30AVX2, mortonKernel63AVX2, hilbertKernel63AVX2},
+    {mortonKernel30AVX2, mortonKernel63AVX2, hilbertKernel63AVX2},
+#else
+    {mortonKernel30, mortonKernel63, hilbertKernel63},
+    {mortonKernel30, mortonKernel63, hilbertKernel63},
+#endif
+}};
+
+/* Digit counts of keys[begin, end) for passes [firstPass, lastPass), in locals so stores elsewhere can't alias them */
+template <typename Key, size_t PassCount>
+void countDigits(const Key* keys, size_t begin, size_t end, size_t firstPass, size_t lastPass,
+                 std::array<std::array<uint32_t, RadixSize>, PassCount>& out) {
+  std::array<std::array<uint32_t, RadixSize>, PassCount> counts{};
+  for (size_t i = begin; i < end; ++i)
+    for (size_t pass = firstPass; pass < lastPass; ++pass)
+      ++counts[pass][size_t(keys[i] >> (pass * RadixBits)) & (RadixSize - 1)];
+  for (size_t pass = firstPass; pass < lastPass; ++pass)
+    out[pass] = counts[pass];
+}
+
+/* Moves keys[begin, end) and their values to the positions next gives for their digit, in order */
+template <typename Key>
+void scatterDigits(const Key* srcKeys, const uint32_t* srcValues, Key* dstKeys, uint32_t* dstValues, size_t begin,
+                   size_t end, uint32_t shift, std::array<uint32_t, RadixSize> next) {
+  for (size_t i = begin; i < end; ++i) {
+    const Key key = srcKeys[i];
+    const uint32_t j = next[size_t(key >> shift) & (RadixSize - 1)]++;
+    dstKeys[j] = key;
+    dstValues[j] = srcValues[i];
+  }
+}
+
+template <typename Key>
+void radixSort(std::span<Key> keys, std::span<uint32_t> values, unsigned threadCount) {
+  assert(values.size() == keys.size());
+  const size_t count = keys.size();
+  if (count < 2)
+    return;
+
+  constexpr size_t PassCount = sizeof(Key) * 8 / RadixBits;
+  using Counts = std::array<std::array<uint32_t, RadixSize>, PassCount>;
+  const size_t workers = parallelWorkers(count, threadCount, ParallelSortCount);
+  std::vector<Key> keyScratch(count);
+  std::vector<uint32_t> valueScratch(count);
+  Key* srcKeys = keys.data();
+  Key* dstKeys = keyScratch.data();
+  uint32_t* srcValues = values.data();
+  uint32_t* dstValues = valueScratch.data();
+  std::vector<Counts> counts(workers);
+
+  /* A lone worker's chunk is the whole input, whose counts don't change between passes, so one read gathers all */
+  if (workers == 1)
+    countDigits(srcKeys, 0, count, 0, PassCount, counts.front());
+
+  for (size_t pass = 0; pass < PassCount; ++pass) {
+    if (workers > 1) {
+      parallelSplit(count, threadCount, ParallelSortCount, 1, [&](size_t w, size_t begin, size_t end) {
+        countDigits(srcKeys, begin, end, pass, pass + 1, counts[w]);
+      });
+    }
+
+    /* Each worker scatters its chunk in order from its own offset into each digit's range, keeping the sort stable */
+    uint32_t total = 0;
+    bool oneDigit = false;
+    for (size_t digit = 0; digit < RadixSize; ++digit) {
+      const uint32_t digitBegin = total;
+      for (Counts& workerCounts : counts)
+        total += std::exchange(workerCounts[pass][digit], total);
+      oneDigit |= total - digitBegin == count;
+    }
+    if (oneDigit)
+      continue;
+
+    const uint32_t shift = uint32_t(pass) * RadixBits;
+    parallelSplit(count, threadCount, ParallelSortCount, 1, [&](size_t w, size_t begin, size_t end) {
+      scatterDigits(srcKeys, srcValues, dstKeys, dstValues, begin, end, shift, counts[w][pass]);
+    });
+    std::swap(srcKeys, dstKeys);
+    std::swap(srcValues, dstValues);
+  }
+
+  if (srcKeys != keys.data()) {
+    std::copy(srcKeys, srcKeys + count, keys.data());
+    std::copy(srcValues, srcValues + count, values.data());
+  }
+}
+} // Anonymous namespace
+
+uint64_t encodeHilbert63(uint32_t x, uint32_t y, uint32_t z) {
+  constexpr uint32_t mask = (1u << Morton63AxisBits) - 1;
+  std::array<uint32_t, 3> axes{x & mask, y & mask, z & mask};
+  hilbertTranspose(axes, Morton63AxisBits);
+  /* The first transposed axis supplies the most significant bit of each group */
+  return encodeMorton63(axes[2], axes[1], axes[0]);
+}
+
+uint32_t encodeHilbert2(const CVector2i& v) {
+  std::array<uint32_t, 2> axes{uint32_t(v.x) & 0xFFFFu, uint32_t(v.y) & 0xFFFFu};
+  hilbertTranspose(axes, 16);
+  return encodeMorton2({int32_t(axes[1]), int32_t(axes[0])});
+}
+
+uint32_t mortonKey30(const CVector3f& point, const CAABox& bounds) {
+  const Grid grid = gridOver(bounds, Morton30AxisBits);
+  return encodeMorton30(quantize(grid, point, 0), quantize(grid, point, 1), quantize(grid, point, 2));
+}
+
+uint64_t mortonKey63(const CVector3f& point, const CAABox& bounds) {
+  const Grid grid = gridOver(bounds, Morton63AxisBits);
+  return encodeMorton63(quantize(grid, point, 0), quantize(grid, point, 1), quantize(grid, point, 2));
+}
+
+uint64_t hilbertKey63(const CVector3f& point, const CAABox& bounds) {
+  const Grid grid = gridOver(bounds, Morton63AxisBits);
+  return encodeHilbert63(quantize(grid, point, 0), quantize(grid, point, 1), quantize(grid, point, 2));
+}
+
+void mortonKeys30(std::span<const CVector3f> points, const CAABox& bounds, std::span<uint32_t> keys,
+                  unsigned threadCount) {
+  assert(keys.size() >= points.size());
+  const Grid grid = gridOver(bounds, Morton30AxisBits);
+  const KeyKernels& kernels = KeyKernelTable[size_t(kernelISA())];
+  parallelSplit(points.size(), threadCount, ParallelKeyCount, KeyBlockSize, [&](size_t, size_t begin, size_t end) {
+    kernels.morton30(grid, points.data(), keys.data(), begin, end);
+  });
+}
+
+void mortonKeys63(std::span<const CVector3f> points, const CAABox& bounds, std::span<uint64_t> keys,
+                  unsigned threadCount) {
+  assert(keys.size() >= points.size());
+  const Grid grid = gridOver(bounds, Morton63AxisBits);
+  const KeyKernels& kernels = KeyKernelTable[size_t(kernelISA())];
+  parallelSplit(points.size(), threadCount, ParallelKeyCount, KeyBlockSize, [&](size_t, size_t begin, size_t end) {
+    kernels.morton63(grid, points.data(), keys.data(), begin, end);
+  });
+}
+
+void hilbertKeys63(std::span<const CVector3f> points, const CAABox& bounds, std::span<uint64_t> keys,
+                   unsigned threadCount) {
+  assert(keys.size() >= points.size());
+  const Grid grid = gridOver(bounds, Morton63AxisBits);
+  const KeyKernels& kernels = KeyKernelTable[size_t(kernelISA())];
+  parallelSplit(points.size(), threadCount, ParallelKeyCount, KeyBlockSize, [&](size_t, size_t begin, size_t end) {
+    kernels.hilbert63(grid, points.data(), keys.data(), begin, end);
+  });
+}
+
+void radixSortByKey(std::span<uint32_t> keys, std::span<uint32_t> values, unsigned threadCount) {
+  radixSort(keys, values, threadCount);
+}
+
+void radixSortByKey(std::span<uint64_t> keys, std::span<uint32_t> values, unsigned threadCount) {
+  radixSort(keys, values, threadCount);
+}
+} // namespace zeus
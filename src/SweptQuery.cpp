@@ -0,0 +1,356 @@
+#include "zeus/SweptQuery.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cfloat>
+#include <cmath>
+
+#include "zeus/CQuaternion.hpp"
+#include "zeus/ConvexQuery.hpp"
+
+#include "SafeReciprocal.hpp"
+
+namespace zeus {
+namespace {
+using SweepSimd = simd<float>;
+constexpr size_t SweepLanes = SweepSimd::size();
+
+constexpr int MaxAdvanceIterations = 64;
+/* Conservative advancement reports contact once the boxes are closer than this fraction of their combined size */
+constexpr float AdvanceTolerance = 1e-3f;
+/* Rotations smaller than this many radians are left out of the interpolated pose */
+constexpr float MinRotation = 1e-6f;
+
+CVector3f axisNormal(int axis, float sign) {
+  CVector3f ret;
+  ret[axis] = sign;
+  return ret;
+}
+
+/* Unit normal out of a box of the given half size centred on the origin, for the shallowest way out of p */
+CVector3f shallowestFace(const CVector3f& p, const CVector3f& halfSize) {
+  int axis = 0;
+  float best = FLT_MAX;
+  for (int i = 0; i < 3; ++i) {
+    const float depth = halfSize[i] - std::fabs(p[i]);
+    if (depth < best) {
+      best = depth;
+      axis = i;
+    }
+  }
+  return axisNormal(axis, p[axis] < 0.f ? -1.f : 1.f);
+}
+
+/* Slab test of the motion from origin against a box, over the whole motion and before */
+struct Slab {
+  float enter = -FLT_MAX;
+  float exit = FLT_MAX;
+  /* Axis of the last slab entered, -1 when the origin starts inside all of them */
+  int axis = -1;
+};
+
+bool slabTest(const CVector3f& origin, const CVector3f& delta, const CVector3f& lo, const CVector3f& hi, Slab& slab) {
+  for (int i = 0; i < 3; ++i) {
+    if (delta[i] == 0.f) {
+      if (origin[i] < lo[i] || origin[i] > hi[i])
+        return false;
+      continue;
+    }
+    const float inv = 1.f / delta[i];
+    float t0 = (lo[i] - origin[i]) * inv;
+    float t1 = (hi[i] - origin[i]) * inv;
+    if (t0 > t1)
+      std::swap(t0, t1);
+    if (t0 > slab.enter) {
+      slab.enter = t0;
+      slab.axis = i;
+    }
+    slab.exit = std::min(slab.exit, t1);
+  }
+  return slab.enter <= slab.exit && slab.enter <= 1.f && slab.exit > 0.f;
+}
+
+/* First time in [0, 1] at which origin + delta * t comes within radius of center */
+bool sweepPointSphere(const CVector3f& origin, const CVector3f& delta, const CVector3f& center, float radius,
+                      float& t) {
+  const CVector3f m = origin - center;
+  const float b = m.dot(delta);
+  const float c = m.magSquared() - radius * radius;
+  if (c > 0.f && b >= 0.f)
+    return false;
+  const float a = delta.magSquared();
+  const float disc = b * b - a * c;
+  if (disc < 0.f)
+    return false;
+  t = a > 0.f ? std::max((-b - std::sqrt(disc)) / a, 0.f) : 0.f;
+  return t <= 1.f;
+}
+
+/**
+ * First time origin + delta * t comes within radius of the segment from p to q. The start is outside the capsule,
+ * so the first contact is either with the side of the cylinder, between the ends, or with one of the end spheres.
+ */
+bool sweepPointCapsule(const CVector3f& origin, const CVector3f& delta, const CVector3f& p, const CVector3f& q,
+                       float radius, float& t) {
+  const CVector3f d = q - p;
+  const CVector3f m = origin - p;
+  const float dd = d.magSquared();
+  const float md = m.dot(d);
+  const float nd = delta.dot(d);
+  const float a = dd * delta.magSquared() - nd * nd;
+  const float c = dd * (m.magSquared() - radius * radius) - md * md;
+  bool hit = false;
+  t = FLT_MAX;
+  if (a > 0.f && c > 0.f) {
+    const float b = dd * m.dot(delta) - nd * md;
+    const float disc = b * b - a * c;
+    if (disc >= 0.f) {
+      const float tc = (-b - std::sqrt(disc)) / a;
+      const float s = md + tc * nd;
+      if (tc >= 0.f && tc <= 1.f && s >= 0.f && s <= dd) {
+        t = tc;
+        hit = true;
+      }
+    }
+  }
+  float ts;
+  if (sweepPointSphere(origin, delta, p, radius, ts) && ts < t) {
+    t = ts;
+    hit = true;
+  }
+  if (sweepPointSphere(origin, delta, q, radius, ts) && ts < t) {
+    t = ts;
+    hit = true;
+  }
+  return hit;
+}
+
+CVector3f boxCorner(const CAABox& box, uint32_t maxBits) {
+  return {(maxBits & 1) ? box.max.x() : box.min.x(), (maxBits & 2) ? box.max.y() : box.min.y(),
+          (maxBits & 4) ? box.max.z() : box.min.z()};
+}
+
+/**
+ * Screens a run of boxes grown by grow against the motion, SweepLanes at a time, and hands each lane that may be hit
+ * before best.time to test in order. Lanes past the end are masked off, so the final run is read from a padded copy.
+ */
+template <typename Test>
+SSweepHit sweepBoxes(const CVector3f& origin, const CVector3f& delta, const CVector3f& grow,
+                     const CAABoxSoA& boxes, uint32_t& index, Test test) {
+  const std::array<std::span<const float>, 6> spans{boxes.minX, boxes.minY, boxes.minZ,
+                                                   boxes.maxX, boxes.maxY, boxes.maxZ};
+  const SweepSimd ox(origin.x()), oy(origin.y()), oz(origin.z());
+  const SweepSimd ix(safeReciprocal(delta.x())), iy(safeReciprocal(delta.y())), iz(safeReciprocal(delta.z()));
+  const SweepSimd gx(grow.x()), gy(grow.y()), gz(grow.z());
+  const SweepSimd zero(0.f);
+  const auto slab = [](const SweepSimd& lo, const SweepSimd& hi, const SweepSimd& o, const SweepSimd& inv,
+                       SweepSimd& enter, SweepSimd& exit) {
+    const SweepSimd t0 = (lo - o) * inv;
+    const SweepSimd t1 = (hi - o) * inv;
+    enter = max(enter, min(t0, t1));
+    exit = min(exit, max(t0, t1));
+  };
+
+  SSweepHit best;
+  best.time = 1.f;
+  const size_t count = boxes.size();
+  std::array<std::array<float, SweepLanes>, 6> tail{};
+  for (size_t i = 0; i < count; i += SweepLanes) {
+    const size_t lanes = std::min(SweepLanes, count - i);
+    std::array<const float*, 6> data;
+    for (size_t c = 0; c < 6; ++c) {
+      data[c] = &spans[c][i];
+      if (lanes < SweepLanes) {
+        std::copy_n(data[c], lanes, tail[c].begin());
+        data[c] = tail[c].data();
+      }
+    }
+
+    SweepSimd enter(zero);
+    SweepSimd exit(best.time);
+    slab(loadLanes(data[0]) - gx, loadLanes(data[3]) + gx, ox, ix, enter, exit);
+    slab(loadLanes(data[1]) - gy, loadLanes(data[4]) + gy, oy, iy, enter, exit);
+    slab(loadLanes(data[2]) - gz, loadLanes(data[5]) + gz, oz, iz, enter, exit);
+    uint32_t mask = uint32_t(bitmask(enter <= exit)) & ((1u << lanes) - 1u);
+    for (; mask != 0; mask &= mask - 1) {
+      const size_t j = i + std::countr_zero(mask);
+      const CAABox box({boxes.minX[j], boxes.minY[j], boxes.minZ[j]}, {boxes.maxX[j], boxes.maxY[j], boxes.maxZ[j]});
+      const SSweepHit hit = test(box);
+      if (hit.hit && (!best.hit || hit.time < best.time)) {
+        best = hit;
+        index = uint32_t(j);
+      }
+    }
+  }
+  if (!best.hit)
+    best.time = 0.f;
+  return best;
+}
+
+/* An oriented box partway along its motion, with the rotation taken the short way round */
+struct BoxMotion {
+  const COBBox& box;
+  CVector3f delta;
+  CQuaternion from, to;
+  float rotation;
+
+  BoxMotion(const COBBox& box, const CTransform& end)
+  : box(box), delta(end.origin - box.transform.origin), from(box.transform.basis), to(end.basis) {
+    rotation = 2.f * std::acos(std::min(std::fabs(from.dot(to)), 1.f));
+  }
+
+  COBBox at(float t) const {
+    const CMatrix3f basis =
+        rotation > MinRotation ? CMatrix3f(CQuaternion::slerpShort(from, to, t)) : box.transform.basis;
+    return {CTransform(basis, box.transform.origin + delta * t), box.extents};
+  }
+};
+
+/* Conservative advancement of a toward b over [0, tMax] */
+SSweepHit advance(const BoxMotion& a, const BoxMotion& b, float tMax) {
+  SSweepHit ret;
+  const float tolerance = AdvanceTolerance * (a.box.extents.magnitude() + b.box.extents.magnitude());
+  const float spin = a.rotation * a.box.extents.magnitude() + b.rotation * b.box.extents.magnitude();
+  SGJKCache cache;
+  CVector3f normal = a.box.transform.origin - b.box.transform.origin;
+  float t = 0.f;
+  for (int i = 0; i < MaxAdvanceIterations; ++i) {
+    const CConvexShape shapeA(a.at(t));
+    const CConvexShape shapeB(b.at(t));
+    const SConvexDistance dist = gjkDistance(shapeA, shapeB, &cache);
+    if (dist.intersecting) {
+      if (t == 0.f)
+        normal = -epaPenetration(shapeA, shapeB).normal;
+      break;
+    }
+    normal = dist.pointA - dist.pointB;
+    if (dist.distance <= tolerance)
+      break;
+
+    /* Every point of a closes on b along the separating direction no faster than this */
+    const CVector3f toward = -normal / dist.distance;
+    const float speed = (a.delta - b.delta).dot(toward) + spin;
+    if (!(speed > 0.f))
+      return ret;
+    t += dist.distance / speed;
+    if (t > tMax)
+      return ret;
+  }
+
+  /* Also reached when the iterations run out, which counts as contact to stay conservative */
+  ret.hit = true;
+  ret.time = t;
+  ret.normal = normal.canBeNormalized() ? normal.normalized() : CVector3f(0.f, 0.f, 1.f);
+  return ret;
+}
+} // Anonymous namespace
+
+SSweepHit sweepSphereAABox(const CSphere& sphere, const CVector3f& delta, const CAABox& box) {
+  SSweepHit ret;
+  const CVector3f& c = sphere.position;
+  const float r = sphere.radius;
+  const CVector3f closest = box.clampToBox(c);
+  const float distSq = (c - closest).magSquared();
+  if (distSq < r * r) {
+    ret.hit = true;
+    ret.normal = distSq > 0.f ? (c - closest) / std::sqrt(distSq) : shallowestFace(c - box.center(), box.extents());
+    return ret;
+  }
+
+  /* Ericson's method: the sphere's centre against the box grown by the radius, then the rounded edges and corners */
+  Slab slab;
+  if (!slabTest(c, delta, box.min - r, box.max + r, slab))
+    return ret;
+  float t = std::max(slab.enter, 0.f);
+  const CVector3f p = c + delta * t;
+  uint32_t below = 0, above = 0;
+  for (int i = 0; i < 3; ++i) {
+    below |= uint32_t(p[i] < box.min[i]) << i;
+    above |= uint32_t(p[i] > box.max[i]) << i;
+  }
+  const int outside = std::popcount(below | above);
+  if (outside >= 2 && r > 0.f) {
+    if (outside == 2) {
+      /* Edge region: the edge runs along the remaining axis */
+      if (!sweepPointCapsule(c, delta, boxCorner(box, below ^ 7), boxCorner(box, above), r, t))
+        return ret;
+    } else {
+      /* Corner region: the first of the three edges meeting there */
+      const CVector3f corner = boxCorner(box, above);
+      t = FLT_MAX;
+      for (uint32_t axis = 1; axis < 8; axis <<= 1) {
+        float te;
+        if (sweepPointCapsule(c, delta, corner, boxCorner(box, above ^ axis), r, te))
+          t = std::min(t, te);
+      }
+      if (t > 1.f)
+        return ret;
+    }
+    const CVector3f hitPos = c + delta * t;
+    const CVector3f out = hitPos - box.clampToBox(hitPos);
+    ret.hit = true;
+    ret.time = t;
+    ret.normal = out.canBeNormalized() ? out.normalized() : -delta.normalized();
+    return ret;
+  }
+
+  ret.hit = true;
+  ret.time = t;
+  ret.normal = slab.axis >= 0 ? axisNormal(slab.axis, delta[slab.axis] > 0.f ? -1.f : 1.f)
+                              : shallowestFace(p - box.center(), box.extents() + r);
+  return ret;
+}
+
+SSweepHit sweepAABoxAABox(const CAABox& moving, const CVector3f& delta, const CAABox& box) {
+  SSweepHit ret;
+  const CVector3f halfSize = moving.extents();
+  const CVector3f c = moving.center();
+  const CVector3f lo = box.min - halfSize;
+  const CVector3f hi = box.max + halfSize;
+  if (c.x() > lo.x() && c.x() < hi.x() && c.y() > lo.y() && c.y() < hi.y() && c.z() > lo.z() && c.z() < hi.z()) {
+    ret.hit = true;
+    ret.normal = shallowestFace(c - box.center(), hi - box.center());
+    return ret;
+  }
+
+  /* Boxes that start out touching only count when moving into each other */
+  Slab slab;
+  if (!slabTest(c, delta, lo, hi, slab) || !(slab.enter >= 0.f))
+    return ret;
+  ret.hit = true;
+  ret.time = slab.enter;
+  ret.normal = axisNormal(slab.axis, delta[slab.axis] > 0.f ? -1.f : 1.f);
+  return ret;
+}
+
+SSweepHit sweepSphereAABoxes(const CSphere& sphere, const CVector3f& delta, const CAABoxSoA& boxes,
+                             uint32_t& index) {
+  return sweepBoxes(sphere.position, delta, CVector3f(sphere.radius), boxes, index,
+                    [&](const CAABox& box) { return sweepSphereAABox(sphere, delta, box); });
+}
+
+SSweepHit sweepAABoxAABoxes(const CAABox& moving, const CVector3f& delta, const CAABoxSoA& boxes,
+                            uint32_t& index) {
+  return sweepBoxes(moving.center(), delta, moving.extents(), boxes, index,
+                    [&](const CAABox& box) { return sweepAABoxAABox(moving, delta, box); });
+}
+
+SSweepHit timeOfImpact(const COBBox& a, const CTransform& aEnd, const COBBox& b, const CTransform& bEnd) {
+  return advance(BoxMotion(a, aEnd), BoxMotion(b, bEnd), 1.f);
+}
+
+SSweepHit timeOfImpact(const COBBox& a, const CTransform& aEnd, std::span<const COBBox> boxes, uint32_t& index) {
+  const BoxMotion motion(a, aEnd);
+  SSweepHit best;
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    /* Each candidate only has to be searched up to the earliest contact found so far */
+    const SSweepHit hit = advance(motion, BoxMotion(boxes[i], boxes[i].transform), best.hit ? best.time : 1.f);
+    if (hit.hit && (!best.hit || hit.time < best.time)) {
+      best = hit;
+      index = uint32_t(i);
+    }
+  }
+  return best;
+}
+} // namespace zeus
@@ -0,0 +1,123 @@
+#include "zeus/TriangleQuery.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "zeus/Math.hpp"
+
+namespace zeus {
+namespace {
+CVector3f absolute(const CVector3f& v) { return CVector3f(std::fabs(v.x()), std::fabs(v.y()), std::fabs(v.z())); }
+
+/* Whether the projections of the corners onto axis fall clear of the box's projection radius */
+bool separates(const CVector3f& axis, const std::array<CVector3f, 3>& v, const CVector3f& halfSize) {
+  const float p0 = v[0].dot(axis);
+  const float p1 = v[1].dot(axis);
+  const float p2 = v[2].dot(axis);
+  const float r = halfSize.dot(absolute(axis));
+  return std::max({p0, p1, p2}) < -r || std::min({p0, p1, p2}) > r;
+}
+} // Anonymous namespace
+
+bool rayTriangleIntersect(const CMRay& ray, const CVector3f& p0, const CVector3f& p1, const CVector3f& p2,
+                          float& distOut, CVector3f& baryOut) {
+  const CVector3f e1 = p1 - p0;
+  const CVector3f e2 = p2 - p0;
+  const CVector3f p = ray.dir.cross(e2);
+  const float det = e1.dot(p);
+  if (det == 0.f)
+    return false;
+  const float invDet = 1.f / det;
+
+  const CVector3f t = ray.start - p0;
+  const float u = t.dot(p) * invDet;
+  if (!(u >= 0.f && u <= 1.f))
+    return false;
+  const CVector3f q = t.cross(e1);
+  const float v = ray.dir.dot(q) * invDet;
+  if (!(v >= 0.f && u + v <= 1.f))
+    return false;
+  const float dist = e2.dot(q) * invDet;
+  if (!(dist >= 0.f && dist <= ray.length))
+    return false;
+
+  distOut = dist;
+  baryOut = CVector3f(1.f - u - v, u, v);
+  return true;
+}
+
+bool triangleAABoxIntersect(const CVector3f& p0, const CVector3f& p1, const CVector3f& p2, const CAABox& box) {
+  /* Akenine-Möller: everything relative to the box centre */
+  const CVector3f center = box.center();
+  const CVector3f halfSize = box.extents();
+  const std::array<CVector3f, 3> v{p0 - center, p1 - center, p2 - center};
+  const std::array<CVector3f, 3> f{v[1] - v[0], v[2] - v[1], v[0] - v[2]};
+
+  for (int i = 0; i < 3; ++i) {
+    if (std::max({v[0][i], v[1][i], v[2][i]}) < -halfSize[i] || std::min({v[0][i], v[1][i], v[2][i]}) > halfSize[i])
+      return false;
+  }
+
+  const CVector3f normal = f[0].cross(f[1]);
+  if (std::fabs(normal.dot(v[0])) > halfSize.dot(absolute(normal)))
+    return false;
+
+  for (int i = 0; i < 3; ++i) {
+    CVector3f boxAxis;
+    boxAxis[i] = 1.f;
+    for (const CVector3f& edge : f) {
+      if (separates(boxAxis.cross(edge), v, halfSize))
+        return false;
+    }
+  }
+  return true;
+}
+
+CVector3f closestPointOnTriangle(const CVector3f& point, const CVector3f& p0, const CVector3f& p1,
+                                 const CVector3f& p2, CVector3f* baryOut) {
+  /* Ericson's Voronoi region tests, corners and edges first */
+  const CVector3f ab = p1 - p0;
+  const CVector3f ac = p2 - p0;
+  const CVector3f ap = point - p0;
+  const float d1 = ab.dot(ap);
+  const float d2 = ac.dot(ap);
+  CVector3f bary;
+  if (d1 <= 0.f && d2 <= 0.f) {
+    bary = CVector3f(1.f, 0.f, 0.f);
+  } else {
+    const CVector3f bp = point - p1;
+    const float d3 = ab.dot(bp);
+    const float d4 = ac.dot(bp);
+    const CVector3f cp = point - p2;
+    const float d5 = ab.dot(cp);
+    const float d6 = ac.dot(cp);
+    const float vc = d1 * d4 - d3 * d2;
+    const float vb = d5 * d2 - d1 * d6;
+    const float va = d3 * d6 - d5 * d4;
+    if (d3 >= 0.f && d4 <= d3) {
+      bary = CVector3f(0.f, 1.f, 0.f);
+    } else if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f) {
+      const float v = d1 / (d1 - d3);
+      bary = CVector3f(1.f - v, v, 0.f);
+    } else if (d6 >= 0.f && d5 <= d6) {
+      bary = CVector3f(0.f, 0.f, 1.f);
+    } else if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f) {
+      const float w = d2 / (d2 - d6);
+      bary = CVector3f(1.f - w, 0.f, w);
+    } else if (va <= 0.f && d4 - d3 >= 0.f && d5 - d6 >= 0.f) {
+      const float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+      bary = CVector3f(0.f, 1.f - w, w);
+    } else {
+      const float denom = 1.f / (va + vb + vc);
+      const float v = vb * denom;
+      const float w = vc * denom;
+      bary = CVector3f(1.f - v - w, v, w);
+    }
+  }
+
+  if (baryOut != nullptr)
+    *baryOut = bary;
+  return baryToWorld(p0, p1, p2, bary);
+}
+} // namespace zeus
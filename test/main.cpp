@@ -1,5 +1,12 @@
+/* The checks below are plain asserts; keep them in release builds too */
+#undef NDEBUG
+#include <cassert>
+
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <vector>
+#include <zeus/CEulerAngles.hpp>
 #include <zeus/zeus.hpp>
 
 // This is only for testing, do NOT do this normally
@@ -22,7 +29,7 @@ int main() {
   assert(vec.canBeNormalized());
   assert(!vec.isZero());
   assert(CVector3f().isZero());
-  assert(!vec.normalized().canBeNormalized());
+  assert(vec.normalized().canBeNormalized());
   float blarg = 5.f;
   CVector3f t{100, 100, 200};
   blarg = clamp(0.f, blarg, 1.f);
@@ -78,5 +85,1431 @@ int main() {
   std::cout << (int)ctest1.r() << " " << (int)ctest1.g() << " " << (int)ctest1.b() << " " << (int)ctest1.a()
             << std::endl;
   std::cout << h << " " << s << " " << v << " " << (float)(ctest1.a() / 255.f) << std::endl;
+
+  CFrustum frustum;
+  frustum.updatePlanes(lookAt({0.f, -10.f, 0.f}, {0.f, 0.f, 0.f}),
+                       CProjection(SProjPersp(degToRad(60.f), 1.f, 1.f, 100.f)));
+  std::vector<float> bounds[6];
+  for (int i = 0; i < 37; ++i) {
+    const CVector3f center(float(i % 7) * 8.f - 24.f, float(i % 5) * 10.f - 5.f, float(i % 3) * 6.f - 6.f);
+    for (int c = 0; c < 3; ++c) {
+      bounds[c].push_back(center[c] - 1.f);
+      bounds[c + 3].push_back(center[c] + 1.f);
+    }
+  }
+  const CAABoxSoA soaBoxes{bounds[0], bounds[1], bounds[2], bounds[3], bounds[4], bounds[5]};
+  std::vector<uint32_t> visibleBits((soaBoxes.size() + 31) / 32);
+  std::vector<uint32_t> visibleIndices(soaBoxes.size());
+  frustum.aabbFrustumTest(soaBoxes, visibleBits);
+  const size_t visibleCount = frustum.aabbFrustumCull(soaBoxes, visibleIndices);
+  size_t expectedCount = 0;
+  for (size_t i = 0; i < soaBoxes.size(); ++i) {
+    const bool expected = frustum.aabbFrustumTest(
+        CAABox(bounds[0][i], bounds[1][i], bounds[2][i], bounds[3][i], bounds[4][i], bounds[5][i]));
+    assert(((visibleBits[i / 32] >> (i % 32)) & 1) == expected);
+    if (expected)
+      assert(visibleIndices[expectedCount++] == i);
+  }
+  assert(visibleCount == expectedCount);
+  std::cout << "Frustum batch " << visibleCount << "/" << soaBoxes.size() << " visible" << std::endl;
+
+  std::vector<CAABox> bvhBoxes;
+  for (int i = 0; i < 500; ++i) {
+    const CVector3f center(float((i * 37) % 101) - 50.f, float((i * 53) % 97) - 48.f, float((i * 71) % 89) - 44.f);
+    bvhBoxes.emplace_back(center - CVector3f(float(i % 3) + 0.5f), center + CVector3f(float(i % 5) + 0.5f));
+  }
+  const CBVH bvh(bvhBoxes);
+  const auto sortedQuery = [](std::vector<uint32_t> v) {
+    std::sort(v.begin(), v.end());
+    return v;
+  };
+  std::vector<uint32_t> bvhHits, bruteHits;
+  const CAABox queryBox({-10.f, -5.f, -20.f}, {15.f, 12.f, 3.f});
+  bvh.queryAABB(queryBox, bvhHits);
+  for (uint32_t i = 0; i < bvhBoxes.size(); ++i)
+    if (bvhBoxes[i].intersects(queryBox))
+      bruteHits.push_back(i);
+  assert(sortedQuery(bvhHits) == bruteHits);
+  bvhHits.clear();
+  bruteHits.clear();
+  const CSphere querySphere({4.f, -7.f, 9.f}, 11.f);
+  bvh.querySphere(querySphere, bvhHits);
+  for (uint32_t i = 0; i < bvhBoxes.size(); ++i)
+    if (bvhBoxes[i].intersects(querySphere))
+      bruteHits.push_back(i);
+  assert(sortedQuery(bvhHits) == bruteHits);
+  bvhHits.clear();
+  bruteHits.clear();
+  bvh.queryFrustum(frustum, bvhHits);
+  for (uint32_t i = 0; i < bvhBoxes.size(); ++i)
+    if (frustum.aabbFrustumTest(bvhBoxes[i]))
+      bruteHits.push_back(i);
+  assert(sortedQuery(bvhHits) == bruteHits);
+  bvhHits.clear();
+  bruteHits.clear();
+  const CMRay bvhRay({-60.f, 1.f, 2.f}, {1.f, 0.f, 0.f}, 120.f);
+  bvh.queryRay(bvhRay, bvhHits);
+  float bruteClosest = FLT_MAX;
+  for (uint32_t i = 0; i < bvhBoxes.size(); ++i) {
+    const CAABox& box = bvhBoxes[i];
+    if (box.min.y() <= 1.f && box.max.y() >= 1.f && box.min.z() <= 2.f && box.max.z() >= 2.f &&
+        box.max.x() >= -60.f && box.min.x() <= 60.f) {
+      bruteHits.push_back(i);
+      bruteClosest = std::min(bruteClosest, std::max(box.min.x(), -60.f) + 60.f);
+    }
+  }
+  assert(sortedQuery(bvhHits) == bruteHits);
+  uint32_t closestPrim = 0;
+  float closestDist = 0.f;
+  assert(bvh.rayCastClosest(bvhRay, closestPrim, closestDist) == !bruteHits.empty());
+  assert(bruteHits.empty() || close_enough(closestDist, bruteClosest, 0.001f));
+  std::cout << "BVH " << bvh.nodes().size() << " nodes, ray hit " << bvhHits.size() << " boxes" << std::endl;
+
+  CBVH lbvh;
+  lbvh.buildLBVH(bvhBoxes);
+  assert(lbvh.primitiveCount() == bvhBoxes.size() && lbvh.nodes().size() < bvhBoxes.size());
+  assert(lbvh.bounds() == bvh.bounds());
+  bvhHits.clear();
+  lbvh.queryRay(bvhRay, bvhHits);
+  assert(sortedQuery(bvhHits) == bruteHits);
+  assert(lbvh.rayCastClosest(bvhRay, closestPrim, closestDist) == !bruteHits.empty());
+  assert(bruteHits.empty() || close_enough(closestDist, bruteClosest, 0.001f));
+  bvhHits.clear();
+  bruteHits.clear();
+  lbvh.queryAABB(queryBox, bvhHits);
+  for (uint32_t i = 0; i < bvhBoxes.size(); ++i)
+    if (bvhBoxes[i].intersects(queryBox))
+      bruteHits.push_back(i);
+  assert(sortedQuery(bvhHits) == bruteHits);
+  std::cout << "LBVH " << lbvh.nodes().size() << " nodes, box hit " << bvhHits.size() << " boxes" << std::endl;
+  bvhHits.clear();
+  lbvh.buildLBVH(std::span(bvhBoxes).first(1));
+  lbvh.queryAABB(bvhBoxes[0], bvhHits);
+  assert(lbvh.nodes().size() == 1 && bvhHits == std::vector<uint32_t>{0});
+  /* Six primitives leave empty lanes in the tree, which whole-space queries must not report */
+  const std::vector<uint32_t> allHits{0, 1, 2, 3, 4, 5};
+  CBVH partialBvh{std::span(bvhBoxes).first(6)};
+  for (int pass = 0; pass < 2; ++pass) {
+    if (pass == 1)
+      partialBvh.buildLBVH(std::span(bvhBoxes).first(6));
+    bvhHits.clear();
+    partialBvh.queryAABB(CAABox(-FLT_MAX, FLT_MAX), bvhHits);
+    assert(sortedQuery(bvhHits) == allHits);
+    bvhHits.clear();
+    partialBvh.queryAABB(CAABox(-INFINITY, INFINITY), bvhHits);
+    assert(sortedQuery(bvhHits) == allHits);
+    bvhHits.clear();
+    partialBvh.querySphere(CSphere({0.f, 0.f, 0.f}, 1e30f), bvhHits);
+    assert(sortedQuery(bvhHits) == allHits);
+  }
+
+  const CAABox unitBox(0.f, 1.f);
+  float tEnter = 0.f;
+  float tExit = 0.f;
+  assert(CRaySlab(CMRay({-5.f, 0.5f, 0.5f}, {1.f, 0.f, 0.f}, 10.f)).intersect(unitBox, tEnter, tExit));
+  assert(close_enough(tEnter, 5.f) && close_enough(tExit, 6.f));
+  assert(CRaySlab(CMRay({0.5f, 0.5f, -3.f}, {0.f, 0.f, 1.f}, 10.f)).intersect(unitBox, tEnter, tExit));
+  assert(close_enough(tEnter, 3.f) && close_enough(tExit, 4.f));
+  assert(!CRaySlab(CMRay({2.f, 0.5f, -3.f}, {0.f, 0.f, 1.f}, 10.f)).intersect(unitBox, tEnter, tExit));
+  assert(!CRaySlab(CMRay({-5.f, 0.5f, 0.5f}, {1.f, 0.f, 0.f}, 4.f)).intersect(unitBox, tEnter, tExit));
+  assert(CRaySlab(CMRay({0.5f, 0.5f, 0.5f}, {0.f, 0.f, 0.f}, 0.f)).intersect(unitBox, tEnter, tExit));
+  assert(tEnter == 0.f && tExit == 0.f);
+  assert(!CRaySlab(CMRay({NAN, 0.5f, 0.5f}, {1.f, 0.f, 0.f}, 10.f)).intersect(unitBox, tEnter, tExit));
+  assert(!CRaySlab(CMRay({-5.f, 0.5f, 0.5f}, {1.f, 0.f, 0.f}, 10.f))
+              .intersect(CAABox(0.f, NAN, 0.f, 1.f, 1.f, 1.f), tEnter, tExit));
+
+  const size_t slabCount = bvhBoxes.size() - 3;
+  std::array<std::vector<float>, 6> slabBounds;
+  for (size_t i = 0; i < slabCount; ++i) {
+    for (int c = 0; c < 3; ++c) {
+      slabBounds[c].push_back(bvhBoxes[i].min[c]);
+      slabBounds[c + 3].push_back(bvhBoxes[i].max[c]);
+    }
+  }
+  const CRaySlab bvhSlab(bvhRay);
+  std::vector<uint32_t> slabBits((slabCount + 31) / 32);
+  std::vector<float> slabEnter(slabCount);
+  std::vector<float> slabExit(slabCount);
+  bvhSlab.intersect(CAABoxSoA{slabBounds[0], slabBounds[1], slabBounds[2], slabBounds[3], slabBounds[4], slabBounds[5]},
+                    slabBits, slabEnter, slabExit);
+  for (size_t i = 0; i < slabCount; ++i) {
+    const bool hit = bvhSlab.intersect(bvhBoxes[i], tEnter, tExit);
+    assert(hit == ((slabBits[i / 32] >> (i % 32)) & 1));
+    assert(!hit || (slabEnter[i] == tEnter && slabExit[i] == tExit));
+  }
+
+  std::vector<CMRay> packetRays;
+  for (int i = 0; i < 6; ++i)
+    packetRays.emplace_back(CVector3f{-2.f, 0.25f * float(i), 0.5f}, CVector3f{1.f, 0.f, float(i % 2)}.normalized(),
+                            float(i + 3));
+  packetRays.emplace_back(CVector3f{NAN, 0.5f, 0.5f}, CVector3f{1.f, 0.f, 0.f}, 10.f);
+  const CRayPacket packet(packetRays);
+  std::array<float, CRayPacket::MaxRays> packetEnter{};
+  std::array<float, CRayPacket::MaxRays> packetExit{};
+  const uint32_t packetHits = packet.intersect(unitBox, packetEnter, packetExit);
+  for (size_t i = 0; i < packetRays.size(); ++i) {
+    const bool hit = CRaySlab(packetRays[i]).intersect(unitBox, tEnter, tExit);
+    assert(hit == ((packetHits >> i) & 1));
+    assert(!hit || (close_enough(packetEnter[i], tEnter) && close_enough(packetExit[i], tExit)));
+  }
+  std::cout << "Ray packet hits " << std::hex << packetHits << std::dec << std::endl;
+
+  std::vector<CAABox> movedBoxes;
+  for (int i = 0; i < 20000; ++i) {
+    const CVector3f center(float((i * 37) % 1009), float((i * 53) % 997), float((i * 71) % 983));
+    movedBoxes.emplace_back(center - 501.5f, center - 497.5f);
+  }
+  CBVH parallelBvh(movedBoxes, 4);
+  assert(parallelBvh.nodes().size() == CBVH(movedBoxes, 1).nodes().size());
+  for (size_t i = 0; i < movedBoxes.size(); ++i)
+    movedBoxes[i] = movedBoxes[i].getTransformedAABox(CTransform::Translate(float(i % 13), -float(i % 7), 3.f));
+  parallelBvh.refit(movedBoxes);
+  bvhHits.clear();
+  bruteHits.clear();
+  const CAABox refitQuery(-100.f, 100.f);
+  parallelBvh.queryAABB(refitQuery, bvhHits);
+  for (uint32_t i = 0; i < movedBoxes.size(); ++i)
+    if (movedBoxes[i].intersects(refitQuery))
+      bruteHits.push_back(i);
+  assert(sortedQuery(bvhHits) == bruteHits);
+  CBVH parallelLbvh;
+  parallelLbvh.buildLBVH(movedBoxes, 4);
+  CBVH serialLbvh;
+  serialLbvh.buildLBVH(movedBoxes, 1);
+  assert(parallelLbvh.nodes().size() == serialLbvh.nodes().size());
+  std::vector<uint32_t> lbvhHits;
+  parallelLbvh.queryAABB(refitQuery, lbvhHits);
+  assert(sortedQuery(lbvhHits) == bruteHits);
+  std::cout << "BVH refit " << bvhHits.size() << " hits" << std::endl;
+
+  std::vector<CAABox> crowd;
+  for (int i = 0; i < 2000; ++i) {
+    const CVector3f center(float((i * 37) % 61) - 30.f, float((i * 53) % 59) - 30.f, float((i * 71) % 29) * 0.5f);
+    crowd.emplace_back(center - 0.3f * float(1 + i % 5), center + 0.2f * float(1 + i % 7));
+  }
+  CSpatialHashGrid grid(2.f);
+  for (uint32_t i = 0; i < crowd.size(); ++i)
+    grid.insert(i, crowd[i]);
+  const auto checkGrid = [&]() {
+    std::vector<std::pair<uint32_t, uint32_t>> gridPairs, brutePairs;
+    grid.findPairs(gridPairs);
+    for (uint32_t i = 0; i < crowd.size(); ++i)
+      for (uint32_t j = i + 1; j < crowd.size(); ++j)
+        if (grid.contains(i) && grid.contains(j) && crowd[i].intersects(crowd[j]))
+          brutePairs.emplace_back(i, j);
+    std::sort(gridPairs.begin(), gridPairs.end());
+    assert(gridPairs == brutePairs);
+
+    const CAABox gridQuery({-7.f, -3.5f, 1.f}, {4.f, 9.f, 6.5f});
+    const CSphere gridSphere({3.f, -2.f, 5.f}, 6.5f);
+    const CMRay gridRay({-40.f, -31.f, 2.f}, CVector3f(1.f, 0.9f, 0.15f).normalized(), 90.f);
+    const CRaySlab gridSlab(gridRay);
+    std::vector<uint32_t> boxHits, sphereHits, rayHits;
+    grid.queryAABB(gridQuery, boxHits);
+    grid.querySphere(gridSphere, sphereHits);
+    grid.queryRay(gridRay, rayHits);
+    std::vector<uint32_t> bruteBox, bruteSphere, bruteRay;
+    float bruteClosest = INFINITY;
+    for (uint32_t i = 0; i < crowd.size(); ++i) {
+      if (!grid.contains(i))
+        continue;
+      const CAABox& box = crowd[i];
+      if (box.intersects(gridQuery))
+        bruteBox.push_back(i);
+      const CVector3f d = CVector3f(std::max(std::max(box.min.x() - gridSphere.position.x(), 0.f),
+                                             gridSphere.position.x() - box.max.x()),
+                                    std::max(std::max(box.min.y() - gridSphere.position.y(), 0.f),
+                                             gridSphere.position.y() - box.max.y()),
+                                    std::max(std::max(box.min.z() - gridSphere.position.z(), 0.f),
+                                             gridSphere.position.z() - box.max.z()));
+      if (d.magSquared() <= gridSphere.radius * gridSphere.radius)
+        bruteSphere.push_back(i);
+      if (gridSlab.intersect(box, tEnter, tExit)) {
+        bruteRay.push_back(i);
+        bruteClosest = std::min(bruteClosest, tEnter);
+      }
+    }
+    assert(sortedQuery(boxHits) == bruteBox && !bruteBox.empty());
+    assert(sortedQuery(sphereHits) == bruteSphere && !bruteSphere.empty());
+    assert(sortedQuery(rayHits) == bruteRay && !bruteRay.empty());
+    uint32_t closestId = 0;
+    float closestDist = 0.f;
+    assert(grid.rayCastClosest(gridRay, closestId, closestDist));
+    assert(closestDist == bruteClosest && gridSlab.intersect(crowd[closestId], tEnter, tExit) && tEnter == closestDist);
+    return gridPairs.size();
+  };
+  const size_t crowdPairs = checkGrid();
+  for (uint32_t i = 0; i < crowd.size(); i += 3) {
+    crowd[i] = crowd[i].getTransformedAABox(CTransform::Translate(float(i % 5) - 2.f, 0.7f, -float(i % 3)));
+    grid.move(i, crowd[i]);
+  }
+  for (uint32_t i = 1; i < crowd.size(); i += 7)
+    grid.remove(i);
+  crowd.emplace_back(CVector3f(-1.f), CVector3f(1.f));
+  grid.insert(uint32_t(crowd.size() - 1), CSphere(CVector3f(0.f), 1.f));
+  assert(grid.bounds(uint32_t(crowd.size() - 1)) == crowd.back());
+  checkGrid();
+  for (uint32_t i = 0; i < crowd.size(); ++i)
+    if (grid.contains(i))
+      grid.remove(i);
+  assert(grid.size() == 0 && grid.cellCount() == 0);
+  std::cout << "Hash grid " << crowdPairs << " pairs" << std::endl;
+
+  std::vector<CAABox> swarm;
+  for (int i = 0; i < 600; ++i) {
+    const CVector3f center(float((i * 29) % 43) - 20.f, float((i * 41) % 37) - 18.f, float((i * 13) % 17) * 0.5f);
+    swarm.emplace_back(center - 0.4f * float(1 + i % 3), center + 0.3f * float(1 + i % 4));
+  }
+  CSweepAndPrune sap;
+  std::vector<CSweepAndPrune::Pair> swarmPairs;
+  const auto bruteSwarm = [&]() {
+    std::vector<CSweepAndPrune::Pair> brute;
+    for (uint32_t i = 0; i < swarm.size(); ++i)
+      for (uint32_t j = i + 1; j < swarm.size(); ++j)
+        if (sap.contains(i) && sap.contains(j) && swarm[i].intersects(swarm[j]))
+          brute.emplace_back(i, j);
+    return brute;
+  };
+  /* Checks the pair set against brute force, and the events against the change since the previous check */
+  const auto checkSap = [&]() {
+    const std::vector<CSweepAndPrune::Pair> brute = bruteSwarm();
+    std::vector<CSweepAndPrune::Pair> current, added, removed, expectAdded, expectRemoved;
+    sap.pairs(current);
+    std::sort(current.begin(), current.end());
+    assert(current == brute && sap.pairCount() == brute.size());
+    sap.collectEvents(added, removed);
+    std::set_difference(brute.begin(), brute.end(), swarmPairs.begin(), swarmPairs.end(),
+                        std::back_inserter(expectAdded));
+    std::set_difference(swarmPairs.begin(), swarmPairs.end(), brute.begin(), brute.end(),
+                        std::back_inserter(expectRemoved));
+    assert(added == expectAdded && removed == expectRemoved);
+    swarmPairs = brute;
+    return added.size() + removed.size();
+  };
+  for (uint32_t i = 0; i < swarm.size(); ++i)
+    sap.insert(i, swarm[i]);
+  checkSap();
+  std::vector<CSweepAndPrune::Pair> sweptPairs;
+  CSweepAndPrune::FindPairs(swarm, sweptPairs);
+  std::sort(sweptPairs.begin(), sweptPairs.end());
+  assert(sweptPairs == swarmPairs && !swarmPairs.empty());
+  const size_t initialPairs = swarmPairs.size();
+  for (int frame = 0; frame < 8; ++frame) {
+    for (uint32_t i = 0; i < swarm.size(); ++i) {
+      const float step = float(frame + 1) * 0.05f;
+      swarm[i] = swarm[i].getTransformedAABox(
+          CTransform::Translate(i % 2 != 0 ? step : -step, float(i % 3) * step - step, i % 5 == 0 ? 0.3f : -0.1f));
+      sap.move(i, swarm[i]);
+    }
+    assert(checkSap() != 0);
+  }
+  for (uint32_t i = 0; i < swarm.size(); i += 4)
+    sap.remove(i);
+  checkSap();
+  for (uint32_t i = 0; i < swarm.size(); i += 8)
+    sap.insert(i, swarm[(i + 100) % swarm.size()]);
+  for (uint32_t i = 0; i < swarm.size(); i += 8)
+    swarm[i] = sap.bounds(i);
+  checkSap();
+  for (uint32_t i = 0; i < swarm.size(); ++i)
+    if (sap.contains(i))
+      sap.remove(i);
+  checkSap();
+  assert(sap.size() == 0 && sap.pairCount() == 0);
+  std::cout << "Sweep and prune " << initialPairs << " pairs" << std::endl;
+
+  const CTransform batchXf = CTransform::Translate(1.f, -2.f, 3.f) * CTransformFromEditorEuler({0.3f, -0.7f, 1.1f}) *
+                             CTransform::Scale(1.f, 2.f, 0.5f);
+  const CMatrix4f batchProj = CProjection(SProjPersp(degToRad(60.f), 1.f, 1.f, 100.f)).getCachedMatrix() *
+                              batchXf.toMatrix4f();
+  const CMatrix3f normalMtx = batchXf.basis.inverted().transposed();
+  std::vector<float> batchAoS;
+  for (int i = 0; i < 37 * 3; ++i)
+    batchAoS.push_back(float((i * 29) % 41) * 0.25f - 5.f);
+  std::array<std::vector<float>, 3> batchSoA;
+  for (size_t i = 0; i < batchAoS.size(); ++i)
+    batchSoA[i % 3].push_back(batchAoS[i]);
+  std::vector<float> outAoS(batchAoS.size());
+  std::array<std::vector<float>, 3> outSoA{std::vector<float>(37), std::vector<float>(37), std::vector<float>(37)};
+  const CVector3fSoA inSoAView{batchSoA[0], batchSoA[1], batchSoA[2]};
+  const CVector3fSoAOut outSoAView{outSoA[0], outSoA[1], outSoA[2]};
+  const auto checkBatch = [&](auto&& reference) {
+    for (size_t i = 0; i < 37; ++i) {
+      const CVector3f expected = reference(CVector3f(batchAoS[i * 3], batchAoS[i * 3 + 1], batchAoS[i * 3 + 2]));
+      assert(close_enough(CVector3f(outAoS[i * 3], outAoS[i * 3 + 1], outAoS[i * 3 + 2]), expected, 0.001f));
+      assert(close_enough(CVector3f(outSoA[0][i], outSoA[1][i], outSoA[2][i]), expected, 0.001f));
+    }
+  };
+  transformPoints(batchXf, batchAoS, outAoS);
+  transformPoints(batchXf, inSoAView, outSoAView);
+  checkBatch([&](const CVector3f& v) { return batchXf * v; });
+  transformPoints(batchXf.toMatrix4f(), batchAoS, outAoS);
+  transformPoints(batchXf.toMatrix4f(), inSoAView, outSoAView);
+  checkBatch([&](const CVector3f& v) { return batchXf * v; });
+  transformNormals(batchXf, batchAoS, outAoS);
+  transformNormals(batchXf.toMatrix4f(), inSoAView, outSoAView);
+  checkBatch([&](const CVector3f& v) { return normalMtx * v; });
+  projectPoints(batchProj, batchAoS, outAoS);
+  projectPoints(batchProj, inSoAView, outSoAView);
+  checkBatch([&](const CVector3f& v) { return batchProj.multiplyOneOverW(v); });
+
+  std::vector<float> bigMesh(100003 * 3);
+  for (size_t i = 0; i < bigMesh.size(); ++i)
+    bigMesh[i] = float(i % 97) - 48.f;
+  std::vector<float> bigSerial(bigMesh.size());
+  transformPoints(batchXf, bigMesh, bigSerial);
+  transformPoints(batchXf, bigMesh, bigMesh, 4);
+  assert(bigMesh == bigSerial);
+  std::cout << "Batch transform " << bigMesh.size() / 3 << " points" << std::endl;
+
+  const EKernelISA detectedISA = kernelISA();
+  assert(kernelISASupported(EKernelISA::Baseline) && kernelISASupported(detectedISA));
+  assert(setKernelISA(EKernelISA::Baseline));
+  transformPoints(batchXf, bigSerial, bigMesh);
+  frustum.aabbFrustumTest(soaBoxes, visibleBits);
+  bvhSlab.intersect(CAABoxSoA{slabBounds[0], slabBounds[1], slabBounds[2], slabBounds[3], slabBounds[4], slabBounds[5]},
+                    slabBits, slabEnter, slabExit);
+  int kernelISAs = 0;
+  for (size_t isa = 0; isa < KernelISACount; ++isa) {
+    if (!setKernelISA(EKernelISA(isa)))
+      continue;
+    ++kernelISAs;
+    std::vector<float> isaMesh(bigMesh.size());
+    std::vector<uint32_t> isaVisibleBits(visibleBits.size());
+    std::vector<uint32_t> isaSlabBits(slabBits.size());
+    std::vector<float> isaSlabEnter(slabCount);
+    std::vector<float> isaSlabExit(slabCount);
+    transformPoints(batchXf, bigSerial, isaMesh);
+    frustum.aabbFrustumTest(soaBoxes, isaVisibleBits);
+    bvhSlab.intersect(
+        CAABoxSoA{slabBounds[0], slabBounds[1], slabBounds[2], slabBounds[3], slabBounds[4], slabBounds[5]},
+        isaSlabBits, isaSlabEnter, isaSlabExit);
+    /* AVX-512 kernels fuse multiply-adds; the others must match the baseline exactly */
+    if (EKernelISA(isa) == EKernelISA::AVX512) {
+      for (size_t i = 0; i < isaMesh.size(); ++i)
+        assert(close_enough(isaMesh[i], bigMesh[i], 0.001f));
+    } else {
+      assert(isaMesh == bigMesh);
+    }
+    assert(isaVisibleBits == visibleBits);
+    assert(isaSlabBits == slabBits);
+    assert(isaSlabEnter == slabEnter && isaSlabExit == slabExit);
+    assert(frustum.aabbFrustumCull(soaBoxes, visibleIndices) == visibleCount);
+    projectPoints(batchProj, batchAoS, outAoS);
+    projectPoints(batchProj, inSoAView, outSoAView);
+    checkBatch([&](const CVector3f& v) { return batchProj.multiplyOneOverW(v); });
+  }
+  assert(setKernelISA(detectedISA));
+  std::cout << "Kernel ISAs " << kernelISAs << "/" << KernelISACount << std::endl;
+
+  const CQuaternion qa = CQuaternion::fromAxisAngle(CVector3f(1.f, 2.f, 3.f).normalized(), 0.7f);
+  const CQuaternion qb = CQuaternion::fromAxisAngle(CVector3f(-2.f, 0.5f, 1.f).normalized(), 2.1f);
+  const CQuaternion qab = qa * qb;
+  assert(close_enough(qab.w(), qa.w() * qb.w() - qa.x() * qb.x() - qa.y() * qb.y() - qa.z() * qb.z()));
+  assert(close_enough(qab.x(), qa.w() * qb.x() + qa.x() * qb.w() + qa.y() * qb.z() - qa.z() * qb.y()));
+  assert(close_enough(qab.y(), qa.w() * qb.y() - qa.x() * qb.z() + qa.y() * qb.w() + qa.z() * qb.x()));
+  assert(close_enough(qab.z(), qa.w() * qb.z() + qa.x() * qb.y() - qa.y() * qb.x() + qa.z() * qb.w()));
+  CQuaternion qabInPlace = qa;
+  qabInPlace *= qb;
+  assert(qabInPlace.mSimd[0] == qab.mSimd[0] && qabInPlace.mSimd[3] == qab.mSimd[3]);
+
+  std::vector<CVector3f> rotateIn;
+  for (int i = 0; i < 37; ++i)
+    rotateIn.emplace_back(float(i % 5) - 2.f, float(i % 7) * 0.5f, float(i) * 0.25f - 4.f);
+  std::vector<CVector3f> rotateOut(rotateIn.size());
+  rotateVectors(qab, rotateIn, rotateOut);
+  rotateVectors(qab, batchAoS, outAoS);
+  rotateVectors(qab, inSoAView, outSoAView);
+  checkBatch([&](const CVector3f& v) { return qab.transform(v); });
+  const CMatrix3f qabMtx(qab);
+  for (size_t i = 0; i < rotateIn.size(); ++i) {
+    assert(close_enough(qab.transform(rotateIn[i]), qabMtx * rotateIn[i], 0.0001f));
+    assert(close_enough(rotateOut[i], qab.transform(rotateIn[i]), 0.0001f));
+  }
+  assert(qab.transform(CVector3f(1.f, 2.f, 3.f)).mSimd[3] == 0.f);
+
+  std::array<float, 16> wideIn{};
+  for (size_t i = 0; i < wideIn.size(); ++i)
+    wideIn[i] = float(i) - 5.f;
+  fixed_size_simd<float, 8> wide8;
+  wide8.copy_from(wideIn.data(), _simd::element_aligned);
+  const fixed_size_simd<float, 8> tripled = wide8 * fixed_size_simd<float, 8>(2.f) + wide8;
+  assert(bitmask(tripled > fixed_size_simd<float, 8>(0.f)) == 0xC0 && tripled[7] == 6.f);
+  fixed_size_simd<float, 16> wide16;
+  wide16.copy_from(wideIn.data(), 11, _simd::element_aligned);
+  assert(wide16[10] == 5.f && wide16[11] == 0.f && wide16[15] == 0.f);
+  assert(bitmask(wide16 < fixed_size_simd<float, 16>(0.f)) == 0x1F);
+  std::array<float, 16> wideOut;
+  wideOut.fill(-1.f);
+  max(-wide16, fixed_size_simd<float, 16>(0.f)).copy_to(wideOut.data(), 11, _simd::element_aligned);
+  assert(wideOut[0] == 5.f && wideOut[10] == 0.f && wideOut[11] == -1.f);
+  simd<float> narrow;
+  narrow.copy_from(wideIn.data(), 3, _simd::element_aligned);
+  assert(narrow[2] == -3.f && narrow[3] == 0.f);
+  assert(sqrt(narrow)[0] != sqrt(narrow)[0] && sqrt(-narrow)[2] == std::sqrt(3.f));
+  assert(bitmask(select(narrow < simd<float>(-4.f), narrow, -narrow) > simd<float>(0.f)) == 0x6);
+  assert(select(wide16 > fixed_size_simd<float, 16>(2.f), sqrt(wide16), wide16)[10] == std::sqrt(5.f));
+
+  std::array<std::vector<float>, 4> blendA, blendB, blendOut, blendInPlace;
+  std::vector<float> blendT;
+  for (int i = 0; i < 37; ++i) {
+    const CQuaternion from =
+        CQuaternion::fromAxisAngle(CVector3f(1.f, float(i % 3), -2.f).normalized(), float(i) * 0.2f);
+    /* Pairs 5 and 6 are the same rotation and a half turn apart, so their dot products are 1 and 0 */
+    const CQuaternion to = i == 5   ? from
+                           : i == 6 ? from * CQuaternion(0.f, 1.f, 0.f, 0.f)
+                                    : CQuaternion::fromAxisAngle(CVector3f(float(i % 4), 2.f, 1.f).normalized(),
+                                                                 3.f - float(i) * 0.3f);
+    for (int c = 0; c < 4; ++c) {
+      blendA[c].push_back(from.mSimd[c]);
+      blendB[c].push_back(to.mSimd[c]);
+    }
+    blendT.push_back(float(i % 9) * 0.15f - 0.1f);
+  }
+  for (int c = 0; c < 4; ++c) {
+    blendOut[c].resize(blendT.size());
+    blendInPlace[c] = blendA[c];
+  }
+  const CQuaternionSoA blendAView{blendA[0], blendA[1], blendA[2], blendA[3]};
+  const CQuaternionSoA blendBView{blendB[0], blendB[1], blendB[2], blendB[3]};
+  const CQuaternionSoAOut blendOutView{blendOut[0], blendOut[1], blendOut[2], blendOut[3]};
+  const CQuaternionSoAOut blendInPlaceView{blendInPlace[0], blendInPlace[1], blendInPlace[2], blendInPlace[3]};
+  const auto checkBlend = [&](const auto& blendT, float tolerance) {
+    for (size_t i = 0; i < blendT.size(); ++i) {
+      const CQuaternion from(blendA[0][i], blendA[1][i], blendA[2][i], blendA[3][i]);
+      const CQuaternion to(blendB[0][i], blendB[1][i], blendB[2][i], blendB[3][i]);
+      const CQuaternion expected = CQuaternion::slerpShort(from, to, std::clamp(blendT[i], 0.f, 1.f));
+      const CQuaternion blended(blendOut[0][i], blendOut[1][i], blendOut[2][i], blendOut[3][i]);
+      const float sign = blended.dot(expected) < 0.f ? -1.f : 1.f;
+      for (int c = 0; c < 4; ++c)
+        assert(close_enough(blended.mSimd[c] * sign, expected.mSimd[c], tolerance));
+    }
+  };
+  for (size_t isa = 0; isa < KernelISACount; ++isa) {
+    if (!setKernelISA(EKernelISA(isa)))
+      continue;
+    for (int c = 0; c < 4; ++c)
+      blendInPlace[c] = blendA[c];
+    slerpQuaternions(blendAView, blendBView, blendT, blendOutView);
+    checkBlend(blendT, 0.00001f);
+    slerpQuaternions({blendInPlace[0], blendInPlace[1], blendInPlace[2], blendInPlace[3]}, blendBView, blendT,
+                     blendInPlaceView);
+    assert(blendInPlace == blendOut);
+    slerpQuaternions(blendAView, blendBView, 0.3f, blendOutView);
+    checkBlend(std::vector<float>(blendT.size(), 0.3f), 0.00001f);
+    nlerpQuaternions(blendAView, blendBView, blendT, blendOutView);
+    checkBlend(blendT, 0.001f);
+    nlerpQuaternions(blendAView, blendBView, 0.7f, blendOutView);
+    checkBlend(std::vector<float>(blendT.size(), 0.7f), 0.001f);
+  }
+  assert(setKernelISA(detectedISA));
+
+  const auto checkSimdMath = [](auto precision, float tolerance) {
+    constexpr EMathPrecision P = decltype(precision)::value;
+    for (int i = -400; i < 400; ++i) {
+      const float v = float(i) / 400.f;
+      const simd<float> unit(v, v + 0.00025f, v + 0.0005f, v + 0.00075f);
+      simd<float> sines, cosines;
+      sincos<P>(unit * simd<float>(100.f), sines, cosines);
+      const simd<float> angles = atan2<P>(unit, unit * unit - simd<float>(0.3f));
+      const simd<float> atans = atan<P>(unit * simd<float>(20.f));
+      const simd<float> asines = asin<P>(unit);
+      const simd<float> acosines = acos<P>(unit);
+      const simd<float> exps = exp<P>(unit * simd<float>(80.f));
+      const simd<float> logs = log<P>(unit * unit * simd<float>(1e6f) + simd<float>(1e-30f));
+      for (size_t l = 0; l < 4; ++l) {
+        const float x = unit[l];
+        assert(close_enough(sines[l], std::sin(x * 100.f), tolerance));
+        assert(close_enough(cosines[l], std::cos(x * 100.f), tolerance));
+        assert(close_enough(angles[l], std::atan2(x, x * x - 0.3f), tolerance));
+        assert(close_enough(atans[l], std::atan(x * 20.f), tolerance));
+        assert(close_enough(asines[l], std::asin(x), tolerance));
+        assert(close_enough(acosines[l], std::acos(x), tolerance));
+        assert(close_enough(exps[l] / std::exp(x * 80.f), 1.f, tolerance));
+        const float logRef = std::log(x * x * 1e6f + 1e-30f);
+        assert(close_enough(logs[l], logRef, tolerance * std::max(1.f, std::abs(logRef))));
+      }
+    }
+  };
+  checkSimdMath(std::integral_constant<EMathPrecision, EMathPrecision::Precise>(), 4e-7f);
+  checkSimdMath(std::integral_constant<EMathPrecision, EMathPrecision::Fast>(), 1e-4f);
+  const simd<float> mathEdges(0.f, -1.f, INFINITY, 1e-40f);
+  const simd<float> edgeLogs = log(mathEdges);
+  assert(edgeLogs[0] == -INFINITY && std::isnan(edgeLogs[1]) && edgeLogs[2] == INFINITY);
+  assert(close_enough(edgeLogs[3], std::log(1e-40f), 1e-5f));
+  const simd<float> edgeExps = exp(simd<float>(-100.f, 100.f, 88.7f, 0.f));
+  assert(edgeExps[0] == 0.f && edgeExps[1] == INFINITY && edgeExps[3] == 1.f);
+  assert(close_enough(edgeExps[2] / std::exp(88.7f), 1.f, 1e-6f));
+  const fixed_size_simd<float, 16> wideExps = exp(wide16 * fixed_size_simd<float, 16>(7.f));
+  const fixed_size_simd<float, 16> wideLogs = log(wideExps);
+  const fixed_size_simd<float, 16> wideSines = sin(wide16);
+  for (size_t i = 0; i < 11; ++i) {
+    assert(close_enough(wideLogs[i], wideIn[i] * 7.f, 2e-5f));
+    assert(close_enough(wideSines[i], std::sin(wideIn[i]), 4e-7f));
+  }
+  const CVector3f eulers(0.3f, -0.7f, 1.1f);
+  const CTransform eulerXf = CTransformFromEditorEuler(eulers);
+  assert(close_enough(eulerXf.basis[0][2], -std::sin(-0.7f), 1e-6f) &&
+         close_enough(eulerXf.basis[2][2], std::cos(-0.7f) * std::cos(0.3f), 1e-6f));
+  assert(close_enough(CEulerAngles(eulerXf), CVector3f(0.1185393f, -0.7225934f, 1.2967031f), 1e-5f));
+  assert(close_enough(CEulerAngles(CQuaternion(eulerXf.basis)), CVector3f(0.2279965f, -0.7225934f, 1.2967030f), 1e-5f));
+  const CQuaternion eulerQuat(CVector3f(0.f, 0.f, 1.1f));
+  const CQuaternion axisQuat = CQuaternion::fromAxisAngle(CVector3f(0.f, 0.f, 1.f), 1.1f);
+  assert(close_enough(eulerQuat.w(), axisQuat.w(), 1e-6f) && close_enough(eulerQuat.z(), axisQuat.z(), 1e-6f));
+
+  /* The rsqrt fast paths must stay within 5e-7 relative over the whole range of magnitudes */
+  const auto unitError = [](std::initializer_list<float> c) {
+    double sum = 0.0;
+    for (float f : c)
+      sum += double(f) * double(f);
+    return std::abs(std::sqrt(sum) - 1.0);
+  };
+  std::vector<CVector3f> fastIn, fastOut;
+  std::vector<CQuaternion> fastQuats;
+  for (int i = -370; i <= 370; ++i) {
+    const float scale = std::pow(10.f, float(i) * 0.1f);
+    const float v = scale * (1.f + float(i & 7) * 0.1f);
+    assert(std::abs(double(fastInvSqrtF(v)) * std::sqrt(double(v)) - 1.0) <= 5e-7);
+    if (std::abs(i) > 180)
+      continue;
+    const CVector3f vec = CVector3f(float(i % 5) - 2.f, 1.f + float(i % 3), -0.5f) * scale;
+    const CVector3f fastVec = vec.fastNormalized();
+    assert(unitError({fastVec.x(), fastVec.y(), fastVec.z()}) <= 5e-7);
+    assert(close_enough(fastVec, vec.normalized(), 1e-6f));
+    const CQuaternion fastQuat = CQuaternion(0.3f, vec.x(), vec.y(), vec.z()).fastNormalized();
+    assert(unitError({fastQuat.w(), fastQuat.x(), fastQuat.y(), fastQuat.z()}) <= 5e-7);
+    CPlane fastPlane(vec, 2.f * scale);
+    fastPlane.fastNormalize();
+    assert(unitError({fastPlane.normal().x(), fastPlane.normal().y(), fastPlane.normal().z()}) <= 5e-7);
+    assert(close_enough(fastPlane.d(), 2.f / vec.magnitude() * scale, 1e-5f));
+    fastIn.push_back(vec);
+    fastQuats.push_back(CQuaternion(0.3f, vec.x(), vec.y(), vec.z()));
+  }
+  fastOut.resize(fastIn.size());
+  normalizeVectors(fastIn, fastOut);
+  std::vector<float> fastAoS, fastAoSOut(fastIn.size() * 3);
+  std::array<std::vector<float>, 3> fastSoA, fastSoAOut;
+  for (const CVector3f& vec : fastIn) {
+    for (size_t c = 0; c < 3; ++c) {
+      fastAoS.push_back(vec[c]);
+      fastSoA[c].push_back(vec[c]);
+      fastSoAOut[c].push_back(0.f);
+    }
+  }
+  normalizeVectors(fastAoS, fastAoSOut);
+  normalizeVectors({fastSoA[0], fastSoA[1], fastSoA[2]}, {fastSoAOut[0], fastSoAOut[1], fastSoAOut[2]});
+  for (size_t i = 0; i < fastIn.size(); ++i) {
+    assert(fastOut[i] == fastIn[i].fastNormalized());
+    const CVector3f aos(fastAoSOut[i * 3], fastAoSOut[i * 3 + 1], fastAoSOut[i * 3 + 2]);
+    const CVector3f soa(fastSoAOut[0][i], fastSoAOut[1][i], fastSoAOut[2][i]);
+    assert(unitError({aos.x(), aos.y(), aos.z()}) <= 5e-7 && close_enough(aos, fastOut[i], 1e-6f));
+    assert(unitError({soa.x(), soa.y(), soa.z()}) <= 5e-7 && close_enough(soa, fastOut[i], 1e-6f));
+  }
+  std::vector<CQuaternion> fastQuatsOut(fastQuats.size());
+  normalizeQuaternions(fastQuats, fastQuatsOut);
+  for (size_t isa = 0; isa < KernelISACount; ++isa) {
+    if (!setKernelISA(EKernelISA(isa)))
+      continue;
+    std::array<std::vector<float>, 4> quatSoA;
+    for (const CQuaternion& q : fastQuats)
+      for (int c = 0; c < 4; ++c)
+        quatSoA[c].push_back(q.mSimd[c]);
+    normalizeQuaternions({quatSoA[0], quatSoA[1], quatSoA[2], quatSoA[3]},
+                         CQuaternionSoAOut{quatSoA[0], quatSoA[1], quatSoA[2], quatSoA[3]});
+    for (size_t i = 0; i < fastQuats.size(); ++i) {
+      const CQuaternion& q = fastQuatsOut[i];
+      const CQuaternion expected = fastQuats[i].fastNormalized();
+      assert(q.mSimd[0] == expected.mSimd[0] && q.mSimd[3] == expected.mSimd[3]);
+      assert(unitError({quatSoA[0][i], quatSoA[1][i], quatSoA[2][i], quatSoA[3][i]}) <= 5e-7);
+      assert(close_enough(quatSoA[0][i], q.w(), 1e-6f) && close_enough(quatSoA[3][i], q.z(), 1e-6f));
+    }
+  }
+  assert(setKernelISA(detectedISA));
+
+  std::vector<CVector3f> cloud;
+  std::vector<float> packedCloud;
+  for (int i = 0; i < 100003; ++i) {
+    cloud.emplace_back(float((i * 37) % 1001) - 500.f, float((i * 91) % 613) * 0.5f, -float((i * 13) % 257) * 2.f);
+    for (size_t c = 0; c < 3; ++c)
+      packedCloud.push_back(cloud.back()[c]);
+  }
+  CAABox cloudBounds, cloudXfBounds;
+  for (const CVector3f& p : cloud) {
+    cloudBounds.accumulateBounds(p);
+    cloudXfBounds.accumulateBounds(batchXf * p);
+  }
+  assert(CAABox::FromPoints(cloud) == cloudBounds && CAABox::FromPoints(packedCloud) == cloudBounds);
+  assert(CAABox::FromPoints(cloud, 4) == cloudBounds && CAABox::FromPoints(packedCloud, 4) == cloudBounds);
+  assert(CAABox::FromPoints(batchXf, cloud, 3) == cloudXfBounds);
+  /* The gathered lanes may contract into fused multiply-adds where CTransform::operator* does not */
+  const CAABox packedXfBounds = CAABox::FromPoints(batchXf, packedCloud, 3);
+  assert(close_enough(packedXfBounds.min, cloudXfBounds.min, 1e-3f) &&
+         close_enough(packedXfBounds.max, cloudXfBounds.max, 1e-3f));
+  assert(CAABox::FromPoints(std::span<const CVector3f>()) == CAABox());
+  assert(CAABox::FromPoints(std::span(packedCloud).first(21)) == CAABox::FromPoints(std::span(cloud).first(7)));
+  CAABox nanBounds(0.f, 1.f);
+  nanBounds.accumulateBounds(CVector3f(NAN, 2.f, -1.f));
+  assert(nanBounds == CAABox(0.f, 0.f, -1.f, 1.f, 2.f, 1.f));
+
+  const CAABox arvoBox(-1.f, 0.5f, 2.f, 3.f, 4.f, 2.25f);
+  for (const CTransform& xf : {batchXf, CTransform::RotateZ(0.4f) * CTransform::Scale(-2.f, 1.f, 3.f), CTransform()}) {
+    CAABox cornerBounds;
+    for (int i = 0; i < 8; ++i)
+      cornerBounds.accumulateBounds(xf * arvoBox.getPoint(i));
+    const CAABox arvoBounds = arvoBox.getTransformedAABox(xf);
+    assert(close_enough(arvoBounds.min, cornerBounds.min, 1e-5f) &&
+           close_enough(arvoBounds.max, cornerBounds.max, 1e-5f));
+    const COBBox obb(CTransform::RotateX(0.9f), CVector3f(1.f, 2.f, 0.5f));
+    CAABox obbCorners;
+    for (int i = 0; i < 8; ++i)
+      obbCorners.accumulateBounds(xf * obb.transform * CAABox(-obb.extents, obb.extents).getPoint(i));
+    const CAABox obbBounds = obb.calculateAABox(xf);
+    assert(close_enough(obbBounds.min, obbCorners.min, 1e-5f) && close_enough(obbBounds.max, obbCorners.max, 1e-5f));
+  }
+  assert(skInvertedBox.getTransformedAABox(batchXf).invalid());
+
+  /* Rounding never pushes a transformed corner outside the transformed box, and the identity is exact */
+  uint32_t cornerSeed = 12345;
+  const auto nextUnit = [&cornerSeed] {
+    cornerSeed = cornerSeed * 1664525u + 1013904223u;
+    return float(cornerSeed >> 8) / float(1u << 24);
+  };
+  for (int n = 0; n < 2000; ++n) {
+    const CVector3f lo(nextUnit() * 200.f - 100.f, nextUnit() * 200.f - 100.f, nextUnit() * 200.f - 100.f);
+    const CAABox box(lo, lo + CVector3f(nextUnit() * 7.f, nextUnit() * 7.f, nextUnit() * 7.f));
+    const CTransform xf = n % 2 == 0 ? CTransform::Translate(nextUnit() * 50.f, nextUnit() * 0.3f, -nextUnit())
+                                     : CTransform::RotateY(nextUnit() * 6.f) *
+                                           CTransform::Translate(nextUnit(), nextUnit() * 90.f, nextUnit());
+    const CAABox moved = box.getTransformedAABox(xf);
+    for (int i = 0; i < 8; ++i) {
+      const CVector3f corner = xf * box.getPoint(i);
+      assert(moved.min.x() <= corner.x() && moved.min.y() <= corner.y() && moved.min.z() <= corner.z());
+      assert(moved.max.x() >= corner.x() && moved.max.y() >= corner.y() && moved.max.z() >= corner.z());
+    }
+    assert(box.getTransformedAABox(CTransform()) == box);
+  }
+  CAABox nanCloud(0.f, 1.f);
+  nanCloud.accumulateBounds(CVector3f(NAN, 2.f, -1.f));
+  const std::array<CVector3f, 3> nanPoints{CVector3f(0.f), CVector3f(NAN, 2.f, -1.f), CVector3f(1.f)};
+  assert(CAABox::FromPoints(nanPoints) == nanCloud);
+
+  std::vector<COBBox> obbSet;
+  std::array<std::vector<float>, 15> obbSoa;
+  for (int i = 0; i < 157; ++i) {
+    const CVector3f angles(float(i % 7) * 0.9f, float(i % 11) * 0.6f - 3.f, float(i % 5) * 1.3f);
+    const CVector3f origin(float((i * 17) % 23) - 11.f, float((i * 7) % 19) - 9.f, float((i * 5) % 13) - 6.f);
+    obbSet.emplace_back(CTransformFromEditorEulers(angles, origin),
+                        CVector3f(0.5f + float(i % 4), 0.3f + float(i % 3) * 0.8f, 1.f + float(i % 5) * 0.4f));
+    for (int r = 0; r < 3; ++r) {
+      obbSoa[r].push_back(obbSet.back().transform.origin[r]);
+      obbSoa[12 + r].push_back(obbSet.back().extents[r]);
+      for (int c = 0; c < 3; ++c)
+        obbSoa[3 + c * 3 + r].push_back(obbSet.back().transform.basis[c][r]);
+    }
+  }
+  const COBBoxSoA obbView{obbSoa[0],
+                          obbSoa[1],
+                          obbSoa[2],
+                          {obbSoa[3], obbSoa[4], obbSoa[5], obbSoa[6], obbSoa[7], obbSoa[8], obbSoa[9], obbSoa[10],
+                           obbSoa[11]},
+                          obbSoa[12],
+                          obbSoa[13],
+                          obbSoa[14]};
+  const std::span<const COBBox> obbSpan(obbSet);
+  std::vector<uint32_t> soaHits(5, ~0u), aosHits(5), pairHits(5);
+  int obbISAs = 0;
+  for (size_t isa = 0; isa < KernelISACount; ++isa) {
+    if (!setKernelISA(EKernelISA(isa)))
+      continue;
+    ++obbISAs;
+    size_t obbHitCount = 0;
+    for (size_t p = 0; p < obbSet.size(); p += 13) {
+      obbSet[p].OBBIntersectsBoxes(obbView, soaHits);
+      obbSet[p].OBBIntersectsBoxes(obbSet, aosHits);
+      assert(soaHits == aosHits);
+      for (size_t i = 0; i < obbSet.size(); ++i) {
+        const bool hit = obbSet[p].OBBIntersectsBox(obbSet[i]);
+        assert(((soaHits[i / 32] >> (i % 32)) & 1) == uint32_t(hit));
+        obbHitCount += hit;
+      }
+      assert(soaHits[4] >> (obbSet.size() % 32) == 0);
+    }
+    assert(obbHitCount > 0 && obbHitCount < obbSet.size() * 10);
+    COBBox::OBBIntersectsPairs(obbSpan.subspan(0, 150), obbSpan.subspan(7, 150), pairHits);
+    for (size_t i = 0; i < 150; ++i)
+      assert(((pairHits[i / 32] >> (i % 32)) & 1) == uint32_t(obbSet[i].OBBIntersectsBox(obbSet[i + 7])));
+  }
+  assert(obbISAs >= 1);
+  assert(setKernelISA(detectedISA));
+  for (size_t i = 0; i < obbSet.size(); ++i) {
+    const CAABox probe = obbSet[(i * 3) % obbSet.size()].calculateAABox();
+    assert(obbSet[i].AABoxIntersectsBox(probe) == obbSet[i].OBBIntersectsBox(COBBox::FromAABox(probe, CTransform())));
+  }
+
+  const CConvexShape unitSphere(CSphere(CVector3f(0.f), 1.f));
+  const SConvexDistance sphereGap = gjkDistance(unitSphere, CSphere({3.f, 0.5f, 0.f}, 0.5f));
+  assert(!sphereGap.intersecting &&
+         close_enough(sphereGap.distance, CVector3f(3.f, 0.5f, 0.f).magnitude() - 1.5f, 1e-4));
+  assert(close_enough(sphereGap.pointA, CVector3f(3.f, 0.5f, 0.f).normalized(), 1e-3f));
+  assert(!gjkIntersects(unitSphere, CSphere({3.f, 0.5f, 0.f}, 0.5f)));
+  const SConvexPenetration sphereOverlap = epaPenetration(unitSphere, CSphere({1.5f, 0.f, 0.f}, 1.f));
+  assert(sphereOverlap.intersecting && close_enough(sphereOverlap.depth, 0.5f, 1e-3));
+  assert(close_enough(sphereOverlap.normal, CVector3f(1.f, 0.f, 0.f), 1e-2f));
+  assert(close_enough(sphereOverlap.pointA - sphereOverlap.pointB, sphereOverlap.normal * sphereOverlap.depth, 1e-3f));
+
+  const CConvexShape cube(CAABox(0.f, 0.f, 0.f, 2.f, 2.f, 2.f));
+  const SConvexDistance boxGap = gjkDistance(cube, CAABox(3.f, 0.5f, 0.f, 4.f, 1.5f, 1.f));
+  assert(close_enough(boxGap.distance, 1.f, 1e-5) && close_enough(boxGap.pointA.x(), 2.f, 1e-5) &&
+         close_enough(boxGap.pointB.x(), 3.f, 1e-5));
+  const SConvexPenetration boxOverlap = epaPenetration(cube, CAABox(1.5f, 0.2f, -1.f, 3.f, 1.2f, 3.f));
+  assert(boxOverlap.intersecting && close_enough(boxOverlap.depth, 0.5f, 1e-4));
+  assert(close_enough(boxOverlap.normal, CVector3f(1.f, 0.f, 0.f), 1e-4f));
+  const SConvexDistance capsuleGap =
+      gjkDistance(CConvexShape(CLineSeg({0.f, 0.f, 0.f}, {0.f, 4.f, 0.f}), 0.5f), CSphere({2.f, 2.f, 0.f}, 0.5f));
+  assert(close_enough(capsuleGap.distance, 1.f, 1e-3) && close_enough(capsuleGap.pointA, {0.5f, 2.f, 0.f}, 1e-3f));
+
+  /* A hull of a box's corners and some interior points behaves like the box */
+  std::vector<CVector3f> cornerCloud;
+  for (int i = 0; i < 8; ++i)
+    cornerCloud.push_back(CAABox(-obbSet[3].extents, obbSet[3].extents).getPoint(i));
+  for (int i = 0; i < 11; ++i)
+    cornerCloud.push_back(obbSet[3].extents * (float(i) / 11.f - 0.5f));
+  const CConvexHull cornerHull(cornerCloud);
+  size_t gjkHits = 0;
+  for (size_t i = 0; i < obbSet.size(); ++i) {
+    SGJKCache cache;
+    const SConvexDistance obbGap = gjkDistance(obbSet[3], obbSet[i], &cache);
+    const SConvexDistance hullGap = gjkDistance(CConvexShape(cornerHull, obbSet[3].transform), obbSet[i]);
+    assert(obbGap.intersecting == hullGap.intersecting && close_enough(obbGap.distance, hullGap.distance, 1e-3));
+    if (obbGap.distance > 1e-3f)
+      assert(!obbSet[3].OBBIntersectsBox(obbSet[i]));
+    assert(close_enough((obbGap.pointA - obbGap.pointB).magnitude(), obbGap.distance, 1e-3));
+    const SConvexPenetration obbOverlap = epaPenetration(obbSet[3], obbSet[i], &cache);
+    assert(obbOverlap.intersecting == obbGap.intersecting);
+    if (obbOverlap.intersecting) {
+      ++gjkHits;
+      assert(obbSet[3].OBBIntersectsBox(obbSet[i]));
+      /* Moving b out along the normal by the depth leaves the boxes just touching */
+      COBBox pushed = obbSet[i];
+      pushed.transform.origin += obbOverlap.normal * (obbOverlap.depth + 1e-2f);
+      assert(!gjkIntersects(obbSet[3], pushed));
+      pushed.transform.origin -= obbOverlap.normal * 2e-2f;
+      assert(gjkIntersects(obbSet[3], pushed));
+    }
+    /* Warm starting from the cache gives the same answer for a slightly moved pair */
+    COBBox nudged = obbSet[i];
+    nudged.transform.origin += CVector3f(0.01f, -0.02f, 0.015f);
+    const SConvexDistance warm = gjkDistance(obbSet[3], nudged, &cache);
+    const SConvexDistance cold = gjkDistance(obbSet[3], nudged);
+    assert(cache.count != 0 && warm.intersecting == cold.intersecting &&
+           close_enough(warm.distance, cold.distance, 1e-3));
+  }
+  assert(gjkHits > 0 && gjkHits < obbSet.size());
+  std::cout << "GJK " << gjkHits << " of " << obbSet.size() << " boxes overlap" << std::endl;
+
+  /* Face, edge and corner contacts of a unit sphere swept at a 2x2x2 box */
+  const CAABox sweepBox(-1.f, -1.f, -1.f, 1.f, 1.f, 1.f);
+  const SSweepHit faceSweep = sweepSphereAABox(CSphere({-4.f, 0.5f, 0.f}, 1.f), {4.f, 0.f, 0.f}, sweepBox);
+  assert(faceSweep.hit && close_enough(faceSweep.time, 0.5f, 1e-5) &&
+         close_enough(faceSweep.normal, CVector3f(-1.f, 0.f, 0.f), 1e-5f));
+  const SSweepHit edgeSweep = sweepSphereAABox(CSphere({-3.f, -3.f, 0.f}, 1.f), {4.f, 4.f, 0.f}, sweepBox);
+  const float edgeTime = (2.f - 1.f / std::sqrt(2.f)) / 4.f;
+  assert(edgeSweep.hit && close_enough(edgeSweep.time, edgeTime, 1e-5) &&
+         close_enough(edgeSweep.normal, CVector3f(-1.f, -1.f, 0.f).normalized(), 1e-4f));
+  const SSweepHit cornerSweep = sweepSphereAABox(CSphere({3.f, 3.f, 3.f}, 1.f), {-4.f, -4.f, -4.f}, sweepBox);
+  assert(cornerSweep.hit && close_enough(cornerSweep.time, (2.f - 1.f / std::sqrt(3.f)) / 4.f, 1e-5) &&
+         close_enough(cornerSweep.normal, CVector3f(1.f).normalized(), 1e-4f));
+  /* Inside the grown box's corner region but clear of the rounded corner */
+  assert(!sweepSphereAABox(CSphere({1.8f, 1.8f, 0.f}, 1.f), {0.f, 0.f, 2.f}, sweepBox).hit);
+  assert(!sweepSphereAABox(CSphere({-4.f, 0.f, 0.f}, 1.f), {1.5f, 0.f, 0.f}, sweepBox).hit);
+  const SSweepHit startSweep = sweepSphereAABox(CSphere({0.f, 1.5f, 0.f}, 1.f), {5.f, 0.f, 0.f}, sweepBox);
+  assert(startSweep.hit && startSweep.time == 0.f && close_enough(startSweep.normal, CVector3f(0.f, 1.f, 0.f)));
+
+  const SSweepHit boxSweep =
+      sweepAABoxAABox(CAABox(-5.f, 0.5f, 0.f, -3.f, 1.5f, 1.f), {4.f, -1.f, 0.f}, sweepBox);
+  assert(boxSweep.hit && close_enough(boxSweep.time, 0.5f, 1e-5) &&
+         close_enough(boxSweep.normal, CVector3f(-1.f, 0.f, 0.f)));
+  assert(!sweepAABoxAABox(CAABox(-5.f, 1.5f, 0.f, -3.f, 2.5f, 1.f), {4.f, 0.f, 0.f}, sweepBox).hit);
+  /* Touching and moving apart is not a hit; touching and moving in is one at time 0 */
+  assert(!sweepAABoxAABox(CAABox(1.f, 0.f, 0.f, 2.f, 1.f, 1.f), {1.f, 0.f, 0.f}, sweepBox).hit);
+  assert(sweepAABoxAABox(CAABox(1.f, 0.f, 0.f, 2.f, 1.f, 1.f), {-1.f, 0.f, 0.f}, sweepBox).time == 0.f);
+
+  /* The batched sweeps match the first hit of the scalar ones */
+  size_t sweepHits = 0;
+  for (int i = 0; i < 24; ++i) {
+    const CVector3f from(float(i % 5) * 9.f - 30.f, float(i % 3) * 14.f - 12.f, float(i % 4) * 5.f - 8.f);
+    const CVector3f delta(float(i % 7) * 9.f - 20.f, float(i % 2) * 8.f - 3.f, float(i % 3) * 4.f - 3.f);
+    const CSphere mover(from, 0.5f + float(i % 3));
+    const CAABox moverBox(from - 1.5f, from + CVector3f(1.f, 2.f, 0.5f));
+    SSweepHit sphereFirst, boxFirst;
+    uint32_t sphereIndex = 0, boxIndex = 0;
+    for (size_t j = 0; j < soaBoxes.size(); ++j) {
+      const CAABox box({bounds[0][j], bounds[1][j], bounds[2][j]}, {bounds[3][j], bounds[4][j], bounds[5][j]});
+      const SSweepHit sphereHit = sweepSphereAABox(mover, delta, box);
+      if (sphereHit.hit && (!sphereFirst.hit || sphereHit.time < sphereFirst.time)) {
+        sphereFirst = sphereHit;
+        sphereIndex = uint32_t(j);
+      }
+      const SSweepHit boxHit = sweepAABoxAABox(moverBox, delta, box);
+      if (boxHit.hit && (!boxFirst.hit || boxHit.time < boxFirst.time)) {
+        boxFirst = boxHit;
+        boxIndex = uint32_t(j);
+      }
+    }
+    uint32_t index = ~0u;
+    const SSweepHit sphereBatch = sweepSphereAABoxes(mover, delta, soaBoxes, index);
+    assert(sphereBatch.hit == sphereFirst.hit && sphereBatch.time == sphereFirst.time);
+    assert(!sphereBatch.hit || index == sphereIndex);
+    const SSweepHit boxBatch = sweepAABoxAABoxes(moverBox, delta, soaBoxes, index);
+    assert(boxBatch.hit == boxFirst.hit && boxBatch.time == boxFirst.time);
+    assert(!boxBatch.hit || index == boxIndex);
+    sweepHits += sphereFirst.hit + boxFirst.hit;
+  }
+  assert(sweepHits > 0);
+
+  /* A box sliding and spinning into a resting one stops just short of the face it reaches */
+  const COBBox restingBox(CTransform(), {1.f, 1.f, 1.f});
+  const COBBox slidingBox(CTransform::Translate(-6.f, 0.f, 0.f), {1.f, 0.5f, 0.5f});
+  const SSweepHit slideHit =
+      timeOfImpact(slidingBox, CTransform::Translate(2.f, 0.f, 0.f), restingBox, restingBox.transform);
+  assert(slideHit.hit && close_enough(slideHit.time, 0.5f, 1e-3) &&
+         close_enough(slideHit.normal, CVector3f(-1.f, 0.f, 0.f), 1e-3f));
+  const CTransform spunEnd = CTransform(CMatrix3f(CQuaternion::fromAxisAngle({0.f, 0.f, 1.f}, M_PIF / 2.f)),
+                                        CVector3f(-6.f, 0.f, 0.f) + CVector3f(8.f, 0.f, 0.f));
+  const SSweepHit spinHit = timeOfImpact(slidingBox, spunEnd, restingBox, restingBox.transform);
+  assert(spinHit.hit && spinHit.time > 0.f && spinHit.time < 1.f);
+  const CTransform spinPose(CMatrix3f(CQuaternion::slerpShort(CQuaternion(), CQuaternion(spunEnd.basis),
+                                                                spinHit.time)),
+                            CVector3f(-6.f + 8.f * spinHit.time, 0.f, 0.f));
+  const SConvexDistance spinGap = gjkDistance(COBBox(spinPose, slidingBox.extents), restingBox);
+  assert(!spinGap.intersecting && spinGap.distance < 1e-2f);
+  assert(!timeOfImpact(slidingBox, CTransform::Translate(-6.f, 3.f, 0.f), restingBox, restingBox.transform).hit);
+  const SSweepHit overlapHit = timeOfImpact(restingBox, CTransform::Translate(0.f, 4.f, 0.f),
+                                            COBBox(CTransform::Translate(0.f, -1.8f, 0.f), {1.f, 1.f, 1.f}),
+                                            CTransform::Translate(0.f, -1.8f, 0.f));
+  assert(overlapHit.hit && overlapHit.time == 0.f && close_enough(overlapHit.normal, {0.f, 1.f, 0.f}, 1e-3f));
+
+  /* Against candidates, the earliest contact wins */
+  const COBBox droppingBox(CTransform::Translate(1.f, 0.5f, 16.f), {1.f, 0.5f, 2.f});
+  const CTransform droppedEnd(CMatrix3f(CQuaternion::fromAxisAngle({1.f, 0.f, 0.f}, 1.f)), {1.f, 0.5f, -4.f});
+  uint32_t toiIndex = 0;
+  const SSweepHit toiFirst = timeOfImpact(droppingBox, droppedEnd, obbSpan, toiIndex);
+  assert(toiFirst.hit && toiFirst.time > 0.f);
+  for (size_t i = 0; i < obbSet.size(); ++i) {
+    const SSweepHit toi = timeOfImpact(droppingBox, droppedEnd, obbSet[i], obbSet[i].transform);
+    assert(!toi.hit || (toiFirst.hit && toi.time >= toiFirst.time - 1e-4f));
+    if (i == toiIndex)
+      assert(toi.hit == toiFirst.hit && close_enough(toi.time, toiFirst.time, 1e-4));
+  }
+  std::cout << "Swept " << sweepHits << " hits, first contact at " << toiFirst.time << std::endl;
+
+  const CVector3f triA(0.f, 0.f, 0.f), triB(1.f, 0.f, 0.f), triC(0.f, 1.f, 0.f);
+  float triDist = 0.f;
+  CVector3f triBary;
+  assert(rayTriangleIntersect(CMRay({0.25f, 0.25f, 1.f}, {0.f, 0.f, -1.f}, 5.f), triA, triB, triC, triDist, triBary));
+  assert(close_enough(triDist, 1.f) && close_enough(triBary, {0.5f, 0.25f, 0.25f}));
+  assert(close_enough(baryToWorld(triA, triB, triC, triBary), {0.25f, 0.25f, 0.f}));
+  /* From below, past the hypotenuse, in the plane, and too short */
+  assert(rayTriangleIntersect(CMRay({0.1f, 0.1f, -2.f}, {0.f, 0.f, 1.f}, 5.f), triA, triB, triC, triDist, triBary));
+  assert(!rayTriangleIntersect(CMRay({0.6f, 0.6f, 1.f}, {0.f, 0.f, -1.f}, 5.f), triA, triB, triC, triDist, triBary));
+  assert(!rayTriangleIntersect(CMRay({-1.f, 0.2f, 0.f}, {1.f, 0.f, 0.f}, 5.f), triA, triB, triC, triDist, triBary));
+  assert(!rayTriangleIntersect(CMRay({0.2f, 0.2f, 1.f}, {0.f, 0.f, -1.f}, 0.5f), triA, triB, triC, triDist, triBary));
+
+  const CAABox triBox(-1.f, -1.f, -1.f, 1.f, 1.f, 1.f);
+  /* Slicing through the box with every corner outside it */
+  assert(triangleAABoxIntersect({-5.f, -5.f, 0.2f}, {5.f, -5.f, 0.2f}, {0.f, 5.f, 0.2f}, triBox));
+  assert(!triangleAABoxIntersect({-5.f, -5.f, 1.2f}, {5.f, -5.f, 1.2f}, {0.f, 5.f, 1.2f}, triBox));
+  /* Only the axis across the box edge and the triangle's hypotenuse separates these */
+  assert(!triangleAABoxIntersect({2.f, 0.5f, 0.f}, {0.5f, 2.f, 0.f}, {2.f, 2.f, 0.f}, triBox));
+  assert(triangleAABoxIntersect({2.f, 0.5f, 0.f}, {0.5f, 1.2f, 0.f}, {2.f, 2.f, 0.f}, triBox));
+  /* Tilted out of the box's corner by the triangle plane alone */
+  assert(!triangleAABoxIntersect({3.5f, 0.f, 0.f}, {0.f, 3.5f, 0.f}, {0.f, 0.f, 3.5f}, triBox));
+  assert(triangleAABoxIntersect({2.5f, 0.f, 0.f}, {0.f, 2.5f, 0.f}, {0.f, 0.f, 2.5f}, triBox));
+
+  CVector3f closestBary;
+  assert(close_enough(closestPointOnTriangle({0.2f, 0.3f, 2.f}, triA, triB, triC, &closestBary), {0.2f, 0.3f, 0.f}));
+  assert(close_enough(closestBary, {0.5f, 0.2f, 0.3f}));
+  assert(close_enough(closestPointOnTriangle({-1.f, -2.f, 1.f}, triA, triB, triC, &closestBary), triA));
+  assert(close_enough(closestPointOnTriangle({3.f, -1.f, 0.f}, triA, triB, triC, &closestBary), triB));
+  assert(close_enough(closestPointOnTriangle({1.f, 1.f, -1.f}, triA, triB, triC, &closestBary), {0.5f, 0.5f, 0.f}));
+  assert(close_enough(closestPointOnTriangle({0.5f, -3.f, 0.f}, triA, triB, triC), {0.5f, 0.f, 0.f}));
+  assert(close_enough(closestPointOnTriangle({-2.f, 0.4f, 0.f}, triA, triB, triC), {0.f, 0.4f, 0.f}));
+
+  /* A bumpy height field of 37 triangles short of a whole register plus a few loose ones, against scalar loops */
+  std::vector<CVector3f> soupVerts;
+  std::vector<uint32_t> soupIndices;
+  for (int y = 0; y < 5; ++y)
+    for (int x = 0; x < 6; ++x)
+      soupVerts.emplace_back(float(x) * 2.f, float(y) * 2.f, std::sin(float(x * 3 + y * 5)) * 0.8f);
+  for (uint32_t y = 0; y < 4; ++y) {
+    for (uint32_t x = 0; x < 5; ++x) {
+      const uint32_t corner = y * 6 + x;
+      soupIndices.insert(soupIndices.end(), {corner, corner + 1, corner + 7});
+      if (soupIndices.size() < 37 * 3)
+        soupIndices.insert(soupIndices.end(), {corner, corner + 7, corner + 6});
+    }
+  }
+  for (int i = 0; i < 7; ++i) {
+    const CVector3f base(float(i) * 1.3f, float(i % 3) * 2.5f, 1.5f + float(i % 2));
+    soupVerts.insert(soupVerts.end(), {base, base + CVector3f(1.f, 0.2f, -0.5f), base + CVector3f(0.1f, 1.2f, 0.4f)});
+    const uint32_t first = uint32_t(soupVerts.size() - 3);
+    soupIndices.insert(soupIndices.end(), {first, first + 1, first + 2});
+  }
+  const CTriangleSoup soup(soupVerts, soupIndices);
+  assert(soup.size() == soupIndices.size() / 3);
+  std::vector<uint32_t> soupBits((soup.size() + 31) / 32);
+  size_t soupHits = 0, soupOverlaps = 0;
+  int soupISAs = 0;
+  for (size_t isa = 0; isa < KernelISACount; ++isa) {
+    if (!setKernelISA(EKernelISA(isa)))
+      continue;
+    ++soupISAs;
+    for (int r = 0; r < 31; ++r) {
+      const CVector3f from(float(r % 6) * 1.9f - 0.5f, float(r % 5) * 1.7f, 4.f - float(r % 3));
+      const CVector3f to(float(r % 4) * 2.6f, float((r * 7) % 9), -2.f + float(r % 2) * 0.5f);
+      const CMRay ray(from, (to - from).normalized(), (to - from).magnitude() * (r % 4 == 0 ? 0.5f : 1.f));
+      STriangleHit first;
+      bool scalarHit = false;
+      for (size_t i = 0; i < soup.size(); ++i) {
+        const auto [p0, p1, p2] = soup.triangle(i);
+        if (rayTriangleIntersect(ray, p0, p1, p2, triDist, triBary) && (!scalarHit || triDist < first.distance)) {
+          scalarHit = true;
+          first.index = uint32_t(i);
+          first.distance = triDist;
+          first.bary = triBary;
+        }
+      }
+      STriangleHit hit;
+      assert(soup.rayCastClosest(ray, hit) == scalarHit);
+      if (scalarHit) {
+        ++soupHits;
+        assert(close_enough(hit.distance, first.distance, 1e-4) && close_enough(hit.bary, first.bary, 1e-4f));
+        assert(close_enough(hit.point, ray.start + ray.dir * hit.distance, 1e-3f));
+      }
+
+      const CAABox probe(from - CVector3f(0.3f + float(r % 3)), from + CVector3f(1.f, 0.5f, 0.2f) * float(r % 4));
+      soup.intersect(probe, soupBits);
+      for (size_t i = 0; i < soup.size(); ++i) {
+        const auto [p0, p1, p2] = soup.triangle(i);
+        assert(((soupBits[i / 32] >> (i % 32)) & 1) == uint32_t(triangleAABoxIntersect(p0, p1, p2, probe)));
+        soupOverlaps += triangleAABoxIntersect(p0, p1, p2, probe);
+      }
+      assert(soupBits.back() >> (soup.size() % 32) == 0);
+
+      float nearest = FLT_MAX;
+      for (size_t i = 0; i < soup.size(); ++i) {
+        const auto [p0, p1, p2] = soup.triangle(i);
+        nearest = std::min(nearest, (closestPointOnTriangle(to, p0, p1, p2) - to).magnitude());
+      }
+      STriangleHit near;
+      assert(soup.closestPoint(to, near) && close_enough(near.distance, nearest, 1e-4));
+      const auto [n0, n1, n2] = soup.triangle(near.index);
+      assert(close_enough(closestPointOnTriangle(to, n0, n1, n2), near.point, 1e-4f));
+      assert(!soup.closestPoint(to, near, nearest * 0.99f));
+    }
+  }
+  assert(setKernelISA(detectedISA));
+  assert(soupOverlaps > 0 && soupOverlaps < soup.size() * 31 * soupISAs);
+  std::cout << "Triangle soup " << soupHits / soupISAs << " ray hits, " << soupOverlaps / soupISAs << " box overlaps"
+            << std::endl;
+
+  CDynamicAABBTree dynTree;
+  std::vector<CAABox> movers;
+  std::vector<uint32_t> moverHandles;
+  for (int i = 0; i < 300; ++i) {
+    const CVector3f center(float((i * 37) % 41) - 20.f, float((i * 23) % 31) - 15.f, float((i * 11) % 13) - 6.f);
+    movers.emplace_back(center - 0.5f, center + 0.25f * float(1 + i % 3));
+    moverHandles.push_back(dynTree.insert(movers.back(), uint32_t(i)));
+  }
+  /* Compares every query against brute force over the live movers */
+  const auto checkDynTree = [&]() {
+    std::vector<uint32_t> treeHits, bruteDyn;
+    const auto compare = [&]() {
+      std::vector<uint32_t> got;
+      for (uint32_t handle : treeHits)
+        got.push_back(dynTree.userData(handle));
+      assert(sortedQuery(got) == bruteDyn);
+      treeHits.clear();
+      bruteDyn.clear();
+    };
+    const CAABox probe(CVector3f(-6.f, -4.f, -3.f), CVector3f(5.f, 6.f, 2.f));
+    dynTree.queryAABB(probe, treeHits);
+    for (uint32_t i = 0; i < movers.size(); ++i)
+      if (dynTree.contains(moverHandles[i]) && movers[i].intersects(probe))
+        bruteDyn.push_back(i);
+    compare();
+    dynTree.queryFrustum(frustum, treeHits);
+    for (uint32_t i = 0; i < movers.size(); ++i)
+      if (dynTree.contains(moverHandles[i]) && frustum.aabbFrustumTest(movers[i]))
+        bruteDyn.push_back(i);
+    compare();
+    size_t rayHits = 0;
+    for (int r = 0; r < 16; ++r) {
+      const CVector3f start(-30.f, float(r * 2) - 15.f, float(r % 13) - 6.f);
+      const CMRay dynRay(start, CVector3f(1.f, 0.05f, 0.02f).normalized(), 60.f);
+      const CRaySlab dynSlab(dynRay);
+      dynTree.queryRay(dynRay, treeHits);
+      float bruteNearest = FLT_MAX;
+      for (uint32_t i = 0; i < movers.size(); ++i) {
+        float enter, exit;
+        if (dynTree.contains(moverHandles[i]) && dynSlab.intersect(movers[i], enter, exit)) {
+          bruteDyn.push_back(i);
+          bruteNearest = std::min(bruteNearest, enter);
+        }
+      }
+      const bool anyHit = !bruteDyn.empty();
+      rayHits += bruteDyn.size();
+      compare();
+      uint32_t nearestHandle = 0;
+      float nearestDist = 0.f;
+      assert(dynTree.rayCastClosest(dynRay, nearestHandle, nearestDist) == anyHit);
+      assert(!anyHit || close_enough(nearestDist, bruteNearest, 1e-4));
+    }
+    for (uint32_t i = 0; i < movers.size(); ++i)
+      if (dynTree.contains(moverHandles[i]))
+        assert(movers[i].inside(dynTree.fatBounds(moverHandles[i])));
+    return rayHits;
+  };
+  const size_t dynRayHits = checkDynTree();
+  assert(dynTree.size() == movers.size() && dynTree.height() <= 14 && dynTree.areaRatio() > 1.f);
+
+  /* Small steps stay inside the fat boxes; large ones reinsert */
+  size_t reinserts = 0;
+  for (int step = 0; step < 4; ++step) {
+    for (uint32_t i = 0; i < movers.size(); i += 2) {
+      const CVector3f delta(0.02f, -0.01f * float(i % 3), 0.015f);
+      movers[i] = CAABox(movers[i].min + delta, movers[i].max + delta);
+      reinserts += dynTree.move(moverHandles[i], movers[i], delta);
+    }
+  }
+  assert(reinserts == 0);
+  checkDynTree();
+  for (uint32_t i = 0; i < movers.size(); i += 3) {
+    const CVector3f delta(float(i % 7) - 3.f, 2.f, -float(i % 5));
+    movers[i] = CAABox(movers[i].min + delta, movers[i].max + delta);
+    reinserts += dynTree.move(moverHandles[i], movers[i], delta);
+  }
+  assert(reinserts > 0 && reinserts <= movers.size() / 3 + 1 && dynTree.height() <= 14);
+  checkDynTree();
+
+  /* Freed nodes are reused, and the remaining handles keep their objects */
+  std::vector<uint32_t> removedHandles;
+  for (uint32_t i = 1; i < movers.size(); i += 4) {
+    dynTree.remove(moverHandles[i]);
+    removedHandles.push_back(std::exchange(moverHandles[i], CDynamicAABBTree::NullNode));
+  }
+  const uint32_t reused = dynTree.insert(CAABox(CVector3f(0.f), CVector3f(1.f)), uint32_t(movers.size()));
+  movers.emplace_back(CVector3f(0.f), CVector3f(1.f));
+  moverHandles.push_back(reused);
+  assert(reused == removedHandles.back() && !dynTree.contains(removedHandles.front()));
+  for (uint32_t i = 0; i < movers.size(); ++i)
+    if (dynTree.contains(moverHandles[i]))
+      assert(dynTree.userData(moverHandles[i]) == i && dynTree.bounds(moverHandles[i]) == movers[i]);
+  checkDynTree();
+
+  /* Rotations keep sorted insertions balanced */
+  CDynamicAABBTree chain;
+  for (int i = 0; i < 1024; ++i)
+    (void)chain.insert(CAABox(CVector3f(float(i), 0.f, 0.f), CVector3f(float(i) + 0.5f, 1.f, 1.f)));
+  assert(chain.size() == 1024 && chain.height() <= 15);
+  chain.clear();
+  assert(chain.empty() && chain.height() == 0);
+  std::cout << "Dynamic AABB tree height " << dynTree.height() << ", ray hit " << dynRayHits << " boxes" << std::endl;
+
+  CLooseOctree octree(CAABox(CVector3f(-32.f, -16.f, -8.f), CVector3f(32.f, 16.f, 8.f)), 5);
+  std::vector<CAABox> octObjects;
+  for (int i = 0; i < 400; ++i) {
+    const CVector3f center(float((i * 53) % 71) - 35.f, float((i * 19) % 37) - 18.f, float((i * 7) % 17) - 8.f);
+    const float size = i % 50 == 0 ? 20.f : 0.2f + 0.4f * float(i % 6);
+    octObjects.emplace_back(center - size * 0.5f, center + size * 0.5f);
+    octree.insert(uint32_t(i), octObjects.back());
+  }
+  /* Compares every query against brute force over the live objects */
+  const auto checkOctree = [&]() {
+    std::vector<uint32_t> treeHits, bruteOct;
+    const auto compare = [&]() {
+      assert(sortedQuery(treeHits) == bruteOct);
+      treeHits.clear();
+      bruteOct.clear();
+    };
+    const CVector3f point(1.3f, -2.1f, 0.4f);
+    octree.queryPoint(point, treeHits);
+    for (uint32_t i = 0; i < octObjects.size(); ++i)
+      if (octree.contains(i) && octObjects[i].pointInside(point))
+        bruteOct.push_back(i);
+    compare();
+    const CAABox probe(CVector3f(-10.f, -6.f, -3.f), CVector3f(4.f, 5.f, 2.f));
+    octree.queryAABB(probe, treeHits);
+    for (uint32_t i = 0; i < octObjects.size(); ++i)
+      if (octree.contains(i) && octObjects[i].intersects(probe))
+        bruteOct.push_back(i);
+    const size_t probeHits = bruteOct.size();
+    compare();
+    octree.queryFrustum(frustum, treeHits);
+    for (uint32_t i = 0; i < octObjects.size(); ++i)
+      if (octree.contains(i) && frustum.aabbFrustumTest(octObjects[i]))
+        bruteOct.push_back(i);
+    compare();
+    return probeHits;
+  };
+  const size_t octProbeHits = checkOctree();
+  const size_t octNodes = octree.nodeCount();
+  assert(octree.size() == octObjects.size() && octree.depth(0) == 0 && octree.depth(1) == 4 && octree.depth(6) == 5);
+
+  /* Small steps keep objects in their nodes; larger ones move them */
+  for (uint32_t i = 0; i < octObjects.size(); ++i) {
+    const CVector3f delta = i % 4 == 0 ? CVector3f(3.f, -2.f, 1.f) : CVector3f(0.01f, 0.f, -0.01f);
+    octObjects[i] = CAABox(octObjects[i].min + delta, octObjects[i].max + delta);
+    octree.move(i, octObjects[i]);
+    assert(octree.bounds(i) == octObjects[i]);
+  }
+  checkOctree();
+  /* Renumbering keeps the nodes and the Morton order queries visit them in */
+  std::vector<uint32_t> octOrder, octOptimizedOrder;
+  octree.queryAABB(octree.worldBounds(), octOrder);
+  const size_t octMovedNodes = octree.nodeCount();
+  octree.optimize();
+  octree.queryAABB(octree.worldBounds(), octOptimizedOrder);
+  assert(octree.nodeCount() == octMovedNodes && octOptimizedOrder == octOrder);
+  checkOctree();
+  for (uint32_t i = 0; i < octObjects.size(); i += 2)
+    octree.remove(i);
+  assert(octree.size() == octObjects.size() / 2 && octree.nodeCount() < octNodes);
+  checkOctree();
+  for (uint32_t i = 1; i < octObjects.size(); i += 2)
+    octree.remove(i);
+  assert(octree.size() == 0 && octree.nodeCount() == 1);
+  octree.insert(7, octObjects[7]);
+  octree.clear();
+  assert(octree.size() == 0 && !octree.contains(7));
+
+  CLooseQuadtree quadtree(CRectangle(-50.f, -50.f, 100.f, 100.f));
+  std::vector<CRectangle> quadObjects;
+  for (int i = 0; i < 300; ++i) {
+    quadObjects.emplace_back(float((i * 41) % 113) - 56.f, float((i * 29) % 97) - 48.f, 0.5f + float(i % 5),
+                             0.25f + float(i % 3) * 0.75f);
+    quadtree.insert(uint32_t(i), quadObjects.back());
+  }
+  const auto checkQuadtree = [&]() {
+    std::vector<uint32_t> treeHits, bruteQuad;
+    const CRectangle probe(-12.f, -7.f, 20.f, 15.f);
+    quadtree.queryRect(probe, treeHits);
+    for (uint32_t i = 0; i < quadObjects.size(); ++i)
+      if (quadtree.contains(i) && quadObjects[i].intersects(probe))
+        bruteQuad.push_back(i);
+    assert(sortedQuery(treeHits) == bruteQuad);
+    treeHits.clear();
+    bruteQuad.clear();
+    const CVector2f point(3.2f, -1.7f);
+    quadtree.queryPoint(point, treeHits);
+    for (uint32_t i = 0; i < quadObjects.size(); ++i)
+      if (quadtree.contains(i) && quadObjects[i].contains(point))
+        bruteQuad.push_back(i);
+    assert(sortedQuery(treeHits) == bruteQuad);
+  };
+  checkQuadtree();
+  for (uint32_t i = 0; i < quadObjects.size(); i += 3) {
+    quadObjects[i].position += CVector2f(float(i % 7) - 3.f, 1.5f);
+    quadtree.move(i, quadObjects[i]);
+  }
+  for (uint32_t i = 1; i < quadObjects.size(); i += 5)
+    quadtree.remove(i);
+  checkQuadtree();
+  quadtree.optimize();
+  checkQuadtree();
+  for (uint32_t i = 0; i < quadObjects.size(); i += 3) {
+    if (!quadtree.contains(i))
+      continue;
+    quadObjects[i].position -= CVector2f(float(i % 7) - 3.f, 1.5f);
+    quadtree.move(i, quadObjects[i]);
+  }
+  checkQuadtree();
+  std::cout << "Loose octree " << octNodes << " nodes, " << octProbeHits << " box hits" << std::endl;
+
+  assert(encodeMorton30(1, 0, 0) == 1 && encodeMorton30(0, 1, 0) == 2 && encodeMorton30(0, 0, 1) == 4);
+  assert(encodeMorton30(1023, 1023, 1023) == 0x3FFFFFFFu && encodeMorton30(1024, 0, 0) == 0);
+  assert(encodeMorton63(0x1FFFFF, 0x1FFFFF, 0x1FFFFF) == 0x7FFFFFFFFFFFFFFFull);
+  assert(encodeMorton63(0, 0, 1u << 20) == 1ull << 62 && encodeMorton2({3, 1}) == 0x7);
+  for (uint32_t i = 0; i < 1000; ++i) {
+    const uint32_t a = i * 2654435761u;
+    const uint32_t b = a ^ (a >> 13) * 40503u;
+    uint32_t x, y, z;
+    decodeMorton30(encodeMorton30(a, b, a >> 11), x, y, z);
+    assert(x == (a & 0x3FF) && y == (b & 0x3FF) && z == ((a >> 11) & 0x3FF));
+    decodeMorton63(encodeMorton63(a, b, a >> 11), x, y, z);
+    assert(x == (a & 0x1FFFFF) && y == (b & 0x1FFFFF) && z == ((a >> 11) & 0x1FFFFF));
+    assert(decodeMorton2(encodeMorton2(CVector2i(int32_t(a & 0xFFFF), int32_t(b & 0xFFFF)))) ==
+           CVector2i(int32_t(a & 0xFFFF), int32_t(b & 0xFFFF)));
+  }
+
+  /* The curve starts at the origin corner, so a corner block takes the first keys, one step per face-adjacent cell */
+  const auto checkHilbert = [](std::vector<std::pair<uint64_t, std::array<int, 3>>> cells) {
+    std::sort(cells.begin(), cells.end());
+    for (size_t i = 0; i < cells.size(); ++i) {
+      assert(cells[i].first == i);
+      if (i > 0) {
+        int steps = 0;
+        for (int c = 0; c < 3; ++c)
+          steps += std::abs(cells[i].second[c] - cells[i - 1].second[c]);
+        assert(steps == 1);
+      }
+    }
+  };
+  std::vector<std::pair<uint64_t, std::array<int, 3>>> hilbertCells;
+  for (int x = 0; x < 8; ++x)
+    for (int y = 0; y < 8; ++y)
+      for (int z = 0; z < 8; ++z)
+        hilbertCells.push_back({encodeHilbert63(x, y, z), {x, y, z}});
+  checkHilbert(hilbertCells);
+  hilbertCells.clear();
+  for (int x = 0; x < 16; ++x)
+    for (int y = 0; y < 16; ++y)
+      hilbertCells.push_back({encodeHilbert2({x, y}), {x, y, 0}});
+  checkHilbert(hilbertCells);
+
+  std::vector<CVector3f> keyPoints;
+  for (int i = 0; i < 1000; ++i)
+    keyPoints.emplace_back(float((i * 37) % 101) * 0.31f - 9.f, float((i * 53) % 89) * 0.4f - 20.f,
+                           float((i * 11) % 29) - 3.f);
+  keyPoints[5] = CVector3f(NAN, 1e9f, -1e9f);
+  const CAABox keyBounds(CVector3f(-10.f, -20.f, -4.f), CVector3f(22.f, 16.f, 26.f));
+  std::vector<uint32_t> keys30(keyPoints.size());
+  std::vector<uint64_t> keys63(keyPoints.size()), hilbert63(keyPoints.size());
+  for (size_t isa = 0; isa < KernelISACount; ++isa) {
+    if (!setKernelISA(EKernelISA(isa)))
+      continue;
+    mortonKeys30(keyPoints, keyBounds, keys30);
+    mortonKeys63(keyPoints, keyBounds, keys63);
+    hilbertKeys63(keyPoints, keyBounds, hilbert63);
+    for (size_t i = 0; i < keyPoints.size(); ++i) {
+      assert(keys30[i] == mortonKey30(keyPoints[i], keyBounds) && keys63[i] == mortonKey63(keyPoints[i], keyBounds));
+      assert(hilbert63[i] == hilbertKey63(keyPoints[i], keyBounds));
+    }
+  }
+  assert(setKernelISA(detectedISA));
+  assert(keys30[5] == encodeMorton30(0, 1023, 0) && keys63[5] == encodeMorton63(0, 0x1FFFFF, 0));
+
+  /* Radix sorting matches a stable sort, threaded or not */
+  const auto checkRadix = [](auto keys, unsigned threadCount) {
+    std::vector<uint32_t> order(keys.size());
+    for (uint32_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+    std::vector<uint32_t> expected = order;
+    std::stable_sort(expected.begin(), expected.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+    auto sortedKeys = keys;
+    radixSortByKey(std::span(sortedKeys), std::span(order), threadCount);
+    assert(order == expected);
+    for (size_t i = 0; i < order.size(); ++i)
+      assert(sortedKeys[i] == keys[order[i]]);
+  };
+  checkRadix(keys30, 1);
+  checkRadix(keys63, 1);
+  checkRadix(hilbert63, 1);
+  std::vector<uint64_t> manyKeys(1 << 18);
+  for (uint32_t i = 0; i < manyKeys.size(); ++i)
+    manyKeys[i] = encodeMorton63(i * 2654435761u, i >> 3, (i * 40503u) >> 7) & ~0xFF00ull;
+  checkRadix(manyKeys, 4);
+  std::cout << "Spatial keys " << std::hex << keys63[1] << ", " << hilbert63[1] << std::dec << std::endl;
+
+  std::vector<CVector3f> kdPoints;
+  for (int i = 0; i < 3000; ++i)
+    kdPoints.emplace_back(float((i * 37) % 211) * 0.5f, float((i * 53) % 97), float((i * 71) % 13) * 2.f);
+  kdPoints.push_back(kdPoints[7]);
+  const CKdTree kdTree(kdPoints);
+  assert(kdTree.size() == kdPoints.size() && kdTree.bounds().pointInside(kdPoints[1234]));
+  std::vector<CVector3f> kdQueries;
+  for (int i = 0; i < 600; ++i)
+    kdQueries.emplace_back(float((i * 29) % 113) - 3.f, float((i * 61) % 101), float((i * 17) % 31) - 2.f);
+  const auto bruteNearest = [&](const CVector3f& q, size_t k, float maxDistance) {
+    std::vector<float> distances;
+    for (const CVector3f& p : kdPoints)
+      if ((p - q).magSquared() <= maxDistance * maxDistance)
+        distances.push_back((p - q).magSquared());
+    std::sort(distances.begin(), distances.end());
+    distances.resize(std::min(distances.size(), k));
+    return distances;
+  };
+  std::array<SNeighbor, 5> neighbors;
+  std::vector<uint32_t> kdHits;
+  for (size_t q = 0; q < 40; ++q) {
+    const std::vector<float> expected = bruteNearest(kdQueries[q], neighbors.size(), q % 2 == 0 ? FLT_MAX : 4.f);
+    const size_t found = kdTree.queryNearest(kdQueries[q], neighbors, q % 2 == 0 ? FLT_MAX : 4.f);
+    assert(found == expected.size());
+    for (size_t i = 0; i < found; ++i)
+      assert(neighbors[i].distanceSq == expected[i] &&
+             (kdPoints[neighbors[i].index] - kdQueries[q]).magSquared() == expected[i]);
+
+    const size_t approx = kdTree.queryNearest(kdQueries[q], neighbors, q % 2 == 0 ? FLT_MAX : 4.f, 0.5f);
+    assert(approx == expected.size());
+    for (size_t i = 0; i < approx; ++i)
+      assert(neighbors[i].distanceSq <= expected[i] * 2.25f);
+
+    kdHits.clear();
+    kdTree.queryRadius(kdQueries[q], 6.f, kdHits);
+    std::vector<uint32_t> bruteRadius;
+    for (uint32_t i = 0; i < kdPoints.size(); ++i)
+      if ((kdPoints[i] - kdQueries[q]).magSquared() <= 36.f)
+        bruteRadius.push_back(i);
+    assert(sortedQuery(kdHits) == bruteRadius);
+  }
+  std::vector<SNeighbor> tooMany(kdPoints.size() + 3);
+  assert(kdTree.queryNearest(kdPoints[7], tooMany) == kdPoints.size() && tooMany[1].distanceSq == 0.f);
+
+  /* Batches match single queries, threaded or not */
+  std::vector<SNeighbor> batchNeighbors(kdQueries.size() * 3);
+  std::vector<uint32_t> batchCounts(kdQueries.size());
+  kdTree.queryNearest(kdQueries, 3, batchNeighbors, batchCounts, 10.f, 0.f, 4);
+  std::vector<uint32_t> batchHits{UINT32_MAX};
+  std::vector<uint32_t> batchOffsets(kdQueries.size() + 1);
+  kdTree.queryRadius(kdQueries, 5.f, batchHits, batchOffsets, 4);
+  assert(batchOffsets.front() == 1 && batchOffsets.back() == batchHits.size());
+  for (size_t q = 0; q < kdQueries.size(); ++q) {
+    const size_t found = kdTree.queryNearest(kdQueries[q], std::span(neighbors).first(3), 10.f);
+    assert(batchCounts[q] == found);
+    for (size_t i = 0; i < found; ++i)
+      assert(batchNeighbors[q * 3 + i].distanceSq == neighbors[i].distanceSq);
+    kdHits.clear();
+    kdTree.queryRadius(kdQueries[q], 5.f, kdHits);
+    assert(std::equal(kdHits.begin(), kdHits.end(), batchHits.begin() + batchOffsets[q],
+                      batchHits.begin() + batchOffsets[q + 1]));
+  }
+  std::cout << "Kd tree " << kdTree.nodeCount() << " nodes, " << batchHits.size() - 1 << " radius hits" << std::endl;
+
+  assert(floatToHalf(1.f) == 0x3C00 && halfToFloat(0x3C00) == 1.f);
+  assert(floatToHalf(-2.5f) == 0xC100 && halfToFloat(0xC100) == -2.5f);
+  assert(floatToHalf(65504.f) == 0x7BFF && floatToHalf(65520.f) == 0x7C00);
+  assert(floatToHalf(1.f + 1.f / 2048.f) == 0x3C00 && floatToHalf(1.f + 3.f / 2048.f) == 0x3C02);
+  assert(halfToFloat(0x0001) == std::ldexp(1.f, -24) && floatToHalf(std::ldexp(1.f, -24)) == 0x0001);
+  assert(std::isnan(halfToFloat(floatToHalf(NAN))));
+
+  std::vector<CVector3f> unpacked;
+  for (int i = 0; i < 7; ++i)
+    unpacked.emplace_back(float(i) * 0.5f, -float(i), float(i * i) * 0.25f);
+  std::vector<CPackedVector3f> packed(unpacked.size());
+  std::vector<CPackedHalfVector3f> packedHalf(unpacked.size());
+  std::vector<CVector3f> reloaded(unpacked.size());
+  storePacked(unpacked, packed);
+  loadPacked(packed, reloaded);
+  assert(reloaded == unpacked);
+  storePacked(unpacked, packedHalf);
+  loadPacked(packedHalf, reloaded);
+  assert(reloaded == unpacked);
+
+  std::vector<CQuaternion> rotations;
+  for (int i = 0; i < 5; ++i)
+    rotations.push_back(CQuaternion::fromAxisAngle(CVector3f(1.f, float(i), 2.f).normalized(), float(i) * 1.5f));
+  std::vector<CPackedQuaternion> packedRotations(rotations.size());
+  std::vector<CPackedHalfQuaternion> packedHalfRotations(rotations.size());
+  std::vector<CQuaternion> reloadedRotations(rotations.size());
+  const CVector3f rotated(1.f, 2.f, 3.f);
+  storePacked(rotations, packedRotations);
+  loadPacked(packedRotations, reloadedRotations);
+  for (size_t i = 0; i < rotations.size(); ++i)
+    assert(close_enough(reloadedRotations[i].transform(rotated), rotations[i].transform(rotated), 0.001f));
+  storePacked(rotations, packedHalfRotations);
+  loadPacked(packedHalfRotations, reloadedRotations);
+  for (size_t i = 0; i < rotations.size(); ++i)
+    assert(close_enough(reloadedRotations[i].transform(rotated), rotations[i].transform(rotated), 0.02f));
+  std::cout << "Packed " << sizeof(CPackedVector3f) << "/" << sizeof(CPackedQuaternion) << " bytes" << std::endl;
   return 0;
 }